@@ -20,6 +20,7 @@
 #include "host_rpu_sys_if.h"
 #include "fmac_cmd_common.h"
 #include "fmac_structs_common.h"
+#include "rpu_stats_common.h"
 
 #include <patch_info.h>
 
@@ -47,6 +48,30 @@ void nrf_wifi_fmac_deinit(struct nrf_wifi_fmac_priv *fpriv);
 void nrf_wifi_fmac_dev_rem(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx);
 
 
+/**
+ * @brief Allocate the command completion objects of a RPU instance.
+ * @param fmac_dev_ctx Pointer to the context of the RPU instance.
+ *
+ * This function allocates the completion objects which are used to wait
+ * for the responses to the commands sent to the RPU, and the lock guarding
+ * the mode specific state the event handler shares with the API. The
+ * objects are freed as part of nrf_wifi_fmac_dev_rem.
+ *
+ * @return Command execution status
+ */
+enum nrf_wifi_status nrf_wifi_fmac_dev_comps_alloc(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx);
+
+
+/**
+ * @brief Free the command completion objects of a RPU instance.
+ * @param fmac_dev_ctx Pointer to the context of the RPU instance.
+ *
+ * This function frees the completion objects and the lock allocated using
+ * nrf_wifi_fmac_dev_comps_alloc.
+ */
+void nrf_wifi_fmac_dev_comps_free(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx);
+
+
 /**
  * @brief Validate the firmware header.
  * @param fmac_dev_ctx Pointer to the UMAC IF context for a RPU WLAN device.
@@ -127,6 +152,57 @@ enum nrf_wifi_status nrf_wifi_fmac_fw_chunk_load(struct nrf_wifi_fmac_dev_ctx *f
 enum nrf_wifi_status nrf_wifi_fmac_fw_load(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
 					   struct nrf_wifi_fmac_fw_info *fmac_fw);
 
+/**
+ * @brief Verify the patches already held by the RPU instead of rewriting them.
+ * @param fpriv Pointer to the context of the UMAC IF layer.
+ * @param enable Whether the RPU retains the patch memory across a reload.
+ *
+ * When the image being loaded is the one last loaded (as identified by the
+ * hash in its header), each patch chunk is first read back from the RPU and
+ * only written if it differs. A patch whose first chunk differs is written
+ * without further verification. This only pays off where the RPU retains its
+ * memory across a reload, e.g. a soft reset without a power cycle, and is
+ * disabled by default.
+ *
+ * @return Command execution status
+ */
+enum nrf_wifi_status nrf_wifi_fmac_fw_cache_verify_set(struct nrf_wifi_fmac_priv *fpriv,
+						       bool enable);
+
+/**
+ * @brief Drop the cached firmware image.
+ * @param fpriv Pointer to the context of the UMAC IF layer.
+ *
+ * nrf_wifi_fmac_fw_parse caches the parsed and validated image and reuses it
+ * when called again with the same image. This is to be called if the memory
+ * holding the image is freed or reused for something else.
+ */
+void nrf_wifi_fmac_fw_cache_invalidate(struct nrf_wifi_fmac_priv *fpriv);
+
+/**
+ * @brief Get the firmware image cache and load statistics.
+ * @param fpriv Pointer to the context of the UMAC IF layer.
+ * @param stats Pointer to the structure to be filled with the statistics.
+ *
+ * @return Command execution status
+ */
+enum nrf_wifi_status nrf_wifi_fmac_fw_cache_stats_get(struct nrf_wifi_fmac_priv *fpriv,
+						      struct nrf_wifi_fmac_fw_cache_stats *stats);
+
+/**
+ * @brief Get the timeline of the bring-up of a RPU device.
+ * @param fmac_dev_ctx Pointer to the UMAC IF context for a RPU WLAN device.
+ * @param timeline Pointer to the structure to be filled with the timeline.
+ *
+ * The timeline holds, for each bring-up phase, the start and end times along
+ * with the bus traffic and register polls done during the phase. Phases are
+ * recorded again on every (re)initialization of the device.
+ *
+ * @return Command execution status
+ */
+enum nrf_wifi_status nrf_wifi_fmac_boot_timeline_get(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+						     struct nrf_wifi_fmac_boot_timeline *timeline);
+
 
 /**
  * @brief Get FW versions from the RPU.
@@ -253,6 +329,80 @@ enum nrf_wifi_status nrf_wifi_sys_fmac_get_power_save_info(void *fmac_dev_ctx,
  */
 enum nrf_wifi_status nrf_wifi_fmac_stats_reset(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx);
 
+/**
+ * @brief Read debug statistics directly from RPU memory.
+ * @param fmac_dev_ctx Pointer to the UMAC IF context for a RPU WLAN device.
+ * @param groups Statistics groups of the active firmware variant (e.g.
+ *               rpu_all_umac_stats or rpu_all_lmac_stats), terminated by an
+ *               entry with a NULL stats table.
+ * @param stats Array to be filled with the name/value pairs.
+ * @param max_stats Number of entries available in @p stats.
+ * @param num_stats Number of entries filled in @p stats.
+ *
+ * This function reads all the counters listed in @p groups from the RPU
+ * memory. The counter addresses are sorted and merged into contiguous
+ * blocks so that the counters are fetched with as few RPU memory reads as
+ * possible. The values are returned in the order of @p groups.
+ *
+ * @return Command execution status
+ */
+enum nrf_wifi_status nrf_wifi_fmac_mem_stats_get(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+						 const struct rpu_stat_global *groups,
+						 struct nrf_wifi_fmac_mem_stat *stats,
+						 unsigned int max_stats,
+						 unsigned int *num_stats);
+
+#if defined(NRF_WIFI_LOW_POWER) || defined(__DOXYGEN__)
+/**
+ * @brief Get the RPU power state residency and wake statistics.
+ * @param fmac_dev_ctx Pointer to the UMAC IF context for a RPU WLAN device.
+ * @param ps_stats Pointer to the structure to be filled with the statistics.
+ *
+ * This function returns the time the host kept the RPU awake and let it
+ * sleep, the number and latency of the RPU wakes and the breakdown of the
+ * wakes by cause, as seen by the host since init or the last reset.
+ *
+ * @return Command execution status
+ */
+enum nrf_wifi_status nrf_wifi_fmac_rpu_ps_stats_get(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+						    struct nrf_wifi_hal_ps_stats *ps_stats);
+
+/**
+ * @brief Reset the RPU power state residency and wake statistics.
+ * @param fmac_dev_ctx Pointer to the UMAC IF context for a RPU WLAN device.
+ *
+ * @return Command execution status
+ */
+enum nrf_wifi_status nrf_wifi_fmac_rpu_ps_stats_reset(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx);
+
+/**
+ * @brief Set the bounds of the adaptive RPU idle timeout.
+ * @param fmac_dev_ctx Pointer to the UMAC IF context for a RPU WLAN device.
+ * @param min_ms Minimum idle timeout (in ms).
+ * @param max_ms Maximum idle timeout (in ms).
+ *
+ * The host lets the RPU sleep once it has not been accessed for the idle
+ * timeout. The timeout is picked from the observed gaps between RPU accesses
+ * to trade the time the RPU is kept awake against the wake stalls, and is
+ * kept within these bounds.
+ *
+ * @return Command execution status
+ */
+enum nrf_wifi_status nrf_wifi_fmac_rpu_ps_idle_timeout_bounds_set(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+								  unsigned int min_ms,
+								  unsigned int max_ms);
+
+/**
+ * @brief Override the adaptive RPU idle timeout with a fixed value.
+ * @param fmac_dev_ctx Pointer to the UMAC IF context for a RPU WLAN device.
+ * @param timeout_ms Fixed idle timeout (in ms), 0 to go back to the adaptive one.
+ *
+ * @return Command execution status
+ */
+enum nrf_wifi_status nrf_wifi_fmac_rpu_ps_idle_timeout_override(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+								unsigned int timeout_ms);
+#endif /* NRF_WIFI_LOW_POWER */
+
 /**
  * @}
  */
@@ -18,6 +18,7 @@
 
 #include "osal_api.h"
 #include "host_rpu_umac_if.h"
+#include "patch_info.h"
 
 #define NRF_WIFI_FW_CHUNK_ID_STR_LEN 16
 
@@ -134,6 +135,192 @@ struct nrf_wifi_fmac_reg_info {
 	struct nrf_wifi_get_reg_chn_info reg_chan_info[MAX_NUM_REG_CHANELS];
 };
 
+/** Offset used in &struct nrf_wifi_fmac_ie_index for elements which are not present. */
+#define NRF_WIFI_FMAC_IE_NOT_PRESENT 0xFFFF
+
+/**
+ * @brief Information elements tracked in &struct nrf_wifi_fmac_ie_index.
+ */
+enum nrf_wifi_fmac_ie {
+	/** SSID element. */
+	NRF_WIFI_FMAC_IE_SSID,
+	/** Supported rates element. */
+	NRF_WIFI_FMAC_IE_SUPP_RATES,
+	/** DS parameter set element. */
+	NRF_WIFI_FMAC_IE_DS_PARAMS,
+	/** TIM element. */
+	NRF_WIFI_FMAC_IE_TIM,
+	/** Country element. */
+	NRF_WIFI_FMAC_IE_COUNTRY,
+	/** HT capabilities element. */
+	NRF_WIFI_FMAC_IE_HT_CAP,
+	/** RSN element. */
+	NRF_WIFI_FMAC_IE_RSN,
+	/** Extended supported rates element. */
+	NRF_WIFI_FMAC_IE_EXT_SUPP_RATES,
+	/** HT operation element. */
+	NRF_WIFI_FMAC_IE_HT_OPER,
+	/** Extended capabilities element. */
+	NRF_WIFI_FMAC_IE_EXT_CAP,
+	/** VHT capabilities element. */
+	NRF_WIFI_FMAC_IE_VHT_CAP,
+	/** VHT operation element. */
+	NRF_WIFI_FMAC_IE_VHT_OPER,
+	/** WPA vendor specific element. */
+	NRF_WIFI_FMAC_IE_WPA,
+	/** WMM vendor specific element. */
+	NRF_WIFI_FMAC_IE_WMM,
+	/** HE capabilities extension element. */
+	NRF_WIFI_FMAC_IE_HE_CAP,
+	/** HE operation extension element. */
+	NRF_WIFI_FMAC_IE_HE_OPER,
+	/** Number of tracked elements. */
+	NRF_WIFI_FMAC_IE_MAX
+};
+
+/**
+ * @brief Structure to hold the index of the information elements of a frame.
+ *
+ * Only the first occurrence of each tracked element is indexed.
+ */
+struct nrf_wifi_fmac_ie_index {
+	/** Offset of the information elements from the start of the frame. */
+	unsigned short ies_offset;
+	/** Length of the information elements. */
+	unsigned short ies_len;
+	/** Offset of the element ID of each tracked element from the start of
+	 *  the information elements, %NRF_WIFI_FMAC_IE_NOT_PRESENT if absent.
+	 */
+	unsigned short offset[NRF_WIFI_FMAC_IE_MAX];
+	/** Value of the length field of each tracked element. */
+	unsigned char len[NRF_WIFI_FMAC_IE_MAX];
+	/** The elements were truncated or malformed, only the elements
+	 *  preceding the first malformed one were indexed.
+	 */
+	bool malformed;
+};
+
+/** Maximum gap (in bytes) between two statistics merged into one RPU memory read. */
+#define NRF_WIFI_FMAC_MEM_STATS_MAX_GAP 64
+/** Maximum length (in bytes) of a single merged RPU memory read. */
+#define NRF_WIFI_FMAC_MEM_STATS_MAX_BLOCK_LEN 512
+
+/**
+ * @brief Structure to hold a debug statistic read from RPU memory.
+ *
+ */
+struct nrf_wifi_fmac_mem_stat {
+	/** Name of the statistics group the counter belongs to. */
+	const char *group;
+	/** Name of the counter. */
+	const char *name;
+	/** Value of the counter. */
+	unsigned int value;
+};
+
+/**
+ * @brief Structure to hold the firmware image cache statistics.
+ */
+struct nrf_wifi_fmac_fw_cache_stats {
+	/** Number of times an image was parsed and validated. */
+	unsigned int num_parses;
+	/** Number of times parsing was skipped as the image was already cached. */
+	unsigned int num_cache_hits;
+	/** Number of firmware loads. */
+	unsigned int num_loads;
+	/** Time (in us) taken by the last load, from the reset to the boot check. */
+	unsigned int last_load_us;
+	/** Number of patch bytes written to the RPU by the last load. */
+	unsigned int last_bytes_written;
+	/** Number of patch bytes read back from the RPU by the last load. */
+	unsigned int last_bytes_verified;
+	/** Number of patch bytes the last load did not rewrite as the RPU already held them. */
+	unsigned int last_bytes_skipped;
+};
+
+/**
+ * @brief Structure to hold the parsed firmware image.
+ *
+ * The cache lives in the FMAC context so that it survives the removal and
+ * re-addition of the device, e.g. during an RPU recovery.
+ */
+struct nrf_wifi_fmac_fw_cache {
+	/** Whether the cache holds a parsed and validated image. */
+	bool valid;
+	/** Image the cache was filled from. */
+	const void *fw_data;
+	/** Size of the image the cache was filled from. */
+	unsigned int fw_size;
+	/** Version from the image header. */
+	unsigned int version;
+	/** Feature flags from the image header. */
+	unsigned int feature_flags;
+	/** Hash from the image header. */
+	unsigned char hash[NRF_WIFI_PATCH_HASH_LEN];
+	/** Patches of the image. */
+	struct nrf_wifi_fmac_fw_info fw_info;
+	/** Whether loaded_hash identifies the patches last loaded to the RPU. */
+	bool loaded;
+	/** Hash of the image last loaded to the RPU. */
+	unsigned char loaded_hash[NRF_WIFI_PATCH_HASH_LEN];
+	/** Whether the patches already held by the RPU are verified instead of rewritten. */
+	bool verify;
+	/** Cache statistics. */
+	struct nrf_wifi_fmac_fw_cache_stats stats;
+};
+
+/**
+ * @brief Phases of the RPU bring-up, in the order they happen.
+ */
+enum nrf_wifi_fmac_boot_phase {
+	/** Device addition, i.e. HAL and bus device setup. */
+	NRF_WIFI_FMAC_BOOT_PHASE_DEV_ADD,
+	/** Reset of the RPU processors. */
+	NRF_WIFI_FMAC_BOOT_PHASE_FW_RESET,
+	/** Download of the UMAC patches. */
+	NRF_WIFI_FMAC_BOOT_PHASE_UMAC_PATCH,
+	/** Download of the LMAC patches. */
+	NRF_WIFI_FMAC_BOOT_PHASE_LMAC_PATCH,
+	/** Boot of the RPU processors and boot signature check. */
+	NRF_WIFI_FMAC_BOOT_PHASE_FW_BOOT,
+	/** Device initialization up to the firmware initialization (HAL, OTP, RF parameters). */
+	NRF_WIFI_FMAC_BOOT_PHASE_DEV_INIT,
+	/** TX path initialization. */
+	NRF_WIFI_FMAC_BOOT_PHASE_INIT_TX,
+	/** RX path initialization, i.e. programming of the RX buffers. */
+	NRF_WIFI_FMAC_BOOT_PHASE_INIT_RX,
+	/** Firmware initialization, up to the reception of the init done event. */
+	NRF_WIFI_FMAC_BOOT_PHASE_FW_INIT,
+	/** Number of bring-up phases. */
+	NRF_WIFI_FMAC_BOOT_PHASE_MAX
+};
+
+/**
+ * @brief Structure to hold the profile of a bring-up phase.
+ */
+struct nrf_wifi_fmac_boot_phase_info {
+	/** Time (in us) at which the phase started, 0 if it did not run. */
+	unsigned long start_us;
+	/** Time (in us) at which the phase ended. */
+	unsigned long end_us;
+	/** Whether the phase completed successfully. */
+	bool done;
+	/** Number of bytes read from the RPU during the phase. */
+	unsigned int bytes_read;
+	/** Number of bytes written to the RPU during the phase. */
+	unsigned int bytes_written;
+	/** Number of times the RPU was polled during the phase. */
+	unsigned int num_polls;
+};
+
+/**
+ * @brief Structure to hold the timeline of the RPU bring-up.
+ */
+struct nrf_wifi_fmac_boot_timeline {
+	/** Profile of each phase, see &enum nrf_wifi_fmac_boot_phase. */
+	struct nrf_wifi_fmac_boot_phase_info phases[NRF_WIFI_FMAC_BOOT_PHASE_MAX];
+};
+
 /**
  * @brief Structure to hold common fmac priv parameter data.
  *
@@ -143,6 +330,8 @@ struct nrf_wifi_fmac_priv {
 	struct nrf_wifi_hal_priv *hpriv;
 	/** Operation mode. \ref nrf_wifi_op_mode */
 	int op_mode;
+	/** Parsed firmware image. */
+	struct nrf_wifi_fmac_fw_cache fw_cache;
 	/** Data pointer to mode specific parameters */
 	char priv[];
 };
@@ -186,6 +375,22 @@ struct nrf_wifi_fmac_dev_ctx {
 	struct nrf_wifi_event_regulatory_change *reg_change;
 	/** TX power ceiling parameters */
 	struct nrf_wifi_tx_pwr_ceil_params *tx_pwr_ceil_params;
+	/** Completion signalled on reception of the firmware init done event */
+	void *fw_init_comp;
+	/** Completion signalled on reception of the firmware deinit done event */
+	void *fw_deinit_comp;
+	/** Completion signalled on reception of the statistics event */
+	void *stats_comp;
+	/** Completion signalled on reception of the get regulatory event */
+	void *reg_get_comp;
+	/** Completion signalled on reception of the regulatory change event */
+	void *reg_set_comp;
+	/** Completion signalled on reception of a mode specific command response */
+	void *cmd_comp;
+	/** Lock protecting mode specific state shared with the event handler */
+	void *mode_lock;
+	/** Timeline of the bring-up of the device */
+	struct nrf_wifi_fmac_boot_timeline boot_timeline;
 	/** Data pointer to mode specific parameters */
 	char priv[];
 };
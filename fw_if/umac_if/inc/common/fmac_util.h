@@ -67,6 +67,28 @@
 #define NRF_WIFI_FMAC_IPV6_TOS_SHIFT 0x04 /* 4bit */
 #define NRF_WIFI_FMAC_ETH_TYPE_MASK 0xFFFF
 
+#define NRF_WIFI_FMAC_BCN_PRB_RSP_FIXED_LEN 36 /* MAC header, timestamp, beacon int, capab */
+
+#define NRF_WIFI_FMAC_EID_SSID 0
+#define NRF_WIFI_FMAC_EID_SUPP_RATES 1
+#define NRF_WIFI_FMAC_EID_DS_PARAMS 3
+#define NRF_WIFI_FMAC_EID_TIM 5
+#define NRF_WIFI_FMAC_EID_COUNTRY 7
+#define NRF_WIFI_FMAC_EID_HT_CAP 45
+#define NRF_WIFI_FMAC_EID_RSN 48
+#define NRF_WIFI_FMAC_EID_EXT_SUPP_RATES 50
+#define NRF_WIFI_FMAC_EID_HT_OPER 61
+#define NRF_WIFI_FMAC_EID_EXT_CAP 127
+#define NRF_WIFI_FMAC_EID_VHT_CAP 191
+#define NRF_WIFI_FMAC_EID_VHT_OPER 192
+#define NRF_WIFI_FMAC_EID_VENDOR 221
+#define NRF_WIFI_FMAC_EID_EXTENSION 255
+#define NRF_WIFI_FMAC_EID_EXT_HE_CAP 35
+#define NRF_WIFI_FMAC_EID_EXT_HE_OPER 36
+#define NRF_WIFI_FMAC_VENDOR_OUI_MICROSOFT 0x0050F2
+#define NRF_WIFI_FMAC_VENDOR_TYPE_WPA 1
+#define NRF_WIFI_FMAC_VENDOR_TYPE_WMM 2
+
 struct nrf_wifi_fmac_ieee80211_hdr {
 	unsigned short fc;
 	unsigned short dur_id;
@@ -104,7 +126,22 @@ unsigned short nrf_wifi_util_tx_get_eth_type(void *nwb);
 bool nrf_wifi_util_is_arr_zero(unsigned char *arr,
 			       unsigned int arr_sz);
 
+bool nrf_wifi_util_ie_index(const unsigned char *ies,
+			    unsigned int ies_len,
+			    struct nrf_wifi_fmac_ie_index *ie_index);
+
+bool nrf_wifi_util_bcn_prb_rsp_ie_index(const unsigned char *frm,
+					unsigned int frm_len,
+					struct nrf_wifi_fmac_ie_index *ie_index);
+
 void *wifi_fmac_priv(struct nrf_wifi_fmac_priv *def);
 void *wifi_dev_priv(struct nrf_wifi_fmac_dev_ctx *def);
 
+void nrf_wifi_util_boot_phase_start(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+				    enum nrf_wifi_fmac_boot_phase phase);
+
+void nrf_wifi_util_boot_phase_end(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+				  enum nrf_wifi_fmac_boot_phase phase,
+				  enum nrf_wifi_status status);
+
 #endif /* __FMAC_UTIL_H__ */
@@ -118,6 +118,110 @@ enum nrf_wifi_status nrf_wifi_off_raw_tx_fmac_start(struct nrf_wifi_fmac_dev_ctx
  */
 enum nrf_wifi_status nrf_wifi_off_raw_tx_fmac_stop(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx);
 
+/**
+ * @brief Register the callbacks of the offloaded raw TX FMAC layer.
+ * @param fmac_dev_ctx Pointer to the context of the RPU instance.
+ * @param callbk_fns Callback functions to be invoked on schedule status and
+ *		     asynchronous statistics events.
+ *
+ * @retval NRF_WIFI_STATUS_SUCCESS On Success
+ * @retval NRF_WIFI_STATUS_FAIL On failure
+ */
+enum nrf_wifi_status nrf_wifi_off_raw_tx_fmac_callbk_set(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+							 struct nrf_wifi_off_raw_tx_fmac_callbk_fns *callbk_fns);
+
+/**
+ * @brief Add an offloaded raw TX schedule.
+ * @param fmac_dev_ctx Pointer to the context of the RPU instance.
+ * @param off_ctrl_params Period, TX power and channel of the schedule.
+ * @param off_tx_params TX parameters of the schedule, the packet length and
+ *			packet RAM pointer are filled in by the driver.
+ * @param pkt Frame to be transmitted.
+ * @param pkt_len Length of the frame (at most NRF_WIFI_OFF_RAW_TX_PKT_MAX_LEN).
+ * @param sched_id Pointer to where the ID of the added schedule is returned.
+ *
+ * This function copies the frame to the packet RAM owned by the schedule.
+ * The schedule becomes active on the next nrf_wifi_off_raw_tx_fmac_sched_run().
+ * Schedules and nrf_wifi_off_raw_tx_fmac_conf() are not meant to be mixed.
+ *
+ * @retval NRF_WIFI_STATUS_SUCCESS On Success
+ * @retval NRF_WIFI_STATUS_FAIL On failure
+ */
+enum nrf_wifi_status nrf_wifi_off_raw_tx_fmac_sched_add(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+							struct nrf_wifi_offload_ctrl_params *off_ctrl_params,
+							struct nrf_wifi_offload_tx_ctrl *off_tx_params,
+							unsigned char *pkt,
+							unsigned int pkt_len,
+							unsigned char *sched_id);
+
+/**
+ * @brief Update the payload of an offloaded raw TX schedule.
+ * @param fmac_dev_ctx Pointer to the context of the RPU instance.
+ * @param sched_id ID of the schedule.
+ * @param pkt New frame to be transmitted.
+ * @param pkt_len Length of the new frame.
+ *
+ * This function writes the frame to the idle payload buffer of the schedule
+ * and switches to it without stopping the transmission. The status of the
+ * reconfiguration is reported through the schedule status callback. The
+ * running schedule cannot be updated while the status of the previous
+ * configuration is still awaited.
+ *
+ * @retval NRF_WIFI_STATUS_SUCCESS On Success
+ * @retval NRF_WIFI_STATUS_FAIL On failure
+ */
+enum nrf_wifi_status nrf_wifi_off_raw_tx_fmac_sched_update(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+							   unsigned char sched_id,
+							   unsigned char *pkt,
+							   unsigned int pkt_len);
+
+/**
+ * @brief Delete an offloaded raw TX schedule.
+ * @param fmac_dev_ctx Pointer to the context of the RPU instance.
+ * @param sched_id ID of the schedule.
+ *
+ * If the schedule is running in the RPU the next due schedule takes over,
+ * offloaded raw TX is stopped when it was the last one. The running schedule
+ * cannot be deleted while the status of its configuration is still awaited.
+ *
+ * @retval NRF_WIFI_STATUS_SUCCESS On Success
+ * @retval NRF_WIFI_STATUS_FAIL On failure
+ */
+enum nrf_wifi_status nrf_wifi_off_raw_tx_fmac_sched_del(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+							unsigned char sched_id);
+
+/**
+ * @brief Run the offloaded raw TX schedules.
+ * @param fmac_dev_ctx Pointer to the context of the RPU instance.
+ * @param next_run_us Pointer to where the time (in us) until the next run is
+ *		      returned, 0 if no further run is needed.
+ *
+ * The RPU transmits one schedule at a time. This function programs the
+ * schedule which is due the earliest and is expected to be called again by
+ * the OS layer after @p next_run_us. A single schedule runs in the RPU
+ * without any further host involvement. A switch to another schedule waits
+ * for the status of the previous configuration, the run is then retried
+ * after NRF_WIFI_OFF_RAW_TX_SCHED_RETRY_US.
+ *
+ * @retval NRF_WIFI_STATUS_SUCCESS On Success
+ * @retval NRF_WIFI_STATUS_FAIL On failure
+ */
+enum nrf_wifi_status nrf_wifi_off_raw_tx_fmac_sched_run(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+							unsigned int *next_run_us);
+
+/**
+ * @brief Get the host side statistics of an offloaded raw TX schedule.
+ * @param fmac_dev_ctx Pointer to the context of the RPU instance.
+ * @param sched_id ID of the schedule.
+ * @param stats Pointer to where the statistics are to be copied.
+ *
+ * @retval NRF_WIFI_STATUS_SUCCESS On Success
+ * @retval NRF_WIFI_STATUS_FAIL On failure
+ */
+enum nrf_wifi_status nrf_wifi_off_raw_tx_fmac_sched_stats_get(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+							      unsigned char sched_id,
+							      struct nrf_wifi_off_raw_tx_sched_stats *stats);
+
 /**
  * @brief Get the RF parameters to be programmed to the RPU.
  * @param fmac_dev_ctx Pointer to the UMAC IF context for a RPU WLAN device.
@@ -149,6 +253,17 @@ enum nrf_wifi_status nrf_wifi_off_raw_tx_fmac_stats_get(struct nrf_wifi_fmac_dev
 							enum rpu_op_mode op_mode,
 							struct rpu_off_raw_tx_op_stats *stats);
 
+/**
+ * @brief Request the RPU statistics without waiting for them.
+ * @param fmac_dev_ctx Pointer to the UMAC IF context for a RPU WLAN device.
+ *
+ * The statistics are delivered through the stats callback registered with
+ * nrf_wifi_off_raw_tx_fmac_callbk_set().
+ *
+ * @return Command execution status
+ */
+enum nrf_wifi_status nrf_wifi_off_raw_tx_fmac_stats_req(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx);
+
 /**
  * @}
  */
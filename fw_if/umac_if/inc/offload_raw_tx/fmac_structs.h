@@ -23,6 +23,65 @@
 
 #define NRF_WIFI_FMAC_PARAMS_RECV_TIMEOUT 100 /* ms */
 
+/** Maximum number of offloaded raw TX schedules managed by the host. */
+#define NRF_WIFI_OFF_RAW_TX_MAX_SCHEDS 4
+/** Maximum length of an offloaded raw TX frame. */
+#define NRF_WIFI_OFF_RAW_TX_PKT_MAX_LEN 600
+/** Size of one payload buffer in the packet RAM (word aligned). */
+#define NRF_WIFI_OFF_RAW_TX_SCHED_BUF_LEN 608
+/** Schedule ID used when no schedule is referenced. */
+#define NRF_WIFI_OFF_RAW_TX_SCHED_INVALID 0xFF
+/** Time (in us) after which a schedule run held by an awaited status is retried. */
+#define NRF_WIFI_OFF_RAW_TX_SCHED_RETRY_US 1000
+
+/**
+ * @brief Host side statistics of an offloaded raw TX schedule.
+ */
+struct nrf_wifi_off_raw_tx_sched_stats {
+	/** Number of times the schedule was programmed to the RPU. */
+	unsigned int num_activations;
+	/** Number of payload updates applied to the schedule. */
+	unsigned int num_updates;
+	/** Number of configuration commands rejected by the RPU. */
+	unsigned int num_cmd_fail;
+};
+
+/**
+ * @brief Offloaded raw TX schedule.
+ *
+ * The RPU transmits one offloaded configuration at a time, the host
+ * multiplexes the schedules onto it. Each schedule owns two payload
+ * buffers in the packet RAM so that a payload update can be written
+ * to the idle buffer and switched to without stopping the transmission.
+ */
+struct nrf_wifi_off_raw_tx_sched {
+	/** Schedule slot is allocated. */
+	bool in_use;
+	/** Index of the payload buffer holding the live payload. */
+	unsigned char buf_idx;
+	/** Time (in us) at which the schedule is next due. */
+	unsigned long next_due_us;
+	/** Control information (period, power, channel) of the schedule. */
+	struct nrf_wifi_offload_ctrl_params ctrl_info;
+	/** TX parameters of the schedule. */
+	struct nrf_wifi_offload_tx_ctrl tx_params;
+	/** Host side statistics of the schedule. */
+	struct nrf_wifi_off_raw_tx_sched_stats stats;
+};
+
+/**
+ * @brief Callback functions to be invoked by the offloaded raw TX FMAC layer.
+ */
+struct nrf_wifi_off_raw_tx_fmac_callbk_fns {
+	/** Callback invoked when the RPU statistics requested asynchronously arrive. */
+	void (*stats_callbk_fn)(void *os_dev_ctx,
+				struct rpu_off_raw_tx_fw_stats *fw_stats);
+	/** Callback invoked when the RPU reports the status of a schedule configuration. */
+	void (*sched_status_callbk_fn)(void *os_dev_ctx,
+				       unsigned char sched_id,
+				       int status);
+};
+
 /**
  * @brief  Structure to hold per device context information for the UMAC IF layer.
  *
@@ -32,6 +91,20 @@
 struct nrf_wifi_off_raw_tx_fmac_dev_ctx {
     enum nrf_wifi_cmd_status off_raw_tx_cmd_status;
     bool off_raw_tx_cmd_done;
+    /** Offloaded raw TX schedules, this and the schedule state below are
+     *  protected by the mode lock of the device context.
+     */
+    struct nrf_wifi_off_raw_tx_sched sched[NRF_WIFI_OFF_RAW_TX_MAX_SCHEDS];
+    /** Schedule currently programmed to the RPU. */
+    unsigned char cur_sched;
+    /** Schedule whose configuration status is awaited from the RPU. */
+    unsigned char sched_cmd_id;
+    /** Offloaded raw TX has been started by the schedules. */
+    bool sched_tx_started;
+    /** Statistics have been requested without waiting for them. */
+    bool stats_async;
+    /** Callback functions registered by the OS layer. */
+    struct nrf_wifi_off_raw_tx_fmac_callbk_fns callbk_fns;
 };
 
 
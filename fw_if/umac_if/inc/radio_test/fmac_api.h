@@ -113,6 +113,62 @@ enum nrf_wifi_status nrf_wifi_rt_fmac_rf_test_rx_cap(struct nrf_wifi_fmac_dev_ct
 						     unsigned char *timeout_status);
 
 
+/**
+ * @brief Start a streaming RX capture in radio test mode.
+ * @param fmac_dev_ctx Pointer to the UMAC IF context for a RPU WLAN device.
+ * @param params Parameters of the capture stream.
+ *
+ * This function chains RX captures of @p params->num_samples each. As soon as
+ * a capture completes the next one is armed in the RPU and the captured chunk
+ * is handed to @p params->chunk_callbk_fn. Chunks carry the sequence number
+ * of their capture, failed captures are reported as a gap through the
+ * num_lost field of the next delivered chunk.
+ *
+ * Other radio test commands fail until the stream has been stopped with
+ * nrf_wifi_rt_fmac_rf_test_rx_cap_stream_stop().
+ *
+ * @retval NRF_WIFI_STATUS_SUCCESS On Success
+ * @retval NRF_WIFI_STATUS_FAIL On failure to execute command
+ */
+enum nrf_wifi_status nrf_wifi_rt_fmac_rf_test_rx_cap_stream_start(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+								  struct nrf_wifi_rt_rx_cap_stream_params *params);
+
+
+/**
+ * @brief Stop a streaming RX capture in radio test mode.
+ * @param fmac_dev_ctx Pointer to the UMAC IF context for a RPU WLAN device.
+ * @param stats Pointer to where the statistics of the stream are copied, can be NULL.
+ *
+ * This function waits for the capture armed in the RPU to complete and
+ * releases the capture buffers. It is also to be called once a stream
+ * with a fixed number of chunks has completed. On timeout the capture
+ * buffers are kept and the stream stays busy until the armed capture
+ * completes, this function is then to be called again.
+ *
+ * @retval NRF_WIFI_STATUS_SUCCESS On Success
+ * @retval NRF_WIFI_STATUS_FAIL On timeout waiting for the armed capture
+ */
+enum nrf_wifi_status nrf_wifi_rt_fmac_rf_test_rx_cap_stream_stop(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+								 struct nrf_wifi_rt_rx_cap_stream_stats *stats);
+
+
+/**
+ * @brief Unpack RX capture samples into I/Q components.
+ * @param cap_data Packed samples as returned by the RX capture.
+ * @param num_samples Number of samples in @p cap_data.
+ * @param iq Pointer to memory for 2 * @p num_samples values, I and Q interleaved.
+ *
+ * Each sample is a 24 bit little endian word holding the 12 bit signed
+ * I component in bits 11:0 and the 12 bit signed Q component in bits 23:12.
+ *
+ * @retval NRF_WIFI_STATUS_SUCCESS On Success
+ * @retval NRF_WIFI_STATUS_FAIL On invalid parameters
+ */
+enum nrf_wifi_status nrf_wifi_rt_fmac_rx_cap_unpack(const unsigned char *cap_data,
+						    unsigned int num_samples,
+						    signed short *iq);
+
+
 /**
  * @brief Start/Stop RF TX tone test in radio test mode.
  * @param fmac_dev_ctx Pointer to the UMAC IF context for a RPU WLAN device.
@@ -23,6 +23,84 @@
 #include "radio_test/phy_rf_params.h"
 #include "common/fmac_structs_common.h"
 
+/** Number of bytes in which one RX capture sample is packed. */
+#define NRF_WIFI_RT_RX_CAP_SAMPLE_SZ 3
+
+/**
+ * @brief Chunk of samples delivered by a streaming RX capture.
+ */
+struct nrf_wifi_rt_rx_cap_chunk {
+	/** Sequence number of the capture which produced the chunk. */
+	unsigned int seq;
+	/** Number of captures lost since the previously delivered chunk. */
+	unsigned int num_lost;
+	/** Time (in us) at which the chunk was read from the RPU. */
+	unsigned long timestamp_us;
+	/** Number of samples in the chunk. */
+	unsigned short int num_samples;
+	/** Packed samples, valid until the callback for the next chunk returns. */
+	unsigned char *data;
+};
+
+/**
+ * @brief Parameters of a streaming RX capture.
+ */
+struct nrf_wifi_rt_rx_cap_stream_params {
+	/** Type of RX capture, one of the NRF_WIFI_RF_TEST_RX_*_CAP tests. */
+	enum nrf_wifi_rf_test rf_test_type;
+	/** Number of samples captured per chunk. */
+	unsigned short int num_samples;
+	/** Capture timeout of each chunk. */
+	unsigned short int capture_timeout;
+	/** LNA gain value. */
+	unsigned char lna_gain;
+	/** Baseband gain value. */
+	unsigned char bb_gain;
+	/** Number of chunks to be captured, 0 to capture until stopped. */
+	unsigned int num_chunks;
+	/** Callback invoked for each captured chunk. */
+	void (*chunk_callbk_fn)(void *os_dev_ctx,
+				struct nrf_wifi_rt_rx_cap_chunk *chunk);
+};
+
+/**
+ * @brief Statistics of a streaming RX capture.
+ */
+struct nrf_wifi_rt_rx_cap_stream_stats {
+	/** Number of chunks delivered. */
+	unsigned int num_chunks;
+	/** Number of captures which failed or could not be read. */
+	unsigned int num_lost;
+	/** Number of times re-arming the capture failed. */
+	unsigned int num_rearm_fail;
+};
+
+/**
+ * @brief State of a streaming RX capture.
+ *
+ * Captures are chained back to back: the next capture is armed in the RPU
+ * before the current chunk is handed to the callback, and chunks alternate
+ * between two host buffers.
+ */
+struct nrf_wifi_rt_rx_cap_stream {
+	/** Further captures are to be armed. */
+	bool active;
+	/** A capture is armed in the RPU. */
+	bool in_flight;
+	/** Parameters of the stream. */
+	struct nrf_wifi_rt_rx_cap_stream_params params;
+	/** Host buffers the chunks alternate between. */
+	unsigned char *buf[2];
+	/** Buffer the next chunk is read into. */
+	unsigned char buf_idx;
+	/** Sequence number of the armed capture. */
+	unsigned int seq;
+	/** Number of captures lost since the last delivered chunk. */
+	unsigned int num_lost;
+	/** Statistics of the stream. */
+	struct nrf_wifi_rt_rx_cap_stream_stats stats;
+};
+
 /**
  * @brief  Structure to hold per device context information for the UMAC IF layer.
  *
@@ -42,6 +120,8 @@ struct nrf_wifi_rt_fmac_dev_ctx {
 	enum nrf_wifi_cmd_status radio_cmd_status;
 	/** Firmware RF test RX capture event status */
 	unsigned char capture_status;
+	/** Streaming RX capture state. */
+	struct nrf_wifi_rt_rx_cap_stream rx_cap_stream;
 };
 
 
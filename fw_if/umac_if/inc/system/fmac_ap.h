@@ -21,4 +21,9 @@ enum nrf_wifi_status sap_client_update_pmmode(struct nrf_wifi_fmac_dev_ctx *fmac
 
 enum nrf_wifi_status sap_client_ps_get_frames(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
 					      struct nrf_wifi_sap_ps_get_frames *config);
+
+void sap_client_uapsd_init(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+			   int peer_id,
+			   const unsigned char *ies,
+			   unsigned int ies_len);
 #endif /* __FMAC_AP_H__ */
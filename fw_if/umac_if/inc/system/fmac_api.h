@@ -39,6 +39,11 @@
  * @param callbk_fns Pointer to callback functions for addressing events
  *                   from the UMAC layer. e.g. callback function to process
  *                   packet received from RPU firmware, scan result etc
+ * @param max_peers Number of peers the TX path is sized for, 0 selects
+ *                  the default (MAX_PEERS). Clients of an AP interface
+ *                  are further limited to the maximum number of associated
+ *                  stations reported by the firmware in its wiphy
+ *                  information, once that has been retrieved.
  *
  * This function initializes the UMAC IF layer. It does the following:
  *	    - Creates and initializes the context for the UMAC IF layer.
@@ -51,7 +56,8 @@
  */
 struct nrf_wifi_fmac_priv *nrf_wifi_sys_fmac_init(struct nrf_wifi_data_config_params *data_config,
 						  struct rx_buf_pool_params *rx_buf_pools,
-						  struct nrf_wifi_fmac_callbk_fns *callbk_fns);
+						  struct nrf_wifi_fmac_callbk_fns *callbk_fns,
+						  unsigned int max_peers);
 
 /**
  * @brief Issue a scan request to the RPU firmware.
@@ -121,6 +127,93 @@ enum nrf_wifi_status nrf_wifi_sys_fmac_scan_res_get(void *fmac_dev_ctx,
 enum nrf_wifi_status nrf_wifi_sys_fmac_abort_scan(void *fmac_dev_ctx,
 						unsigned char if_idx);
 
+
+/**
+ * @brief Get the BSSs seen in the recent scans.
+ * @param dev_ctx Pointer to the context of the RPU instance.
+ * @param entries Array to be filled with the BSS entries.
+ * @param max_entries Number of entries available in @p entries.
+ * @param num_entries Number of entries filled in @p entries.
+ *
+ * The scan results (both regular and display scan results) reported by the
+ * RPU are merged into a bounded BSS table keyed by BSSID and band. Repeated
+ * results for a BSS update its entry in place (tracking both the latest and
+ * the best RSSI) and entries which have not been seen for the configured
+ * maximum age are dropped. This function returns the strongest
+ * @p max_entries BSSs sorted by their latest RSSI, without triggering a scan.
+ * The table size is set by NRF70_BSS_TABLE_SIZE, if it is 0 the table is
+ * compiled out and this function always fails.
+ *
+ * @return Command execution status
+ */
+enum nrf_wifi_status nrf_wifi_sys_fmac_bss_table_get(void *dev_ctx,
+						     struct nrf_wifi_fmac_bss_entry *entries,
+						     unsigned int max_entries,
+						     unsigned int *num_entries);
+
+
+/**
+ * @brief Remove all the BSSs from the scan result BSS table.
+ * @param dev_ctx Pointer to the context of the RPU instance.
+ */
+void nrf_wifi_sys_fmac_bss_table_flush(void *dev_ctx);
+
+
+/**
+ * @brief Set the maximum age of the entries in the scan result BSS table.
+ * @param dev_ctx Pointer to the context of the RPU instance.
+ * @param max_age_ms Time (in ms) after which a BSS which has not been seen
+ *                   in any scan result is dropped from the table.
+ */
+void nrf_wifi_sys_fmac_bss_table_max_age_set(void *dev_ctx,
+					     unsigned int max_age_ms);
+
+
+/**
+ * @brief Get the channels on which the BSSs of an SSID were last seen.
+ * @param dev_ctx Pointer to the context of the RPU instance.
+ * @param ssid SSID to look up.
+ * @param freqs Array to be filled with the frequencies (in MHz).
+ * @param max_freqs Number of entries available in @p freqs.
+ * @param num_freqs Number of entries filled in @p freqs.
+ *
+ * The channel hint cache is filled from the scan results and from successful
+ * associations, and unlike the BSS table its entries are not aged out. The
+ * frequencies are returned without duplicates, those of BSSs which were
+ * associated with first followed by the most recently seen ones. The cache
+ * size is set by NRF70_CHAN_HINT_CACHE_SIZE, if it is 0 the cache is compiled
+ * out and no frequencies are returned.
+ *
+ * @return Command execution status
+ */
+enum nrf_wifi_status nrf_wifi_sys_fmac_chan_hints_get(void *dev_ctx,
+						      struct nrf_wifi_ssid *ssid,
+						      unsigned int *freqs,
+						      unsigned int max_freqs,
+						      unsigned int *num_freqs);
+
+
+/**
+ * @brief Trigger a scan restricted to the channels where the SSIDs were last seen.
+ * @param dev_ctx Pointer to the context of the RPU instance.
+ * @param if_idx Index of the interface on which the scan is to be performed.
+ * @param scan_info The parameters needed by the RPU for scan operation.
+ * @param num_chans Number of channels which are scanned, 0 for all channels.
+ *
+ * This function looks up the channel hints of the SSIDs in @p scan_info and
+ * triggers a scan of at most %NRF_WIFI_FMAC_CHAN_HINT_MAX_SCAN_CHANS of those
+ * channels, to reduce the reconnection time after a roam or link loss. If
+ * @p scan_info already specifies channels or no hints are known, the scan is
+ * triggered as requested by @p scan_info. The caller is expected to fall
+ * back to a full scan if a targeted scan does not find the SSIDs.
+ *
+ * @return Command execution status
+ */
+enum nrf_wifi_status nrf_wifi_sys_fmac_scan_targeted(void *dev_ctx,
+						     unsigned char if_idx,
+						     struct nrf_wifi_umac_scan_info *scan_info,
+						     unsigned int *num_chans);
+
 #if defined(NRF70_STA_MODE) || defined(__DOXYGEN__)
 /**
  * @brief Issue an 802.11 authentication request to the RPU firmware.
@@ -329,6 +422,22 @@ enum nrf_wifi_status nrf_wifi_sys_fmac_stop_ap(void *fmac_dev_ctx,
 					   unsigned char if_idx);
 
 
+/**
+ * @brief Release the buffered group addressed frames of a SoftAP at DTIM.
+ * @param dev_ctx Pointer to the UMAC IF context for a RPU WLAN device.
+ *
+ * While at least one client of the SoftAP is in power save, group addressed
+ * frames are held by the driver and sent as a burst once the next DTIM beacon
+ * (counted from the start of the SoftAP) is due. The check is also done on the
+ * TX path, this function lets the OS layer drive it from a timer running at
+ * the beacon interval so that the burst is not delayed when the TX is idle.
+ *
+ *@retval	NRF_WIFI_STATUS_SUCCESS On success
+ *@retval	NRF_WIFI_STATUS_FAIL On failure
+ */
+enum nrf_wifi_status nrf_wifi_sys_fmac_ap_dtim_tick(void *dev_ctx);
+
+
 /**
  * @brief Start P2P mode on an interface.
  * @param fmac_dev_ctx Pointer to the UMAC IF context for a RPU WLAN device.
@@ -613,6 +722,42 @@ enum nrf_wifi_status nrf_wifi_fmac_start_xmit(void *fmac_dev_ctx,
 					      unsigned char if_idx,
 					      void *netbuf);
 
+/**
+ * @brief Get the current TX data path parameters.
+ *
+ * @param dev_ctx Pointer to the UMAC IF context for a RPU WLAN device.
+ * @param params Pointer to the structure to be filled with the TX parameters.
+ *
+ *@retval	NRF_WIFI_STATUS_SUCCESS On success
+ *@retval	NRF_WIFI_STATUS_FAIL On failure
+ */
+enum nrf_wifi_status nrf_wifi_sys_fmac_tx_params_get(void *dev_ctx,
+						     struct nrf_wifi_fmac_tx_params *params);
+
+/**
+ * @brief Change the TX data path parameters at runtime.
+ *
+ * @param dev_ctx Pointer to the UMAC IF context for a RPU WLAN device.
+ * @param params TX parameters to be applied, @p num_tx_tokens_spare is ignored.
+ *
+ * This function validates the parameters against the TX buffer sizing done
+ * at init and the layout of the RPU packet RAM. It then stops granting TX
+ * descriptors and waits (sleeping) for the descriptors already submitted to
+ * the RPU to be returned before applying the parameters. Frames held for the
+ * next TWT service period are put back in the pending queues. Frames submitted
+ * in the meantime are queued and sent once the parameters have been applied.
+ * Must not be called from atomic context.
+ *
+ * The parameters are shared by all the devices of the FMAC instance, so this
+ * is only supported when a single device has been added.
+ *
+ *@retval	NRF_WIFI_STATUS_SUCCESS On success
+ *@retval	NRF_WIFI_STATUS_FAIL On invalid parameters, if more than one device
+ *		has been added or if the TX descriptors were not returned in time
+ */
+enum nrf_wifi_status nrf_wifi_sys_fmac_tx_params_set(void *dev_ctx,
+						     struct nrf_wifi_fmac_tx_params *params);
+
 /**
  * @brief Inform the RPU firmware that host is going to suspend state.
  * @param fmac_dev_ctx Pointer to the UMAC IF context for a RPU WLAN device.
@@ -857,6 +1002,27 @@ enum nrf_wifi_status nrf_wifi_sys_fmac_twt_teardown(void *fmac_dev_ctx,
 						unsigned char if_idx,
 						struct nrf_wifi_umac_config_twt_info *twt_info);
 
+#if defined(NRF70_STA_MODE) || defined(__DOXYGEN__)
+/**
+ * @brief Get the TX statistics of the TWT service periods.
+ *
+ * @param dev_ctx Pointer to the UMAC IF context for a RPU WLAN device.
+ * @param stats Pointer to the structure to be filled with the statistics.
+ *
+ * While a TWT flow is set up, the frames queued during sleep are aggregated
+ * ahead of the next service period and sent at its start. A service period is
+ * counted as a predicted miss when the bytes queued at its start exceed the
+ * capacity estimated from the previous service periods, and as a miss when it
+ * ends with frames still queued. The statistics are reset by every accepted
+ * TWT setup.
+ *
+ *@retval	NRF_WIFI_STATUS_SUCCESS On success
+ *@retval	NRF_WIFI_STATUS_FAIL On failure
+ */
+enum nrf_wifi_status nrf_wifi_sys_fmac_twt_tx_stats_get(void *dev_ctx,
+							struct nrf_wifi_fmac_twt_tx_stats *stats);
+#endif /* NRF70_STA_MODE */
+
 /**
  * @brief Get connection info from RPU
  * @param fmac_dev_ctx Pointer to the UMAC IF context for a RPU WLAN device.
@@ -931,6 +1097,175 @@ enum nrf_wifi_status nrf_wifi_sys_fmac_dev_init(struct nrf_wifi_fmac_dev_ctx *fm
  */
 void nrf_wifi_sys_fmac_dev_deinit(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx);
 
+
+/**
+ * @brief Submit a UMAC control command without waiting for its response.
+ * @param dev_ctx Pointer to the context of the RPU instance.
+ * @param cmd Pointer to the UMAC command (starting with &struct nrf_wifi_umac_hdr).
+ * @param cmd_len Length of the UMAC command.
+ * @param resp_event UMAC event expected in response to the command, 0 if the
+ *		     command does not have a response event.
+ * @param timeout_ms Time (in ms) to wait for the response event.
+ * @param callbk_fn Callback to be invoked on completion of the command.
+ * @param callbk_ctx Context to be passed to @p callbk_fn.
+ * @param tag Pointer to the location where the tag assigned to the command is returned.
+ *
+ * This function sends a UMAC control command to the RPU and returns
+ * immediately, allowing up to NRF_WIFI_FMAC_MAX_ASYNC_CMDS commands to be
+ * outstanding. When the response event is received it is dispatched to
+ * @p callbk_fn from the event processing context, matching the oldest
+ * outstanding command waiting for that event on the same VIF. Commands that
+ * exceed @p timeout_ms are completed with NRF_WIFI_STATUS_FAIL. The command
+ * buffer is copied and can be freed as soon as this function returns.
+ *
+ * @retval	NRF_WIFI_STATUS_SUCCESS On success
+ * @retval	NRF_WIFI_STATUS_FAIL On failure to submit the command
+ */
+enum nrf_wifi_status nrf_wifi_sys_fmac_cmd_submit_async(void *dev_ctx,
+							void *cmd,
+							unsigned int cmd_len,
+							unsigned int resp_event,
+							unsigned int timeout_ms,
+							nrf_wifi_fmac_cmd_resp_callbk_t callbk_fn,
+							void *callbk_ctx,
+							unsigned int *tag);
+
+
+/**
+ * @brief Cancel an outstanding asynchronous UMAC control command.
+ * @param dev_ctx Pointer to the context of the RPU instance.
+ * @param tag Tag of the command returned by nrf_wifi_sys_fmac_cmd_submit_async.
+ *
+ * This function stops tracking an outstanding command. Its callback will not
+ * be invoked, the response event (if any) is processed as an unsolicited event.
+ *
+ * @retval	NRF_WIFI_STATUS_SUCCESS On success
+ * @retval	NRF_WIFI_STATUS_FAIL If no outstanding command with @p tag exists
+ */
+enum nrf_wifi_status nrf_wifi_sys_fmac_cmd_async_cancel(void *dev_ctx,
+							unsigned int tag);
+
+
+/**
+ * @brief Process the timeouts of outstanding asynchronous UMAC control commands.
+ * @param dev_ctx Pointer to the context of the RPU instance.
+ *
+ * This function completes the outstanding commands whose timeouts have
+ * expired. Timeouts are also processed on every submission and event, this
+ * function is meant to be called periodically by the OS layer when the
+ * RPU is not generating any events.
+ *
+ * @return Number of commands still outstanding.
+ */
+unsigned int nrf_wifi_sys_fmac_cmd_async_poll(void *dev_ctx);
+
+
+/**
+ * @brief Change the state of a virtual interface without blocking the caller.
+ * @param dev_ctx Pointer to the context of the RPU instance.
+ * @param if_idx Index of the interface whose state needs to be changed.
+ * @param vif_info State information to be changed for the interface.
+ * @param callbk_fn Callback to be invoked on completion of the command.
+ * @param callbk_ctx Context to be passed to @p callbk_fn.
+ * @param tag Pointer to the location where the tag assigned to the command is returned.
+ *
+ * Asynchronous variant of nrf_wifi_sys_fmac_chg_vif_state. @p callbk_fn is
+ * invoked with the %NRF_WIFI_UMAC_EVENT_IFFLAGS_STATUS event, the status
+ * reported by the RPU is in &struct nrf_wifi_umac_event_vif_state.
+ *
+ * @retval	NRF_WIFI_STATUS_SUCCESS On success
+ * @retval	NRF_WIFI_STATUS_FAIL On failure to submit the command
+ */
+enum nrf_wifi_status nrf_wifi_sys_fmac_chg_vif_state_async(void *dev_ctx,
+							   unsigned char if_idx,
+							   struct nrf_wifi_umac_chg_vif_state_info *vif_info,
+							   nrf_wifi_fmac_cmd_resp_callbk_t callbk_fn,
+							   void *callbk_ctx,
+							   unsigned int *tag);
+
+
+/**
+ * @brief Register an observer for a UMAC event.
+ * @param dev_ctx Pointer to the context of the RPU instance.
+ * @param data_event Whether @p event is a data event (refer
+ *                   &enum nrf_wifi_umac_data_commands) or a control event
+ *                   (refer &enum nrf_wifi_umac_events).
+ * @param event Event ID to observe.
+ * @param callbk_fn Callback function to be invoked for every occurrence of @p event.
+ * @param callbk_ctx Context to be passed to @p callbk_fn.
+ *
+ * The observers are invoked after the driver has processed the event (and
+ * called the regular OS callbacks), which allows the OS layer to act on
+ * specific events without modifying the event processing. Observers cannot
+ * replace the driver's own handling of an event. Up to
+ * %NRF_WIFI_FMAC_MAX_EVENT_OBSERVERS observers can be registered per device.
+ *
+ * @return Command execution status
+ */
+enum nrf_wifi_status nrf_wifi_sys_fmac_event_observer_register(void *dev_ctx,
+							       bool data_event,
+							       unsigned int event,
+							       nrf_wifi_fmac_event_observer_t callbk_fn,
+							       void *callbk_ctx);
+
+
+/**
+ * @brief Unregister an observer for a UMAC event.
+ * @param dev_ctx Pointer to the context of the RPU instance.
+ * @param data_event Whether @p event is a data event or a control event.
+ * @param event Event ID which was observed.
+ * @param callbk_fn Callback function which was registered.
+ * @param callbk_ctx Context which was registered.
+ *
+ * This function waits for any observer call in progress to return, so
+ * @p callbk_ctx can be freed once it returns. It must therefore not be called
+ * from an observer callback.
+ *
+ * @return Command execution status
+ */
+enum nrf_wifi_status nrf_wifi_sys_fmac_event_observer_unregister(void *dev_ctx,
+								 bool data_event,
+								 unsigned int event,
+								 nrf_wifi_fmac_event_observer_t callbk_fn,
+								 void *callbk_ctx);
+
+
+/**
+ * @brief Enable or disable the UMAC event processing statistics.
+ * @param dev_ctx Pointer to the context of the RPU instance.
+ * @param enable Whether to collect the statistics.
+ *
+ * When enabled, the number of occurrences and a histogram of the processing
+ * time of every UMAC control and data event are collected. The statistics
+ * are disabled by default to keep timer reads out of the event path.
+ */
+void nrf_wifi_sys_fmac_event_stats_enable(void *dev_ctx,
+					  bool enable);
+
+
+/**
+ * @brief Reset the UMAC event processing statistics.
+ * @param dev_ctx Pointer to the context of the RPU instance.
+ */
+void nrf_wifi_sys_fmac_event_stats_reset(void *dev_ctx);
+
+
+/**
+ * @brief Get the processing statistics of a UMAC event.
+ * @param dev_ctx Pointer to the context of the RPU instance.
+ * @param data_event Whether @p event is a data event (refer
+ *                   &enum nrf_wifi_umac_data_commands) or a control event
+ *                   (refer &enum nrf_wifi_umac_events).
+ * @param event Event ID.
+ * @param stats Pointer to be filled with the statistics.
+ *
+ * @return Command execution status
+ */
+enum nrf_wifi_status nrf_wifi_sys_fmac_event_stats_get(void *dev_ctx,
+						       bool data_event,
+						       unsigned int event,
+						       struct nrf_wifi_fmac_event_stats *stats);
+
 #ifdef NRF70_SR_COEX_SLEEP_CTRL_GPIO_CTRL
 /**
  * @brief Configure Sleep control GPIO control for coexistence.
@@ -1026,6 +1361,66 @@ enum nrf_wifi_status nrf_wifi_sys_fmac_set_ps_exit_strategy(
 enum nrf_wifi_status nrf_wifi_fmac_start_rawpkt_xmit(void *dev_ctx,
 						     unsigned char if_idx,
 						     void *net_packet);
+
+/**
+ * @brief Start a raw TX session.
+ * @param dev_ctx Pointer to the UMAC IF context for a RPU WLAN device.
+ * @param if_idx Index of the interface on which the frames are to be
+ *               transmitted.
+ * @param cfg Rate, retries, queue and 802.11 header template to be used for
+ *            all the frames of the session.
+ *
+ * Unlike nrf_wifi_fmac_start_rawpkt_xmit, the frames submitted with
+ * nrf_wifi_fmac_rawtx_session_xmit carry no &struct raw_tx_pkt_header,
+ * the settings are validated once here and applied to every frame. Frames
+ * still queued from a previous session keep the settings they were
+ * submitted with.
+ *
+ *@retval      NRF_WIFI_STATUS_SUCCESS On success
+ *@retval      NRF_WIFI_STATUS_FAIL On failure
+ */
+enum nrf_wifi_status nrf_wifi_fmac_rawtx_session_start(void *dev_ctx,
+						       unsigned char if_idx,
+						       const struct nrf_wifi_fmac_rawtx_session_cfg *cfg);
+
+/**
+ * @brief Submit a batch of frames to the current raw TX session.
+ * @param dev_ctx Pointer to the UMAC IF context for a RPU WLAN device.
+ * @param nwbs Array of OS specific network buffers holding the payloads.
+ * @param num_nwbs Number of buffers in @p nwbs.
+ * @param num_queued Pointer to be filled with the number of buffers queued.
+ *
+ * The header template of the session is prepended to each payload, which
+ * needs the template length plus the size of &struct
+ * nrf_wifi_fmac_rawtx_session_hdr of headroom, and the sequence
+ * number is updated if requested. The buffers are queued in order until
+ * one cannot be queued (e.g. the TX queue is full), the buffers from that
+ * one onwards are left untouched and still belong to the caller. A buffer
+ * which was queued but could not be handed to the RPU is counted in
+ * @p num_queued and belongs to the driver. The session is ended if its
+ * interface was removed or left the raw TX mode.
+ *
+ *@retval      NRF_WIFI_STATUS_SUCCESS All the buffers were queued
+ *@retval      NRF_WIFI_STATUS_FAIL Otherwise
+ */
+enum nrf_wifi_status nrf_wifi_fmac_rawtx_session_xmit(void *dev_ctx,
+						      void **nwbs,
+						      unsigned int num_nwbs,
+						      unsigned int *num_queued);
+
+/**
+ * @brief Stop the current raw TX session.
+ * @param dev_ctx Pointer to the UMAC IF context for a RPU WLAN device.
+ * @param stats Pointer to be filled with the session statistics, can be NULL.
+ *
+ * The frames already queued are still transmitted. The frame rate of the
+ * session is num_frames / duration_us.
+ *
+ *@retval      NRF_WIFI_STATUS_SUCCESS On success
+ *@retval      NRF_WIFI_STATUS_FAIL On failure
+ */
+enum nrf_wifi_status nrf_wifi_fmac_rawtx_session_stop(void *dev_ctx,
+						      struct nrf_wifi_fmac_rawtx_session_stats *stats);
 #endif /* NRF70_RAW_DATA_TX */
 
 /**
@@ -1048,6 +1443,90 @@ enum nrf_wifi_status nrf_wifi_sys_fmac_rpu_recovery_callback(void *mac_dev_ctx,
 						void *event_data,
 						unsigned int len);
 /** @endcond */
+
+/**
+ * @brief Replay the recorded configuration after an RPU recovery.
+ * @param dev_ctx Pointer to the context of the RPU instance.
+ * @param os_vif_ctx Array of MAX_NUM_VIFS OS VIF contexts, indexed by the VIF
+ *		     index the VIFs had before the recovery. VIFs whose entry is
+ *		     NULL are not restored.
+ *
+ * The FMAC layer records the configuration it has sent to the RPU (VIFs and
+ * their type, state and MAC address, power save settings, multicast filters,
+ * packet filters, TX rate overrides and optionally keys). Once an RPU recovery
+ * has been requested, this record is kept across the removal and re-addition of
+ * the device. After the firmware has been reloaded and
+ * nrf_wifi_sys_fmac_dev_init has completed, the OS layer can call this
+ * function instead of reconfiguring the RPU itself. The VIFs are re-added and
+ * the commands are sent back to back in their original order.
+ *
+ * If the OS layer reconfigures the RPU itself instead, the record is discarded
+ * and rebuilt from the new configuration.
+ *
+ * @retval	NRF_WIFI_STATUS_SUCCESS On success
+ * @retval	NRF_WIFI_STATUS_FAIL If no recovery is in progress or not everything could be replayed
+ */
+enum nrf_wifi_status nrf_wifi_sys_fmac_recovery_replay(void *dev_ctx,
+						       void *os_vif_ctx[]);
+
+
+/**
+ * @brief Enable or disable the replay of keys after an RPU recovery.
+ * @param dev_ctx Pointer to the context of the RPU instance.
+ * @param enable Whether the keys are to be recorded and replayed.
+ *
+ * Keys are only useful to replay where the security policy allows keeping
+ * them in host memory and the connection can be resumed without a rekey.
+ * Recording is disabled by default, disabling it drops the recorded keys.
+ *
+ * @return Command execution status
+ */
+enum nrf_wifi_status nrf_wifi_sys_fmac_recovery_replay_keys_set(void *dev_ctx,
+								bool enable);
+
+
+/**
+ * @brief Get the RPU recovery timings and counters.
+ * @param dev_ctx Pointer to the context of the RPU instance.
+ * @param stats Pointer to the structure to be filled with the statistics.
+ *
+ * @return Command execution status
+ */
+enum nrf_wifi_status nrf_wifi_sys_fmac_recovery_stats_get(void *dev_ctx,
+							  struct nrf_wifi_fmac_recovery_stats *stats);
+
+
+/**
+ * @brief Get the breakdown of the last RPU recoveries.
+ * @param dev_ctx Pointer to the context of the RPU instance.
+ * @param history Array to be filled with the recoveries, most recent first.
+ * @param num_records Size of the array on input, number of recoveries filled in on output.
+ *
+ * Each recovery is timed from the detection of the failure through the
+ * teardown, firmware reload, initialization and reconfiguration (the replay,
+ * or the OS layer bringing a VIF back up), see
+ * &enum nrf_wifi_fmac_recovery_phase. Up to NRF_WIFI_FMAC_RECOVERY_HISTORY_LEN
+ * recoveries are kept.
+ *
+ * @return Command execution status
+ */
+enum nrf_wifi_status nrf_wifi_sys_fmac_recovery_history_get(void *dev_ctx,
+							    struct nrf_wifi_fmac_recovery_record *history,
+							    unsigned int *num_records);
+
+
+/**
+ * @brief Request an RPU recovery for a failure detected by the OS layer.
+ * @param dev_ctx Pointer to the context of the RPU instance.
+ * @param cause Cause of the recovery (e.g. a command timeout).
+ *
+ * The recovery goes through the same path as the one triggered by the RPU
+ * watchdog, i.e. the RPU recovery callback is invoked from the recovery tasklet.
+ *
+ * @return Command execution status
+ */
+enum nrf_wifi_status nrf_wifi_sys_fmac_recovery_trigger(void *dev_ctx,
+							enum nrf_wifi_hal_recovery_cause cause);
 #endif /* CONFIG_NRF_RPU_RECOVERY */
 
 /**
@@ -1118,6 +1597,106 @@ enum nrf_wifi_status nrf_wifi_sys_fmac_set_packet_filter(void *dev_ctx,
 							 unsigned char filter,
 							 unsigned char if_idx,
 							 unsigned short buffer_size);
+
+/**
+ * @brief Set the host side RX filter of an interface.
+ * @param dev_ctx Pointer to the UMAC IF context for a RPU WLAN device.
+ * @param if_idx Index of the interface on which the filter is to be set.
+ * @param filter Filter to be applied, NULL to remove the current filter.
+ *
+ * This function is used to install a rule based filter which is evaluated
+ * on every frame received in Monitor or Promiscuous mode, on top of the
+ * frame type filter set with nrf_wifi_sys_fmac_set_packet_filter. Frames
+ * rejected by the filter are dropped before the sniffer callback and
+ * their RX buffer is handed back to the RPU. The filter statistics are
+ * reset.
+ *
+ * @return Command execution status
+ */
+enum nrf_wifi_status nrf_wifi_sys_fmac_set_rx_filter(void *dev_ctx,
+						     unsigned char if_idx,
+						     const struct nrf_wifi_fmac_rx_filter *filter);
+
+/**
+ * @brief Get the statistics of the host side RX filter of an interface.
+ * @param dev_ctx Pointer to the UMAC IF context for a RPU WLAN device.
+ * @param if_idx Index of the interface.
+ * @param stats Pointer to the structure to be filled with the statistics.
+ *
+ * @return Command execution status
+ */
+enum nrf_wifi_status nrf_wifi_sys_fmac_get_rx_filter_stats(void *dev_ctx,
+							   unsigned char if_idx,
+							   struct nrf_wifi_fmac_rx_filter_stats *stats);
+
+/**
+ * @brief Start writing the raw RX frames of an interface to a capture ring.
+ * @param dev_ctx Pointer to the UMAC IF context for a RPU WLAN device.
+ * @param if_idx Index of the interface.
+ * @param buf Memory to hold the ring, 4 byte aligned and owned by the caller
+ *            until the ring is stopped.
+ * @param size Size of @p buf, a multiple of 4.
+ * @param snaplen Maximum number of bytes of each frame to be stored, 0 for
+ *                no limit.
+ *
+ * Instead of being passed one by one to the sniffer callback, the raw RX
+ * frames accepted by the filters are written to @p buf as records, each
+ * made of a &struct nrf_wifi_fmac_capture_rec_hdr, a radiotap header and
+ * the 802.11 frame. Records can be written out as is (without the padding)
+ * to a pcap file with link type LINKTYPE_IEEE802_11_RADIOTAP. Frames that
+ * do not fit in the ring are dropped and counted.
+ *
+ * @return Command execution status
+ */
+enum nrf_wifi_status nrf_wifi_sys_fmac_capture_ring_start(void *dev_ctx,
+							  unsigned char if_idx,
+							  void *buf,
+							  unsigned int size,
+							  unsigned int snaplen);
+
+/**
+ * @brief Stop writing the raw RX frames of an interface to a capture ring.
+ * @param dev_ctx Pointer to the UMAC IF context for a RPU WLAN device.
+ * @param if_idx Index of the interface.
+ *
+ * Raw RX frames are passed to the sniffer callback again. Once this returns
+ * no record is being written, the ring memory can be released.
+ *
+ * @return Command execution status
+ */
+enum nrf_wifi_status nrf_wifi_sys_fmac_capture_ring_stop(void *dev_ctx,
+							 unsigned char if_idx);
+
+/**
+ * @brief Exchange the consumer and producer offsets of a capture ring.
+ * @param dev_ctx Pointer to the UMAC IF context for a RPU WLAN device.
+ * @param if_idx Index of the interface.
+ * @param tail Offset up to which the records have been consumed.
+ * @param head Pointer to be filled with the offset of the next record to be
+ *             written, the records from @p tail up to it can be read.
+ *
+ * The space up to @p tail is made available for new records. Records are
+ * read from @p tail, going back to the start of the ring on a wrap marker
+ * (see &struct nrf_wifi_fmac_capture_rec_hdr).
+ *
+ * @return Command execution status
+ */
+enum nrf_wifi_status nrf_wifi_sys_fmac_capture_ring_sync(void *dev_ctx,
+							 unsigned char if_idx,
+							 unsigned int tail,
+							 unsigned int *head);
+
+/**
+ * @brief Get the statistics of the capture ring of an interface.
+ * @param dev_ctx Pointer to the UMAC IF context for a RPU WLAN device.
+ * @param if_idx Index of the interface.
+ * @param stats Pointer to the structure to be filled with the statistics.
+ *
+ * @return Command execution status
+ */
+enum nrf_wifi_status nrf_wifi_sys_fmac_capture_ring_stats_get(void *dev_ctx,
+							      unsigned char if_idx,
+							      struct nrf_wifi_fmac_capture_ring_stats *stats);
 #endif /* NRF70_RAW_DATA_RX || NRF70_PROMISC_DATA_RX */
 
 #if defined(NRF70_UTIL) || defined(__DOXYGEN__)
@@ -1175,6 +1754,65 @@ enum nrf_wifi_status nrf_wifi_sys_fmac_stats_get(struct nrf_wifi_fmac_dev_ctx *f
 						 enum rpu_op_mode op_mode,
 						 struct rpu_sys_op_stats *stats);
 
+
+/**
+ * @brief Enable periodic firmware statistics snapshots.
+ * @param fmac_dev_ctx Pointer to the UMAC IF context for a RPU WLAN device.
+ * @param interval_ms Interval (in ms) between the snapshots.
+ *
+ * This function enables (or changes the interval of) the periodic statistics
+ * mode. In this mode the statistics are requested from the RPU at most once
+ * every @p interval_ms, driven by nrf_wifi_sys_fmac_stats_periodic_tick, and
+ * the latest snapshot along with the deltas and rates since the previous one
+ * is kept for nrf_wifi_sys_fmac_stats_periodic_get to read without blocking.
+ * A reply to nrf_wifi_sys_fmac_stats_get also updates the snapshot.
+ *
+ * @return Command execution status
+ */
+enum nrf_wifi_status nrf_wifi_sys_fmac_stats_periodic_start(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+							    unsigned int interval_ms);
+
+
+/**
+ * @brief Disable periodic firmware statistics snapshots.
+ * @param fmac_dev_ctx Pointer to the UMAC IF context for a RPU WLAN device.
+ *
+ * This function disables the periodic statistics mode. The snapshot buffers
+ * are kept until the device is de-initialized.
+ */
+void nrf_wifi_sys_fmac_stats_periodic_stop(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx);
+
+
+/**
+ * @brief Drive the periodic firmware statistics snapshots.
+ * @param fmac_dev_ctx Pointer to the UMAC IF context for a RPU WLAN device.
+ *
+ * This function is expected to be called periodically (e.g. from a work
+ * queue) by the OS layer. It sends a statistics request to the RPU if the
+ * configured interval has elapsed since the previous one. If an on-demand
+ * statistics request is outstanding its reply is reused instead of sending
+ * a new request. It does not wait for the response.
+ *
+ * @return Command execution status
+ */
+enum nrf_wifi_status nrf_wifi_sys_fmac_stats_periodic_tick(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx);
+
+
+/**
+ * @brief Get the latest periodic firmware statistics snapshot.
+ * @param fmac_dev_ctx Pointer to the UMAC IF context for a RPU WLAN device.
+ * @param snapshot Pointer to memory where the snapshot is to be copied.
+ *
+ * This function copies the latest published snapshot. It does not take any
+ * lock, never blocks waiting for the RPU and does not generate any RPU
+ * traffic.
+ *
+ * @retval	NRF_WIFI_STATUS_SUCCESS On success
+ * @retval	NRF_WIFI_STATUS_FAIL If periodic statistics are disabled or no snapshot is available yet
+ */
+enum nrf_wifi_status nrf_wifi_sys_fmac_stats_periodic_get(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+							  struct nrf_wifi_fmac_stats_snapshot *snapshot);
+
 /**
  * @}
  */
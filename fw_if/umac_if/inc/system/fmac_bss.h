@@ -0,0 +1,36 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @brief Header containing scan result BSS table specific declarations
+ * for the FMAC IF Layer of the Wi-Fi driver.
+ */
+
+#ifndef __FMAC_BSS_H__
+#define __FMAC_BSS_H__
+
+#include "system/fmac_structs.h"
+
+enum nrf_wifi_status nrf_wifi_sys_fmac_bss_table_init(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx);
+
+void nrf_wifi_sys_fmac_bss_table_deinit(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx);
+
+void nrf_wifi_sys_fmac_bss_table_scan_res(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+					  struct nrf_wifi_umac_event_new_scan_results *scan_res,
+					  unsigned int event_len);
+
+void nrf_wifi_sys_fmac_bss_table_disp_res(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+					  struct nrf_wifi_umac_event_new_scan_display_results *disp_res,
+					  unsigned int event_len);
+
+void nrf_wifi_sys_fmac_chan_hint_assoc_start(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+					     struct nrf_wifi_umac_assoc_info *assoc_info);
+
+void nrf_wifi_sys_fmac_chan_hint_assoc_done(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+					    struct nrf_wifi_umac_event_mlme *mlme,
+					    unsigned int event_len);
+
+#endif /* __FMAC_BSS_H__ */
@@ -0,0 +1,25 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @brief Header containing asynchronous UMAC control command specific
+ * declarations for the FMAC IF Layer of the Wi-Fi driver.
+ */
+
+#ifndef __FMAC_CMD_ASYNC_H__
+#define __FMAC_CMD_ASYNC_H__
+
+#include "system/fmac_structs.h"
+
+enum nrf_wifi_status nrf_wifi_sys_fmac_cmd_async_init(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx);
+
+void nrf_wifi_sys_fmac_cmd_async_deinit(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx);
+
+bool nrf_wifi_sys_fmac_cmd_async_resp(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+				      struct nrf_wifi_umac_hdr *umac_hdr,
+				      unsigned int event_len);
+
+#endif /* __FMAC_CMD_ASYNC_H__ */
@@ -0,0 +1,30 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @brief Header containing UMAC event dispatch specific declarations for
+ * the FMAC IF Layer of the Wi-Fi driver.
+ */
+
+#ifndef __FMAC_EVENT_DISPATCH_H__
+#define __FMAC_EVENT_DISPATCH_H__
+
+#include "system/fmac_structs.h"
+
+enum nrf_wifi_status nrf_wifi_sys_fmac_event_dispatch_init(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx);
+
+void nrf_wifi_sys_fmac_event_dispatch_deinit(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx);
+
+unsigned long nrf_wifi_sys_fmac_event_dispatch_start(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx);
+
+void nrf_wifi_sys_fmac_event_dispatch_done(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+					   unsigned long start_us,
+					   bool data_event,
+					   unsigned int event,
+					   void *event_data,
+					   unsigned int event_len);
+
+#endif /* __FMAC_EVENT_DISPATCH_H__ */
@@ -13,6 +13,11 @@
 #define __FMAC_PEER_H__
 
 #include "system/fmac_structs.h"
+#include "host_rpu_common_if.h"
+
+/* Number of SoftAP clients the RPU firmware keeps a pending frames bitmap for */
+#define NRF_WIFI_FMAC_FW_AP_MAX_PEERS ((RPU_MEM_PKT_BASE - RPU_MEM_UMAC_PEND_Q_BMP) / \
+				       sizeof(struct sap_client_pend_frames_bitmap))
 
 int nrf_wifi_fmac_peer_get_id(struct nrf_wifi_fmac_dev_ctx *fmac_ctx,
 			      const unsigned char *mac_addr);
@@ -30,4 +35,11 @@ void nrf_wifi_fmac_peer_remove(struct nrf_wifi_fmac_dev_ctx *fmac_ctx,
 void nrf_wifi_fmac_peers_flush(struct nrf_wifi_fmac_dev_ctx *fmac_ctx,
 			       unsigned char if_idx);
 
+void nrf_wifi_fmac_peer_mc_set(struct nrf_wifi_fmac_dev_ctx *fmac_ctx,
+			       unsigned char if_idx,
+			       bool enable);
+
+void nrf_wifi_fmac_peers_fw_capa_set(struct nrf_wifi_fmac_dev_ctx *fmac_ctx,
+				     unsigned int max_ap_assoc_sta);
+
 #endif /* __FMAC_PEER_H__ */
@@ -75,6 +75,68 @@ struct nrf_wifi_fmac_frame_ctrl {
 } __NRF_WIFI_PKD;
 #endif
 
+/** Maximum length of the radiotap header written for a frame */
+#define NRF_WIFI_RADIOTAP_MAX_LEN 32
+
+#if defined(NRF70_RAW_DATA_RX) || defined(NRF70_PROMISC_DATA_RX)
+/** Capture ring state, the memory holding the records belongs to the consumer */
+struct nrf_wifi_fmac_capture_ring {
+	/** Memory holding the records */
+	unsigned char *buf;
+	/** Size of @p buf */
+	unsigned int size;
+	/** Maximum number of frame bytes stored per record, 0 for no limit */
+	unsigned int snaplen;
+	/** Offset of the next record to be written */
+	unsigned int head;
+	/** Offset of the next record to be read by the consumer */
+	unsigned int tail;
+	/** Lock protecting @p head, @p tail and @p stats */
+	void *lock;
+	/** Ring statistics */
+	struct nrf_wifi_fmac_capture_ring_stats stats;
+};
+#endif /* NRF70_RAW_DATA_RX || NRF70_PROMISC_DATA_RX */
+
 bool nrf_wifi_util_check_filt_setting(struct nrf_wifi_fmac_vif_ctx *vif,
 				      unsigned short *frame_control);
+
+unsigned int nrf_wifi_util_ieee80211_hdr_len(const unsigned char *frm,
+					     unsigned int len);
+
+#if defined(NRF70_RAW_DATA_RX) || defined(NRF70_PROMISC_DATA_RX)
+bool nrf_wifi_util_rx_filter_valid(const struct nrf_wifi_fmac_rx_filter *filter);
+
+bool nrf_wifi_util_rx_filter_match(const struct nrf_wifi_fmac_rx_filter *filter,
+				   const unsigned char *frm,
+				   unsigned int len,
+				   signed short signal);
+
+bool nrf_wifi_util_rx_filter_check(struct nrf_wifi_fmac_vif_ctx *vif,
+				   const unsigned char *frm,
+				   unsigned int len,
+				   signed short signal);
+
+unsigned int nrf_wifi_util_radiotap_hdr_build(unsigned char *buf,
+					      struct raw_rx_pkt_header *raw_rx_hdr);
+
+enum nrf_wifi_status nrf_wifi_util_capture_ring_alloc(struct nrf_wifi_fmac_vif_ctx *vif,
+						      void *buf,
+						      unsigned int size,
+						      unsigned int snaplen);
+
+void nrf_wifi_util_capture_ring_free(struct nrf_wifi_fmac_vif_ctx *vif);
+
+bool nrf_wifi_util_capture_ring_put(struct nrf_wifi_fmac_capture_ring *ring,
+				    struct raw_rx_pkt_header *raw_rx_hdr,
+				    const unsigned char *frm,
+				    unsigned int len);
+
+enum nrf_wifi_status nrf_wifi_util_capture_ring_sync(struct nrf_wifi_fmac_vif_ctx *vif,
+						     unsigned int tail,
+						     unsigned int *head);
+
+enum nrf_wifi_status nrf_wifi_util_capture_ring_stats_get(struct nrf_wifi_fmac_vif_ctx *vif,
+							  struct nrf_wifi_fmac_capture_ring_stats *stats);
+#endif /* NRF70_RAW_DATA_RX || NRF70_PROMISC_DATA_RX */
 #endif /* __FMAC_PROMISC_H__ */
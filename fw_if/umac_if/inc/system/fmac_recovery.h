@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @brief Header containing RPU recovery configuration replay specific
+ * declarations for the FMAC IF Layer of the Wi-Fi driver.
+ */
+
+#ifndef __FMAC_RECOVERY_H__
+#define __FMAC_RECOVERY_H__
+
+#include "system/fmac_structs.h"
+
+enum nrf_wifi_status nrf_wifi_sys_fmac_recovery_init(struct nrf_wifi_fmac_priv *fpriv);
+
+void nrf_wifi_sys_fmac_recovery_deinit(struct nrf_wifi_fmac_priv *fpriv);
+
+void nrf_wifi_sys_fmac_recovery_record(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+				       int type,
+				       unsigned char if_idx,
+				       unsigned int cmd,
+				       unsigned int key,
+				       void *data,
+				       unsigned int len);
+
+void nrf_wifi_sys_fmac_recovery_forget(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+				       int type,
+				       unsigned char if_idx,
+				       unsigned int cmd,
+				       unsigned int key);
+
+void nrf_wifi_sys_fmac_recovery_vif_add(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+					unsigned char if_idx,
+					struct nrf_wifi_umac_add_vif_info *vif_info);
+
+void nrf_wifi_sys_fmac_recovery_vif_del(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+					unsigned char if_idx);
+
+unsigned int nrf_wifi_sys_fmac_recovery_addr_key(const unsigned char *addr);
+
+bool nrf_wifi_sys_fmac_recovery_keys_enabled(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx);
+
+void nrf_wifi_sys_fmac_recovery_request(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+					struct nrf_wifi_hal_recovery_info *info);
+
+void nrf_wifi_sys_fmac_recovery_tx_dropped(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+					   unsigned int num_frames);
+
+void nrf_wifi_sys_fmac_recovery_dev_init(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+					 unsigned long start_time_ms);
+
+void nrf_wifi_sys_fmac_recovery_dev_deinit(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx);
+
+#endif /* __FMAC_RECOVERY_H__ */
@@ -19,11 +19,56 @@
 #include "osal_api.h"
 #include "host_rpu_umac_if.h"
 #include "common/fmac_structs_common.h"
+#include "common/hal_structs_common.h"
 
+/** Default number of peers, used when no peer capacity is given at init. */
 #define MAX_PEERS 5
-#define MAX_SW_PEERS (MAX_PEERS + 1)
+/** Maximum peer capacity that can be requested at init. This only bounds the
+ *  host allocation, the firmware capability is not known before the firmware
+ *  runs and is applied when it reports it (see max_ap_peers).
+ */
+#define NRF_WIFI_FMAC_MAX_PEERS_LIMIT 64
+/** Number of buckets in the peer lookup hash table. */
+#define NRF_WIFI_FMAC_PEER_HASH_SIZE 16
 #define NRF_WIFI_AC_TWT_PRIORITY_EMERGENCY 0xFF
 #define NRF_WIFI_MAGIC_NUM_RAWTX 0x12345678
+/** Magic number identifying a frame queued by a raw TX session. */
+#define NRF_WIFI_MAGIC_NUM_RAWTX_SESSION 0x12345679
+/** Maximum length of the 802.11 header template of a raw TX session. */
+#define NRF_WIFI_FMAC_RAWTX_TEMPLATE_MAX_LEN 32
+/** Maximum number of asynchronous UMAC control commands that can be outstanding. */
+#define NRF_WIFI_FMAC_MAX_ASYNC_CMDS 8
+#ifndef NRF70_BSS_TABLE_SIZE
+#define NRF70_BSS_TABLE_SIZE 32
+#endif /* NRF70_BSS_TABLE_SIZE */
+/** Maximum number of BSSs tracked in the scan result BSS table, 0 compiles the table out. */
+#define NRF_WIFI_FMAC_BSS_TABLE_SIZE NRF70_BSS_TABLE_SIZE
+/** Default time (in ms) after which a BSS not seen in any scan is dropped from the BSS table. */
+#define NRF_WIFI_FMAC_BSS_MAX_AGE_MS 60000
+#ifndef NRF70_CHAN_HINT_CACHE_SIZE
+#define NRF70_CHAN_HINT_CACHE_SIZE 16
+#endif /* NRF70_CHAN_HINT_CACHE_SIZE */
+/** Maximum number of SSID/BSSID to channel mappings kept in the channel hint cache, 0 compiles the cache out. */
+#define NRF_WIFI_FMAC_CHAN_HINT_CACHE_SIZE NRF70_CHAN_HINT_CACHE_SIZE
+/** Maximum number of channels scanned by a targeted rescan. */
+#define NRF_WIFI_FMAC_CHAN_HINT_MAX_SCAN_CHANS 8
+/** Number of UMAC control events tracked by the event statistics. */
+#define NRF_WIFI_FMAC_NUM_CTRL_EVENTS \
+	(NRF_WIFI_UMAC_EVENT_GET_POWER_SAVE_INFO - NRF_WIFI_UMAC_EVENT_UNSPECIFIED + 1)
+/** Number of UMAC data events tracked by the event statistics. */
+#define NRF_WIFI_FMAC_NUM_DATA_EVENTS (NRF_WIFI_CMD_PS_GET_FRAMES + 1)
+/** Maximum number of configuration commands recorded for replay after an RPU recovery. */
+#define NRF_WIFI_FMAC_RECOVERY_MAX_CMDS 24
+/** Number of past RPU recoveries kept in the recovery history. */
+#define NRF_WIFI_FMAC_RECOVERY_HISTORY_LEN 4
+/** Number of bins in the event processing time histograms. */
+#define NRF_WIFI_FMAC_EVENT_HIST_BINS 8
+/** Upper bound (in us) of the first event processing time histogram bin, each
+ *  following bin doubles it and the last bin holds everything above.
+ */
+#define NRF_WIFI_FMAC_EVENT_HIST_BASE_US 64
+/** Maximum number of event observers which can be registered. */
+#define NRF_WIFI_FMAC_MAX_EVENT_OBSERVERS 8
 
 
 /**
@@ -90,6 +135,125 @@ struct raw_rx_pkt_header {
 	/** Data rate of the packet (MCS or Legacy). */
 	unsigned char rate;
 };
+
+/** Maximum number of rules in a RX filter. */
+#define NRF_WIFI_FMAC_RX_FILTER_MAX_RULES 8
+/** Maximum number of bytes a RX filter rule can match. */
+#define NRF_WIFI_FMAC_RX_FILTER_MAX_MATCH_LEN 8
+
+/**
+ * @brief What a RX filter rule is evaluated against.
+ */
+enum nrf_wifi_fmac_rx_filter_base {
+	/** Bytes at an offset from the start of the 802.11 header. */
+	NRF_WIFI_FMAC_RX_FILTER_BASE_MAC_HDR,
+	/** Bytes at an offset from the end of the 802.11 header (e.g. LLC/SNAP). */
+	NRF_WIFI_FMAC_RX_FILTER_BASE_PAYLOAD,
+	/** Signal strength (dBm) of the frame, the offset and bytes are unused. */
+	NRF_WIFI_FMAC_RX_FILTER_BASE_SIGNAL,
+	/** Number of rule bases. */
+	NRF_WIFI_FMAC_RX_FILTER_BASE_MAX
+};
+
+/**
+ * @brief Comparison done by a RX filter rule.
+ */
+enum nrf_wifi_fmac_rx_filter_op {
+	/** Masked bytes (or signal) equal to the value. */
+	NRF_WIFI_FMAC_RX_FILTER_OP_EQ,
+	/** Masked bytes (or signal) differ from the value. */
+	NRF_WIFI_FMAC_RX_FILTER_OP_NE,
+	/** Signal greater than or equal to the threshold. */
+	NRF_WIFI_FMAC_RX_FILTER_OP_GE,
+	/** Signal less than or equal to the threshold. */
+	NRF_WIFI_FMAC_RX_FILTER_OP_LE,
+	/** Number of rule operations. */
+	NRF_WIFI_FMAC_RX_FILTER_OP_MAX
+};
+
+/**
+ * @brief A single RX filter rule.
+ *
+ * For the byte bases, @p len bytes at @p offset are ANDed with @p mask and
+ * compared to @p value, a rule reaching past the end of the frame never
+ * matches. E.g. the frame subtype is matched with offset 0, len 1 and
+ * mask 0xFC, the BSSID of a frame from an AP with offset 10 and len 6 and
+ * the ethertype of a data frame with base PAYLOAD, offset 6 and len 2.
+ */
+struct nrf_wifi_fmac_rx_filter_rule {
+	/** Rule base, see &enum nrf_wifi_fmac_rx_filter_base. */
+	unsigned char base;
+	/** Rule operation, see &enum nrf_wifi_fmac_rx_filter_op. */
+	unsigned char op;
+	/** Number of bytes matched (unused for the signal base). */
+	unsigned char len;
+	/** Signal threshold in dBm (used only for the signal base). */
+	signed char signal;
+	/** Offset of the matched bytes from the rule base. */
+	unsigned short offset;
+	/** Mask applied to the frame bytes before the comparison. */
+	unsigned char mask[NRF_WIFI_FMAC_RX_FILTER_MAX_MATCH_LEN];
+	/** Value the masked frame bytes are compared to. */
+	unsigned char value[NRF_WIFI_FMAC_RX_FILTER_MAX_MATCH_LEN];
+};
+
+/**
+ * @brief RX filter applied to the frames of a promiscuous or monitor VIF.
+ *
+ * A frame is passed up if all the rules match, or if any rule matches when
+ * @p match_any is set. Frames which are not passed up are dropped before
+ * the sniffer callback.
+ */
+struct nrf_wifi_fmac_rx_filter {
+	/** Number of valid rules. */
+	unsigned char num_rules;
+	/** Pass up the frame if any of the rules match instead of all. */
+	bool match_any;
+	/** Filter rules. */
+	struct nrf_wifi_fmac_rx_filter_rule rules[NRF_WIFI_FMAC_RX_FILTER_MAX_RULES];
+};
+
+/**
+ * @brief Statistics of the RX filter of a VIF.
+ */
+struct nrf_wifi_fmac_rx_filter_stats {
+	/** Number of frames passed up. */
+	unsigned int num_accepted;
+	/** Number of frames dropped by the filter. */
+	unsigned int num_rejected;
+};
+
+/**
+ * @brief Header of a record in a capture ring.
+ *
+ * The header is laid out as a pcap record header. It is followed by
+ * @p incl_len bytes holding a radiotap header and the 802.11 frame, and the
+ * record is padded to a multiple of 4 bytes. A record with @p incl_len set
+ * to 0, or less than a header worth of space before the end of the ring,
+ * means the next record is at the start of the ring.
+ */
+struct nrf_wifi_fmac_capture_rec_hdr {
+	/** Receive time, seconds part. */
+	unsigned int ts_sec;
+	/** Receive time, microseconds part. */
+	unsigned int ts_usec;
+	/** Number of bytes stored (radiotap header and captured frame). */
+	unsigned int incl_len;
+	/** Number of bytes on air (radiotap header and full frame). */
+	unsigned int orig_len;
+};
+
+/**
+ * @brief Statistics of a capture ring.
+ */
+struct nrf_wifi_fmac_capture_ring_stats {
+	/** Number of records written to the ring. */
+	unsigned int num_records;
+	/** Number of frames dropped because the ring was full. */
+	unsigned int num_dropped;
+	/** Number of frame bytes dropped because the ring was full. */
+	unsigned int bytes_dropped;
+};
 #endif /* NRF70_RAW_DATA_RX || NRF70_PROMISC_DATA_RX */
 
 /**
@@ -137,6 +301,16 @@ struct nrf_wifi_fmac_callbk_fns {
 					  void *frm,
 					  unsigned short frequency,
 					  signed short signal);
+
+	/** Callback function to be called when a beacon/probe response is received,
+	 *  along with the index of its information elements. If registered, this is
+	 *  called instead of rx_bcn_prb_resp_callbk_fn.
+	 */
+	void (*rx_bcn_prb_resp_ie_callbk_fn)(void *os_vif_ctx,
+					     void *frm,
+					     unsigned short frequency,
+					     signed short signal,
+					     const struct nrf_wifi_fmac_ie_index *ie_index);
 #endif /* WIFI_MGMT_RAW_SCAN_RESULTS */
 
 	/** Callback function to be called when a get regulatory response is received. */
@@ -316,6 +490,77 @@ struct peers_info {
 	unsigned int pairwise_cipher;
 	/** 802.11 power save token count. */
 	int ps_token_count;
+	/** Next peer in the same lookup hash bucket, -1 if none. */
+	int hash_next;
+	/** Bytes queued in the pending queues of the peer. */
+	unsigned int pend_bytes;
+	/** U-APSD trigger-enabled ACs (bitmap of &enum nrf_wifi_fmac_ac). */
+	unsigned char uapsd_trig_mask;
+	/** U-APSD delivery-enabled ACs (bitmap of &enum nrf_wifi_fmac_ac). */
+	unsigned char uapsd_deliv_mask;
+	/** Maximum number of frames in a U-APSD service period, 0 for all. */
+	unsigned char uapsd_max_sp;
+	/** ACs served in the ongoing power save service period. */
+	unsigned char ps_sp_ac_mask;
+	/** A power save service period is ongoing (peer is in the wakeup queue). */
+	bool ps_sp_active;
+};
+
+/**
+ * @brief Structure to hold the per-VIF transmit scheduling information.
+ *
+ */
+struct tx_vif_sched {
+	/** Lock protecting the pending queues of the peers on this VIF. */
+	void *lock;
+	/** Peer on this VIF which will get the next opportunity for TX. */
+	unsigned int curr_peer_opp[NRF_WIFI_FMAC_AC_MAX];
+	/** Per-AC bitmap of the peers on this VIF which have frames pending. */
+	unsigned long *pend_peers[NRF_WIFI_FMAC_AC_MAX];
+};
+
+/**
+ * @brief Structure to hold the TX statistics of the TWT service periods.
+ *
+ */
+struct nrf_wifi_fmac_twt_tx_stats {
+	/** TWT flow is set up and TX is batched for its service periods. */
+	bool active;
+	/** Interval (in us) between two service periods. */
+	unsigned long long wake_interval_us;
+	/** Duration (in us) of a service period. */
+	unsigned int wake_duration_us;
+	/** Number of service periods. */
+	unsigned int num_sps;
+	/** Number of aggregates built during sleep and sent at the start of a service period. */
+	unsigned int num_prebuilt;
+	/** Number of service periods whose backlog was estimated not to fit. */
+	unsigned int num_predicted_misses;
+	/** Number of service periods which ended with frames still queued. */
+	unsigned int num_misses;
+	/** Bytes queued at the start of the last service period. */
+	unsigned int last_backlog_bytes;
+	/** Bytes whose TX completed during the last service period. */
+	unsigned int last_sp_tx_bytes;
+	/** Estimated number of bytes which can be sent in a service period, 0 if unknown. */
+	unsigned int est_sp_capacity_bytes;
+};
+
+/**
+ * @brief Structure to hold the TWT service period schedule used for TX batching.
+ *
+ */
+struct tx_twt_sched {
+	/** ID of the TWT flow. */
+	unsigned char flow_id;
+	/** Time (in ms) at which the ongoing service period started. */
+	unsigned long sp_start_ms;
+	/** Bytes whose TX completed during the ongoing service period. */
+	unsigned int sp_tx_bytes;
+	/** Estimated TX throughput (in bytes per ms) during the service periods, 0 if unknown. */
+	unsigned int est_bytes_per_ms;
+	/** Schedule and statistics reported to the user. */
+	struct nrf_wifi_fmac_twt_tx_stats stats;
 };
 
 /**
@@ -323,22 +568,36 @@ struct peers_info {
  *
  */
 struct tx_config {
-	/** Lock used to make code portions in the TX path atomic. */
+	/** Lock used to make code portions in the TX path atomic, this
+	 *  arbitrates the TX descriptors between the VIFs.
+	 */
 	void *tx_lock;
+	/** Number of peers, the multicast/raw TX peer uses the index after the last peer. */
+	unsigned int max_peers;
+	/** Number of peers usable by SoftAP clients, limited by the firmware. */
+	unsigned int max_ap_peers;
 	/** Context information about peers that the RPU firmware is connected to. */
-	struct peers_info peers[MAX_SW_PEERS];
+	struct peers_info *peers;
+	/** Heads of the peer lookup hash buckets, -1 if empty. */
+	int peer_hash[NRF_WIFI_FMAC_PEER_HASH_SIZE];
 	/** Coalesce count of TX frames. */
 	unsigned int *send_pkt_coalesce_count_p;
 	/** per-peer/per-AC Queue for frames waiting to be passed to the RPU firmware for TX. */
-	void *data_pending_txq[MAX_SW_PEERS][NRF_WIFI_FMAC_AC_MAX];
+	void *(*data_pending_txq)[NRF_WIFI_FMAC_AC_MAX];
 	/** Queue for peers which have woken up from 802.11 power save. */
 	void *wakeup_client_q;
 	/** Used to store tx descs(buff pool ids). */
 	unsigned long *buf_pool_bmp_p;
 	/** TX descriptors which have been queued to the RPU firmware. */
 	unsigned int outstanding_descs[NRF_WIFI_FMAC_AC_MAX];
-	/** Peer who will be get the next opportunity for TX. */
-	unsigned int curr_peer_opp[NRF_WIFI_FMAC_AC_MAX];
+	/** Per-VIF scheduling information, the last entry is used for the
+	 *  multicast/raw TX peer which is shared by all the VIFs.
+	 */
+	struct tx_vif_sched vif_sched[MAX_NUM_VIFS + 1];
+	/** VIF which will get the next opportunity for TX. */
+	unsigned int curr_vif_opp[NRF_WIFI_FMAC_AC_MAX];
+	/** TX descriptors are not being granted while the TX parameters are changed. */
+	bool quiesce;
 	/** Access category which will get the next spare descriptor. */
 	unsigned int next_spare_desc_ac;
 	/** Frame context information. */
@@ -348,13 +607,187 @@ struct tx_config {
 	 *  - Second four bits: Spare desc2 queue number.
 	 */
 	unsigned int spare_desc_queue_map;
+	/** TWT service period schedule. */
+	struct tx_twt_sched twt;
 #if defined(NRF70_TX_DONE_WQ_ENABLED) || defined(__DOXYGEN__)
 	/** Queue for TX done tasklet. */
 	void *tx_done_tasklet_event_q;
 #endif /* NRF70_TX_DONE_WQ_ENABLED */
+#if defined(NRF70_AP_MODE) || defined(__DOXYGEN__)
+	/** Number of SoftAP clients in power save. */
+	unsigned int num_ps_peers;
+	/** DTIM interval (in ms) of the SoftAP, 0 if no SoftAP is running. */
+	unsigned int dtim_interval_ms;
+	/** Time (in ms) at which the next DTIM beacon is expected. */
+	unsigned long next_dtim_ms;
+	/** Group addressed frames left to send in the ongoing DTIM burst. */
+	unsigned int mc_burst_left;
+#endif /* NRF70_AP_MODE */
 };
 #endif /* NRF70_STA_MODE */
 
+/**
+ * @brief Structure to hold the runtime tunable TX data path parameters.
+ *
+ */
+struct nrf_wifi_fmac_tx_params {
+	/** Maximum number of frames aggregated in a TX descriptor, cannot exceed
+	 *  the value the driver was initialized with.
+	 */
+	unsigned char max_tx_aggregation;
+	/** Number of TX descriptors reserved per access category, the remaining
+	 *  descriptors are shared by all the access categories.
+	 */
+	unsigned char num_tx_tokens_per_ac;
+	/** Number of TX descriptors shared by all the access categories
+	 *  (read only, derived from @p num_tx_tokens_per_ac).
+	 */
+	unsigned char num_tx_tokens_spare;
+	/** Size of the region of the RPU packet RAM reserved for each TX descriptor. */
+	unsigned int max_ampdu_len_per_token;
+	/** Length of the frames aggregated in a TX descriptor, cannot exceed
+	 *  @p max_ampdu_len_per_token.
+	 */
+	unsigned int avail_ampdu_len_per_token;
+};
+
+#if defined(NRF_WIFI_RPU_RECOVERY) || defined(__DOXYGEN__)
+/**
+ * @brief Stages of an RPU recovery, as seen by the configuration replay.
+ */
+enum nrf_wifi_fmac_recovery_state {
+	/** No recovery in progress, configuration commands are recorded. */
+	NRF_WIFI_FMAC_RECOVERY_IDLE,
+	/** Recovery requested, the OS layer is tearing down and reloading the RPU. */
+	NRF_WIFI_FMAC_RECOVERY_TEARDOWN,
+	/** The RPU has been re-initialized, waiting for the configuration replay. */
+	NRF_WIFI_FMAC_RECOVERY_RELOADED,
+	/** The recorded configuration is being replayed. */
+	NRF_WIFI_FMAC_RECOVERY_REPLAYING
+};
+
+/**
+ * @brief Phases of an RPU recovery, in the order they happen.
+ */
+enum nrf_wifi_fmac_recovery_phase {
+	/** From the detection of the failure to the recovery request. */
+	NRF_WIFI_FMAC_RECOVERY_PHASE_DETECT,
+	/** From the recovery request to the end of the device de-initialization. */
+	NRF_WIFI_FMAC_RECOVERY_PHASE_TEARDOWN,
+	/** Device removal and re-addition, firmware load and boot. */
+	NRF_WIFI_FMAC_RECOVERY_PHASE_RELOAD,
+	/** Device initialization, up to the firmware being initialized. */
+	NRF_WIFI_FMAC_RECOVERY_PHASE_INIT,
+	/** Reconfiguration, up to the end of the replay or the first VIF brought up. */
+	NRF_WIFI_FMAC_RECOVERY_PHASE_RECONFIG,
+	/** Number of recovery phases. */
+	NRF_WIFI_FMAC_RECOVERY_PHASE_MAX
+};
+
+/**
+ * @brief Structure to hold the breakdown of an RPU recovery.
+ */
+struct nrf_wifi_fmac_recovery_record {
+	/** Cause of the recovery, see &enum nrf_wifi_hal_recovery_cause. */
+	enum nrf_wifi_hal_recovery_cause cause;
+	/** Time (in ms) at which the failure was detected. */
+	unsigned long detect_time_ms;
+	/** Time (in ms) spent in each phase, see &enum nrf_wifi_fmac_recovery_phase. */
+	unsigned int phase_ms[NRF_WIFI_FMAC_RECOVERY_PHASE_MAX];
+	/** Time (in ms) from the detection to the end of the reconfiguration. */
+	unsigned int total_ms;
+	/** Number of TX frames dropped during the teardown. */
+	unsigned int tx_dropped;
+	/** Whether the configuration was restored through the replay. */
+	bool replayed;
+};
+
+/**
+ * @brief Structure to hold a configuration command recorded for replay.
+ */
+struct nrf_wifi_fmac_recovery_cmd {
+	/** Message type, see &enum nrf_wifi_host_rpu_msg_type. */
+	int type;
+	/** VIF index the command applies to, MAX_NUM_VIFS for device wide commands. */
+	unsigned char if_idx;
+	/** Command ID. */
+	unsigned int cmd;
+	/** Distinguishes commands with the same ID which do not replace each other. */
+	unsigned int key;
+	/** Order in which the command was recorded. */
+	unsigned int seq;
+	/** Length of the command. */
+	unsigned int len;
+	/** Copy of the command as sent to the RPU, NULL if the entry is unused. */
+	void *data;
+};
+
+/**
+ * @brief Structure to hold the timings and counters of the RPU recoveries.
+ */
+struct nrf_wifi_fmac_recovery_stats {
+	/** Number of RPU recoveries requested. */
+	unsigned int num_recoveries;
+	/** Number of configuration replays done. */
+	unsigned int num_replays;
+	/** Number of commands replayed. */
+	unsigned int num_replayed_cmds;
+	/** Number of commands which could not be replayed. */
+	unsigned int num_replay_fails;
+	/** Time (in ms) from the recovery request to the start of the last replay,
+	 *  i.e. teardown, firmware reload and initialization.
+	 */
+	unsigned int last_reload_ms;
+	/** Time (in ms) taken by the last replay. */
+	unsigned int last_replay_ms;
+	/** Time (in ms) from the recovery request to the end of the last replay. */
+	unsigned int last_total_ms;
+	/** Maximum time (in ms) from a recovery request to the end of its replay. */
+	unsigned int max_total_ms;
+};
+
+/**
+ * @brief Structure to hold the configuration recorded for replay after an RPU recovery.
+ *
+ * This lives in the FMAC context (rather than the device context) so that it
+ * survives the removal and re-addition of the device during a recovery.
+ */
+struct nrf_wifi_fmac_recovery_ctx {
+	/** Lock protecting the recorded configuration, the state and the statistics. */
+	void *lock;
+	/** Recovery stage. */
+	enum nrf_wifi_fmac_recovery_state state;
+	/** Whether keys are recorded and replayed. */
+	bool replay_keys;
+	/** Time (in ms) at which the recovery was requested. */
+	unsigned long request_time_ms;
+	/** Sequence number to be assigned to the next recorded command. */
+	unsigned int next_seq;
+	/** Whether a VIF has been added at the given index. */
+	bool vif_valid[MAX_NUM_VIFS];
+	/** Parameters the VIFs were added with. */
+	struct nrf_wifi_umac_add_vif_info vif_info[MAX_NUM_VIFS];
+	/** Recorded configuration commands. */
+	struct nrf_wifi_fmac_recovery_cmd cmds[NRF_WIFI_FMAC_RECOVERY_MAX_CMDS];
+	/** Recovery timings and counters. */
+	struct nrf_wifi_fmac_recovery_stats stats;
+	/** Whether the current recovery has not yet been added to the history. */
+	bool rec_open;
+	/** Phase the current recovery is in. */
+	enum nrf_wifi_fmac_recovery_phase phase;
+	/** Time (in ms) at which the current phase started. */
+	unsigned long phase_start_ms;
+	/** Breakdown of the current recovery. */
+	struct nrf_wifi_fmac_recovery_record rec;
+	/** Ring of the breakdowns of the last recoveries. */
+	struct nrf_wifi_fmac_recovery_record history[NRF_WIFI_FMAC_RECOVERY_HISTORY_LEN];
+	/** Index in the history at which the next recovery is added. */
+	unsigned int history_idx;
+	/** Number of valid entries in the history. */
+	unsigned int history_cnt;
+};
+#endif /* NRF_WIFI_RPU_RECOVERY */
+
 /**
  * @brief Structure to hold context information for the UMAC IF layer.
  *
@@ -379,11 +812,19 @@ struct nrf_wifi_sys_fmac_priv {
 	unsigned char num_tx_tokens_per_ac;
 	/** Number of spare tokens (common to all ACs) available for TX. */
 	unsigned char num_tx_tokens_spare;
+	/** Maximum TX aggregation the TX buffer information was sized for. */
+	unsigned char max_tx_aggregation_limit;
+	/** Number of peers the TX path is sized for. */
+	unsigned int max_peers;
 	/** Maximum supported AMPDU length per token. */
 	unsigned int max_ampdu_len_per_token;
 	/** Available (remaining) AMPDU length per token. */
 	unsigned int avail_ampdu_len_per_token;
 #endif /* NRF70_STA_MODE */
+#ifdef NRF_WIFI_RPU_RECOVERY
+	/** Configuration recorded for replay after an RPU recovery. */
+	struct nrf_wifi_fmac_recovery_ctx recovery;
+#endif /* NRF_WIFI_RPU_RECOVERY */
 };
 
 #ifdef NRF70_RAW_DATA_TX
@@ -444,8 +885,320 @@ struct raw_tx_stats {
 	/** Count of un-successful raw packets sent. */
 	unsigned int raw_pkt_send_success;
 };
+
+/**
+ * @brief Configuration of a raw TX session.
+ *
+ * The settings apply to all the frames submitted during the session.
+ */
+struct nrf_wifi_fmac_rawtx_session_cfg {
+	/** Data rate at which the frames are to be transmitted. */
+	unsigned char data_rate;
+	/** Mode of the frames, see &enum nrf_wifi_fmac_rawtx_mode. */
+	unsigned char tx_mode;
+	/** Access category of the frames, see &enum nrf_wifi_fmac_ac. */
+	unsigned char queue;
+	/** Number of times a frame is transmitted at each rate. */
+	unsigned char rate_retries;
+	/** Write an incrementing sequence number in the template (requires @p hdr_len >= 24). */
+	bool seq_num_update;
+	/** Length of @p hdr, 0 if the payloads already carry their 802.11 header. */
+	unsigned char hdr_len;
+	/** 802.11 header template prepended to every payload. */
+	unsigned char hdr[NRF_WIFI_FMAC_RAWTX_TEMPLATE_MAX_LEN];
+};
+
+/**
+ * @brief Statistics of a raw TX session.
+ */
+struct nrf_wifi_fmac_rawtx_session_stats {
+	/** Number of batches submitted. */
+	unsigned int num_batches;
+	/** Number of frames queued for transmission. */
+	unsigned int num_frames;
+	/** Number of frames which could not be queued. */
+	unsigned int num_failed;
+	/** Time (in us) from the start of the session to the last submission. */
+	unsigned long duration_us;
+};
+
+/**
+ * @brief Header prepended to every frame of a raw TX session.
+ *
+ * The frame carries the settings of the session it was submitted to, so
+ * that frames still queued when a new session starts keep their own.
+ */
+struct nrf_wifi_fmac_rawtx_session_hdr {
+	/** Raw TX settings, the magic number identifies a session frame. */
+	struct raw_tx_pkt_header raw_hdr;
+	/** Number of times the frame is transmitted at each rate. */
+	unsigned char rate_retries;
+};
+
+/**
+ * @brief State of a raw TX session.
+ */
+struct nrf_wifi_fmac_rawtx_session {
+	/** Whether the session is active. */
+	bool active;
+	/** Index of the interface the frames are transmitted on. */
+	unsigned char if_idx;
+	/** Session configuration. */
+	struct nrf_wifi_fmac_rawtx_session_cfg cfg;
+	/** Frame header built once from @p cfg. */
+	struct nrf_wifi_fmac_rawtx_session_hdr frame_hdr;
+	/** Next sequence number written in the template. */
+	unsigned short seq_num;
+	/** Time (in us) at which the session started. */
+	unsigned long start_us;
+	/** Session statistics. */
+	struct nrf_wifi_fmac_rawtx_session_stats stats;
+};
 #endif /* NRF70_RAW_DATA_TX */
 
+/**
+ * @brief Callback invoked on completion of an asynchronous UMAC control command.
+ *
+ * @param callbk_ctx Context passed by the caller while submitting the command.
+ * @param tag Tag which was assigned to the command on submission.
+ * @param status NRF_WIFI_STATUS_SUCCESS if the response event was received,
+ *		 NRF_WIFI_STATUS_FAIL on timeout or cancellation.
+ * @param event_data Pointer to the response event (NULL if none was received).
+ * @param event_len Length of the response event.
+ */
+typedef void (*nrf_wifi_fmac_cmd_resp_callbk_t)(void *callbk_ctx,
+						unsigned int tag,
+						enum nrf_wifi_status status,
+						void *event_data,
+						unsigned int event_len);
+
+/**
+ * @brief Structure to hold the information of an outstanding asynchronous
+ *	  UMAC control command.
+ */
+struct nrf_wifi_fmac_async_cmd {
+	/** Slot is in use. */
+	bool in_use;
+	/** Host assigned tag (sequence number) of the command. */
+	unsigned int tag;
+	/** UMAC command sent to the RPU. */
+	unsigned int cmd;
+	/** UMAC event expected in response to the command. */
+	unsigned int resp_event;
+	/** VIF index the command was issued on. */
+	unsigned char if_idx;
+	/** Time (in ms) at which the command was submitted. */
+	unsigned long submit_time_ms;
+	/** Time (in ms) after which the command is considered timed out. */
+	unsigned int timeout_ms;
+	/** Callback to be invoked on completion of the command. */
+	nrf_wifi_fmac_cmd_resp_callbk_t callbk_fn;
+	/** Context to be passed to the callback. */
+	void *callbk_ctx;
+};
+
+/**
+ * @brief Structure to hold the state of the asynchronous UMAC control command path.
+ */
+struct nrf_wifi_fmac_async_cmd_ctx {
+	/** Lock protecting the outstanding commands table. */
+	void *lock;
+	/** Tag to be assigned to the next submitted command. */
+	unsigned int next_tag;
+	/** Number of outstanding commands. */
+	unsigned int num_pending;
+	/** Table of outstanding commands. */
+	struct nrf_wifi_fmac_async_cmd cmds[NRF_WIFI_FMAC_MAX_ASYNC_CMDS];
+};
+
+/**
+ * @brief Structure to hold a periodic firmware statistics snapshot.
+ */
+struct nrf_wifi_fmac_stats_snapshot {
+	/** Sequence number of the snapshot, 0 if no snapshot has been taken yet. */
+	unsigned int seq;
+	/** Time (in ms) at which the snapshot was taken. */
+	unsigned long timestamp_ms;
+	/** Time (in ms) elapsed since the previous snapshot, 0 for the first one. */
+	unsigned int interval_ms;
+	/** Firmware statistics. */
+	struct rpu_sys_fw_stats fw;
+	/** Change in the LMAC counters since the previous snapshot. */
+	struct rpu_lmac_stats lmac_delta;
+	/** Change in the UMAC counters since the previous snapshot. */
+	struct rpu_umac_stats umac_delta;
+	/** Transmitted bytes per second over the last interval. */
+	unsigned int tx_bytes_per_sec;
+	/** Received bytes per second over the last interval. */
+	unsigned int rx_bytes_per_sec;
+	/** Transmitted unicast packets per second over the last interval. */
+	unsigned int tx_pkts_per_sec;
+	/** Received unicast packets per second over the last interval. */
+	unsigned int rx_pkts_per_sec;
+};
+
+/**
+ * @brief Structure to hold the state of the periodic firmware statistics.
+ */
+struct nrf_wifi_fmac_stats_periodic {
+	/** Lock protecting the statistics request flags, readers of the
+	 *  snapshots do not take it.
+	 */
+	void *lock;
+	/** Interval (in ms) between the snapshots, 0 if periodic statistics are disabled. */
+	unsigned int interval_ms;
+	/** A periodic statistics request is outstanding, tracked separately
+	 *  from the on-demand request flag (stats_req).
+	 */
+	bool req_pending;
+	/** Time (in ms) at which the last request was sent. */
+	unsigned long last_req_ms;
+	/** Index of the snapshot which is currently published to readers. */
+	unsigned char active;
+	/** Double buffered snapshots, NULL until periodic statistics are first enabled. */
+	struct nrf_wifi_fmac_stats_snapshot *snap;
+};
+
+/**
+ * @brief Structure to hold a BSS entry of the scan result BSS table.
+ */
+struct nrf_wifi_fmac_bss_entry {
+	/** BSSID of the BSS. */
+	unsigned char bssid[NRF_WIFI_ETH_ADDR_LEN];
+	/** Band of the BSS, refer &enum nrf_wifi_band. */
+	int band;
+	/** Channel number of the BSS, 0 if not known. */
+	unsigned int channel;
+	/** Frequency (in MHz) of the BSS, 0 if not known. */
+	unsigned int frequency;
+	/** SSID of the BSS. */
+	struct nrf_wifi_ssid ssid;
+	/** Security mode, refer &enum nrf_wifi_security_type (-1 if not known). */
+	int security_type;
+	/** Beacon interval of the BSS. */
+	unsigned short beacon_interval;
+	/** Capability field of the BSS. */
+	unsigned short capability;
+	/** Signal strength (in dBm) of the latest scan result. */
+	int last_rssi;
+	/** Best signal strength (in dBm) seen since the BSS was added. */
+	int best_rssi;
+	/** Time (in ms) at which the BSS was first seen. */
+	unsigned long first_seen_ms;
+	/** Time (in ms) at which the BSS was last seen. */
+	unsigned long last_seen_ms;
+	/** Number of scan results merged into this entry. */
+	unsigned int seen_cnt;
+};
+
+/**
+ * @brief Callback function type for the event observers.
+ *
+ * @param observer_ctx Context passed while registering the observer.
+ * @param event UMAC control event ID (refer &enum nrf_wifi_umac_events) or
+ *              data event ID (refer &enum nrf_wifi_umac_data_commands).
+ * @param event_data Event data, starting with &struct nrf_wifi_umac_hdr for
+ *                   control events or &struct nrf_wifi_umac_head for data events.
+ * @param event_len Length of the event data.
+ */
+typedef void (*nrf_wifi_fmac_event_observer_t)(void *observer_ctx,
+					       unsigned int event,
+					       void *event_data,
+					       unsigned int event_len);
+
+/**
+ * @brief Structure to hold the processing statistics of an event.
+ */
+struct nrf_wifi_fmac_event_stats {
+	/** Number of times the event was processed. */
+	unsigned int count;
+	/** Total processing time (in us). */
+	unsigned long long total_us;
+	/** Maximum processing time (in us). */
+	unsigned int max_us;
+	/** Processing time histogram, see %NRF_WIFI_FMAC_EVENT_HIST_BASE_US. */
+	unsigned int hist[NRF_WIFI_FMAC_EVENT_HIST_BINS];
+};
+
+/**
+ * @brief Structure to hold an event observer.
+ */
+struct nrf_wifi_fmac_event_observer {
+	/** Whether @p event is a data event or a control event. */
+	bool data_event;
+	/** UMAC event ID observed. */
+	unsigned int event;
+	/** Observer callback, NULL if the slot is free. */
+	nrf_wifi_fmac_event_observer_t callbk_fn;
+	/** Context passed to the observer callback. */
+	void *callbk_ctx;
+};
+
+/**
+ * @brief Structure to hold the UMAC event observers and statistics.
+ *
+ * The driver's own handling of the events stays in the switch statements of
+ * the event processing, this only adds the hooks which run around it.
+ */
+struct nrf_wifi_fmac_event_dispatch {
+	/** Lock protecting the statistics and the observers. */
+	void *lock;
+	/** Held while observers are called, lets unregister wait for them to return. */
+	void *observer_lock;
+	/** Event processing statistics are being collected. */
+	bool stats_enabled;
+	/** Number of registered observers. */
+	unsigned int num_observers;
+	/** Registered observers. */
+	struct nrf_wifi_fmac_event_observer observers[NRF_WIFI_FMAC_MAX_EVENT_OBSERVERS];
+	/** Processing statistics of the UMAC control events. */
+	struct nrf_wifi_fmac_event_stats ctrl_stats[NRF_WIFI_FMAC_NUM_CTRL_EVENTS];
+	/** Processing statistics of the UMAC data events. */
+	struct nrf_wifi_fmac_event_stats data_stats[NRF_WIFI_FMAC_NUM_DATA_EVENTS];
+};
+
+/**
+ * @brief Structure to hold a channel hint, i.e. where a BSS of an SSID was last seen.
+ */
+struct nrf_wifi_fmac_chan_hint {
+	/** SSID of the BSS. */
+	struct nrf_wifi_ssid ssid;
+	/** BSSID of the BSS. */
+	unsigned char bssid[NRF_WIFI_ETH_ADDR_LEN];
+	/** Frequency (in MHz) on which the BSS was seen. */
+	unsigned int frequency;
+	/** Time (in ms) at which the BSS was last seen or associated with. */
+	unsigned long last_seen_ms;
+	/** The BSS was successfully associated with on this frequency. */
+	bool assoc;
+};
+
+/**
+ * @brief Structure to hold the scan result BSS table and the channel hint cache.
+ */
+struct nrf_wifi_fmac_bss_table {
+	/** Lock protecting the table. */
+	void *lock;
+#if NRF_WIFI_FMAC_BSS_TABLE_SIZE > 0
+	/** Time (in ms) after which an entry which has not been seen is dropped. */
+	unsigned int max_age_ms;
+	/** Number of valid entries. */
+	unsigned int num_entries;
+	/** BSS entries, the first num_entries are valid. */
+	struct nrf_wifi_fmac_bss_entry entries[NRF_WIFI_FMAC_BSS_TABLE_SIZE];
+#endif /* NRF_WIFI_FMAC_BSS_TABLE_SIZE > 0 */
+#if NRF_WIFI_FMAC_CHAN_HINT_CACHE_SIZE > 0
+	/** Number of valid channel hints, these are not aged out with the BSS entries. */
+	unsigned int num_hints;
+	/** Channel hints, the first num_hints are valid. */
+	struct nrf_wifi_fmac_chan_hint hints[NRF_WIFI_FMAC_CHAN_HINT_CACHE_SIZE];
+	/** An association is in progress for pending_assoc. */
+	bool pending_assoc_valid;
+	/** Channel hint to be added if the association in progress succeeds. */
+	struct nrf_wifi_fmac_chan_hint pending_assoc;
+#endif /* NRF_WIFI_FMAC_CHAN_HINT_CACHE_SIZE > 0 */
+};
+
 /**
  * @brief Structure to hold per device context information for the UMAC IF layer.
  *
@@ -484,7 +1237,17 @@ struct nrf_wifi_sys_fmac_dev_ctx {
 #ifdef NRF70_RAW_DATA_TX
 	struct raw_tx_pkt_header raw_tx_config;
 	struct raw_tx_stats raw_pkt_stats;
+	/** Raw TX session. */
+	struct nrf_wifi_fmac_rawtx_session raw_tx_session;
 #endif /* NRF70_RAW_DATA_TX */
+	/** Outstanding asynchronous UMAC control commands. */
+	struct nrf_wifi_fmac_async_cmd_ctx async_cmd;
+	/** Periodic firmware statistics. */
+	struct nrf_wifi_fmac_stats_periodic stats_periodic;
+	/** BSSs seen in the scan results. */
+	struct nrf_wifi_fmac_bss_table bss_table;
+	/** UMAC event dispatcher. */
+	struct nrf_wifi_fmac_event_dispatch event_dispatch;
 };
 
 /**
@@ -504,6 +1267,8 @@ struct nrf_wifi_fmac_vif_ctx {
 	int groupwise_cipher;
 	/** Interface flags related to this VIF. */
 	bool ifflags;
+	/** Completion signalled on reception of the interface flags status event. */
+	void *ifflags_comp;
 	/** Interface type of this VIF. */
 	int if_type;
 	/** BSSID of the AP to which this VIF is connected (applicable only in STA mode). */
@@ -519,6 +1284,16 @@ struct nrf_wifi_fmac_vif_ctx {
 #if defined(NRF70_RAW_DATA_RX) || defined(NRF70_PROMISC_DATA_RX)
 	/** Filter setting for Monitor and Promiscuous modes */
 	unsigned char packet_filter;
+	/** Whether @p rx_filter is to be applied */
+	bool rx_filter_enabled;
+	/** Host side filter for Monitor and Promiscuous modes */
+	struct nrf_wifi_fmac_rx_filter rx_filter;
+	/** Statistics of @p rx_filter */
+	struct nrf_wifi_fmac_rx_filter_stats rx_filter_stats;
+	/** Capture ring raw RX frames are written to, if set */
+	struct nrf_wifi_fmac_capture_ring *capture_ring;
+	/** Lock protecting @p rx_filter, @p rx_filter_stats and @p capture_ring against the RX path */
+	void *raw_rx_lock;
 #endif /* NRF70_RAW_DATA_RX || NRF70_PROMISC_DATA_RX */
 #ifdef NRF70_PROMISC_DATA_RX
 	/** Promiscuous mode setting */
@@ -27,6 +27,8 @@
  */
 #define TX_DESC_BUCKET_BOUND 32
 
+#define TX_PEER_BMP_BITS (sizeof(unsigned long) * 8)
+
 /**
  * @brief The length of the WMM parameters.
  */
@@ -39,6 +41,16 @@
  */
 #define SPARE_DESC_Q_MAP_SIZE 4
 
+#define NRF_WIFI_FMAC_TX_QUIESCE_TIMEOUT_MS 500
+
+/**
+ * @brief The maximum number of bytes buffered for a SoftAP client in power save.
+ *
+ * The oldest frames of the lowest priority ACs are dropped to make room for
+ * new frames once this is exceeded.
+ */
+#define TX_PS_BUF_MAX_BYTES (16 * 1024)
+
 /**
  * @brief The status of a TX operation performed by the RPU driver.
  */
@@ -51,7 +63,9 @@ enum nrf_wifi_fmac_tx_status {
 	/** The TX operation was successful (packet queued in driver). */
 	NRF_WIFI_FMAC_TX_STATUS_QUEUED = 1,
 	/** The TX operation failed. */
-	NRF_WIFI_FMAC_TX_STATUS_FAIL = -1
+	NRF_WIFI_FMAC_TX_STATUS_FAIL = -1,
+	/** The TX operation failed after the packet was queued in driver. */
+	NRF_WIFI_FMAC_TX_STATUS_QUEUED_FAIL = -2
 };
 
 /**
@@ -62,6 +76,12 @@ struct tx_pkt_info {
 	void *pkt;
 	/** Peer ID. */
 	unsigned int peer_id;
+	/** The frames were aggregated during TWT sleep and are sent at the
+	 *  start of the next service period.
+	 */
+	bool deferred;
+	/** Access category the descriptor is accounted to while deferred. */
+	unsigned int ac;
 };
 
 #ifdef NRF70_RAW_DATA_TX
@@ -124,6 +144,20 @@ enum nrf_wifi_status nrf_wifi_fmac_tx_done_event_process(struct nrf_wifi_fmac_de
 enum nrf_wifi_status
 nrf_wifi_fmac_rawtx_done_event_process(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
 		struct nrf_wifi_event_raw_tx_done *config);
+
+/**
+ * @brief End the raw TX session of a VIF which can no longer inject frames.
+ *
+ * @param fmac_dev_ctx Pointer to the FMAC device context.
+ * @param if_idx Index of the VIF.
+ * @param vif_removed Whether the VIF is being removed.
+ *
+ * The session is ended if it runs on @p if_idx and the VIF is being removed
+ * or is no longer in a raw TX mode.
+ */
+void tx_rawtx_session_vif_check(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+				unsigned char if_idx,
+				bool vif_removed);
 #endif /* CONFIG_NRF70_RAW_DATA_TX */
 
 /**
@@ -174,6 +208,92 @@ unsigned int tx_buff_req_free(struct nrf_wifi_fmac_dev_ctx *fmac_ctx,
 		unsigned int desc,
 		unsigned char *ac);
 
+#ifdef NRF70_STA_MODE
+/**
+ * @brief End the ongoing power save service period of a peer.
+ *
+ * @param fmac_dev_ctx Pointer to the FMAC device context.
+ * @param peer Pointer to the peer information.
+ *
+ * Must be called with the TX lock held.
+ */
+void tx_ps_sp_end(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+		  struct peers_info *peer);
+#endif /* NRF70_STA_MODE */
+
+#ifdef NRF70_AP_MODE
+/**
+ * @brief Update the power save state of a SoftAP client.
+ *
+ * @param fmac_dev_ctx Pointer to the FMAC device context.
+ * @param peer Pointer to the peer information.
+ * @param ps_state NRF_WIFI_CLIENT_ACTIVE or NRF_WIFI_CLIENT_PS_MODE.
+ *
+ * Group addressed frames are held back for DTIM beacons as long as at least
+ * one client is in power save. Only available in SoftAP builds, must be
+ * called with the TX lock held.
+ */
+void tx_ps_state_set(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+		     struct peers_info *peer,
+		     unsigned char ps_state);
+
+/**
+ * @brief Configure the DTIM interval used to release group addressed frames.
+ *
+ * @param fmac_dev_ctx Pointer to the FMAC device context.
+ * @param beacon_interval Beacon interval (in TUs), 0 when the SoftAP stops.
+ * @param dtim_period DTIM period (in beacon intervals).
+ */
+void tx_mc_dtim_config(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+		       unsigned short beacon_interval,
+		       unsigned char dtim_period);
+
+/**
+ * @brief Start a burst of the buffered group addressed frames if a DTIM is due.
+ *
+ * @param fmac_dev_ctx Pointer to the FMAC device context.
+ *
+ * Must be called with the TX lock held.
+ */
+void tx_mc_dtim_check(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx);
+#endif /* NRF70_AP_MODE */
+
+/**
+ * @brief Track the service period schedule of a TWT setup response.
+ *
+ * @param fmac_dev_ctx Pointer to the FMAC device context.
+ * @param twt_info Pointer to the TWT parameters of the response.
+ *
+ * Only flows accepted by the AP are tracked.
+ */
+void tx_twt_config(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+		   struct nrf_wifi_umac_config_twt_info *twt_info);
+
+/**
+ * @brief Stop tracking the service period schedule of a TWT flow.
+ *
+ * @param fmac_dev_ctx Pointer to the FMAC device context.
+ * @param flow_id ID of the TWT flow which was torn down.
+ *
+ * Frames held for the next service period are sent right away.
+ */
+void tx_twt_teardown(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+		     unsigned char flow_id);
+
+/**
+ * @brief Handle the start or the end of a TWT service period.
+ *
+ * @param fmac_dev_ctx Pointer to the FMAC device context.
+ * @param awake true at the start of a service period, false at its end.
+ *
+ * At the start of a service period the aggregates built during sleep are sent
+ * first, followed by as many aggregates as there are free TX descriptors. At
+ * the end of a service period the throughput estimate is updated and the
+ * aggregates for the next one are built. Takes the TX lock.
+ */
+void tx_twt_state_set(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+		      bool awake);
+
 /** @} */
 
 #endif /* __FMAC_TX_H__ */
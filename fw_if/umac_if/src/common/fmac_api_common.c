@@ -14,6 +14,9 @@
 #include "common/fmac_util.h"
 #include "common/fmac_cmd_common.h"
 #include "util.h"
+#if defined(NRF_WIFI_RPU_RECOVERY) && (defined(NRF70_SYSTEM_MODE) || defined(NRF70_SCAN_ONLY))
+#include "system/fmac_recovery.h"
+#endif /* NRF_WIFI_RPU_RECOVERY && (NRF70_SYSTEM_MODE || NRF70_SCAN_ONLY) */
 
 struct nrf_wifi_proc {
 	const enum RPU_PROC_TYPE type;
@@ -107,6 +110,12 @@ void nrf_wifi_fmac_deinit(struct nrf_wifi_fmac_priv *fpriv)
 {
 	nrf_wifi_hal_deinit(fpriv->hpriv);
 
+#if defined(NRF_WIFI_RPU_RECOVERY) && (defined(NRF70_SYSTEM_MODE) || defined(NRF70_SCAN_ONLY))
+	if (fpriv->op_mode == NRF_WIFI_OP_MODE_SYS) {
+		nrf_wifi_sys_fmac_recovery_deinit(fpriv);
+	}
+#endif /* NRF_WIFI_RPU_RECOVERY && (NRF70_SYSTEM_MODE || NRF70_SCAN_ONLY) */
+
 	nrf_wifi_osal_mem_free(fpriv);
 }
 
@@ -115,10 +124,63 @@ void nrf_wifi_fmac_dev_rem(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx)
 {
 	nrf_wifi_hal_dev_rem(fmac_dev_ctx->hal_dev_ctx);
 
+	nrf_wifi_fmac_dev_comps_free(fmac_dev_ctx);
+
 	nrf_wifi_osal_mem_free(fmac_dev_ctx);
 }
 
 
+enum nrf_wifi_status nrf_wifi_fmac_dev_comps_alloc(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx)
+{
+	fmac_dev_ctx->fw_init_comp = nrf_wifi_osal_completion_alloc();
+	fmac_dev_ctx->fw_deinit_comp = nrf_wifi_osal_completion_alloc();
+	fmac_dev_ctx->stats_comp = nrf_wifi_osal_completion_alloc();
+	fmac_dev_ctx->reg_get_comp = nrf_wifi_osal_completion_alloc();
+	fmac_dev_ctx->reg_set_comp = nrf_wifi_osal_completion_alloc();
+	fmac_dev_ctx->cmd_comp = nrf_wifi_osal_completion_alloc();
+	fmac_dev_ctx->mode_lock = nrf_wifi_osal_spinlock_alloc();
+
+	if (!fmac_dev_ctx->fw_init_comp ||
+	    !fmac_dev_ctx->fw_deinit_comp ||
+	    !fmac_dev_ctx->stats_comp ||
+	    !fmac_dev_ctx->reg_get_comp ||
+	    !fmac_dev_ctx->reg_set_comp ||
+	    !fmac_dev_ctx->cmd_comp ||
+	    !fmac_dev_ctx->mode_lock) {
+		nrf_wifi_osal_log_err("%s: Unable to allocate completions",
+				      __func__);
+		nrf_wifi_fmac_dev_comps_free(fmac_dev_ctx);
+		return NRF_WIFI_STATUS_FAIL;
+	}
+
+	nrf_wifi_osal_spinlock_init(fmac_dev_ctx->mode_lock);
+
+	return NRF_WIFI_STATUS_SUCCESS;
+}
+
+
+void nrf_wifi_fmac_dev_comps_free(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx)
+{
+	nrf_wifi_osal_completion_free(fmac_dev_ctx->fw_init_comp);
+	fmac_dev_ctx->fw_init_comp = NULL;
+	nrf_wifi_osal_completion_free(fmac_dev_ctx->fw_deinit_comp);
+	fmac_dev_ctx->fw_deinit_comp = NULL;
+	nrf_wifi_osal_completion_free(fmac_dev_ctx->stats_comp);
+	fmac_dev_ctx->stats_comp = NULL;
+	nrf_wifi_osal_completion_free(fmac_dev_ctx->reg_get_comp);
+	fmac_dev_ctx->reg_get_comp = NULL;
+	nrf_wifi_osal_completion_free(fmac_dev_ctx->reg_set_comp);
+	fmac_dev_ctx->reg_set_comp = NULL;
+	nrf_wifi_osal_completion_free(fmac_dev_ctx->cmd_comp);
+	fmac_dev_ctx->cmd_comp = NULL;
+
+	if (fmac_dev_ctx->mode_lock) {
+		nrf_wifi_osal_spinlock_free(fmac_dev_ctx->mode_lock);
+		fmac_dev_ctx->mode_lock = NULL;
+	}
+}
+
+
 enum nrf_wifi_status nrf_wifi_validate_fw_header(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
 						 struct nrf70_fw_image_info *info)
 {
@@ -153,16 +215,87 @@ enum nrf_wifi_status nrf_wifi_validate_fw_header(struct nrf_wifi_fmac_dev_ctx *f
 	return NRF_WIFI_STATUS_SUCCESS;
 }
 
+static bool nrf_wifi_fmac_fw_cache_hit(struct nrf_wifi_fmac_fw_cache *fw_cache,
+				       const void *fw_data,
+				       unsigned int fw_size)
+{
+	const struct nrf70_fw_image_info *info = fw_data;
+
+	/* The header hash covers the image, so an image changed in place is
+	 * not mistaken for the cached one.
+	 */
+	return fw_cache->valid &&
+	       (fw_cache->fw_data == fw_data) &&
+	       (fw_cache->fw_size == fw_size) &&
+	       (fw_cache->version == info->version) &&
+	       (fw_cache->feature_flags == info->feature_flags) &&
+	       !nrf_wifi_osal_mem_cmp(fw_cache->hash,
+				      info->hash,
+				      sizeof(fw_cache->hash));
+}
+
+
+static void nrf_wifi_fmac_fw_cache_fill(struct nrf_wifi_fmac_fw_cache *fw_cache,
+					const void *fw_data,
+					unsigned int fw_size,
+					struct nrf_wifi_fmac_fw_info *fw_info)
+{
+	const struct nrf70_fw_image_info *info = fw_data;
+
+	fw_cache->fw_data = fw_data;
+	fw_cache->fw_size = fw_size;
+	fw_cache->version = info->version;
+	fw_cache->feature_flags = info->feature_flags;
+
+	nrf_wifi_osal_mem_cpy(fw_cache->hash,
+			      info->hash,
+			      sizeof(fw_cache->hash));
+	nrf_wifi_osal_mem_cpy(&fw_cache->fw_info,
+			      fw_info,
+			      sizeof(fw_cache->fw_info));
+
+	fw_cache->valid = true;
+}
+
+
+static bool nrf_wifi_fmac_fw_info_equal(struct nrf_wifi_fmac_fw_info *a,
+					struct nrf_wifi_fmac_fw_info *b)
+{
+	return (a->lmac_patch_pri.data == b->lmac_patch_pri.data) &&
+	       (a->lmac_patch_pri.size == b->lmac_patch_pri.size) &&
+	       (a->lmac_patch_sec.data == b->lmac_patch_sec.data) &&
+	       (a->lmac_patch_sec.size == b->lmac_patch_sec.size) &&
+	       (a->umac_patch_pri.data == b->umac_patch_pri.data) &&
+	       (a->umac_patch_pri.size == b->umac_patch_pri.size) &&
+	       (a->umac_patch_sec.data == b->umac_patch_sec.data) &&
+	       (a->umac_patch_sec.size == b->umac_patch_sec.size);
+}
+
+
+/* Whether the patches to be loaded are the ones last loaded to the RPU */
+static bool nrf_wifi_fmac_fw_cache_loaded(struct nrf_wifi_fmac_fw_cache *fw_cache,
+					  struct nrf_wifi_fmac_fw_info *fmac_fw)
+{
+	return fw_cache->valid &&
+	       fw_cache->loaded &&
+	       nrf_wifi_fmac_fw_info_equal(&fw_cache->fw_info, fmac_fw) &&
+	       !nrf_wifi_osal_mem_cmp(fw_cache->loaded_hash,
+				      fw_cache->hash,
+				      sizeof(fw_cache->loaded_hash));
+}
+
+
 enum nrf_wifi_status nrf_wifi_fmac_fw_parse(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
 					   const void *fw_data,
 					   unsigned int fw_size,
 					   struct nrf_wifi_fmac_fw_info *fw_info)
 {
 	struct nrf70_fw_image_info *info = (struct nrf70_fw_image_info *)fw_data;
+	struct nrf_wifi_fmac_fw_cache *fw_cache = NULL;
 	unsigned int offset;
 	unsigned int image_id;
 
-	if (!fw_data || !fw_size || !fw_info) {
+	if (!fmac_dev_ctx || !fw_data || !fw_size || !fw_info) {
 		nrf_wifi_osal_log_err("Invalid parameters");
 		return NRF_WIFI_STATUS_FAIL;
 	}
@@ -173,6 +306,19 @@ enum nrf_wifi_status nrf_wifi_fmac_fw_parse(struct nrf_wifi_fmac_dev_ctx *fmac_d
 		return NRF_WIFI_STATUS_FAIL;
 	}
 
+	fw_cache = &fmac_dev_ctx->fpriv->fw_cache;
+
+	if (nrf_wifi_fmac_fw_cache_hit(fw_cache, fw_data, fw_size)) {
+		nrf_wifi_osal_log_dbg("Using cached fw image");
+		nrf_wifi_osal_mem_cpy(fw_info,
+				      &fw_cache->fw_info,
+				      sizeof(*fw_info));
+		fw_cache->stats.num_cache_hits++;
+		return NRF_WIFI_STATUS_SUCCESS;
+	}
+
+	fw_cache->valid = false;
+
 
 	if (nrf_wifi_validate_fw_header(fmac_dev_ctx, info) != NRF_WIFI_STATUS_SUCCESS) {
 		nrf_wifi_osal_log_err("Invalid fw header");
@@ -222,6 +368,9 @@ enum nrf_wifi_status nrf_wifi_fmac_fw_parse(struct nrf_wifi_fmac_dev_ctx *fmac_d
 		offset += sizeof(struct nrf70_fw_image) + image->len;
 	}
 
+	nrf_wifi_fmac_fw_cache_fill(fw_cache, fw_data, fw_size, fw_info);
+	fw_cache->stats.num_parses++;
+
 	return NRF_WIFI_STATUS_SUCCESS;
 }
 
@@ -289,8 +438,33 @@ enum nrf_wifi_status nrf_wifi_fmac_fw_load(struct nrf_wifi_fmac_dev_ctx *fmac_de
 					   struct nrf_wifi_fmac_fw_info *fmac_fw)
 {
 	enum nrf_wifi_status status = NRF_WIFI_STATUS_FAIL;
+	struct nrf_wifi_fmac_fw_cache *fw_cache = NULL;
+	struct nrf_wifi_hal_fw_patch_stats patch_stats;
+	unsigned long start_time_us = 0;
+	bool verify = false;
+
+	fw_cache = &fmac_dev_ctx->fpriv->fw_cache;
+
+	nrf_wifi_osal_mem_set(&patch_stats,
+			      0,
+			      sizeof(patch_stats));
+
+	start_time_us = nrf_wifi_osal_time_get_curr_us();
+
+	verify = fw_cache->verify && nrf_wifi_fmac_fw_cache_loaded(fw_cache, fmac_fw);
+
+	/* Only set again once the patches are known to be in the RPU */
+	fw_cache->loaded = false;
+
+	nrf_wifi_util_boot_phase_start(fmac_dev_ctx,
+				       NRF_WIFI_FMAC_BOOT_PHASE_FW_RESET);
 
 	status = nrf_wifi_fmac_fw_reset(fmac_dev_ctx);
+
+	nrf_wifi_util_boot_phase_end(fmac_dev_ctx,
+				     NRF_WIFI_FMAC_BOOT_PHASE_FW_RESET,
+				     status);
+
 	if (status != NRF_WIFI_STATUS_SUCCESS) {
 		nrf_wifi_osal_log_err("%s: FW reset failed\n",
 				      __func__);
@@ -300,12 +474,21 @@ enum nrf_wifi_status nrf_wifi_fmac_fw_load(struct nrf_wifi_fmac_dev_ctx *fmac_de
 	/* Load the UMAC patches if available */
 	if (fmac_fw->umac_patch_pri.data && fmac_fw->umac_patch_pri.size &&
 	    fmac_fw->umac_patch_sec.data && fmac_fw->umac_patch_sec.size) {
+		nrf_wifi_util_boot_phase_start(fmac_dev_ctx,
+					       NRF_WIFI_FMAC_BOOT_PHASE_UMAC_PATCH);
+
 		status = nrf_wifi_hal_fw_patch_load(fmac_dev_ctx->hal_dev_ctx,
 						    RPU_PROC_TYPE_MCU_UMAC,
 						    fmac_fw->umac_patch_pri.data,
 						    fmac_fw->umac_patch_pri.size,
 						    fmac_fw->umac_patch_sec.data,
-						    fmac_fw->umac_patch_sec.size);
+						    fmac_fw->umac_patch_sec.size,
+						    verify,
+						    &patch_stats);
+
+		nrf_wifi_util_boot_phase_end(fmac_dev_ctx,
+					     NRF_WIFI_FMAC_BOOT_PHASE_UMAC_PATCH,
+					     status);
 
 		if (status != NRF_WIFI_STATUS_SUCCESS) {
 			nrf_wifi_osal_log_err("%s: UMAC patch load failed\n",
@@ -322,12 +505,21 @@ enum nrf_wifi_status nrf_wifi_fmac_fw_load(struct nrf_wifi_fmac_dev_ctx *fmac_de
 	/* Load the LMAC patches if available */
 	if (fmac_fw->lmac_patch_pri.data && fmac_fw->lmac_patch_pri.size &&
 	    fmac_fw->lmac_patch_sec.data && fmac_fw->lmac_patch_sec.size) {
+		nrf_wifi_util_boot_phase_start(fmac_dev_ctx,
+					       NRF_WIFI_FMAC_BOOT_PHASE_LMAC_PATCH);
+
 		status = nrf_wifi_hal_fw_patch_load(fmac_dev_ctx->hal_dev_ctx,
 						    RPU_PROC_TYPE_MCU_LMAC,
 						    fmac_fw->lmac_patch_pri.data,
 						    fmac_fw->lmac_patch_pri.size,
 						    fmac_fw->lmac_patch_sec.data,
-						    fmac_fw->lmac_patch_sec.size);
+						    fmac_fw->lmac_patch_sec.size,
+						    verify,
+						    &patch_stats);
+
+		nrf_wifi_util_boot_phase_end(fmac_dev_ctx,
+					     NRF_WIFI_FMAC_BOOT_PHASE_LMAC_PATCH,
+					     status);
 
 		if (status != NRF_WIFI_STATUS_SUCCESS) {
 			nrf_wifi_osal_log_err("%s: LMAC patch load failed\n",
@@ -341,7 +533,15 @@ enum nrf_wifi_status nrf_wifi_fmac_fw_load(struct nrf_wifi_fmac_dev_ctx *fmac_de
 		wifi_proc[0].is_patch_present = false;
 	}
 
+	nrf_wifi_util_boot_phase_start(fmac_dev_ctx,
+				       NRF_WIFI_FMAC_BOOT_PHASE_FW_BOOT);
+
 	status = nrf_wifi_fmac_fw_boot(fmac_dev_ctx);
+
+	nrf_wifi_util_boot_phase_end(fmac_dev_ctx,
+				     NRF_WIFI_FMAC_BOOT_PHASE_FW_BOOT,
+				     status);
+
 	if (status != NRF_WIFI_STATUS_SUCCESS) {
 		nrf_wifi_osal_log_err("%s: FW boot failed\n",
 				      __func__);
@@ -350,6 +550,98 @@ enum nrf_wifi_status nrf_wifi_fmac_fw_load(struct nrf_wifi_fmac_dev_ctx *fmac_de
 
 	fmac_dev_ctx->fw_boot_done = true;
 
+	if (fw_cache->valid &&
+	    nrf_wifi_fmac_fw_info_equal(&fw_cache->fw_info, fmac_fw)) {
+		nrf_wifi_osal_mem_cpy(fw_cache->loaded_hash,
+				      fw_cache->hash,
+				      sizeof(fw_cache->loaded_hash));
+		fw_cache->loaded = true;
+	}
+out:
+	fw_cache->stats.num_loads++;
+	fw_cache->stats.last_load_us = nrf_wifi_osal_time_elapsed_us(start_time_us);
+	fw_cache->stats.last_bytes_written = patch_stats.bytes_written;
+	fw_cache->stats.last_bytes_verified = patch_stats.bytes_verified;
+	fw_cache->stats.last_bytes_skipped = patch_stats.bytes_skipped;
+
+	nrf_wifi_osal_log_dbg("%s: FW load took %d us, %d bytes written, %d verified, %d skipped",
+			      __func__,
+			      fw_cache->stats.last_load_us,
+			      patch_stats.bytes_written,
+			      patch_stats.bytes_verified,
+			      patch_stats.bytes_skipped);
+
+	return status;
+}
+
+
+enum nrf_wifi_status nrf_wifi_fmac_fw_cache_verify_set(struct nrf_wifi_fmac_priv *fpriv,
+						       bool enable)
+{
+	enum nrf_wifi_status status = NRF_WIFI_STATUS_FAIL;
+
+	if (!fpriv) {
+		nrf_wifi_osal_log_err("%s: Invalid parameters",
+				      __func__);
+		goto out;
+	}
+
+	fpriv->fw_cache.verify = enable;
+
+	status = NRF_WIFI_STATUS_SUCCESS;
+out:
+	return status;
+}
+
+
+void nrf_wifi_fmac_fw_cache_invalidate(struct nrf_wifi_fmac_priv *fpriv)
+{
+	if (!fpriv) {
+		return;
+	}
+
+	fpriv->fw_cache.valid = false;
+	fpriv->fw_cache.loaded = false;
+}
+
+
+enum nrf_wifi_status nrf_wifi_fmac_fw_cache_stats_get(struct nrf_wifi_fmac_priv *fpriv,
+						      struct nrf_wifi_fmac_fw_cache_stats *stats)
+{
+	enum nrf_wifi_status status = NRF_WIFI_STATUS_FAIL;
+
+	if (!fpriv || !stats) {
+		nrf_wifi_osal_log_err("%s: Invalid parameters",
+				      __func__);
+		goto out;
+	}
+
+	nrf_wifi_osal_mem_cpy(stats,
+			      &fpriv->fw_cache.stats,
+			      sizeof(*stats));
+
+	status = NRF_WIFI_STATUS_SUCCESS;
+out:
+	return status;
+}
+
+
+enum nrf_wifi_status nrf_wifi_fmac_boot_timeline_get(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+						     struct nrf_wifi_fmac_boot_timeline *timeline)
+{
+	enum nrf_wifi_status status = NRF_WIFI_STATUS_FAIL;
+
+	if (!fmac_dev_ctx || !timeline) {
+		nrf_wifi_osal_log_err("%s: Invalid parameters",
+				      __func__);
+		goto out;
+	}
+
+	nrf_wifi_osal_mem_cpy(timeline,
+			      &fmac_dev_ctx->boot_timeline,
+			      sizeof(*timeline));
+
+	status = NRF_WIFI_STATUS_SUCCESS;
 out:
 	return status;
 }
@@ -446,7 +738,6 @@ enum nrf_wifi_status nrf_wifi_fmac_get_reg(struct nrf_wifi_fmac_dev_ctx *fmac_de
 {
 	enum nrf_wifi_status status = NRF_WIFI_STATUS_FAIL;
 	struct nrf_wifi_umac_cmd_get_reg *get_reg_cmd = NULL;
-	unsigned int count = 0;
 
 	if (!fmac_dev_ctx || !reg_info) {
 		nrf_wifi_osal_log_err("%s: Invalid parameters",
@@ -469,6 +760,7 @@ enum nrf_wifi_status nrf_wifi_fmac_get_reg(struct nrf_wifi_fmac_dev_ctx *fmac_de
 
 	fmac_dev_ctx->alpha2_valid = false;
 	fmac_dev_ctx->reg_chan_info = reg_info->reg_chan_info;
+	nrf_wifi_osal_completion_init(fmac_dev_ctx->reg_get_comp);
 
 	status = umac_cmd_cfg(fmac_dev_ctx,
 			      get_reg_cmd,
@@ -479,9 +771,8 @@ enum nrf_wifi_status nrf_wifi_fmac_get_reg(struct nrf_wifi_fmac_dev_ctx *fmac_de
 		goto err;
 	}
 
-	do {
-		nrf_wifi_osal_sleep_ms(100);
-	} while (count++ < 100 && !fmac_dev_ctx->alpha2_valid);
+	nrf_wifi_osal_completion_wait(fmac_dev_ctx->reg_get_comp,
+				      NRF_WIFI_FMAC_REG_GET_TIMEOUT_MS);
 
 	if (!fmac_dev_ctx->alpha2_valid) {
 		nrf_wifi_osal_log_err("%s: Failed to get regulatory information",
@@ -506,21 +797,27 @@ err:
 enum nrf_wifi_status nrf_wifi_fmac_stats_reset(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx)
 {
 	enum nrf_wifi_status status = NRF_WIFI_STATUS_FAIL;
-	unsigned char count = 0;
 
 	status = umac_cmd_prog_stats_reset(fmac_dev_ctx);
 	if (status != NRF_WIFI_STATUS_SUCCESS) {
 		goto out;
 	}
 
-	do {
-		nrf_wifi_osal_sleep_ms(1);
-	} while ((fmac_dev_ctx->stats_req == true) &&
-		 (count++ < NRF_WIFI_FMAC_STATS_RECV_TIMEOUT));
+	/* The reset is not acked, only wait for an outstanding stats reply */
+	if (fmac_dev_ctx->stats_req == true) {
+		status = nrf_wifi_osal_completion_wait(fmac_dev_ctx->stats_comp,
+						       NRF_WIFI_FMAC_STATS_RECV_TIMEOUT);
 
-	if (count == NRF_WIFI_FMAC_STATS_RECV_TIMEOUT) {
+		if (status == NRF_WIFI_STATUS_SUCCESS) {
+			/* Pass the signal on to the requester of the stats */
+			nrf_wifi_osal_completion_complete(fmac_dev_ctx->stats_comp);
+		}
+	}
+
+	if (fmac_dev_ctx->stats_req == true) {
 		nrf_wifi_osal_log_err("%s: Timed out",
 				      __func__);
+		status = NRF_WIFI_STATUS_FAIL;
 		goto out;
 	}
 
@@ -546,7 +843,6 @@ enum nrf_wifi_status nrf_wifi_fmac_set_reg(struct nrf_wifi_fmac_dev_ctx *fmac_de
 {
 	enum nrf_wifi_status status = NRF_WIFI_STATUS_FAIL;
 	struct nrf_wifi_cmd_req_set_reg *set_reg_cmd = NULL;
-	unsigned int count = 0, max_count = NRF_WIFI_FMAC_REG_SET_TIMEOUT_MS / 20;
 	enum nrf_wifi_reg_initiator exp_initiator = NRF_WIFI_REGDOM_SET_BY_USER;
 	enum nrf_wifi_reg_type exp_reg_type = NRF_WIFI_REGDOM_TYPE_COUNTRY;
 	char exp_alpha2[NRF_WIFI_COUNTRY_CODE_LEN] = {0};
@@ -613,6 +909,7 @@ enum nrf_wifi_status nrf_wifi_fmac_set_reg(struct nrf_wifi_fmac_dev_ctx *fmac_de
 
 	fmac_dev_ctx->reg_set_status = false;
 	fmac_dev_ctx->waiting_for_reg_event = true;
+	nrf_wifi_osal_completion_init(fmac_dev_ctx->reg_set_comp);
 
 	status = umac_cmd_cfg(fmac_dev_ctx,
 			      set_reg_cmd,
@@ -623,11 +920,9 @@ enum nrf_wifi_status nrf_wifi_fmac_set_reg(struct nrf_wifi_fmac_dev_ctx *fmac_de
 		goto out;
 	}
 
-	fmac_dev_ctx->reg_set_status = false;
 	nrf_wifi_osal_log_dbg("%s: Waiting for regulatory domain change event", __func__);
-	while (!fmac_dev_ctx->reg_set_status && count++ <= max_count) {
-		nrf_wifi_osal_sleep_ms(100);
-	}
+	nrf_wifi_osal_completion_wait(fmac_dev_ctx->reg_set_comp,
+				      NRF_WIFI_FMAC_REG_SET_TIMEOUT_MS);
 
 	if (!fmac_dev_ctx->reg_set_status) {
 		nrf_wifi_osal_log_err("%s: Failed to set regulatory information",
@@ -683,4 +978,269 @@ out:
 	}
 
 	return status;
-}
\ No newline at end of file
+}
+
+struct nrf_wifi_fmac_mem_stat_idx {
+	unsigned int addr;
+	unsigned int idx;
+};
+
+
+static void nrf_wifi_fmac_mem_stats_sort(struct nrf_wifi_fmac_mem_stat_idx *order,
+					 unsigned int num)
+{
+	struct nrf_wifi_fmac_mem_stat_idx tmp;
+	unsigned int i = 0;
+	unsigned int j = 0;
+
+	/* The tables are small and mostly sorted already */
+	for (i = 1; i < num; i++) {
+		tmp = order[i];
+		j = i;
+
+		while ((j > 0) && (order[j - 1].addr > tmp.addr)) {
+			order[j] = order[j - 1];
+			j--;
+		}
+
+		order[j] = tmp;
+	}
+}
+
+
+static enum nrf_wifi_status nrf_wifi_fmac_mem_stats_block_read(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+							       struct nrf_wifi_fmac_mem_stat_idx *order,
+							       unsigned int num,
+							       unsigned char *buf,
+							       struct nrf_wifi_fmac_mem_stat *stats)
+{
+	enum nrf_wifi_status status = NRF_WIFI_STATUS_FAIL;
+	unsigned int start_addr = 0;
+	unsigned int len = 0;
+	unsigned int i = 0;
+
+	start_addr = order[0].addr;
+	len = order[num - 1].addr + sizeof(unsigned int) - start_addr;
+
+#ifdef NRF_WIFI_LOW_POWER
+	nrf_wifi_hal_ps_wake_cause_set(fmac_dev_ctx->hal_dev_ctx,
+				       NRF_WIFI_HAL_PS_WAKE_CAUSE_STATS);
+#endif /* NRF_WIFI_LOW_POWER */
+	status = hal_rpu_mem_read(fmac_dev_ctx->hal_dev_ctx,
+				  buf,
+				  start_addr,
+				  len);
+
+	if (status != NRF_WIFI_STATUS_SUCCESS) {
+		nrf_wifi_osal_log_err("%s: Unable to read 0x%x (%d bytes)",
+				      __func__,
+				      start_addr,
+				      len);
+		goto out;
+	}
+
+	for (i = 0; i < num; i++) {
+		nrf_wifi_osal_mem_cpy(&stats[order[i].idx].value,
+				      buf + (order[i].addr - start_addr),
+				      sizeof(stats[order[i].idx].value));
+	}
+out:
+	return status;
+}
+
+
+enum nrf_wifi_status nrf_wifi_fmac_mem_stats_get(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+						 const struct rpu_stat_global *groups,
+						 struct nrf_wifi_fmac_mem_stat *stats,
+						 unsigned int max_stats,
+						 unsigned int *num_stats)
+{
+	enum nrf_wifi_status status = NRF_WIFI_STATUS_FAIL;
+	struct nrf_wifi_fmac_mem_stat_idx *order = NULL;
+	const struct rpu_stat_global *group = NULL;
+	const struct rpu_stat_from_mem *stat = NULL;
+	unsigned char *buf = NULL;
+	unsigned int num = 0;
+	unsigned int block_start = 0;
+	unsigned int num_reads = 0;
+	unsigned int i = 0;
+
+	if (!fmac_dev_ctx || !groups || !stats || !num_stats) {
+		nrf_wifi_osal_log_err("%s: Invalid parameters",
+				      __func__);
+		goto out;
+	}
+
+	*num_stats = 0;
+
+	for (group = groups; group->stats; group++) {
+		for (stat = group->stats; stat->name[0] != '\0'; stat++) {
+			if (stat->addr & (sizeof(unsigned int) - 1)) {
+				nrf_wifi_osal_log_err("%s: Unaligned address 0x%x for %s",
+						      __func__,
+						      stat->addr,
+						      stat->name);
+				goto out;
+			}
+
+			num++;
+		}
+	}
+
+	if (num > max_stats) {
+		nrf_wifi_osal_log_err("%s: Not enough space for %d stats",
+				      __func__,
+				      num);
+		goto out;
+	}
+
+	if (!num) {
+		status = NRF_WIFI_STATUS_SUCCESS;
+		goto out;
+	}
+
+	order = nrf_wifi_osal_mem_zalloc(num * sizeof(*order));
+
+	if (!order) {
+		nrf_wifi_osal_log_err("%s: Unable to allocate memory",
+				      __func__);
+		goto out;
+	}
+
+	buf = nrf_wifi_osal_mem_zalloc(NRF_WIFI_FMAC_MEM_STATS_MAX_BLOCK_LEN);
+
+	if (!buf) {
+		nrf_wifi_osal_log_err("%s: Unable to allocate memory",
+				      __func__);
+		goto out;
+	}
+
+	num = 0;
+
+	for (group = groups; group->stats; group++) {
+		for (stat = group->stats; stat->name[0] != '\0'; stat++) {
+			stats[num].group = group->name;
+			stats[num].name = stat->name;
+			stats[num].value = 0;
+			order[num].addr = stat->addr;
+			order[num].idx = num;
+			num++;
+		}
+	}
+
+	nrf_wifi_fmac_mem_stats_sort(order, num);
+
+	/* Merge neighbouring counters into as few RPU memory reads as possible */
+	for (i = 1; i <= num; i++) {
+		if ((i < num) &&
+		    (order[i].addr - order[i - 1].addr <= NRF_WIFI_FMAC_MEM_STATS_MAX_GAP) &&
+		    (order[i].addr + sizeof(unsigned int) - order[block_start].addr <=
+		     NRF_WIFI_FMAC_MEM_STATS_MAX_BLOCK_LEN)) {
+			continue;
+		}
+
+		status = nrf_wifi_fmac_mem_stats_block_read(fmac_dev_ctx,
+							    &order[block_start],
+							    i - block_start,
+							    buf,
+							    stats);
+
+		if (status != NRF_WIFI_STATUS_SUCCESS) {
+			goto out;
+		}
+
+		num_reads++;
+		block_start = i;
+	}
+
+	nrf_wifi_osal_log_dbg("%s: Read %d stats using %d reads",
+			      __func__,
+			      num,
+			      num_reads);
+
+	*num_stats = num;
+out:
+	if (buf) {
+		nrf_wifi_osal_mem_free(buf);
+	}
+
+	if (order) {
+		nrf_wifi_osal_mem_free(order);
+	}
+
+	return status;
+}
+
+
+#ifdef NRF_WIFI_LOW_POWER
+enum nrf_wifi_status nrf_wifi_fmac_rpu_ps_stats_get(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+						    struct nrf_wifi_hal_ps_stats *ps_stats)
+{
+	enum nrf_wifi_status status = NRF_WIFI_STATUS_FAIL;
+
+	if (!fmac_dev_ctx || !ps_stats) {
+		nrf_wifi_osal_log_err("%s: Invalid parameters",
+				      __func__);
+		goto out;
+	}
+
+	status = nrf_wifi_hal_ps_stats_get(fmac_dev_ctx->hal_dev_ctx,
+					   ps_stats);
+out:
+	return status;
+}
+
+
+enum nrf_wifi_status nrf_wifi_fmac_rpu_ps_stats_reset(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx)
+{
+	enum nrf_wifi_status status = NRF_WIFI_STATUS_FAIL;
+
+	if (!fmac_dev_ctx) {
+		nrf_wifi_osal_log_err("%s: Invalid parameters",
+				      __func__);
+		goto out;
+	}
+
+	status = nrf_wifi_hal_ps_stats_reset(fmac_dev_ctx->hal_dev_ctx);
+out:
+	return status;
+}
+
+
+enum nrf_wifi_status nrf_wifi_fmac_rpu_ps_idle_timeout_bounds_set(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+								  unsigned int min_ms,
+								  unsigned int max_ms)
+{
+	enum nrf_wifi_status status = NRF_WIFI_STATUS_FAIL;
+
+	if (!fmac_dev_ctx) {
+		nrf_wifi_osal_log_err("%s: Invalid parameters",
+				      __func__);
+		goto out;
+	}
+
+	status = nrf_wifi_hal_ps_idle_timeout_bounds_set(fmac_dev_ctx->hal_dev_ctx,
+							 min_ms,
+							 max_ms);
+out:
+	return status;
+}
+
+
+enum nrf_wifi_status nrf_wifi_fmac_rpu_ps_idle_timeout_override(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+								unsigned int timeout_ms)
+{
+	enum nrf_wifi_status status = NRF_WIFI_STATUS_FAIL;
+
+	if (!fmac_dev_ctx) {
+		nrf_wifi_osal_log_err("%s: Invalid parameters",
+				      __func__);
+		goto out;
+	}
+
+	status = nrf_wifi_hal_ps_idle_timeout_override(fmac_dev_ctx->hal_dev_ctx,
+						       timeout_ms);
+out:
+	return status;
+}
+#endif /* NRF_WIFI_LOW_POWER */
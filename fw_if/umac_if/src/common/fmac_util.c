@@ -86,6 +86,140 @@ bool nrf_wifi_util_is_arr_zero(unsigned char *arr,
 	return true;
 }
 
+static int nrf_wifi_util_ie_lookup(const unsigned char *ie)
+{
+	unsigned int oui = 0;
+
+	switch (ie[0]) {
+	case NRF_WIFI_FMAC_EID_SSID:
+		return NRF_WIFI_FMAC_IE_SSID;
+	case NRF_WIFI_FMAC_EID_SUPP_RATES:
+		return NRF_WIFI_FMAC_IE_SUPP_RATES;
+	case NRF_WIFI_FMAC_EID_DS_PARAMS:
+		return NRF_WIFI_FMAC_IE_DS_PARAMS;
+	case NRF_WIFI_FMAC_EID_TIM:
+		return NRF_WIFI_FMAC_IE_TIM;
+	case NRF_WIFI_FMAC_EID_COUNTRY:
+		return NRF_WIFI_FMAC_IE_COUNTRY;
+	case NRF_WIFI_FMAC_EID_HT_CAP:
+		return NRF_WIFI_FMAC_IE_HT_CAP;
+	case NRF_WIFI_FMAC_EID_RSN:
+		return NRF_WIFI_FMAC_IE_RSN;
+	case NRF_WIFI_FMAC_EID_EXT_SUPP_RATES:
+		return NRF_WIFI_FMAC_IE_EXT_SUPP_RATES;
+	case NRF_WIFI_FMAC_EID_HT_OPER:
+		return NRF_WIFI_FMAC_IE_HT_OPER;
+	case NRF_WIFI_FMAC_EID_EXT_CAP:
+		return NRF_WIFI_FMAC_IE_EXT_CAP;
+	case NRF_WIFI_FMAC_EID_VHT_CAP:
+		return NRF_WIFI_FMAC_IE_VHT_CAP;
+	case NRF_WIFI_FMAC_EID_VHT_OPER:
+		return NRF_WIFI_FMAC_IE_VHT_OPER;
+	case NRF_WIFI_FMAC_EID_VENDOR:
+		/* OUI (3 bytes) and OUI type */
+		if (ie[1] < 4) {
+			break;
+		}
+
+		oui = (ie[2] << 16) | (ie[3] << 8) | ie[4];
+
+		if (oui != NRF_WIFI_FMAC_VENDOR_OUI_MICROSOFT) {
+			break;
+		}
+
+		if (ie[5] == NRF_WIFI_FMAC_VENDOR_TYPE_WPA) {
+			return NRF_WIFI_FMAC_IE_WPA;
+		} else if (ie[5] == NRF_WIFI_FMAC_VENDOR_TYPE_WMM) {
+			return NRF_WIFI_FMAC_IE_WMM;
+		}
+		break;
+	case NRF_WIFI_FMAC_EID_EXTENSION:
+		if (ie[1] < 1) {
+			break;
+		}
+
+		if (ie[2] == NRF_WIFI_FMAC_EID_EXT_HE_CAP) {
+			return NRF_WIFI_FMAC_IE_HE_CAP;
+		} else if (ie[2] == NRF_WIFI_FMAC_EID_EXT_HE_OPER) {
+			return NRF_WIFI_FMAC_IE_HE_OPER;
+		}
+		break;
+	default:
+		break;
+	}
+
+	return -1;
+}
+
+bool nrf_wifi_util_ie_index(const unsigned char *ies,
+			    unsigned int ies_len,
+			    struct nrf_wifi_fmac_ie_index *ie_index)
+{
+	unsigned int pos = 0;
+	int idx = 0;
+
+	for (idx = 0; idx < NRF_WIFI_FMAC_IE_MAX; idx++) {
+		ie_index->offset[idx] = NRF_WIFI_FMAC_IE_NOT_PRESENT;
+		ie_index->len[idx] = 0;
+	}
+
+	ie_index->malformed = false;
+
+	/* Offsets are 16 bit, anything beyond cannot be indexed */
+	if (ies_len >= NRF_WIFI_FMAC_IE_NOT_PRESENT) {
+		ies_len = NRF_WIFI_FMAC_IE_NOT_PRESENT - 1;
+		ie_index->malformed = true;
+	}
+
+	ie_index->ies_len = ies_len;
+
+	if (!ies) {
+		ie_index->ies_len = 0;
+		return !ies_len;
+	}
+
+	/* Single pass, every element header and body must lie within ies_len */
+	while (pos < ies_len) {
+		if ((ies_len - pos < 2) ||
+		    (ies_len - pos - 2 < ies[pos + 1])) {
+			ie_index->malformed = true;
+			break;
+		}
+
+		idx = nrf_wifi_util_ie_lookup(&ies[pos]);
+
+		if ((idx >= 0) &&
+		    (ie_index->offset[idx] == NRF_WIFI_FMAC_IE_NOT_PRESENT)) {
+			ie_index->offset[idx] = pos;
+			ie_index->len[idx] = ies[pos + 1];
+		}
+
+		pos += 2 + ies[pos + 1];
+	}
+
+	return !ie_index->malformed;
+}
+
+bool nrf_wifi_util_bcn_prb_rsp_ie_index(const unsigned char *frm,
+					unsigned int frm_len,
+					struct nrf_wifi_fmac_ie_index *ie_index)
+{
+	ie_index->ies_offset = NRF_WIFI_FMAC_BCN_PRB_RSP_FIXED_LEN;
+
+	if (!frm || (frm_len < NRF_WIFI_FMAC_BCN_PRB_RSP_FIXED_LEN)) {
+		nrf_wifi_util_ie_index(NULL,
+				       0,
+				       ie_index);
+		ie_index->ies_offset = 0;
+		ie_index->malformed = true;
+		return false;
+	}
+
+	return nrf_wifi_util_ie_index(frm + NRF_WIFI_FMAC_BCN_PRB_RSP_FIXED_LEN,
+				      frm_len - NRF_WIFI_FMAC_BCN_PRB_RSP_FIXED_LEN,
+				      ie_index);
+}
+
 void *wifi_fmac_priv(struct nrf_wifi_fmac_priv *def)
 {
 	return &def->priv;
@@ -95,3 +229,66 @@ void *wifi_dev_priv(struct nrf_wifi_fmac_dev_ctx *def)
 {
 	return &def->priv;
 }
+
+
+void nrf_wifi_util_boot_phase_start(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+				    enum nrf_wifi_fmac_boot_phase phase)
+{
+	struct nrf_wifi_fmac_boot_phase_info *info = NULL;
+	struct nrf_wifi_hal_bus_stats bus_stats;
+
+	if (!fmac_dev_ctx || phase >= NRF_WIFI_FMAC_BOOT_PHASE_MAX) {
+		return;
+	}
+
+	info = &fmac_dev_ctx->boot_timeline.phases[phase];
+
+	nrf_wifi_osal_mem_set(info,
+			      0,
+			      sizeof(*info));
+
+	nrf_wifi_osal_mem_set(&bus_stats,
+			      0,
+			      sizeof(bus_stats));
+
+	if (fmac_dev_ctx->hal_dev_ctx) {
+		nrf_wifi_hal_bus_stats_get(fmac_dev_ctx->hal_dev_ctx,
+					   &bus_stats);
+	}
+
+	/* Snapshot the bus counters, converted to deltas when the phase ends */
+	info->bytes_read = (unsigned int)bus_stats.bytes_read;
+	info->bytes_written = (unsigned int)bus_stats.bytes_written;
+	info->num_polls = bus_stats.num_polls;
+	info->start_us = nrf_wifi_osal_time_get_curr_us();
+}
+
+
+void nrf_wifi_util_boot_phase_end(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+				  enum nrf_wifi_fmac_boot_phase phase,
+				  enum nrf_wifi_status status)
+{
+	struct nrf_wifi_fmac_boot_phase_info *info = NULL;
+	struct nrf_wifi_hal_bus_stats bus_stats;
+
+	if (!fmac_dev_ctx || phase >= NRF_WIFI_FMAC_BOOT_PHASE_MAX) {
+		return;
+	}
+
+	info = &fmac_dev_ctx->boot_timeline.phases[phase];
+
+	nrf_wifi_osal_mem_set(&bus_stats,
+			      0,
+			      sizeof(bus_stats));
+
+	if (fmac_dev_ctx->hal_dev_ctx) {
+		nrf_wifi_hal_bus_stats_get(fmac_dev_ctx->hal_dev_ctx,
+					   &bus_stats);
+	}
+
+	info->end_us = nrf_wifi_osal_time_get_curr_us();
+	info->bytes_read = (unsigned int)bus_stats.bytes_read - info->bytes_read;
+	info->bytes_written = (unsigned int)bus_stats.bytes_written - info->bytes_written;
+	info->num_polls = bus_stats.num_polls - info->num_polls;
+	info->done = (status == NRF_WIFI_STATUS_SUCCESS);
+}
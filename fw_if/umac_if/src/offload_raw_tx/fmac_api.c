@@ -17,6 +17,7 @@
 #include "offload_raw_tx/fmac_event.h"
 #include "offload_raw_tx/fmac_structs.h"
 #include "common/fmac_util.h"
+#include "common/hal_mem.h"
 #include <stdio.h>
 
 static enum nrf_wifi_status nrf_wifi_fmac_off_raw_tx_fw_init(
@@ -33,7 +34,6 @@ static enum nrf_wifi_status nrf_wifi_fmac_off_raw_tx_fw_init(
 		struct nrf_wifi_board_params *board_params,
 		unsigned char *country_code)
 {
-	unsigned long start_time_us = 0;
 	enum nrf_wifi_status status = NRF_WIFI_STATUS_FAIL;
 
 	if (!fmac_dev_ctx) {
@@ -42,6 +42,8 @@ static enum nrf_wifi_status nrf_wifi_fmac_off_raw_tx_fw_init(
 		goto out;
 	}
 
+	nrf_wifi_osal_completion_init(fmac_dev_ctx->fw_init_comp);
+
 	status = umac_cmd_off_raw_tx_init(fmac_dev_ctx,
 					  rf_params,
 					  rf_params_valid,
@@ -61,14 +63,9 @@ static enum nrf_wifi_status nrf_wifi_fmac_off_raw_tx_fw_init(
 		goto out;
 	}
 
-	start_time_us = nrf_wifi_osal_time_get_curr_us();
-	while (!fmac_dev_ctx->fw_init_done) {
-		nrf_wifi_osal_sleep_ms(1);
-#define MAX_INIT_WAIT (5 * 1000 * 1000)
-		if (nrf_wifi_osal_time_elapsed_us(start_time_us) >= MAX_INIT_WAIT) {
-			break;
-		}
-	}
+#define MAX_INIT_WAIT_MS (5 * 1000)
+	nrf_wifi_osal_completion_wait(fmac_dev_ctx->fw_init_comp,
+				      MAX_INIT_WAIT_MS);
 
 	if (!fmac_dev_ctx->fw_init_done) {
 		nrf_wifi_osal_log_err("%s: UMAC init timed out",
@@ -146,6 +143,16 @@ struct nrf_wifi_fmac_dev_ctx *nrf_wifi_off_raw_tx_fmac_dev_add(struct nrf_wifi_f
 	fmac_dev_ctx->fpriv = fpriv;
 	fmac_dev_ctx->os_dev_ctx = os_dev_ctx;
 
+	off_raw_tx_fmac_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
+	off_raw_tx_fmac_dev_ctx->cur_sched = NRF_WIFI_OFF_RAW_TX_SCHED_INVALID;
+	off_raw_tx_fmac_dev_ctx->sched_cmd_id = NRF_WIFI_OFF_RAW_TX_SCHED_INVALID;
+
+	if (nrf_wifi_fmac_dev_comps_alloc(fmac_dev_ctx) != NRF_WIFI_STATUS_SUCCESS) {
+		nrf_wifi_osal_mem_free(fmac_dev_ctx);
+		fmac_dev_ctx = NULL;
+		goto out;
+	}
+
 	fmac_dev_ctx->hal_dev_ctx = nrf_wifi_off_raw_tx_hal_dev_add(fpriv->hpriv,
 								    fmac_dev_ctx);
 
@@ -153,6 +160,7 @@ struct nrf_wifi_fmac_dev_ctx *nrf_wifi_off_raw_tx_fmac_dev_add(struct nrf_wifi_f
 		nrf_wifi_osal_log_err("%s: nrf_wifi_off_raw_tx_hal_dev_add failed",
 				      __func__);
 
+		nrf_wifi_fmac_dev_comps_free(fmac_dev_ctx);
 		nrf_wifi_osal_mem_free(fmac_dev_ctx);
 		fmac_dev_ctx = NULL;
 		goto out;
@@ -257,7 +265,7 @@ enum nrf_wifi_status nrf_wifi_off_raw_tx_fmac_conf(struct nrf_wifi_fmac_dev_ctx
 	enum nrf_wifi_status status = NRF_WIFI_STATUS_FAIL;
 	struct nrf_wifi_off_raw_tx_fmac_dev_ctx *dev_ctx_off_raw_tx;
 	struct nrf_wifi_fmac_reg_info reg_domain_info = {0};
-	unsigned char count = 0;
+	bool sched_tx_started = false;
 
 	if (!fmac_dev_ctx) {
 		nrf_wifi_osal_log_err("%s: Invalid device context",
@@ -272,6 +280,17 @@ enum nrf_wifi_status nrf_wifi_off_raw_tx_fmac_conf(struct nrf_wifi_fmac_dev_ctx
 	}
 
 	dev_ctx_off_raw_tx = wifi_dev_priv(fmac_dev_ctx);
+
+	nrf_wifi_osal_spinlock_take(fmac_dev_ctx->mode_lock);
+	sched_tx_started = dev_ctx_off_raw_tx->sched_tx_started;
+	nrf_wifi_osal_spinlock_rel(fmac_dev_ctx->mode_lock);
+
+	if (sched_tx_started) {
+		nrf_wifi_osal_log_err("%s: Offloaded raw tx is driven by schedules",
+				      __func__);
+		goto out;
+	}
+
 	dev_ctx_off_raw_tx->off_raw_tx_cmd_done = true;
 
 	if (!off_ctrl_params || !off_tx_params) {
@@ -280,6 +299,8 @@ enum nrf_wifi_status nrf_wifi_off_raw_tx_fmac_conf(struct nrf_wifi_fmac_dev_ctx
 		goto out;
 	}
 
+	nrf_wifi_osal_completion_init(fmac_dev_ctx->cmd_comp);
+
 	status = umac_cmd_off_raw_tx_conf(fmac_dev_ctx,
 					  off_ctrl_params,
 					  off_tx_params);
@@ -289,13 +310,10 @@ enum nrf_wifi_status nrf_wifi_off_raw_tx_fmac_conf(struct nrf_wifi_fmac_dev_ctx
 		goto out;
 	}
 
-	do {
-		nrf_wifi_osal_sleep_ms(1);
-		count++;
-	} while ((dev_ctx_off_raw_tx->off_raw_tx_cmd_done == true) &&
-		 (count < NRF_WIFI_FMAC_PARAMS_RECV_TIMEOUT));
+	status = nrf_wifi_osal_completion_wait(fmac_dev_ctx->cmd_comp,
+					       NRF_WIFI_FMAC_PARAMS_RECV_TIMEOUT);
 
-	if (count == NRF_WIFI_FMAC_PARAMS_RECV_TIMEOUT) {
+	if (status != NRF_WIFI_STATUS_SUCCESS) {
 		nrf_wifi_osal_log_err("%s: Timed out",
 				      __func__);
 		goto out;
@@ -350,6 +368,7 @@ out:
 enum nrf_wifi_status nrf_wifi_off_raw_tx_fmac_stop(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx)
 {
 	enum nrf_wifi_status status = NRF_WIFI_STATUS_FAIL;
+	struct nrf_wifi_off_raw_tx_fmac_dev_ctx *dev_ctx_off_raw_tx;
 
 	if (!fmac_dev_ctx) {
 		nrf_wifi_osal_log_err("%s: Invalid device context",
@@ -369,6 +388,514 @@ enum nrf_wifi_status nrf_wifi_off_raw_tx_fmac_stop(struct nrf_wifi_fmac_dev_ctx
 		nrf_wifi_osal_log_err("%s: umac_cmd_offload_raw_tx_ctrl failed", __func__);
 		goto out;
 	}
+
+	/* The next schedule run has to start the transmission again */
+	dev_ctx_off_raw_tx = wifi_dev_priv(fmac_dev_ctx);
+	nrf_wifi_osal_spinlock_take(fmac_dev_ctx->mode_lock);
+	dev_ctx_off_raw_tx->sched_tx_started = false;
+	dev_ctx_off_raw_tx->cur_sched = NRF_WIFI_OFF_RAW_TX_SCHED_INVALID;
+	nrf_wifi_osal_spinlock_rel(fmac_dev_ctx->mode_lock);
+out:
+	return status;
+}
+
+
+enum nrf_wifi_status nrf_wifi_off_raw_tx_fmac_callbk_set(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+							 struct nrf_wifi_off_raw_tx_fmac_callbk_fns *callbk_fns)
+{
+	enum nrf_wifi_status status = NRF_WIFI_STATUS_FAIL;
+	struct nrf_wifi_off_raw_tx_fmac_dev_ctx *dev_ctx_off_raw_tx;
+
+	if (!fmac_dev_ctx || !callbk_fns) {
+		nrf_wifi_osal_log_err("%s: Invalid parameters",
+				      __func__);
+		goto out;
+	}
+
+	if (fmac_dev_ctx->op_mode != NRF_WIFI_OP_MODE_OFF_RAW_TX) {
+		nrf_wifi_osal_log_err("%s: Invalid op mode",
+				      __func__);
+		goto out;
+	}
+
+	dev_ctx_off_raw_tx = wifi_dev_priv(fmac_dev_ctx);
+
+	nrf_wifi_osal_mem_cpy(&dev_ctx_off_raw_tx->callbk_fns,
+			      callbk_fns,
+			      sizeof(*callbk_fns));
+
+	status = NRF_WIFI_STATUS_SUCCESS;
+out:
+	return status;
+}
+
+
+static unsigned int off_raw_tx_sched_buf_addr(unsigned char sched_id,
+					      unsigned char buf_idx)
+{
+	return RPU_MEM_PKT_BASE +
+		(((sched_id * 2) + buf_idx) * NRF_WIFI_OFF_RAW_TX_SCHED_BUF_LEN);
+}
+
+
+static bool off_raw_tx_dev_valid(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx)
+{
+	if (!fmac_dev_ctx) {
+		nrf_wifi_osal_log_err("%s: Invalid device context",
+				      __func__);
+		return false;
+	}
+
+	if (fmac_dev_ctx->op_mode != NRF_WIFI_OP_MODE_OFF_RAW_TX) {
+		nrf_wifi_osal_log_err("%s: Invalid op mode",
+				      __func__);
+		return false;
+	}
+
+	return true;
+}
+
+
+/* Called with the mode lock held */
+static struct nrf_wifi_off_raw_tx_sched *off_raw_tx_sched_get(struct nrf_wifi_off_raw_tx_fmac_dev_ctx *dev_ctx_off_raw_tx,
+							      unsigned char sched_id)
+{
+	if (sched_id >= NRF_WIFI_OFF_RAW_TX_MAX_SCHEDS) {
+		nrf_wifi_osal_log_err("%s: Invalid schedule %d",
+				      __func__,
+				      sched_id);
+		return NULL;
+	}
+
+	if (!dev_ctx_off_raw_tx->sched[sched_id].in_use) {
+		nrf_wifi_osal_log_err("%s: Schedule %d not in use",
+				      __func__,
+				      sched_id);
+		return NULL;
+	}
+
+	return &dev_ctx_off_raw_tx->sched[sched_id];
+}
+
+
+/* Returns the in use schedule which is due the earliest */
+static unsigned char off_raw_tx_sched_next(struct nrf_wifi_off_raw_tx_fmac_dev_ctx *dev_ctx_off_raw_tx)
+{
+	struct nrf_wifi_off_raw_tx_sched *sched = NULL;
+	unsigned char next = NRF_WIFI_OFF_RAW_TX_SCHED_INVALID;
+	unsigned char i = 0;
+
+	for (i = 0; i < NRF_WIFI_OFF_RAW_TX_MAX_SCHEDS; i++) {
+		sched = &dev_ctx_off_raw_tx->sched[i];
+
+		if (!sched->in_use) {
+			continue;
+		}
+
+		if ((next == NRF_WIFI_OFF_RAW_TX_SCHED_INVALID) ||
+		    ((long)(sched->next_due_us -
+			    dev_ctx_off_raw_tx->sched[next].next_due_us) < 0)) {
+			next = i;
+		}
+	}
+
+	return next;
+}
+
+
+/*
+ * Programs a schedule to the RPU without waiting for the status, which is
+ * reported through the schedule status callback. The RPU reports a single
+ * status at a time, so nothing is programmed while one is still awaited.
+ * Called with the mode lock held.
+ */
+static enum nrf_wifi_status off_raw_tx_sched_program(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+						     unsigned char sched_id)
+{
+	enum nrf_wifi_status status = NRF_WIFI_STATUS_FAIL;
+	struct nrf_wifi_off_raw_tx_fmac_dev_ctx *dev_ctx_off_raw_tx;
+	struct nrf_wifi_off_raw_tx_sched *sched = NULL;
+	unsigned char ctrl_type = NRF_WIFI_OFFLOAD_TX_START;
+
+	dev_ctx_off_raw_tx = wifi_dev_priv(fmac_dev_ctx);
+	sched = &dev_ctx_off_raw_tx->sched[sched_id];
+
+	if (dev_ctx_off_raw_tx->sched_cmd_id != NRF_WIFI_OFF_RAW_TX_SCHED_INVALID) {
+		nrf_wifi_osal_log_err("%s: Status of schedule %d still awaited",
+				      __func__,
+				      dev_ctx_off_raw_tx->sched_cmd_id);
+		goto out;
+	}
+
+	dev_ctx_off_raw_tx->sched_cmd_id = sched_id;
+
+	status = umac_cmd_off_raw_tx_conf(fmac_dev_ctx,
+					  &sched->ctrl_info,
+					  &sched->tx_params);
+
+	if (status != NRF_WIFI_STATUS_SUCCESS) {
+		nrf_wifi_osal_log_err("%s: umac_cmd_off_raw_tx_conf failed", __func__);
+		dev_ctx_off_raw_tx->sched_cmd_id = NRF_WIFI_OFF_RAW_TX_SCHED_INVALID;
+		goto out;
+	}
+
+	if (dev_ctx_off_raw_tx->sched_tx_started) {
+		ctrl_type = NRF_WIFI_OFFLOAD_TX_CONFIG;
+	}
+
+	status = umac_cmd_off_raw_tx_ctrl(fmac_dev_ctx, ctrl_type);
+
+	if (status != NRF_WIFI_STATUS_SUCCESS) {
+		nrf_wifi_osal_log_err("%s: umac_cmd_off_raw_tx_ctrl failed", __func__);
+		goto out;
+	}
+
+	dev_ctx_off_raw_tx->sched_tx_started = true;
+	dev_ctx_off_raw_tx->cur_sched = sched_id;
+	sched->stats.num_activations++;
+out:
+	return status;
+}
+
+
+enum nrf_wifi_status nrf_wifi_off_raw_tx_fmac_sched_add(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+							struct nrf_wifi_offload_ctrl_params *off_ctrl_params,
+							struct nrf_wifi_offload_tx_ctrl *off_tx_params,
+							unsigned char *pkt,
+							unsigned int pkt_len,
+							unsigned char *sched_id)
+{
+	enum nrf_wifi_status status = NRF_WIFI_STATUS_FAIL;
+	struct nrf_wifi_off_raw_tx_fmac_dev_ctx *dev_ctx_off_raw_tx;
+	struct nrf_wifi_off_raw_tx_sched *sched = NULL;
+	unsigned int pkt_addr = 0;
+	unsigned char i = 0;
+
+	if (!off_raw_tx_dev_valid(fmac_dev_ctx)) {
+		goto out;
+	}
+
+	if (!off_ctrl_params || !off_tx_params || !pkt || !sched_id) {
+		nrf_wifi_osal_log_err("%s: Invalid parameters",
+				      __func__);
+		goto out;
+	}
+
+	if (!pkt_len || (pkt_len > NRF_WIFI_OFF_RAW_TX_PKT_MAX_LEN)) {
+		nrf_wifi_osal_log_err("%s: Invalid packet length %d",
+				      __func__,
+				      pkt_len);
+		goto out;
+	}
+
+	if (!off_ctrl_params->period_in_us) {
+		nrf_wifi_osal_log_err("%s: Invalid period",
+				      __func__);
+		goto out;
+	}
+
+	dev_ctx_off_raw_tx = wifi_dev_priv(fmac_dev_ctx);
+
+	nrf_wifi_osal_spinlock_take(fmac_dev_ctx->mode_lock);
+
+	for (i = 0; i < NRF_WIFI_OFF_RAW_TX_MAX_SCHEDS; i++) {
+		if (!dev_ctx_off_raw_tx->sched[i].in_use) {
+			break;
+		}
+	}
+
+	if (i == NRF_WIFI_OFF_RAW_TX_MAX_SCHEDS) {
+		nrf_wifi_osal_log_err("%s: No free schedule",
+				      __func__);
+		goto unlock;
+	}
+
+	sched = &dev_ctx_off_raw_tx->sched[i];
+	pkt_addr = off_raw_tx_sched_buf_addr(i, 0);
+
+	status = hal_rpu_mem_write(fmac_dev_ctx->hal_dev_ctx,
+				   pkt_addr,
+				   pkt,
+				   pkt_len);
+
+	if (status != NRF_WIFI_STATUS_SUCCESS) {
+		nrf_wifi_osal_log_err("%s: Writing the payload failed",
+				      __func__);
+		goto unlock;
+	}
+
+	nrf_wifi_osal_mem_set(sched,
+			      0,
+			      sizeof(*sched));
+
+	nrf_wifi_osal_mem_cpy(&sched->ctrl_info,
+			      off_ctrl_params,
+			      sizeof(*off_ctrl_params));
+
+	nrf_wifi_osal_mem_cpy(&sched->tx_params,
+			      off_tx_params,
+			      sizeof(*off_tx_params));
+
+	sched->tx_params.pkt_length = pkt_len;
+	sched->tx_params.pkt_ram_ptr = pkt_addr;
+	sched->next_due_us = nrf_wifi_osal_time_get_curr_us();
+	sched->in_use = true;
+
+	*sched_id = i;
+unlock:
+	nrf_wifi_osal_spinlock_rel(fmac_dev_ctx->mode_lock);
+out:
+	return status;
+}
+
+
+enum nrf_wifi_status nrf_wifi_off_raw_tx_fmac_sched_update(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+							   unsigned char sched_id,
+							   unsigned char *pkt,
+							   unsigned int pkt_len)
+{
+	enum nrf_wifi_status status = NRF_WIFI_STATUS_FAIL;
+	struct nrf_wifi_off_raw_tx_fmac_dev_ctx *dev_ctx_off_raw_tx;
+	struct nrf_wifi_off_raw_tx_sched *sched = NULL;
+	unsigned char buf_idx = 0;
+	unsigned int pkt_addr = 0;
+	bool live = false;
+
+	if (!off_raw_tx_dev_valid(fmac_dev_ctx)) {
+		goto out;
+	}
+
+	if (!pkt || !pkt_len || (pkt_len > NRF_WIFI_OFF_RAW_TX_PKT_MAX_LEN)) {
+		nrf_wifi_osal_log_err("%s: Invalid packet",
+				      __func__);
+		goto out;
+	}
+
+	dev_ctx_off_raw_tx = wifi_dev_priv(fmac_dev_ctx);
+
+	nrf_wifi_osal_spinlock_take(fmac_dev_ctx->mode_lock);
+
+	sched = off_raw_tx_sched_get(dev_ctx_off_raw_tx, sched_id);
+
+	if (!sched) {
+		goto unlock;
+	}
+
+	/* Other schedules pick up the payload on their next activation */
+	live = dev_ctx_off_raw_tx->sched_tx_started &&
+		(dev_ctx_off_raw_tx->cur_sched == sched_id);
+
+	/* The buffers cannot be switched until the RPU can be reprogrammed */
+	if (live &&
+	    (dev_ctx_off_raw_tx->sched_cmd_id != NRF_WIFI_OFF_RAW_TX_SCHED_INVALID)) {
+		nrf_wifi_osal_log_err("%s: Status of schedule %d still awaited",
+				      __func__,
+				      dev_ctx_off_raw_tx->sched_cmd_id);
+		goto unlock;
+	}
+
+	/* Write to the idle buffer so that the live frame is never torn */
+	buf_idx = !sched->buf_idx;
+	pkt_addr = off_raw_tx_sched_buf_addr(sched_id, buf_idx);
+
+	status = hal_rpu_mem_write(fmac_dev_ctx->hal_dev_ctx,
+				   pkt_addr,
+				   pkt,
+				   pkt_len);
+
+	if (status != NRF_WIFI_STATUS_SUCCESS) {
+		nrf_wifi_osal_log_err("%s: Writing the payload failed",
+				      __func__);
+		goto unlock;
+	}
+
+	sched->buf_idx = buf_idx;
+	sched->tx_params.pkt_length = pkt_len;
+	sched->tx_params.pkt_ram_ptr = pkt_addr;
+	sched->stats.num_updates++;
+
+	if (live) {
+		status = off_raw_tx_sched_program(fmac_dev_ctx,
+						  sched_id);
+	}
+unlock:
+	nrf_wifi_osal_spinlock_rel(fmac_dev_ctx->mode_lock);
+out:
+	return status;
+}
+
+
+enum nrf_wifi_status nrf_wifi_off_raw_tx_fmac_sched_del(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+							unsigned char sched_id)
+{
+	enum nrf_wifi_status status = NRF_WIFI_STATUS_FAIL;
+	struct nrf_wifi_off_raw_tx_fmac_dev_ctx *dev_ctx_off_raw_tx;
+	struct nrf_wifi_off_raw_tx_sched *sched = NULL;
+	unsigned char next = NRF_WIFI_OFF_RAW_TX_SCHED_INVALID;
+
+	if (!off_raw_tx_dev_valid(fmac_dev_ctx)) {
+		goto out;
+	}
+
+	dev_ctx_off_raw_tx = wifi_dev_priv(fmac_dev_ctx);
+
+	nrf_wifi_osal_spinlock_take(fmac_dev_ctx->mode_lock);
+
+	sched = off_raw_tx_sched_get(dev_ctx_off_raw_tx, sched_id);
+
+	if (!sched) {
+		goto unlock;
+	}
+
+	/* The running schedule is handed over only once the RPU can be reprogrammed */
+	if ((dev_ctx_off_raw_tx->cur_sched == sched_id) &&
+	    (dev_ctx_off_raw_tx->sched_cmd_id != NRF_WIFI_OFF_RAW_TX_SCHED_INVALID)) {
+		nrf_wifi_osal_log_err("%s: Status of schedule %d still awaited",
+				      __func__,
+				      dev_ctx_off_raw_tx->sched_cmd_id);
+		goto unlock;
+	}
+
+	sched->in_use = false;
+	status = NRF_WIFI_STATUS_SUCCESS;
+
+	if (dev_ctx_off_raw_tx->cur_sched != sched_id) {
+		goto unlock;
+	}
+
+	dev_ctx_off_raw_tx->cur_sched = NRF_WIFI_OFF_RAW_TX_SCHED_INVALID;
+
+	next = off_raw_tx_sched_next(dev_ctx_off_raw_tx);
+
+	if (next != NRF_WIFI_OFF_RAW_TX_SCHED_INVALID) {
+		status = off_raw_tx_sched_program(fmac_dev_ctx,
+						  next);
+		goto unlock;
+	}
+
+	status = umac_cmd_off_raw_tx_ctrl(fmac_dev_ctx,
+					  NRF_WIFI_OFFLOAD_TX_STOP);
+
+	if (status != NRF_WIFI_STATUS_SUCCESS) {
+		nrf_wifi_osal_log_err("%s: umac_cmd_off_raw_tx_ctrl failed", __func__);
+		goto unlock;
+	}
+
+	dev_ctx_off_raw_tx->sched_tx_started = false;
+unlock:
+	nrf_wifi_osal_spinlock_rel(fmac_dev_ctx->mode_lock);
+out:
+	return status;
+}
+
+
+enum nrf_wifi_status nrf_wifi_off_raw_tx_fmac_sched_run(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+							unsigned int *next_run_us)
+{
+	enum nrf_wifi_status status = NRF_WIFI_STATUS_FAIL;
+	struct nrf_wifi_off_raw_tx_fmac_dev_ctx *dev_ctx_off_raw_tx;
+	struct nrf_wifi_off_raw_tx_sched *sched = NULL;
+	unsigned char next = NRF_WIFI_OFF_RAW_TX_SCHED_INVALID;
+	unsigned int num_scheds = 0;
+	unsigned long curr_time_us = 0;
+	long wait_us = 0;
+	unsigned char i = 0;
+
+	if (!off_raw_tx_dev_valid(fmac_dev_ctx)) {
+		goto out;
+	}
+
+	if (!next_run_us) {
+		nrf_wifi_osal_log_err("%s: Invalid parameters",
+				      __func__);
+		goto out;
+	}
+
+	dev_ctx_off_raw_tx = wifi_dev_priv(fmac_dev_ctx);
+	*next_run_us = 0;
+	status = NRF_WIFI_STATUS_SUCCESS;
+
+	nrf_wifi_osal_spinlock_take(fmac_dev_ctx->mode_lock);
+
+	next = off_raw_tx_sched_next(dev_ctx_off_raw_tx);
+
+	if (next == NRF_WIFI_OFF_RAW_TX_SCHED_INVALID) {
+		goto unlock;
+	}
+
+	curr_time_us = nrf_wifi_osal_time_get_curr_us();
+	sched = &dev_ctx_off_raw_tx->sched[next];
+
+	if ((long)(curr_time_us - sched->next_due_us) >= 0) {
+		if (next != dev_ctx_off_raw_tx->cur_sched) {
+			/* Switch once the status of the last configuration is in */
+			if (dev_ctx_off_raw_tx->sched_cmd_id != NRF_WIFI_OFF_RAW_TX_SCHED_INVALID) {
+				*next_run_us = NRF_WIFI_OFF_RAW_TX_SCHED_RETRY_US;
+				goto unlock;
+			}
+
+			status = off_raw_tx_sched_program(fmac_dev_ctx,
+							  next);
+
+			if (status != NRF_WIFI_STATUS_SUCCESS) {
+				goto unlock;
+			}
+		}
+
+		sched->next_due_us += sched->ctrl_info.period_in_us;
+
+		/* Do not try to catch up on missed periods */
+		if ((long)(curr_time_us - sched->next_due_us) >= 0) {
+			sched->next_due_us = curr_time_us + sched->ctrl_info.period_in_us;
+		}
+	}
+
+	for (i = 0; i < NRF_WIFI_OFF_RAW_TX_MAX_SCHEDS; i++) {
+		if (dev_ctx_off_raw_tx->sched[i].in_use) {
+			num_scheds++;
+		}
+	}
+
+	/* A lone schedule keeps running in the RPU without host intervention */
+	if ((num_scheds == 1) && (dev_ctx_off_raw_tx->cur_sched == next)) {
+		goto unlock;
+	}
+
+	next = off_raw_tx_sched_next(dev_ctx_off_raw_tx);
+	wait_us = (long)(dev_ctx_off_raw_tx->sched[next].next_due_us - curr_time_us);
+
+	*next_run_us = (wait_us > 0) ? wait_us : 1;
+unlock:
+	nrf_wifi_osal_spinlock_rel(fmac_dev_ctx->mode_lock);
+out:
+	return status;
+}
+
+
+enum nrf_wifi_status nrf_wifi_off_raw_tx_fmac_sched_stats_get(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+							      unsigned char sched_id,
+							      struct nrf_wifi_off_raw_tx_sched_stats *stats)
+{
+	enum nrf_wifi_status status = NRF_WIFI_STATUS_FAIL;
+	struct nrf_wifi_off_raw_tx_sched *sched = NULL;
+
+	if (!off_raw_tx_dev_valid(fmac_dev_ctx) || !stats) {
+		goto out;
+	}
+
+	nrf_wifi_osal_spinlock_take(fmac_dev_ctx->mode_lock);
+
+	sched = off_raw_tx_sched_get(wifi_dev_priv(fmac_dev_ctx),
+				     sched_id);
+
+	if (sched) {
+		nrf_wifi_osal_mem_cpy(stats,
+				      &sched->stats,
+				      sizeof(*stats));
+		status = NRF_WIFI_STATUS_SUCCESS;
+	}
+
+	nrf_wifi_osal_spinlock_rel(fmac_dev_ctx->mode_lock);
 out:
 	return status;
 }
@@ -379,7 +906,7 @@ enum nrf_wifi_status nrf_wifi_off_raw_tx_fmac_stats_get(struct nrf_wifi_fmac_dev
 							struct rpu_off_raw_tx_op_stats *stats)
 {
 	enum nrf_wifi_status status = NRF_WIFI_STATUS_FAIL;
-	unsigned char count = 0;
+	struct nrf_wifi_off_raw_tx_fmac_dev_ctx *dev_ctx_off_raw_tx;
 
 	if (fmac_dev_ctx->op_mode != NRF_WIFI_OP_MODE_OFF_RAW_TX) {
 		nrf_wifi_osal_log_err("%s: Invalid op mode",
@@ -387,12 +914,15 @@ enum nrf_wifi_status nrf_wifi_off_raw_tx_fmac_stats_get(struct nrf_wifi_fmac_dev
 		goto out;
 	}
 
-	if (fmac_dev_ctx->stats_req == true) {
+	dev_ctx_off_raw_tx = wifi_dev_priv(fmac_dev_ctx);
+
+	if ((fmac_dev_ctx->stats_req == true) || dev_ctx_off_raw_tx->stats_async) {
 		nrf_wifi_osal_log_err("%s: Stats request already pending",
 				      __func__);
 		goto out;
 	}
 
+	nrf_wifi_osal_completion_init(fmac_dev_ctx->stats_comp);
 	fmac_dev_ctx->stats_req = true;
 	fmac_dev_ctx->fw_stats = &stats->fw;
 
@@ -402,13 +932,10 @@ enum nrf_wifi_status nrf_wifi_off_raw_tx_fmac_stats_get(struct nrf_wifi_fmac_dev
 		goto out;
 	}
 
-	do {
-		nrf_wifi_osal_sleep_ms(1);
-		count++;
-	} while ((fmac_dev_ctx->stats_req == true) &&
-		 (count < NRF_WIFI_FMAC_STATS_RECV_TIMEOUT));
+	status = nrf_wifi_osal_completion_wait(fmac_dev_ctx->stats_comp,
+					       NRF_WIFI_FMAC_STATS_RECV_TIMEOUT);
 
-	if (count == NRF_WIFI_FMAC_STATS_RECV_TIMEOUT) {
+	if (status != NRF_WIFI_STATUS_SUCCESS) {
 		nrf_wifi_osal_log_err("%s: Timed out",
 				      __func__);
 		goto out;
@@ -419,6 +946,43 @@ out:
 	return status;
 }
 
+
+enum nrf_wifi_status nrf_wifi_off_raw_tx_fmac_stats_req(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx)
+{
+	enum nrf_wifi_status status = NRF_WIFI_STATUS_FAIL;
+	struct nrf_wifi_off_raw_tx_fmac_dev_ctx *dev_ctx_off_raw_tx;
+
+	if (!fmac_dev_ctx) {
+		nrf_wifi_osal_log_err("%s: Invalid device context",
+				      __func__);
+		goto out;
+	}
+
+	if (fmac_dev_ctx->op_mode != NRF_WIFI_OP_MODE_OFF_RAW_TX) {
+		nrf_wifi_osal_log_err("%s: Invalid op mode",
+				      __func__);
+		goto out;
+	}
+
+	dev_ctx_off_raw_tx = wifi_dev_priv(fmac_dev_ctx);
+
+	if (fmac_dev_ctx->stats_req || dev_ctx_off_raw_tx->stats_async) {
+		nrf_wifi_osal_log_err("%s: Stats request already pending",
+				      __func__);
+		goto out;
+	}
+
+	dev_ctx_off_raw_tx->stats_async = true;
+
+	status = umac_cmd_off_raw_tx_prog_stats_get(fmac_dev_ctx);
+
+	if (status != NRF_WIFI_STATUS_SUCCESS) {
+		dev_ctx_off_raw_tx->stats_async = false;
+	}
+out:
+	return status;
+}
+
 static int nrf_wifi_off_raw_tx_fmac_phy_rf_params_init(struct nrf_wifi_phy_rf_params *prf,
 						       unsigned int package_info,
 						       unsigned char *str)
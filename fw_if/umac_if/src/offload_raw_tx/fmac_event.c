@@ -20,6 +20,7 @@ static enum nrf_wifi_status umac_event_off_raw_tx_stats_process(
 {
 	enum nrf_wifi_status status = NRF_WIFI_STATUS_FAIL;
 	struct nrf_wifi_off_raw_tx_umac_event_stats *stats = NULL;
+	struct nrf_wifi_off_raw_tx_fmac_dev_ctx *dev_ctx_off_raw_tx;
 
 	if (!event) {
 		nrf_wifi_osal_log_err("%s: Invalid parameters",
@@ -27,6 +28,22 @@ static enum nrf_wifi_status umac_event_off_raw_tx_stats_process(
 		goto out;
 	}
 
+	dev_ctx_off_raw_tx = wifi_dev_priv(fmac_dev_ctx);
+
+	if (dev_ctx_off_raw_tx->stats_async) {
+		stats = ((struct nrf_wifi_off_raw_tx_umac_event_stats *)event);
+
+		dev_ctx_off_raw_tx->stats_async = false;
+
+		if (dev_ctx_off_raw_tx->callbk_fns.stats_callbk_fn) {
+			dev_ctx_off_raw_tx->callbk_fns.stats_callbk_fn(fmac_dev_ctx->os_dev_ctx,
+								       &stats->fw);
+		}
+
+		status = NRF_WIFI_STATUS_SUCCESS;
+		goto out;
+	}
+
 	if (!fmac_dev_ctx->stats_req) {
 		nrf_wifi_osal_log_err("%s: Stats recd when req was not sent!",
 				      __func__);
@@ -40,6 +57,7 @@ static enum nrf_wifi_status umac_event_off_raw_tx_stats_process(
 			      sizeof(stats->fw));
 
 	fmac_dev_ctx->stats_req = false;
+	nrf_wifi_osal_completion_complete(fmac_dev_ctx->stats_comp);
 
 	status = NRF_WIFI_STATUS_SUCCESS;
 
@@ -50,6 +68,48 @@ out:
 
 
 
+/* Returns false if the status is not that of a schedule configuration */
+static bool umac_event_off_raw_tx_sched_status_process(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+							int cmd_status)
+{
+	struct nrf_wifi_off_raw_tx_fmac_dev_ctx *dev_ctx_off_raw_tx;
+	unsigned char sched_id = NRF_WIFI_OFF_RAW_TX_SCHED_INVALID;
+
+	dev_ctx_off_raw_tx = wifi_dev_priv(fmac_dev_ctx);
+
+	nrf_wifi_osal_spinlock_take(fmac_dev_ctx->mode_lock);
+
+	sched_id = dev_ctx_off_raw_tx->sched_cmd_id;
+	dev_ctx_off_raw_tx->sched_cmd_id = NRF_WIFI_OFF_RAW_TX_SCHED_INVALID;
+
+	if ((sched_id != NRF_WIFI_OFF_RAW_TX_SCHED_INVALID) &&
+	    (cmd_status != NRF_WIFI_UMAC_CMD_SUCCESS)) {
+		dev_ctx_off_raw_tx->sched[sched_id].stats.num_cmd_fail++;
+	}
+
+	nrf_wifi_osal_spinlock_rel(fmac_dev_ctx->mode_lock);
+
+	if (sched_id == NRF_WIFI_OFF_RAW_TX_SCHED_INVALID) {
+		return false;
+	}
+
+	if (cmd_status != NRF_WIFI_UMAC_CMD_SUCCESS) {
+		nrf_wifi_osal_log_err("%s: Schedule %d configuration failed (%d)",
+				      __func__,
+				      sched_id,
+				      cmd_status);
+	}
+
+	if (dev_ctx_off_raw_tx->callbk_fns.sched_status_callbk_fn) {
+		dev_ctx_off_raw_tx->callbk_fns.sched_status_callbk_fn(fmac_dev_ctx->os_dev_ctx,
+								      sched_id,
+								      cmd_status);
+	}
+
+	return true;
+}
+
+
 static enum nrf_wifi_status umac_event_off_raw_tx_proc_events(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
 							      struct host_rpu_msg *rpu_msg)
 {
@@ -72,16 +132,26 @@ static enum nrf_wifi_status umac_event_off_raw_tx_proc_events(struct nrf_wifi_fm
 		break;
 	case NRF_WIFI_EVENT_INIT_DONE:
 		fmac_dev_ctx->fw_init_done = 1;
+		nrf_wifi_osal_completion_complete(fmac_dev_ctx->fw_init_comp);
 		status = NRF_WIFI_STATUS_SUCCESS;
 		break;
 	case NRF_WIFI_EVENT_DEINIT_DONE:
 		fmac_dev_ctx->fw_deinit_done = 1;
+		nrf_wifi_osal_completion_complete(fmac_dev_ctx->fw_deinit_comp);
 		status = NRF_WIFI_STATUS_SUCCESS;
 		break;
 	case NRF_WIFI_EVENT_OFFLOADED_RAWTX_STATUS:
 		umac_status = ((struct nrf_wifi_umac_event_err_status *)sys_head);
+
+		if (umac_event_off_raw_tx_sched_status_process(fmac_dev_ctx,
+							       umac_status->status)) {
+			status = NRF_WIFI_STATUS_SUCCESS;
+			break;
+		}
+
 		dev_ctx_off_raw_tx->off_raw_tx_cmd_status = umac_status->status;
 		dev_ctx_off_raw_tx->off_raw_tx_cmd_done = false;
+		nrf_wifi_osal_completion_complete(fmac_dev_ctx->cmd_comp);
 		status = NRF_WIFI_STATUS_SUCCESS;
 		break;
 	default:
@@ -148,6 +218,7 @@ static enum nrf_wifi_status umac_event_ctrl_process(struct nrf_wifi_fmac_dev_ctx
 				      sizeof(struct nrf_wifi_get_reg_chn_info));
 
 		fmac_dev_ctx->alpha2_valid = true;
+		nrf_wifi_osal_completion_complete(fmac_dev_ctx->reg_get_comp);
 		break;
 	default:
 		nrf_wifi_osal_log_dbg("%s: No callback registered for event %d",
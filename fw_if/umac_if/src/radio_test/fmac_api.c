@@ -34,7 +34,6 @@ static enum nrf_wifi_status nrf_wifi_rt_fmac_fw_init(struct nrf_wifi_fmac_dev_ct
 						     struct nrf_wifi_board_params *board_params,
 						     unsigned char *country_code)
 {
-	unsigned long start_time_us = 0;
 	enum nrf_wifi_status status = NRF_WIFI_STATUS_FAIL;
 
 	if (!fmac_dev_ctx) {
@@ -43,6 +42,8 @@ static enum nrf_wifi_status nrf_wifi_rt_fmac_fw_init(struct nrf_wifi_fmac_dev_ct
 		goto out;
 	}
 
+	nrf_wifi_osal_completion_init(fmac_dev_ctx->fw_init_comp);
+
 	status = umac_cmd_rt_init(fmac_dev_ctx,
 				  rf_params,
 				  rf_params_valid,
@@ -61,14 +62,9 @@ static enum nrf_wifi_status nrf_wifi_rt_fmac_fw_init(struct nrf_wifi_fmac_dev_ct
 				      __func__);
 		goto out;
 	}
-	start_time_us = nrf_wifi_osal_time_get_curr_us();
-	while (!fmac_dev_ctx->fw_init_done) {
-		nrf_wifi_osal_sleep_ms(1);
-#define MAX_INIT_WAIT (5 * 1000 * 1000)
-		if (nrf_wifi_osal_time_elapsed_us(start_time_us) >= MAX_INIT_WAIT) {
-			break;
-		}
-	}
+#define MAX_INIT_WAIT_MS (5 * 1000)
+	nrf_wifi_osal_completion_wait(fmac_dev_ctx->fw_init_comp,
+				      MAX_INIT_WAIT_MS);
 
 	if (!fmac_dev_ctx->fw_init_done) {
 		nrf_wifi_osal_log_err("%s: UMAC init timed out",
@@ -115,6 +111,12 @@ struct nrf_wifi_fmac_dev_ctx *nrf_wifi_rt_fmac_dev_add(struct nrf_wifi_fmac_priv
 	fmac_dev_ctx->fpriv = fpriv;
 	fmac_dev_ctx->os_dev_ctx = os_dev_ctx;
 
+	if (nrf_wifi_fmac_dev_comps_alloc(fmac_dev_ctx) != NRF_WIFI_STATUS_SUCCESS) {
+		nrf_wifi_osal_mem_free(fmac_dev_ctx);
+		fmac_dev_ctx = NULL;
+		goto out;
+	}
+
 	fmac_dev_ctx->hal_dev_ctx = nrf_wifi_rt_hal_dev_add(fpriv->hpriv,
 							    fmac_dev_ctx);
 
@@ -122,6 +124,7 @@ struct nrf_wifi_fmac_dev_ctx *nrf_wifi_rt_fmac_dev_add(struct nrf_wifi_fmac_priv
 		nrf_wifi_osal_log_err("%s: nrf_wifi_rt_hal_dev_add failed",
 				      __func__);
 
+		nrf_wifi_fmac_dev_comps_free(fmac_dev_ctx);
 		nrf_wifi_osal_mem_free(fmac_dev_ctx);
 		fmac_dev_ctx = NULL;
 		goto out;
@@ -220,16 +223,37 @@ out:
 	return status;
 }
 
+static void nrf_wifi_rt_fmac_rx_cap_stream_free(struct nrf_wifi_rt_rx_cap_stream *stream)
+{
+	unsigned char i = 0;
+
+	for (i = 0; i < ARRAY_SIZE(stream->buf); i++) {
+		if (stream->buf[i]) {
+			nrf_wifi_osal_mem_free(stream->buf[i]);
+			stream->buf[i] = NULL;
+		}
+	}
+}
+
+
 void nrf_wifi_rt_fmac_dev_deinit(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx)
 {
+	struct nrf_wifi_rt_fmac_dev_ctx *rt_dev_ctx = NULL;
+
 	if (fmac_dev_ctx->op_mode != NRF_WIFI_OP_MODE_RT) {
 		nrf_wifi_osal_log_err("%s: Invalid op mode",
 				      __func__);
 		return;
 	}
 
+	rt_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
+
+	nrf_wifi_rt_fmac_rf_test_rx_cap_stream_stop(fmac_dev_ctx, NULL);
 	nrf_wifi_osal_mem_free(fmac_dev_ctx->tx_pwr_ceil_params);
 	nrf_wifi_rt_fmac_fw_deinit(fmac_dev_ctx);
+
+	/* With the RPU down a capture that did not stop can no longer complete */
+	nrf_wifi_rt_fmac_rx_cap_stream_free(&rt_dev_ctx->rx_cap_stream);
 }
 
 struct nrf_wifi_fmac_priv *nrf_wifi_rt_fmac_init(void)
@@ -271,21 +295,26 @@ out:
 }
 
 
+/* A running capture stream owns rf_test_type and the command completion */
+static bool nrf_wifi_rt_fmac_rx_cap_stream_busy(struct nrf_wifi_rt_fmac_dev_ctx *rt_dev_ctx)
+{
+	return rt_dev_ctx->rx_cap_stream.active ||
+		rt_dev_ctx->rx_cap_stream.in_flight;
+}
+
+
 static enum nrf_wifi_status wait_for_radio_cmd_status(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
 						      unsigned int timeout)
 {
-	unsigned int count = 0;
 	enum nrf_wifi_cmd_status radio_cmd_status;
 	struct nrf_wifi_rt_fmac_dev_ctx *rt_dev_ctx = NULL;
 
 	rt_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
-	do {
-		nrf_wifi_osal_sleep_ms(1);
-		count++;
-	} while ((!rt_dev_ctx->radio_cmd_done) &&
-		 (count < timeout));
 
-	if (count == timeout) {
+	nrf_wifi_osal_completion_wait(fmac_dev_ctx->cmd_comp,
+				      timeout);
+
+	if (!rt_dev_ctx->radio_cmd_done) {
 		nrf_wifi_osal_log_err("%s: Timed out (%d secs)",
 				      __func__,
 					 timeout / 1000);
@@ -321,6 +350,12 @@ enum nrf_wifi_status nrf_wifi_rt_fmac_radio_test_init(struct nrf_wifi_fmac_dev_c
 
 	rt_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
 
+	if (nrf_wifi_rt_fmac_rx_cap_stream_busy(rt_dev_ctx)) {
+		nrf_wifi_osal_log_err("%s: Capture stream running",
+				      __func__);
+		goto out;
+	}
+
 	nrf_wifi_osal_mem_set(&init_params,
 			      0,
 			      sizeof(init_params));
@@ -337,6 +372,7 @@ enum nrf_wifi_status nrf_wifi_rt_fmac_radio_test_init(struct nrf_wifi_fmac_dev_c
 	init_params.phy_calib = params->phy_calib;
 
 	rt_dev_ctx->radio_cmd_done = false;
+	nrf_wifi_osal_completion_init(fmac_dev_ctx->cmd_comp);
 	status = umac_cmd_rt_prog_init(fmac_dev_ctx,
 				       &init_params);
 
@@ -371,7 +407,14 @@ enum nrf_wifi_status nrf_wifi_rt_fmac_prog_tx(struct nrf_wifi_fmac_dev_ctx *fmac
 
 	rt_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
 
+	if (nrf_wifi_rt_fmac_rx_cap_stream_busy(rt_dev_ctx)) {
+		nrf_wifi_osal_log_err("%s: Capture stream running",
+				      __func__);
+		goto out;
+	}
+
 	rt_dev_ctx->radio_cmd_done = false;
+	nrf_wifi_osal_completion_init(fmac_dev_ctx->cmd_comp);
 	status = umac_cmd_rt_prog_tx(fmac_dev_ctx,
 				     params);
 
@@ -406,6 +449,12 @@ enum nrf_wifi_status nrf_wifi_rt_fmac_prog_rx(struct nrf_wifi_fmac_dev_ctx *fmac
 
 	rt_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
 
+	if (nrf_wifi_rt_fmac_rx_cap_stream_busy(rt_dev_ctx)) {
+		nrf_wifi_osal_log_err("%s: Capture stream running",
+				      __func__);
+		goto out;
+	}
+
 	nrf_wifi_osal_mem_set(&rx_params,
 			      0,
 			      sizeof(rx_params));
@@ -425,6 +474,7 @@ enum nrf_wifi_status nrf_wifi_rt_fmac_prog_rx(struct nrf_wifi_fmac_dev_ctx *fmac
 	rx_params.rx = params->rx;
 
 	rt_dev_ctx->radio_cmd_done = false;
+	nrf_wifi_osal_completion_init(fmac_dev_ctx->cmd_comp);
 	status = umac_cmd_rt_prog_rx(fmac_dev_ctx,
 				     &rx_params);
 
@@ -456,7 +506,6 @@ enum nrf_wifi_status nrf_wifi_rt_fmac_rf_test_rx_cap(struct nrf_wifi_fmac_dev_ct
 	enum nrf_wifi_status status = NRF_WIFI_STATUS_FAIL;
 	struct nrf_wifi_rf_test_capture_params rf_test_cap_params;
 	struct nrf_wifi_rt_fmac_dev_ctx *rt_dev_ctx = NULL;
-	unsigned int count = 0;
 
 	if (fmac_dev_ctx->op_mode != NRF_WIFI_OP_MODE_RT) {
 		nrf_wifi_osal_log_err("%s: Invalid op mode",
@@ -466,6 +515,12 @@ enum nrf_wifi_status nrf_wifi_rt_fmac_rf_test_rx_cap(struct nrf_wifi_fmac_dev_ct
 
 	rt_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
 
+	if (nrf_wifi_rt_fmac_rx_cap_stream_busy(rt_dev_ctx)) {
+		nrf_wifi_osal_log_err("%s: Capture stream running",
+				      __func__);
+		goto out;
+	}
+
 	nrf_wifi_osal_mem_set(&rf_test_cap_params,
 			      0,
 			      sizeof(rf_test_cap_params));
@@ -481,6 +536,7 @@ enum nrf_wifi_status nrf_wifi_rt_fmac_rf_test_rx_cap(struct nrf_wifi_fmac_dev_ct
 	rt_dev_ctx->rf_test_cap_sz = (num_samples * 3);
 	rt_dev_ctx->capture_status = 0;
 
+	nrf_wifi_osal_completion_init(fmac_dev_ctx->cmd_comp);
 	status = umac_cmd_rt_prog_rf_test(fmac_dev_ctx,
 					  &rf_test_cap_params,
 					  sizeof(rf_test_cap_params));
@@ -492,13 +548,10 @@ enum nrf_wifi_status nrf_wifi_rt_fmac_rf_test_rx_cap(struct nrf_wifi_fmac_dev_ct
 		goto out;
 	}
 
-	do {
-		nrf_wifi_osal_sleep_ms(100);
-		count++;
-	} while ((rt_dev_ctx->rf_test_type != NRF_WIFI_RF_TEST_MAX) &&
-		 (count < (RX_CAPTURE_TIMEOUT_CONST * capture_timeout)));
+	nrf_wifi_osal_completion_wait(fmac_dev_ctx->cmd_comp,
+				      RX_CAPTURE_TIMEOUT_CONST * capture_timeout * 100);
 
-	if (count == (RX_CAPTURE_TIMEOUT_CONST * capture_timeout)) {
+	if (rt_dev_ctx->rf_test_type != NRF_WIFI_RF_TEST_MAX) {
 		nrf_wifi_osal_log_err("%s: Timed out",
 				      __func__);
 		rt_dev_ctx->rf_test_type = NRF_WIFI_RF_TEST_MAX;
@@ -513,6 +566,196 @@ out:
 }
 
 
+enum nrf_wifi_status nrf_wifi_rt_fmac_rf_test_rx_cap_stream_start(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+								  struct nrf_wifi_rt_rx_cap_stream_params *params)
+{
+	enum nrf_wifi_status status = NRF_WIFI_STATUS_FAIL;
+	struct nrf_wifi_rf_test_capture_params rf_test_cap_params;
+	struct nrf_wifi_rt_fmac_dev_ctx *rt_dev_ctx = NULL;
+	struct nrf_wifi_rt_rx_cap_stream *stream = NULL;
+	unsigned int buf_sz = 0;
+	unsigned char i = 0;
+
+	if (!fmac_dev_ctx || !params || !params->chunk_callbk_fn) {
+		nrf_wifi_osal_log_err("%s: Invalid parameters",
+				      __func__);
+		goto out;
+	}
+
+	if (fmac_dev_ctx->op_mode != NRF_WIFI_OP_MODE_RT) {
+		nrf_wifi_osal_log_err("%s: Invalid op mode",
+				      __func__);
+		goto out;
+	}
+
+	if ((params->rf_test_type != NRF_WIFI_RF_TEST_RX_ADC_CAP) &&
+	    (params->rf_test_type != NRF_WIFI_RF_TEST_RX_STAT_PKT_CAP) &&
+	    (params->rf_test_type != NRF_WIFI_RF_TEST_RX_DYN_PKT_CAP)) {
+		nrf_wifi_osal_log_err("%s: Invalid capture type %d",
+				      __func__,
+				      params->rf_test_type);
+		goto out;
+	}
+
+	if (!params->num_samples || (params->num_samples > MAX_CAPTURE_LEN)) {
+		nrf_wifi_osal_log_err("%s: Invalid number of samples %d",
+				      __func__,
+				      params->num_samples);
+		goto out;
+	}
+
+	rt_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
+	stream = &rt_dev_ctx->rx_cap_stream;
+
+	if (nrf_wifi_rt_fmac_rx_cap_stream_busy(rt_dev_ctx)) {
+		nrf_wifi_osal_log_err("%s: Capture stream already running",
+				      __func__);
+		goto out;
+	}
+
+	nrf_wifi_rt_fmac_rx_cap_stream_free(stream);
+
+	nrf_wifi_osal_mem_set(stream,
+			      0,
+			      sizeof(*stream));
+
+	buf_sz = params->num_samples * NRF_WIFI_RT_RX_CAP_SAMPLE_SZ;
+
+	for (i = 0; i < ARRAY_SIZE(stream->buf); i++) {
+		stream->buf[i] = nrf_wifi_osal_mem_alloc(buf_sz);
+
+		if (!stream->buf[i]) {
+			nrf_wifi_osal_log_err("%s: Unable to allocate capture buffer",
+					      __func__);
+			nrf_wifi_rt_fmac_rx_cap_stream_free(stream);
+			goto out;
+		}
+	}
+
+	nrf_wifi_osal_mem_cpy(&stream->params,
+			      params,
+			      sizeof(*params));
+
+	nrf_wifi_osal_mem_set(&rf_test_cap_params,
+			      0,
+			      sizeof(rf_test_cap_params));
+
+	rf_test_cap_params.test = params->rf_test_type;
+	rf_test_cap_params.cap_len = params->num_samples;
+	rf_test_cap_params.cap_time = params->capture_timeout;
+	rf_test_cap_params.lna_gain = params->lna_gain;
+	rf_test_cap_params.bb_gain = params->bb_gain;
+
+	/* The end of the stream is signalled from the event path, possibly
+	 * before it is waited for.
+	 */
+	nrf_wifi_osal_completion_init(fmac_dev_ctx->cmd_comp);
+
+	rt_dev_ctx->rf_test_type = params->rf_test_type;
+	stream->active = true;
+	stream->in_flight = true;
+
+	status = umac_cmd_rt_prog_rf_test(fmac_dev_ctx,
+					  &rf_test_cap_params,
+					  sizeof(rf_test_cap_params));
+
+	if (status != NRF_WIFI_STATUS_SUCCESS) {
+		nrf_wifi_osal_log_err("%s: umac_cmd_rt_prog_rf_test failed",
+				      __func__);
+		stream->active = false;
+		stream->in_flight = false;
+		rt_dev_ctx->rf_test_type = NRF_WIFI_RF_TEST_MAX;
+		nrf_wifi_rt_fmac_rx_cap_stream_free(stream);
+		goto out;
+	}
+out:
+	return status;
+}
+
+
+enum nrf_wifi_status nrf_wifi_rt_fmac_rf_test_rx_cap_stream_stop(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+								 struct nrf_wifi_rt_rx_cap_stream_stats *stats)
+{
+	enum nrf_wifi_status status = NRF_WIFI_STATUS_FAIL;
+	struct nrf_wifi_rt_fmac_dev_ctx *rt_dev_ctx = NULL;
+	struct nrf_wifi_rt_rx_cap_stream *stream = NULL;
+
+	if (!fmac_dev_ctx) {
+		nrf_wifi_osal_log_err("%s: Invalid device context",
+				      __func__);
+		goto out;
+	}
+
+	if (fmac_dev_ctx->op_mode != NRF_WIFI_OP_MODE_RT) {
+		nrf_wifi_osal_log_err("%s: Invalid op mode",
+				      __func__);
+		goto out;
+	}
+
+	rt_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
+	stream = &rt_dev_ctx->rx_cap_stream;
+	status = NRF_WIFI_STATUS_SUCCESS;
+
+	stream->active = false;
+
+	if (stream->in_flight) {
+		/* Let the armed capture complete before releasing the buffers */
+		nrf_wifi_osal_completion_wait(fmac_dev_ctx->cmd_comp,
+					      RX_CAPTURE_TIMEOUT_CONST *
+					      stream->params.capture_timeout * 100);
+	}
+
+	if (stream->in_flight) {
+		/* The RPU can still write the capture to the buffers */
+		nrf_wifi_osal_log_err("%s: Timed out, capture still armed",
+				      __func__);
+		status = NRF_WIFI_STATUS_FAIL;
+	} else {
+		nrf_wifi_rt_fmac_rx_cap_stream_free(stream);
+	}
+
+	if (stats) {
+		nrf_wifi_osal_mem_cpy(stats,
+				      &stream->stats,
+				      sizeof(*stats));
+	}
+out:
+	return status;
+}
+
+
+enum nrf_wifi_status nrf_wifi_rt_fmac_rx_cap_unpack(const unsigned char *cap_data,
+						    unsigned int num_samples,
+						    signed short *iq)
+{
+	enum nrf_wifi_status status = NRF_WIFI_STATUS_FAIL;
+	unsigned int sample = 0;
+	unsigned int i = 0;
+
+	if (!cap_data || !iq) {
+		nrf_wifi_osal_log_err("%s: Invalid parameters",
+				      __func__);
+		goto out;
+	}
+
+	for (i = 0; i < num_samples; i++) {
+		sample = cap_data[0] |
+			 (cap_data[1] << 8) |
+			 (cap_data[2] << 16);
+
+		/* Sign extend the 12 bit I and Q components */
+		iq[2 * i] = ((signed short)((sample & 0xFFF) << 4)) >> 4;
+		iq[(2 * i) + 1] = ((signed short)(((sample >> 12) & 0xFFF) << 4)) >> 4;
+
+		cap_data += NRF_WIFI_RT_RX_CAP_SAMPLE_SZ;
+	}
+
+	status = NRF_WIFI_STATUS_SUCCESS;
+out:
+	return status;
+}
+
+
 enum nrf_wifi_status nrf_wifi_rt_fmac_rf_test_tx_tone(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
 						      unsigned char enable,
 						      signed char tone_freq,
@@ -521,7 +764,6 @@ enum nrf_wifi_status nrf_wifi_rt_fmac_rf_test_tx_tone(struct nrf_wifi_fmac_dev_c
 	enum nrf_wifi_status status = NRF_WIFI_STATUS_FAIL;
 	struct nrf_wifi_rf_test_tx_params rf_test_tx_params;
 	struct nrf_wifi_rt_fmac_dev_ctx *rt_dev_ctx = NULL;
-	unsigned int count = 0;
 
 	if (fmac_dev_ctx->op_mode != NRF_WIFI_OP_MODE_RT) {
 		nrf_wifi_osal_log_err("%s: Invalid op mode",
@@ -531,6 +773,12 @@ enum nrf_wifi_status nrf_wifi_rt_fmac_rf_test_tx_tone(struct nrf_wifi_fmac_dev_c
 
 	rt_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
 
+	if (nrf_wifi_rt_fmac_rx_cap_stream_busy(rt_dev_ctx)) {
+		nrf_wifi_osal_log_err("%s: Capture stream running",
+				      __func__);
+		goto out;
+	}
+
 	nrf_wifi_osal_mem_set(&rf_test_tx_params,
 			      0,
 			      sizeof(rf_test_tx_params));
@@ -544,6 +792,7 @@ enum nrf_wifi_status nrf_wifi_rt_fmac_rf_test_tx_tone(struct nrf_wifi_fmac_dev_c
 	rt_dev_ctx->rf_test_cap_data = NULL;
 	rt_dev_ctx->rf_test_cap_sz = 0;
 
+	nrf_wifi_osal_completion_init(fmac_dev_ctx->cmd_comp);
 	status = umac_cmd_rt_prog_rf_test(fmac_dev_ctx,
 					  &rf_test_tx_params,
 					  sizeof(rf_test_tx_params));
@@ -555,13 +804,10 @@ enum nrf_wifi_status nrf_wifi_rt_fmac_rf_test_tx_tone(struct nrf_wifi_fmac_dev_c
 		goto out;
 	}
 
-	do {
-		nrf_wifi_osal_sleep_ms(100);
-		count++;
-	} while ((rt_dev_ctx->rf_test_type != NRF_WIFI_RF_TEST_MAX) &&
-		 (count < NRF_WIFI_FMAC_RF_TEST_EVNT_TIMEOUT));
+	nrf_wifi_osal_completion_wait(fmac_dev_ctx->cmd_comp,
+				      NRF_WIFI_FMAC_RF_TEST_EVNT_TIMEOUT * 100);
 
-	if (count == NRF_WIFI_FMAC_RF_TEST_EVNT_TIMEOUT) {
+	if (rt_dev_ctx->rf_test_type != NRF_WIFI_RF_TEST_MAX) {
 		nrf_wifi_osal_log_err("%s: Timed out",
 				      __func__);
 		rt_dev_ctx->rf_test_type = NRF_WIFI_RF_TEST_MAX;
@@ -581,7 +827,6 @@ enum nrf_wifi_status nrf_wifi_rt_fmac_rf_test_dpd(struct nrf_wifi_fmac_dev_ctx *
 	enum nrf_wifi_status status = NRF_WIFI_STATUS_FAIL;
 	struct nrf_wifi_rf_test_dpd_params rf_test_dpd_params;
 	struct nrf_wifi_rt_fmac_dev_ctx *rt_dev_ctx = NULL;
-	unsigned int count = 0;
 
 	if (fmac_dev_ctx->op_mode != NRF_WIFI_OP_MODE_RT) {
 		nrf_wifi_osal_log_err("%s: Invalid op mode",
@@ -591,6 +836,12 @@ enum nrf_wifi_status nrf_wifi_rt_fmac_rf_test_dpd(struct nrf_wifi_fmac_dev_ctx *
 
 	rt_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
 
+	if (nrf_wifi_rt_fmac_rx_cap_stream_busy(rt_dev_ctx)) {
+		nrf_wifi_osal_log_err("%s: Capture stream running",
+				      __func__);
+		goto out;
+	}
+
 	nrf_wifi_osal_mem_set(&rf_test_dpd_params,
 			      0,
 			      sizeof(rf_test_dpd_params));
@@ -602,6 +853,7 @@ enum nrf_wifi_status nrf_wifi_rt_fmac_rf_test_dpd(struct nrf_wifi_fmac_dev_ctx *
 	rt_dev_ctx->rf_test_cap_data = NULL;
 	rt_dev_ctx->rf_test_cap_sz = 0;
 
+	nrf_wifi_osal_completion_init(fmac_dev_ctx->cmd_comp);
 	status = umac_cmd_rt_prog_rf_test(fmac_dev_ctx,
 					  &rf_test_dpd_params,
 					  sizeof(rf_test_dpd_params));
@@ -613,13 +865,10 @@ enum nrf_wifi_status nrf_wifi_rt_fmac_rf_test_dpd(struct nrf_wifi_fmac_dev_ctx *
 		goto out;
 	}
 
-	do {
-		nrf_wifi_osal_sleep_ms(100);
-		count++;
-	} while ((rt_dev_ctx->rf_test_type != NRF_WIFI_RF_TEST_MAX) &&
-		 (count < NRF_WIFI_FMAC_RF_TEST_EVNT_TIMEOUT));
+	nrf_wifi_osal_completion_wait(fmac_dev_ctx->cmd_comp,
+				      NRF_WIFI_FMAC_RF_TEST_EVNT_TIMEOUT * 100);
 
-	if (count == NRF_WIFI_FMAC_RF_TEST_EVNT_TIMEOUT) {
+	if (rt_dev_ctx->rf_test_type != NRF_WIFI_RF_TEST_MAX) {
 		nrf_wifi_osal_log_err("%s: Timed out",
 				      __func__);
 		rt_dev_ctx->rf_test_type = NRF_WIFI_RF_TEST_MAX;
@@ -638,7 +887,6 @@ enum nrf_wifi_status nrf_wifi_rt_fmac_rf_get_temp(struct nrf_wifi_fmac_dev_ctx *
 	enum nrf_wifi_status status = NRF_WIFI_STATUS_FAIL;
 	struct nrf_wifi_temperature_params rf_test_get_temperature;
 	struct nrf_wifi_rt_fmac_dev_ctx *rt_dev_ctx = NULL;
-	unsigned int count = 0;
 
 	if (fmac_dev_ctx->op_mode != NRF_WIFI_OP_MODE_RT) {
 		nrf_wifi_osal_log_err("%s: Invalid op mode",
@@ -648,6 +896,12 @@ enum nrf_wifi_status nrf_wifi_rt_fmac_rf_get_temp(struct nrf_wifi_fmac_dev_ctx *
 
 	rt_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
 
+	if (nrf_wifi_rt_fmac_rx_cap_stream_busy(rt_dev_ctx)) {
+		nrf_wifi_osal_log_err("%s: Capture stream running",
+				      __func__);
+		goto out;
+	}
+
 	nrf_wifi_osal_mem_set(&rf_test_get_temperature,
 			      0,
 			      sizeof(rf_test_get_temperature));
@@ -658,6 +912,7 @@ enum nrf_wifi_status nrf_wifi_rt_fmac_rf_get_temp(struct nrf_wifi_fmac_dev_ctx *
 	rt_dev_ctx->rf_test_cap_data = NULL;
 	rt_dev_ctx->rf_test_cap_sz = 0;
 
+	nrf_wifi_osal_completion_init(fmac_dev_ctx->cmd_comp);
 	status = umac_cmd_rt_prog_rf_test(fmac_dev_ctx,
 					  &rf_test_get_temperature,
 					  sizeof(rf_test_get_temperature));
@@ -669,13 +924,10 @@ enum nrf_wifi_status nrf_wifi_rt_fmac_rf_get_temp(struct nrf_wifi_fmac_dev_ctx *
 		goto out;
 	}
 
-	do {
-		nrf_wifi_osal_sleep_ms(100);
-		count++;
-	} while ((rt_dev_ctx->rf_test_type != NRF_WIFI_RF_TEST_MAX) &&
-		 (count < NRF_WIFI_FMAC_RF_TEST_EVNT_TIMEOUT));
+	nrf_wifi_osal_completion_wait(fmac_dev_ctx->cmd_comp,
+				      NRF_WIFI_FMAC_RF_TEST_EVNT_TIMEOUT * 100);
 
-	if (count == NRF_WIFI_FMAC_RF_TEST_EVNT_TIMEOUT) {
+	if (rt_dev_ctx->rf_test_type != NRF_WIFI_RF_TEST_MAX) {
 		nrf_wifi_osal_log_err("%s: Timed out",
 				      __func__);
 		rt_dev_ctx->rf_test_type = NRF_WIFI_RF_TEST_MAX;
@@ -693,7 +945,6 @@ enum nrf_wifi_status nrf_wifi_rt_fmac_rf_get_bat_volt(struct nrf_wifi_fmac_dev_c
 	enum nrf_wifi_status status = NRF_WIFI_STATUS_FAIL;
 	struct nrf_wifi_bat_volt_params get_bat_volt;
 	struct nrf_wifi_rt_fmac_dev_ctx* rt_dev_ctx = NULL;
-	unsigned int count = 0;
 
 	if (fmac_dev_ctx->op_mode != NRF_WIFI_OP_MODE_RT) {
 		nrf_wifi_osal_log_err("%s: Invalid op mode",
@@ -703,6 +954,12 @@ enum nrf_wifi_status nrf_wifi_rt_fmac_rf_get_bat_volt(struct nrf_wifi_fmac_dev_c
 
 	rt_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
 
+	if (nrf_wifi_rt_fmac_rx_cap_stream_busy(rt_dev_ctx)) {
+		nrf_wifi_osal_log_err("%s: Capture stream running",
+				      __func__);
+		goto out;
+	}
+
 	nrf_wifi_osal_mem_set(&get_bat_volt,
 			      0,
 			      sizeof(get_bat_volt));
@@ -712,6 +969,7 @@ enum nrf_wifi_status nrf_wifi_rt_fmac_rf_get_bat_volt(struct nrf_wifi_fmac_dev_c
 	rt_dev_ctx->rf_test_type = NRF_WIFI_RF_TEST_GET_BAT_VOLT;
 	rt_dev_ctx->rf_test_cap_data = NULL;
 	rt_dev_ctx->rf_test_cap_sz = 0;
+	nrf_wifi_osal_completion_init(fmac_dev_ctx->cmd_comp);
 	status = umac_cmd_rt_prog_rf_test(fmac_dev_ctx,
 				       &get_bat_volt,
 				       sizeof(get_bat_volt));
@@ -722,13 +980,10 @@ enum nrf_wifi_status nrf_wifi_rt_fmac_rf_get_bat_volt(struct nrf_wifi_fmac_dev_c
 		goto out;
 	}
 
-	do {
-		nrf_wifi_osal_sleep_ms(100);
-	    	count++;
-	} while ((rt_dev_ctx->rf_test_type != NRF_WIFI_RF_TEST_MAX) &&
-	         (count < NRF_WIFI_FMAC_RF_TEST_EVNT_TIMEOUT));
+	nrf_wifi_osal_completion_wait(fmac_dev_ctx->cmd_comp,
+				      NRF_WIFI_FMAC_RF_TEST_EVNT_TIMEOUT * 100);
 
-	if (count == NRF_WIFI_FMAC_RF_TEST_EVNT_TIMEOUT) {
+	if (rt_dev_ctx->rf_test_type != NRF_WIFI_RF_TEST_MAX) {
 		nrf_wifi_osal_log_err("%s: Timed out",
 				      __func__);
 	}
@@ -742,7 +997,6 @@ enum nrf_wifi_status nrf_wifi_rt_fmac_rf_get_rf_rssi(struct nrf_wifi_fmac_dev_ct
 	enum nrf_wifi_status status = NRF_WIFI_STATUS_FAIL;
 	struct nrf_wifi_rf_get_rf_rssi rf_get_rf_rssi_params;
 	struct nrf_wifi_rt_fmac_dev_ctx *rt_dev_ctx = NULL;
-	unsigned int count = 0;
 
 	if (fmac_dev_ctx->op_mode != NRF_WIFI_OP_MODE_RT) {
 		nrf_wifi_osal_log_err("%s: Invalid op mode",
@@ -752,6 +1006,12 @@ enum nrf_wifi_status nrf_wifi_rt_fmac_rf_get_rf_rssi(struct nrf_wifi_fmac_dev_ct
 
 	rt_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
 
+	if (nrf_wifi_rt_fmac_rx_cap_stream_busy(rt_dev_ctx)) {
+		nrf_wifi_osal_log_err("%s: Capture stream running",
+				      __func__);
+		goto out;
+	}
+
 	nrf_wifi_osal_mem_set(&rf_get_rf_rssi_params,
 			      0,
 			      sizeof(rf_get_rf_rssi_params));
@@ -764,6 +1024,7 @@ enum nrf_wifi_status nrf_wifi_rt_fmac_rf_get_rf_rssi(struct nrf_wifi_fmac_dev_ct
 	rt_dev_ctx->rf_test_cap_data = NULL;
 	rt_dev_ctx->rf_test_cap_sz = 0;
 
+	nrf_wifi_osal_completion_init(fmac_dev_ctx->cmd_comp);
 	status = umac_cmd_rt_prog_rf_test(fmac_dev_ctx,
 					  &rf_get_rf_rssi_params,
 					  sizeof(rf_get_rf_rssi_params));
@@ -775,13 +1036,10 @@ enum nrf_wifi_status nrf_wifi_rt_fmac_rf_get_rf_rssi(struct nrf_wifi_fmac_dev_ct
 		goto out;
 	}
 
-	do {
-		nrf_wifi_osal_sleep_ms(100);
-		count++;
-	} while ((rt_dev_ctx->rf_test_type != NRF_WIFI_RF_TEST_MAX) &&
-		 (count < NRF_WIFI_FMAC_RF_TEST_EVNT_TIMEOUT));
+	nrf_wifi_osal_completion_wait(fmac_dev_ctx->cmd_comp,
+				      NRF_WIFI_FMAC_RF_TEST_EVNT_TIMEOUT * 100);
 
-	if (count == NRF_WIFI_FMAC_RF_TEST_EVNT_TIMEOUT) {
+	if (rt_dev_ctx->rf_test_type != NRF_WIFI_RF_TEST_MAX) {
 		nrf_wifi_osal_log_err("%s: Timed out",
 				      __func__);
 		rt_dev_ctx->rf_test_type = NRF_WIFI_RF_TEST_MAX;
@@ -801,7 +1059,6 @@ enum nrf_wifi_status nrf_wifi_rt_fmac_set_xo_val(struct nrf_wifi_fmac_dev_ctx *f
 	enum nrf_wifi_status status = NRF_WIFI_STATUS_FAIL;
 	struct nrf_wifi_rf_test_xo_calib nrf_wifi_rf_test_xo_calib_params;
 	struct nrf_wifi_rt_fmac_dev_ctx *rt_dev_ctx = NULL;
-	unsigned int count = 0;
 
 	if (fmac_dev_ctx->op_mode != NRF_WIFI_OP_MODE_RT) {
 		nrf_wifi_osal_log_err("%s: Invalid op mode",
@@ -811,6 +1068,12 @@ enum nrf_wifi_status nrf_wifi_rt_fmac_set_xo_val(struct nrf_wifi_fmac_dev_ctx *f
 
 	rt_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
 
+	if (nrf_wifi_rt_fmac_rx_cap_stream_busy(rt_dev_ctx)) {
+		nrf_wifi_osal_log_err("%s: Capture stream running",
+				      __func__);
+		goto out;
+	}
+
 	nrf_wifi_osal_mem_set(&nrf_wifi_rf_test_xo_calib_params,
 			      0,
 			      sizeof(nrf_wifi_rf_test_xo_calib_params));
@@ -823,6 +1086,7 @@ enum nrf_wifi_status nrf_wifi_rt_fmac_set_xo_val(struct nrf_wifi_fmac_dev_ctx *f
 	rt_dev_ctx->rf_test_cap_data = NULL;
 	rt_dev_ctx->rf_test_cap_sz = 0;
 
+	nrf_wifi_osal_completion_init(fmac_dev_ctx->cmd_comp);
 	status = umac_cmd_rt_prog_rf_test(fmac_dev_ctx,
 					  &nrf_wifi_rf_test_xo_calib_params,
 					  sizeof(nrf_wifi_rf_test_xo_calib_params));
@@ -834,13 +1098,10 @@ enum nrf_wifi_status nrf_wifi_rt_fmac_set_xo_val(struct nrf_wifi_fmac_dev_ctx *f
 		goto out;
 	}
 
-	do {
-		nrf_wifi_osal_sleep_ms(100);
-		count++;
-	} while ((rt_dev_ctx->rf_test_type != NRF_WIFI_RF_TEST_MAX) &&
-		 (count < NRF_WIFI_FMAC_RF_TEST_EVNT_TIMEOUT));
+	nrf_wifi_osal_completion_wait(fmac_dev_ctx->cmd_comp,
+				      NRF_WIFI_FMAC_RF_TEST_EVNT_TIMEOUT * 100);
 
-	if (count == NRF_WIFI_FMAC_RF_TEST_EVNT_TIMEOUT) {
+	if (rt_dev_ctx->rf_test_type != NRF_WIFI_RF_TEST_MAX) {
 		nrf_wifi_osal_log_err("%s: Timed out",
 				      __func__);
 		rt_dev_ctx->rf_test_type = NRF_WIFI_RF_TEST_MAX;
@@ -859,7 +1120,6 @@ enum nrf_wifi_status nrf_wifi_rt_fmac_rf_test_compute_xo(struct nrf_wifi_fmac_de
 	enum nrf_wifi_status status = NRF_WIFI_STATUS_FAIL;
 	struct nrf_wifi_rf_get_xo_value rf_get_xo_value_params;
 	struct nrf_wifi_rt_fmac_dev_ctx *rt_dev_ctx = NULL;
-	unsigned int count = 0;
 
 	if (fmac_dev_ctx->op_mode != NRF_WIFI_OP_MODE_RT) {
 		nrf_wifi_osal_log_err("%s: Invalid op mode",
@@ -869,6 +1129,12 @@ enum nrf_wifi_status nrf_wifi_rt_fmac_rf_test_compute_xo(struct nrf_wifi_fmac_de
 
 	rt_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
 
+	if (nrf_wifi_rt_fmac_rx_cap_stream_busy(rt_dev_ctx)) {
+		nrf_wifi_osal_log_err("%s: Capture stream running",
+				      __func__);
+		goto out;
+	}
+
 	nrf_wifi_osal_mem_set(&rf_get_xo_value_params,
 			      0,
 			      sizeof(rf_get_xo_value_params));
@@ -879,6 +1145,7 @@ enum nrf_wifi_status nrf_wifi_rt_fmac_rf_test_compute_xo(struct nrf_wifi_fmac_de
 	rt_dev_ctx->rf_test_cap_data = NULL;
 	rt_dev_ctx->rf_test_cap_sz = 0;
 
+	nrf_wifi_osal_completion_init(fmac_dev_ctx->cmd_comp);
 	status = umac_cmd_rt_prog_rf_test(fmac_dev_ctx,
 					  &rf_get_xo_value_params,
 					  sizeof(rf_get_xo_value_params));
@@ -890,13 +1157,10 @@ enum nrf_wifi_status nrf_wifi_rt_fmac_rf_test_compute_xo(struct nrf_wifi_fmac_de
 		goto out;
 	}
 
-	do {
-		nrf_wifi_osal_sleep_ms(100);
-		count++;
-	} while ((rt_dev_ctx->rf_test_type != NRF_WIFI_RF_TEST_MAX) &&
-		 (count < NRF_WIFI_FMAC_RF_TEST_EVNT_TIMEOUT));
+	nrf_wifi_osal_completion_wait(fmac_dev_ctx->cmd_comp,
+				      NRF_WIFI_FMAC_RF_TEST_EVNT_TIMEOUT * 100);
 
-	if (count == NRF_WIFI_FMAC_RF_TEST_EVNT_TIMEOUT) {
+	if (rt_dev_ctx->rf_test_type != NRF_WIFI_RF_TEST_MAX) {
 		nrf_wifi_osal_log_err("%s: Timed out",
 				      __func__);
 		rt_dev_ctx->rf_test_type = NRF_WIFI_RF_TEST_MAX;
@@ -914,7 +1178,6 @@ enum nrf_wifi_status nrf_wifi_rt_fmac_stats_get(struct nrf_wifi_fmac_dev_ctx *fm
 						struct rpu_rt_op_stats *stats)
 {
 	enum nrf_wifi_status status = NRF_WIFI_STATUS_FAIL;
-	unsigned char count = 0;
 
 	if (fmac_dev_ctx->op_mode != NRF_WIFI_OP_MODE_RT) {
 		nrf_wifi_osal_log_err("%s: Invalid op mode",
@@ -928,6 +1191,7 @@ enum nrf_wifi_status nrf_wifi_rt_fmac_stats_get(struct nrf_wifi_fmac_dev_ctx *fm
 		goto out;
 	}
 
+	nrf_wifi_osal_completion_init(fmac_dev_ctx->stats_comp);
 	fmac_dev_ctx->stats_req = true;
 	fmac_dev_ctx->fw_stats = &stats->fw;
 
@@ -938,13 +1202,10 @@ enum nrf_wifi_status nrf_wifi_rt_fmac_stats_get(struct nrf_wifi_fmac_dev_ctx *fm
 		goto out;
 	}
 
-	do {
-		nrf_wifi_osal_sleep_ms(1);
-		count++;
-	} while ((fmac_dev_ctx->stats_req == true) &&
-		 (count < NRF_WIFI_FMAC_STATS_RECV_TIMEOUT));
+	status = nrf_wifi_osal_completion_wait(fmac_dev_ctx->stats_comp,
+					       NRF_WIFI_FMAC_STATS_RECV_TIMEOUT);
 
-	if (count == NRF_WIFI_FMAC_STATS_RECV_TIMEOUT) {
+	if (status != NRF_WIFI_STATUS_SUCCESS) {
 		nrf_wifi_osal_log_err("%s: Timed out",
 				      __func__);
 		goto out;
@@ -13,6 +13,7 @@
 #include "radio_test/phy_rf_params.h"
 #include "host_rpu_umac_if.h"
 #include "radio_test/fmac_structs.h"
+#include "radio_test/fmac_cmd.h"
 #include "common/hal_mem.h"
 #include "common/fmac_util.h"
 
@@ -41,6 +42,7 @@ static enum nrf_wifi_status umac_event_rt_stats_process(struct nrf_wifi_fmac_dev
 			      sizeof(stats->fw));
 
 	fmac_dev_ctx->stats_req = false;
+	nrf_wifi_osal_completion_complete(fmac_dev_ctx->stats_comp);
 
 	status = NRF_WIFI_STATUS_SUCCESS;
 
@@ -49,6 +51,94 @@ out:
 }
 
 
+static void umac_event_rt_rx_cap_stream_process(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+						unsigned char capture_status)
+{
+	enum nrf_wifi_status status = NRF_WIFI_STATUS_FAIL;
+	struct nrf_wifi_rt_fmac_dev_ctx *def_dev_ctx;
+	struct nrf_wifi_rt_rx_cap_stream *stream = NULL;
+	struct nrf_wifi_rf_test_capture_params rf_test_cap_params;
+	struct nrf_wifi_rt_rx_cap_chunk chunk;
+	bool deliver = false;
+	bool rearmed = false;
+
+	def_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
+	stream = &def_dev_ctx->rx_cap_stream;
+
+	nrf_wifi_osal_mem_set(&chunk,
+			      0,
+			      sizeof(chunk));
+
+	if (capture_status == 0) {
+		status = hal_rpu_mem_read(fmac_dev_ctx->hal_dev_ctx,
+					  stream->buf[stream->buf_idx],
+					  RPU_MEM_RF_TEST_CAP_BASE,
+					  stream->params.num_samples * NRF_WIFI_RT_RX_CAP_SAMPLE_SZ);
+	}
+
+	if (status == NRF_WIFI_STATUS_SUCCESS) {
+		chunk.seq = stream->seq;
+		chunk.num_lost = stream->num_lost;
+		chunk.timestamp_us = nrf_wifi_osal_time_get_curr_us();
+		chunk.num_samples = stream->params.num_samples;
+		chunk.data = stream->buf[stream->buf_idx];
+
+		stream->buf_idx = !stream->buf_idx;
+		stream->num_lost = 0;
+		stream->stats.num_chunks++;
+		deliver = true;
+	} else {
+		stream->num_lost++;
+		stream->stats.num_lost++;
+	}
+
+	stream->seq++;
+
+	if (stream->params.num_chunks &&
+	    (stream->seq >= stream->params.num_chunks)) {
+		stream->active = false;
+	}
+
+	/* Arm the next capture before handing out this chunk */
+	if (stream->active) {
+		nrf_wifi_osal_mem_set(&rf_test_cap_params,
+				      0,
+				      sizeof(rf_test_cap_params));
+
+		rf_test_cap_params.test = stream->params.rf_test_type;
+		rf_test_cap_params.cap_len = stream->params.num_samples;
+		rf_test_cap_params.cap_time = stream->params.capture_timeout;
+		rf_test_cap_params.lna_gain = stream->params.lna_gain;
+		rf_test_cap_params.bb_gain = stream->params.bb_gain;
+
+		status = umac_cmd_rt_prog_rf_test(fmac_dev_ctx,
+						  &rf_test_cap_params,
+						  sizeof(rf_test_cap_params));
+
+		if (status != NRF_WIFI_STATUS_SUCCESS) {
+			nrf_wifi_osal_log_err("%s: Re-arming the capture failed",
+					      __func__);
+			stream->stats.num_rearm_fail++;
+			stream->active = false;
+		} else {
+			rearmed = true;
+		}
+	}
+
+	if (deliver) {
+		stream->params.chunk_callbk_fn(fmac_dev_ctx->os_dev_ctx,
+					       &chunk);
+	}
+
+	/* Signal the end of the stream only once the last chunk is consumed */
+	if (!rearmed) {
+		stream->in_flight = false;
+		def_dev_ctx->rf_test_type = NRF_WIFI_RF_TEST_MAX;
+		nrf_wifi_osal_completion_complete(fmac_dev_ctx->cmd_comp);
+	}
+}
+
+
 static enum nrf_wifi_status umac_event_rt_rf_test_process(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
 							  void *event)
 {
@@ -85,6 +175,17 @@ static enum nrf_wifi_status umac_event_rt_rf_test_process(struct nrf_wifi_fmac_d
 	case NRF_WIFI_RF_TEST_EVENT_RX_ADC_CAP:
 	case NRF_WIFI_RF_TEST_EVENT_RX_STAT_PKT_CAP:
 	case NRF_WIFI_RF_TEST_EVENT_RX_DYN_PKT_CAP:
+		if (def_dev_ctx->rx_cap_stream.in_flight) {
+			nrf_wifi_osal_mem_cpy(&rf_test_capture_params,
+					      (const unsigned char *)&rf_test_event->rf_test_info.rfevent[0],
+					      sizeof(rf_test_capture_params));
+
+			umac_event_rt_rx_cap_stream_process(fmac_dev_ctx,
+							    rf_test_capture_params.capture_status);
+			status = NRF_WIFI_STATUS_SUCCESS;
+			goto out;
+		}
+
 		status = hal_rpu_mem_read(fmac_dev_ctx->hal_dev_ctx,
 					  def_dev_ctx->rf_test_cap_data,
 					  RPU_MEM_RF_TEST_CAP_BASE,
@@ -156,6 +257,7 @@ static enum nrf_wifi_status umac_event_rt_rf_test_process(struct nrf_wifi_fmac_d
 	}
 
 	def_dev_ctx->rf_test_type = NRF_WIFI_RF_TEST_MAX;
+	nrf_wifi_osal_completion_complete(fmac_dev_ctx->cmd_comp);
 	status = NRF_WIFI_STATUS_SUCCESS;
 
 out:
@@ -187,10 +289,12 @@ static enum nrf_wifi_status umac_event_rt_proc_events(struct nrf_wifi_fmac_dev_c
 		break;
 	case NRF_WIFI_EVENT_INIT_DONE:
 		fmac_dev_ctx->fw_init_done = 1;
+		nrf_wifi_osal_completion_complete(fmac_dev_ctx->fw_init_comp);
 		status = NRF_WIFI_STATUS_SUCCESS;
 		break;
 	case NRF_WIFI_EVENT_DEINIT_DONE:
 		fmac_dev_ctx->fw_deinit_done = 1;
+		nrf_wifi_osal_completion_complete(fmac_dev_ctx->fw_deinit_comp);
 		status = NRF_WIFI_STATUS_SUCCESS;
 		break;
 	case NRF_WIFI_EVENT_RF_TEST:
@@ -201,6 +305,7 @@ static enum nrf_wifi_status umac_event_rt_proc_events(struct nrf_wifi_fmac_dev_c
 		umac_status = ((struct nrf_wifi_umac_event_err_status *)sys_head);
 		def_dev_ctx_rt->radio_cmd_status = umac_status->status;
 		def_dev_ctx_rt->radio_cmd_done = true;
+		nrf_wifi_osal_completion_complete(fmac_dev_ctx->cmd_comp);
 		status = NRF_WIFI_STATUS_SUCCESS;
 		break;
 	default:
@@ -268,6 +373,7 @@ static enum nrf_wifi_status umac_event_ctrl_process(struct nrf_wifi_fmac_dev_ctx
 				      sizeof(struct nrf_wifi_get_reg_chn_info));
 
 		fmac_dev_ctx->alpha2_valid = true;
+		nrf_wifi_osal_completion_complete(fmac_dev_ctx->reg_get_comp);
 		break;
 	case NRF_WIFI_UMAC_EVENT_REG_CHANGE:
 		reg_change_event = (struct nrf_wifi_event_regulatory_change *)event_data;
@@ -284,6 +390,7 @@ static enum nrf_wifi_status umac_event_ctrl_process(struct nrf_wifi_fmac_dev_ctx
 				      reg_change_event,
 				      sizeof(*reg_change_event));
 		fmac_dev_ctx->reg_set_status = true;
+		nrf_wifi_osal_completion_complete(fmac_dev_ctx->reg_set_comp);
 		break;
 	default:
 		nrf_wifi_osal_log_dbg("%s: No callback registered for event %d",
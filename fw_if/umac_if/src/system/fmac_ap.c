@@ -15,6 +15,133 @@
 #include "system/fmac_tx.h"
 #include "common/fmac_util.h"
 
+#define SAP_CLIENT_AC_MASK_ALL ((1 << NRF_WIFI_FMAC_AC_BK) | \
+				(1 << NRF_WIFI_FMAC_AC_BE) | \
+				(1 << NRF_WIFI_FMAC_AC_VI) | \
+				(1 << NRF_WIFI_FMAC_AC_VO))
+
+/* U-APSD flags and max SP length in the QoS info field of the WMM element */
+#define SAP_CLIENT_QOS_INFO_UAPSD_VO (1 << 0)
+#define SAP_CLIENT_QOS_INFO_UAPSD_VI (1 << 1)
+#define SAP_CLIENT_QOS_INFO_UAPSD_BK (1 << 2)
+#define SAP_CLIENT_QOS_INFO_UAPSD_BE (1 << 3)
+#define SAP_CLIENT_QOS_INFO_MAX_SP_SHIFT 5
+#define SAP_CLIENT_QOS_INFO_MAX_SP_MASK 0x3
+/* Offset of the QoS info field in the WMM information element */
+#define SAP_CLIENT_WMM_QOS_INFO_OFFSET 8
+
+
+/* Called with the TX lock held. Kick the TX of the ACs in ac_mask, highest
+ * priority first.
+ */
+static void sap_client_ac_kick(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+			       unsigned char ac_mask)
+{
+	struct nrf_wifi_sys_fmac_priv *sys_priv = NULL;
+	int ac = 0;
+	int desc = 0;
+
+	sys_priv = wifi_fmac_priv(fmac_dev_ctx->fpriv);
+
+	for (ac = NRF_WIFI_FMAC_AC_VO; ac >= 0; --ac) {
+		if (!(ac_mask & (1 << ac))) {
+			continue;
+		}
+
+		desc = tx_desc_get(fmac_dev_ctx, ac);
+
+		if (desc < sys_priv->num_tx_tokens) {
+			tx_pending_process(fmac_dev_ctx, desc, ac);
+		}
+	}
+}
+
+
+/* ACs to be served in the service period requested by a client.
+ *
+ * A trigger frame opens a U-APSD service period for the delivery-enabled ACs,
+ * a PS-Poll retrieves frames from the other ACs (or from any AC if all of
+ * them are delivery-enabled). The RPU does not report which of the two was
+ * received, so, prefer the delivery-enabled ACs when they have frames.
+ */
+static unsigned char sap_client_ps_sp_acs(struct peers_info *peer)
+{
+	unsigned char pend = peer->pend_q_bmp & SAP_CLIENT_AC_MASK_ALL;
+	unsigned char deliv = peer->uapsd_deliv_mask;
+
+	if (peer->uapsd_trig_mask && (pend & deliv)) {
+		return pend & deliv;
+	}
+
+	if (deliv == SAP_CLIENT_AC_MASK_ALL) {
+		return pend;
+	}
+
+	return pend & ~deliv;
+}
+
+
+void sap_client_uapsd_init(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+			   int peer_id,
+			   const unsigned char *ies,
+			   unsigned int ies_len)
+{
+	struct nrf_wifi_fmac_ie_index ie_index;
+	struct nrf_wifi_sys_fmac_dev_ctx *sys_dev_ctx = NULL;
+	struct peers_info *peer = NULL;
+	const unsigned char *wmm = NULL;
+	unsigned char qos_info = 0;
+	unsigned char ac_mask = 0;
+	unsigned char max_sp = 0;
+
+	sys_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
+
+	if (!sys_dev_ctx->tx_config.peers ||
+	    peer_id < 0 || peer_id >= (int)sys_dev_ctx->tx_config.max_peers) {
+		return;
+	}
+
+	peer = &sys_dev_ctx->tx_config.peers[peer_id];
+
+	nrf_wifi_util_ie_index(ies, ies_len, &ie_index);
+
+	/* OUI, OUI type, OUI subtype and version precede the QoS info */
+	if (ie_index.offset[NRF_WIFI_FMAC_IE_WMM] != NRF_WIFI_FMAC_IE_NOT_PRESENT &&
+	    ie_index.len[NRF_WIFI_FMAC_IE_WMM] >= (SAP_CLIENT_WMM_QOS_INFO_OFFSET - 1)) {
+		wmm = ies + ie_index.offset[NRF_WIFI_FMAC_IE_WMM];
+		qos_info = wmm[SAP_CLIENT_WMM_QOS_INFO_OFFSET];
+	}
+
+	if (qos_info & SAP_CLIENT_QOS_INFO_UAPSD_VO) {
+		ac_mask |= (1 << NRF_WIFI_FMAC_AC_VO);
+	}
+
+	if (qos_info & SAP_CLIENT_QOS_INFO_UAPSD_VI) {
+		ac_mask |= (1 << NRF_WIFI_FMAC_AC_VI);
+	}
+
+	if (qos_info & SAP_CLIENT_QOS_INFO_UAPSD_BK) {
+		ac_mask |= (1 << NRF_WIFI_FMAC_AC_BK);
+	}
+
+	if (qos_info & SAP_CLIENT_QOS_INFO_UAPSD_BE) {
+		ac_mask |= (1 << NRF_WIFI_FMAC_AC_BE);
+	}
+
+	/* 0: all buffered frames, 1: 2 frames, 2: 4 frames, 3: 6 frames */
+	max_sp = (qos_info >> SAP_CLIENT_QOS_INFO_MAX_SP_SHIFT) &
+		SAP_CLIENT_QOS_INFO_MAX_SP_MASK;
+
+	/* The WMM QoS info of a client sets up each U-APSD AC as both
+	 * trigger and delivery-enabled.
+	 */
+	peer->uapsd_trig_mask = ac_mask;
+	peer->uapsd_deliv_mask = ac_mask;
+	peer->uapsd_max_sp = max_sp * 2;
+}
+
+
+
 enum nrf_wifi_status sap_client_ps_get_frames(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
 					      struct nrf_wifi_sap_ps_get_frames *config)
 {
@@ -22,10 +149,9 @@ enum nrf_wifi_status sap_client_ps_get_frames(struct nrf_wifi_fmac_dev_ctx *fmac
 	struct peers_info *peer = NULL;
 	void *wakeup_client_q = NULL;
 	int id = -1;
-	int ac = 0;
-	int desc = 0;
+	int num_frames = 0;
+	unsigned char ac_mask = 0;
 	struct nrf_wifi_sys_fmac_dev_ctx *sys_dev_ctx = NULL;
-	struct nrf_wifi_sys_fmac_priv *sys_priv = NULL;
 
 	if (!fmac_dev_ctx || !config) {
 		nrf_wifi_osal_log_err("%s: Invalid params",
@@ -34,7 +160,6 @@ enum nrf_wifi_status sap_client_ps_get_frames(struct nrf_wifi_fmac_dev_ctx *fmac
 	}
 
 	sys_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
-	sys_priv = wifi_fmac_priv(fmac_dev_ctx->fpriv);
 
 	nrf_wifi_osal_spinlock_take(sys_dev_ctx->tx_config.tx_lock);
 
@@ -51,22 +176,37 @@ enum nrf_wifi_status sap_client_ps_get_frames(struct nrf_wifi_fmac_dev_ctx *fmac
 
 
 	peer = &sys_dev_ctx->tx_config.peers[id];
-	peer->ps_token_count = config->num_frames;
+
+	ac_mask = sap_client_ps_sp_acs(peer);
+
+	/* Nothing buffered for the ACs of this service period */
+	if (!ac_mask) {
+		nrf_wifi_osal_spinlock_rel(sys_dev_ctx->tx_config.tx_lock);
+
+		status = NRF_WIFI_STATUS_SUCCESS;
+		goto out;
+	}
+
+	num_frames = config->num_frames;
+
+	if ((ac_mask & peer->uapsd_deliv_mask) &&
+	    peer->uapsd_max_sp &&
+	    num_frames > peer->uapsd_max_sp) {
+		num_frames = peer->uapsd_max_sp;
+	}
+
+	peer->ps_token_count = num_frames;
+	peer->ps_sp_ac_mask = ac_mask;
 
 	wakeup_client_q = sys_dev_ctx->tx_config.wakeup_client_q;
 
-	if (wakeup_client_q) {
+	if (wakeup_client_q && !peer->ps_sp_active) {
 		nrf_wifi_utils_q_enqueue(wakeup_client_q,
 					 peer);
+		peer->ps_sp_active = true;
 	}
 
-	for (ac = NRF_WIFI_FMAC_AC_VO; ac >= 0; --ac) {
-		desc = tx_desc_get(fmac_dev_ctx, ac);
-
-		if (desc < sys_priv->num_tx_tokens) {
-			tx_pending_process(fmac_dev_ctx, desc, ac);
-		}
-	}
+	sap_client_ac_kick(fmac_dev_ctx, ac_mask);
 
 	nrf_wifi_osal_spinlock_rel(sys_dev_ctx->tx_config.tx_lock);
 
@@ -81,12 +221,8 @@ enum nrf_wifi_status sap_client_update_pmmode(struct nrf_wifi_fmac_dev_ctx *fmac
 {
 	enum nrf_wifi_status status = NRF_WIFI_STATUS_FAIL;
 	struct peers_info *peer = NULL;
-	void *wakeup_client_q = NULL;
 	int id = -1;
-	int ac = 0;
-	int desc = 0;
 	struct nrf_wifi_sys_fmac_dev_ctx *sys_dev_ctx = NULL;
-	struct nrf_wifi_sys_fmac_priv *sys_priv = NULL;
 
 	if (!fmac_dev_ctx || !config) {
 		nrf_wifi_osal_log_err("%s: Invalid params",
@@ -95,7 +231,6 @@ enum nrf_wifi_status sap_client_update_pmmode(struct nrf_wifi_fmac_dev_ctx *fmac
 	}
 
 	sys_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
-	sys_priv = wifi_fmac_priv(fmac_dev_ctx->fpriv);
 
 	nrf_wifi_osal_spinlock_take(sys_dev_ctx->tx_config.tx_lock);
 
@@ -114,23 +249,17 @@ enum nrf_wifi_status sap_client_update_pmmode(struct nrf_wifi_fmac_dev_ctx *fmac
 
 
 	peer = &sys_dev_ctx->tx_config.peers[id];
-	peer->ps_state = config->sta_ps_state;
 
-	if (peer->ps_state == NRF_WIFI_CLIENT_ACTIVE) {
-		wakeup_client_q = sys_dev_ctx->tx_config.wakeup_client_q;
-
-		if (wakeup_client_q) {
-			nrf_wifi_utils_q_enqueue(wakeup_client_q,
-						 peer);
-		}
+	tx_ps_state_set(fmac_dev_ctx, peer, config->sta_ps_state);
 
-		for (ac = NRF_WIFI_FMAC_AC_VO; ac >= 0; --ac) {
-			desc = tx_desc_get(fmac_dev_ctx, ac);
+	if (peer->ps_state == NRF_WIFI_CLIENT_ACTIVE) {
+		/* Any service period ends when the client leaves power save,
+		 * only the ACs which have frames buffered need a kick.
+		 */
+		tx_ps_sp_end(fmac_dev_ctx, peer);
 
-			if (desc < sys_priv->num_tx_tokens) {
-				tx_pending_process(fmac_dev_ctx, desc, ac);
-			}
-		}
+		sap_client_ac_kick(fmac_dev_ctx,
+				   peer->pend_q_bmp & SAP_CLIENT_AC_MASK_ALL);
 	}
 
 	nrf_wifi_osal_spinlock_rel(sys_dev_ctx->tx_config.tx_lock);
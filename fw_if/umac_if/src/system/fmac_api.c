@@ -21,6 +21,15 @@
 #include "system/fmac_rx.h"
 #include "system/fmac_cmd.h"
 #include "system/fmac_event.h"
+#include "system/fmac_cmd_async.h"
+#ifdef NRF_WIFI_RPU_RECOVERY
+#include "system/fmac_recovery.h"
+#endif /* NRF_WIFI_RPU_RECOVERY */
+#include "system/fmac_bss.h"
+#if defined(NRF70_RAW_DATA_RX) || defined(NRF70_PROMISC_DATA_RX)
+#include "system/fmac_promisc.h"
+#endif /* NRF70_RAW_DATA_RX || NRF70_PROMISC_DATA_RX */
+#include "system/fmac_event_dispatch.h"
 #include "system/fmac_bb.h"
 #include "util.h"
 
@@ -203,15 +212,21 @@ static enum nrf_wifi_status nrf_wifi_sys_fmac_fw_init(struct nrf_wifi_fmac_dev_c
 						      struct nrf_wifi_board_params *board_params,
 						      unsigned char *country_code)
 {
-	unsigned long start_time_us = 0;
 	enum nrf_wifi_status status = NRF_WIFI_STATUS_FAIL;
 	struct nrf_wifi_sys_fmac_priv *sys_fpriv = NULL;
 
 	sys_fpriv = wifi_fmac_priv(fmac_dev_ctx->fpriv);
 
 #ifdef NRF70_DATA_TX
+	nrf_wifi_util_boot_phase_start(fmac_dev_ctx,
+				       NRF_WIFI_FMAC_BOOT_PHASE_INIT_TX);
+
 	status = nrf_wifi_sys_fmac_init_tx(fmac_dev_ctx);
 
+	nrf_wifi_util_boot_phase_end(fmac_dev_ctx,
+				     NRF_WIFI_FMAC_BOOT_PHASE_INIT_TX,
+				     status);
+
 	if (status != NRF_WIFI_STATUS_SUCCESS) {
 		nrf_wifi_osal_log_err("%s: Init TX failed",
 				      __func__);
@@ -219,8 +234,15 @@ static enum nrf_wifi_status nrf_wifi_sys_fmac_fw_init(struct nrf_wifi_fmac_dev_c
 	}
 #endif /* NRF70_DATA_TX */
 
+	nrf_wifi_util_boot_phase_start(fmac_dev_ctx,
+				       NRF_WIFI_FMAC_BOOT_PHASE_INIT_RX);
+
 	status = nrf_wifi_sys_fmac_init_rx(fmac_dev_ctx);
 
+	nrf_wifi_util_boot_phase_end(fmac_dev_ctx,
+				     NRF_WIFI_FMAC_BOOT_PHASE_INIT_RX,
+				     status);
+
 	if (status != NRF_WIFI_STATUS_SUCCESS) {
 		nrf_wifi_osal_log_err("%s: Init RX failed",
 				      __func__);
@@ -230,6 +252,11 @@ static enum nrf_wifi_status nrf_wifi_sys_fmac_fw_init(struct nrf_wifi_fmac_dev_c
 		goto out;
 	}
 
+	nrf_wifi_osal_completion_init(fmac_dev_ctx->fw_init_comp);
+
+	nrf_wifi_util_boot_phase_start(fmac_dev_ctx,
+				       NRF_WIFI_FMAC_BOOT_PHASE_FW_INIT);
+
 	status = umac_cmd_sys_init(fmac_dev_ctx,
 				   rf_params,
 				   rf_params_valid,
@@ -247,20 +274,23 @@ static enum nrf_wifi_status nrf_wifi_sys_fmac_fw_init(struct nrf_wifi_fmac_dev_c
 	if (status != NRF_WIFI_STATUS_SUCCESS) {
 		nrf_wifi_osal_log_err("%s: UMAC init failed",
 				      __func__);
+		nrf_wifi_util_boot_phase_end(fmac_dev_ctx,
+					     NRF_WIFI_FMAC_BOOT_PHASE_FW_INIT,
+					     status);
 		nrf_wifi_sys_fmac_deinit_rx(fmac_dev_ctx);
 #ifdef NRF70_DATA_TX
 		nrf_wifi_sys_fmac_deinit_tx(fmac_dev_ctx);
 #endif /* NRF70_DATA_TX */
 		goto out;
 	}
-	start_time_us = nrf_wifi_osal_time_get_curr_us();
-	while (!fmac_dev_ctx->fw_init_done) {
-		nrf_wifi_osal_sleep_ms(1);
-#define MAX_INIT_WAIT (5 * 1000 * 1000)
-		if (nrf_wifi_osal_time_elapsed_us(start_time_us) >= MAX_INIT_WAIT) {
-			break;
-		}
-	}
+#define MAX_INIT_WAIT_MS (5 * 1000)
+	nrf_wifi_osal_completion_wait(fmac_dev_ctx->fw_init_comp,
+				      MAX_INIT_WAIT_MS);
+
+	nrf_wifi_util_boot_phase_end(fmac_dev_ctx,
+				     NRF_WIFI_FMAC_BOOT_PHASE_FW_INIT,
+				     fmac_dev_ctx->fw_init_done ?
+				     NRF_WIFI_STATUS_SUCCESS : NRF_WIFI_STATUS_FAIL);
 
 	if (!fmac_dev_ctx->fw_init_done) {
 		nrf_wifi_osal_log_err("%s: UMAC init timed out",
@@ -283,9 +313,10 @@ static void nrf_wifi_sys_fmac_fw_deinit(struct nrf_wifi_fmac_dev_ctx *fmac_dev_c
 {
 	/* TODO: To be activated once UMAC supports deinit */
 #ifdef NOTYET
-	unsigned long start_time_us = 0;
 	enum nrf_wifi_status status = NRF_WIFI_STATUS_FAIL;
 
+	nrf_wifi_osal_completion_init(fmac_dev_ctx->fw_deinit_comp);
+
 	status = umac_cmd_deinit(fmac_dev_ctx);
 
 	if (status != NRF_WIFI_STATUS_SUCCESS) {
@@ -294,15 +325,9 @@ static void nrf_wifi_sys_fmac_fw_deinit(struct nrf_wifi_fmac_dev_ctx *fmac_dev_c
 		goto out;
 	}
 
-	start_time_us = nrf_wifi_osal_time_get_curr_us();
-
-	while (!fmac_dev_ctx->fw_deinit_done) {
-#define MAX_DEINIT_WAIT (5 * 1000 * 1000)
-		nrf_wifi_osal_sleep_ms(1);
-		if (nrf_wifi_osal_time_elapsed_us(start_time_us) >= MAX_DEINIT_WAIT) {
-			break;
-		}
-	}
+#define MAX_DEINIT_WAIT_MS (5 * 1000)
+	nrf_wifi_osal_completion_wait(fmac_dev_ctx->fw_deinit_comp,
+				      MAX_DEINIT_WAIT_MS);
 
 	if (!fmac_dev_ctx->fw_deinit_done) {
 		nrf_wifi_osal_log_err("%s: UMAC deinit timed out",
@@ -349,6 +374,15 @@ struct nrf_wifi_fmac_dev_ctx *nrf_wifi_sys_fmac_dev_add(struct nrf_wifi_fmac_pri
 	fmac_dev_ctx->fpriv = fpriv;
 	fmac_dev_ctx->os_dev_ctx = os_dev_ctx;
 
+	nrf_wifi_util_boot_phase_start(fmac_dev_ctx,
+				       NRF_WIFI_FMAC_BOOT_PHASE_DEV_ADD);
+
+	if (nrf_wifi_fmac_dev_comps_alloc(fmac_dev_ctx) != NRF_WIFI_STATUS_SUCCESS) {
+		nrf_wifi_osal_mem_free(fmac_dev_ctx);
+		fmac_dev_ctx = NULL;
+		goto out;
+	}
+
 	fmac_dev_ctx->hal_dev_ctx = nrf_wifi_sys_hal_dev_add(fpriv->hpriv,
 							     fmac_dev_ctx);
 
@@ -356,6 +390,7 @@ struct nrf_wifi_fmac_dev_ctx *nrf_wifi_sys_fmac_dev_add(struct nrf_wifi_fmac_pri
 		nrf_wifi_osal_log_err("%s: nrf_wifi_sys_hal_dev_add failed",
 				      __func__);
 
+		nrf_wifi_fmac_dev_comps_free(fmac_dev_ctx);
 		nrf_wifi_osal_mem_free(fmac_dev_ctx);
 		fmac_dev_ctx = NULL;
 		goto out;
@@ -367,6 +402,10 @@ struct nrf_wifi_fmac_dev_ctx *nrf_wifi_sys_fmac_dev_add(struct nrf_wifi_fmac_pri
 #endif /* NRF70_DATA_TX */
 
 	fmac_dev_ctx->op_mode = NRF_WIFI_OP_MODE_SYS;
+
+	nrf_wifi_util_boot_phase_end(fmac_dev_ctx,
+				     NRF_WIFI_FMAC_BOOT_PHASE_DEV_ADD,
+				     NRF_WIFI_STATUS_SUCCESS);
 out:
 	return fmac_dev_ctx;
 }
@@ -387,6 +426,10 @@ enum nrf_wifi_status nrf_wifi_sys_fmac_dev_init(struct nrf_wifi_fmac_dev_ctx *fm
 	enum nrf_wifi_status status = NRF_WIFI_STATUS_FAIL;
 	struct nrf_wifi_fmac_otp_info otp_info;
 	struct nrf_wifi_phy_rf_params phy_rf_params;
+	struct nrf_wifi_sys_fmac_dev_ctx *sys_dev_ctx = NULL;
+#ifdef NRF_WIFI_RPU_RECOVERY
+	unsigned long start_time_ms = 0;
+#endif /* NRF_WIFI_RPU_RECOVERY */
 
 	if (!fmac_dev_ctx) {
 		nrf_wifi_osal_log_err("%s: Invalid device context",
@@ -400,17 +443,59 @@ enum nrf_wifi_status nrf_wifi_sys_fmac_dev_init(struct nrf_wifi_fmac_dev_ctx *fm
 		goto out;
 	}
 
+#ifdef NRF_WIFI_RPU_RECOVERY
+	start_time_ms = nrf_wifi_osal_time_get_curr_ms();
+#endif /* NRF_WIFI_RPU_RECOVERY */
+
+	nrf_wifi_util_boot_phase_start(fmac_dev_ctx,
+				       NRF_WIFI_FMAC_BOOT_PHASE_DEV_INIT);
+
 	fmac_dev_ctx->tx_pwr_ceil_params = nrf_wifi_osal_mem_alloc(sizeof(*tx_pwr_ceil_params));
 	nrf_wifi_osal_mem_cpy(fmac_dev_ctx->tx_pwr_ceil_params,
 			      tx_pwr_ceil_params,
 			      sizeof(*tx_pwr_ceil_params));
 
+	status = nrf_wifi_sys_fmac_cmd_async_init(fmac_dev_ctx);
+
+	if (status != NRF_WIFI_STATUS_SUCCESS) {
+		goto out;
+	}
+
+	status = nrf_wifi_sys_fmac_bss_table_init(fmac_dev_ctx);
+
+	if (status != NRF_WIFI_STATUS_SUCCESS) {
+		goto err;
+	}
+
+	status = nrf_wifi_sys_fmac_event_dispatch_init(fmac_dev_ctx);
+
+	if (status != NRF_WIFI_STATUS_SUCCESS) {
+		goto err;
+	}
+
+	sys_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
+
+	nrf_wifi_osal_mem_set(&sys_dev_ctx->stats_periodic,
+			      0,
+			      sizeof(sys_dev_ctx->stats_periodic));
+
+	sys_dev_ctx->stats_periodic.lock = nrf_wifi_osal_spinlock_alloc();
+
+	if (!sys_dev_ctx->stats_periodic.lock) {
+		nrf_wifi_osal_log_err("%s: Unable to allocate periodic stats lock",
+				      __func__);
+		status = NRF_WIFI_STATUS_FAIL;
+		goto err;
+	}
+
+	nrf_wifi_osal_spinlock_init(sys_dev_ctx->stats_periodic.lock);
+
 	status = nrf_wifi_hal_dev_init(fmac_dev_ctx->hal_dev_ctx);
 
 	if (status != NRF_WIFI_STATUS_SUCCESS) {
 		nrf_wifi_osal_log_err("%s: nrf_wifi_hal_dev_init failed",
 				      __func__);
-		goto out;
+		goto err;
 	}
 
 	nrf_wifi_osal_mem_set(&otp_info,
@@ -424,7 +509,7 @@ enum nrf_wifi_status nrf_wifi_sys_fmac_dev_init(struct nrf_wifi_fmac_dev_ctx *fm
 	if (status != NRF_WIFI_STATUS_SUCCESS) {
 		nrf_wifi_osal_log_err("%s: Fetching of RPU OTP information failed",
 				      __func__);
-		goto out;
+		goto err;
 	}
 
 	status = nrf_wifi_sys_fmac_rf_params_get(fmac_dev_ctx,
@@ -432,9 +517,13 @@ enum nrf_wifi_status nrf_wifi_sys_fmac_dev_init(struct nrf_wifi_fmac_dev_ctx *fm
 	if (status != NRF_WIFI_STATUS_SUCCESS) {
 		nrf_wifi_osal_log_err("%s: RF parameters get failed",
 				      __func__);
-		goto out;
+		goto err;
 	}
 
+	nrf_wifi_util_boot_phase_end(fmac_dev_ctx,
+				     NRF_WIFI_FMAC_BOOT_PHASE_DEV_INIT,
+				     status);
+
 	status = nrf_wifi_sys_fmac_fw_init(fmac_dev_ctx,
 				       &phy_rf_params,
 				       true,
@@ -451,7 +540,24 @@ enum nrf_wifi_status nrf_wifi_sys_fmac_dev_init(struct nrf_wifi_fmac_dev_ctx *fm
 	if (status == NRF_WIFI_STATUS_FAIL) {
 		nrf_wifi_osal_log_err("%s: nrf_wifi_sys_fmac_fw_init failed",
 				      __func__);
-		goto out;
+		goto err;
+	}
+#ifdef NRF_WIFI_RPU_RECOVERY
+	nrf_wifi_sys_fmac_recovery_dev_init(fmac_dev_ctx,
+					    start_time_ms);
+#endif /* NRF_WIFI_RPU_RECOVERY */
+	goto out;
+err:
+	/* Release what was set up so far, the teardown helpers skip the
+	 * parts which were never initialized.
+	 */
+	nrf_wifi_sys_fmac_event_dispatch_deinit(fmac_dev_ctx);
+	nrf_wifi_sys_fmac_bss_table_deinit(fmac_dev_ctx);
+	nrf_wifi_sys_fmac_cmd_async_deinit(fmac_dev_ctx);
+
+	if (sys_dev_ctx && sys_dev_ctx->stats_periodic.lock) {
+		nrf_wifi_osal_spinlock_free(sys_dev_ctx->stats_periodic.lock);
+		sys_dev_ctx->stats_periodic.lock = NULL;
 	}
 out:
 	return status;
@@ -479,6 +585,8 @@ enum nrf_wifi_status nrf_wifi_coex_config_sleep_ctrl_gpio_ctrl(
 
 void nrf_wifi_sys_fmac_dev_deinit(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx)
 {
+	struct nrf_wifi_sys_fmac_dev_ctx *sys_dev_ctx = NULL;
+
 	if (fmac_dev_ctx->op_mode != NRF_WIFI_OP_MODE_SYS) {
 		nrf_wifi_osal_log_err("%s: Invalid op mode",
 				      __func__);
@@ -487,6 +595,26 @@ void nrf_wifi_sys_fmac_dev_deinit(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx)
 
 	nrf_wifi_hal_dev_deinit(fmac_dev_ctx->hal_dev_ctx);
 	nrf_wifi_sys_fmac_fw_deinit(fmac_dev_ctx);
+	nrf_wifi_sys_fmac_cmd_async_deinit(fmac_dev_ctx);
+	nrf_wifi_sys_fmac_bss_table_deinit(fmac_dev_ctx);
+	nrf_wifi_sys_fmac_event_dispatch_deinit(fmac_dev_ctx);
+	nrf_wifi_sys_fmac_stats_periodic_stop(fmac_dev_ctx);
+#ifdef NRF_WIFI_RPU_RECOVERY
+	nrf_wifi_sys_fmac_recovery_dev_deinit(fmac_dev_ctx);
+#endif /* NRF_WIFI_RPU_RECOVERY */
+
+	sys_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
+
+	if (sys_dev_ctx->stats_periodic.lock) {
+		nrf_wifi_osal_spinlock_free(sys_dev_ctx->stats_periodic.lock);
+		sys_dev_ctx->stats_periodic.lock = NULL;
+	}
+
+	if (sys_dev_ctx->stats_periodic.snap) {
+		nrf_wifi_osal_mem_free(sys_dev_ctx->stats_periodic.snap);
+		sys_dev_ctx->stats_periodic.snap = NULL;
+	}
+
 	nrf_wifi_osal_mem_free(fmac_dev_ctx->tx_pwr_ceil_params);
 }
 
@@ -500,6 +628,7 @@ enum nrf_wifi_status nrf_wifi_sys_fmac_rpu_recovery_callback(void *mac_dev_ctx,
 	struct nrf_wifi_sys_fmac_dev_ctx *sys_dev_ctx = NULL;
 	struct nrf_wifi_fmac_priv *fpriv = NULL;
 	struct nrf_wifi_sys_fmac_priv *sys_fpriv = NULL;
+	struct nrf_wifi_hal_recovery_info *info = NULL;
 
 	fmac_dev_ctx = mac_dev_ctx;
 	if (!fmac_dev_ctx) {
@@ -528,6 +657,13 @@ enum nrf_wifi_status nrf_wifi_sys_fmac_rpu_recovery_callback(void *mac_dev_ctx,
 		goto out;
 	}
 
+	if (event_data && (len == sizeof(struct nrf_wifi_hal_recovery_info))) {
+		info = event_data;
+	}
+
+	nrf_wifi_sys_fmac_recovery_request(fmac_dev_ctx,
+					   info);
+
 	/* Here we only care about FMAC, so, just use VIF0 */
 	sys_fpriv->callbk_fns.rpu_recovery_callbk_fn(sys_dev_ctx->vif_ctx[0],
 			event_data, len);
@@ -540,7 +676,8 @@ out:
 
 struct nrf_wifi_fmac_priv *nrf_wifi_sys_fmac_init(struct nrf_wifi_data_config_params *data_config,
 						  struct rx_buf_pool_params *rx_buf_pools,
-						  struct nrf_wifi_fmac_callbk_fns *callbk_fns)
+						  struct nrf_wifi_fmac_callbk_fns *callbk_fns,
+						  unsigned int max_peers)
 {
 	struct nrf_wifi_fmac_priv *fpriv = NULL;
 	struct nrf_wifi_sys_fmac_priv *sys_fpriv = NULL;
@@ -548,6 +685,14 @@ struct nrf_wifi_fmac_priv *nrf_wifi_sys_fmac_init(struct nrf_wifi_data_config_pa
 	unsigned int pool_idx = 0;
 	unsigned int desc = 0;
 
+	if (max_peers > NRF_WIFI_FMAC_MAX_PEERS_LIMIT) {
+		nrf_wifi_osal_log_err("%s: Invalid number of peers %d (max %d)",
+				      __func__,
+				      max_peers,
+				      NRF_WIFI_FMAC_MAX_PEERS_LIMIT);
+		goto out;
+	}
+
 	fpriv = nrf_wifi_osal_mem_zalloc(sizeof(*fpriv) + sizeof(*sys_fpriv));
 
 	if (!fpriv) {
@@ -574,6 +719,8 @@ struct nrf_wifi_fmac_priv *nrf_wifi_sys_fmac_init(struct nrf_wifi_data_config_pa
 	sys_fpriv->num_tx_tokens = NRF70_MAX_TX_TOKENS;
 	sys_fpriv->num_tx_tokens_per_ac = (sys_fpriv->num_tx_tokens / NRF_WIFI_FMAC_AC_MAX);
 	sys_fpriv->num_tx_tokens_spare = (sys_fpriv->num_tx_tokens % NRF_WIFI_FMAC_AC_MAX);
+	sys_fpriv->max_tx_aggregation_limit = sys_fpriv->data_config.max_tx_aggregation;
+	sys_fpriv->max_peers = max_peers ? max_peers : MAX_PEERS;
 #endif /* NRF70_DATA_TX */
 	nrf_wifi_osal_mem_cpy(sys_fpriv->rx_buf_pools,
 			      rx_buf_pools,
@@ -587,6 +734,17 @@ struct nrf_wifi_fmac_priv *nrf_wifi_sys_fmac_init(struct nrf_wifi_data_config_pa
 
 	sys_fpriv->num_rx_bufs = desc;
 
+#ifdef NRF_WIFI_RPU_RECOVERY
+	if (nrf_wifi_sys_fmac_recovery_init(fpriv) != NRF_WIFI_STATUS_SUCCESS) {
+		nrf_wifi_osal_log_err("%s: Unable to initialize RPU recovery",
+				      __func__);
+		nrf_wifi_osal_mem_free(fpriv);
+		fpriv = NULL;
+		sys_fpriv = NULL;
+		goto out;
+	}
+#endif /* NRF_WIFI_RPU_RECOVERY */
+
 	hal_cfg_params.rx_buf_headroom_sz = RX_BUF_HEADROOM;
 	hal_cfg_params.tx_buf_headroom_sz = TX_BUF_HEADROOM;
 #ifdef NRF70_DATA_TX
@@ -618,6 +776,9 @@ struct nrf_wifi_fmac_priv *nrf_wifi_sys_fmac_init(struct nrf_wifi_data_config_pa
 	if (!fpriv->hpriv) {
 		nrf_wifi_osal_log_err("%s: Unable to do HAL init",
 				      __func__);
+#ifdef NRF_WIFI_RPU_RECOVERY
+		nrf_wifi_sys_fmac_recovery_deinit(fpriv);
+#endif /* NRF_WIFI_RPU_RECOVERY */
 		nrf_wifi_osal_mem_free(fpriv);
 		fpriv = NULL;
 		sys_fpriv = NULL;
@@ -678,6 +839,110 @@ out:
 	return status;
 }
 
+enum nrf_wifi_status nrf_wifi_sys_fmac_scan_targeted(void *dev_ctx,
+						     unsigned char if_idx,
+						     struct nrf_wifi_umac_scan_info *scan_info,
+						     unsigned int *num_chans)
+{
+	enum nrf_wifi_status status = NRF_WIFI_STATUS_FAIL;
+	struct nrf_wifi_umac_scan_info *targeted_info = NULL;
+	struct nrf_wifi_scan_params *scan_params = NULL;
+	unsigned int freqs[NRF_WIFI_FMAC_CHAN_HINT_MAX_SCAN_CHANS];
+	unsigned int ssid_freqs[NRF_WIFI_FMAC_CHAN_HINT_MAX_SCAN_CHANS];
+	unsigned int num_ssid_freqs = 0;
+	unsigned int num_freqs = 0;
+	unsigned int i = 0;
+	unsigned int j = 0;
+	unsigned int k = 0;
+
+	if (!dev_ctx || !scan_info || !num_chans) {
+		nrf_wifi_osal_log_err("%s: Invalid parameters",
+				      __func__);
+		goto out;
+	}
+
+	scan_params = &scan_info->scan_params;
+
+	*num_chans = scan_params->num_scan_channels;
+
+	/* Nothing to target, the caller has already chosen the channels */
+	if (scan_params->num_scan_channels || !scan_params->num_scan_ssids) {
+		status = nrf_wifi_sys_fmac_scan(dev_ctx,
+						if_idx,
+						scan_info);
+		goto out;
+	}
+
+	for (i = 0; (i < scan_params->num_scan_ssids) && (i < NRF_WIFI_SCAN_MAX_NUM_SSIDS); i++) {
+		status = nrf_wifi_sys_fmac_chan_hints_get(dev_ctx,
+							  &scan_params->scan_ssids[i],
+							  ssid_freqs,
+							  NRF_WIFI_FMAC_CHAN_HINT_MAX_SCAN_CHANS,
+							  &num_ssid_freqs);
+
+		if (status != NRF_WIFI_STATUS_SUCCESS) {
+			goto out;
+		}
+
+		for (j = 0; (j < num_ssid_freqs) && (num_freqs < ARRAY_SIZE(freqs)); j++) {
+			for (k = 0; k < num_freqs; k++) {
+				if (freqs[k] == ssid_freqs[j]) {
+					break;
+				}
+			}
+
+			if (k == num_freqs) {
+				freqs[num_freqs++] = ssid_freqs[j];
+			}
+		}
+	}
+
+	if (!num_freqs) {
+		/* No hints, fall back to the scan requested by the caller */
+		status = nrf_wifi_sys_fmac_scan(dev_ctx,
+						if_idx,
+						scan_info);
+		goto out;
+	}
+
+	/* nrf_wifi_sys_fmac_scan copies the channel list sized in units of
+	 * struct nrf_wifi_channel, so allocate accordingly.
+	 */
+	targeted_info = nrf_wifi_osal_mem_zalloc(sizeof(*targeted_info) +
+						 (sizeof(struct nrf_wifi_channel) * num_freqs));
+
+	if (!targeted_info) {
+		nrf_wifi_osal_log_err("%s: Unable to allocate memory",
+				      __func__);
+		status = NRF_WIFI_STATUS_FAIL;
+		goto out;
+	}
+
+	nrf_wifi_osal_mem_cpy(targeted_info,
+			      scan_info,
+			      sizeof(*targeted_info));
+
+	for (i = 0; i < num_freqs; i++) {
+		targeted_info->scan_params.center_frequency[i] = freqs[i];
+	}
+
+	targeted_info->scan_params.num_scan_channels = num_freqs;
+
+	status = nrf_wifi_sys_fmac_scan(dev_ctx,
+					if_idx,
+					targeted_info);
+
+	if (status == NRF_WIFI_STATUS_SUCCESS) {
+		*num_chans = num_freqs;
+	}
+out:
+	if (targeted_info) {
+		nrf_wifi_osal_mem_free(targeted_info);
+	}
+
+	return status;
+}
+
 enum nrf_wifi_status nrf_wifi_sys_fmac_abort_scan(void *dev_ctx,
 						  unsigned char if_idx)
 {
@@ -909,6 +1174,9 @@ enum nrf_wifi_status nrf_wifi_sys_fmac_assoc(void *dev_ctx,
 			      assoc_info->nrf_wifi_bssid,
 			      NRF_WIFI_ETH_ADDR_LEN);
 
+	nrf_wifi_sys_fmac_chan_hint_assoc_start(fmac_dev_ctx,
+						assoc_info);
+
 	assoc_cmd = nrf_wifi_osal_mem_zalloc(sizeof(*assoc_cmd));
 
 	if (!assoc_cmd) {
@@ -1048,6 +1316,9 @@ enum nrf_wifi_status nrf_wifi_sys_fmac_add_key(void *dev_ctx,
 	struct nrf_wifi_sys_fmac_dev_ctx *sys_dev_ctx = NULL;
 	struct nrf_wifi_fmac_vif_ctx *vif_ctx = NULL;
 	int peer_id = -1;
+#ifdef NRF_WIFI_RPU_RECOVERY
+	unsigned int key_id = 0;
+#endif /* NRF_WIFI_RPU_RECOVERY */
 
 	fmac_dev_ctx = dev_ctx;
 
@@ -1115,9 +1386,26 @@ enum nrf_wifi_status nrf_wifi_sys_fmac_add_key(void *dev_ctx,
 	key_cmd->key_info.valid_fields |= NRF_WIFI_CIPHER_SUITE_VALID;
 	key_cmd->key_info.valid_fields |= NRF_WIFI_KEY_TYPE_VALID;
 
+#ifdef NRF_WIFI_RPU_RECOVERY
+	key_id = (nrf_wifi_sys_fmac_recovery_addr_key((const unsigned char *)mac_addr) << 8) |
+		 ((key_info->key_type & 0xF) << 4) |
+		 (key_info->key_idx & 0xF);
+#endif /* NRF_WIFI_RPU_RECOVERY */
 	status = umac_cmd_cfg(fmac_dev_ctx,
 			      key_cmd,
 			      sizeof(*key_cmd));
+#ifdef NRF_WIFI_RPU_RECOVERY
+	if ((status == NRF_WIFI_STATUS_SUCCESS) &&
+	    nrf_wifi_sys_fmac_recovery_keys_enabled(fmac_dev_ctx)) {
+		nrf_wifi_sys_fmac_recovery_record(fmac_dev_ctx,
+						  NRF_WIFI_HOST_RPU_MSG_TYPE_UMAC,
+						  if_idx,
+						  NRF_WIFI_UMAC_CMD_NEW_KEY,
+						  key_id,
+						  key_cmd,
+						  sizeof(*key_cmd));
+	}
+#endif /* NRF_WIFI_RPU_RECOVERY */
 
 out:
 	if (key_cmd) {
@@ -1137,6 +1425,9 @@ enum nrf_wifi_status nrf_wifi_sys_fmac_del_key(void *dev_ctx,
 	struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx = NULL;
 	struct nrf_wifi_fmac_vif_ctx *vif_ctx = NULL;
 	struct nrf_wifi_sys_fmac_dev_ctx *sys_dev_ctx = NULL;
+#ifdef NRF_WIFI_RPU_RECOVERY
+	unsigned int key_id = 0;
+#endif /* NRF_WIFI_RPU_RECOVERY */
 
 	fmac_dev_ctx = dev_ctx;
 
@@ -1181,9 +1472,23 @@ enum nrf_wifi_status nrf_wifi_sys_fmac_del_key(void *dev_ctx,
 		vif_ctx->groupwise_cipher = 0;
 	}
 
+#ifdef NRF_WIFI_RPU_RECOVERY
+	key_id = (nrf_wifi_sys_fmac_recovery_addr_key((const unsigned char *)mac_addr) << 8) |
+		 ((key_info->key_type & 0xF) << 4) |
+		 (key_info->key_idx & 0xF);
+#endif /* NRF_WIFI_RPU_RECOVERY */
 	status = umac_cmd_cfg(fmac_dev_ctx,
 			      key_cmd,
 			      sizeof(*key_cmd));
+#ifdef NRF_WIFI_RPU_RECOVERY
+	if (status == NRF_WIFI_STATUS_SUCCESS) {
+		nrf_wifi_sys_fmac_recovery_forget(fmac_dev_ctx,
+						  NRF_WIFI_HOST_RPU_MSG_TYPE_UMAC,
+						  if_idx,
+						  NRF_WIFI_UMAC_CMD_NEW_KEY,
+						  key_id);
+	}
+#endif /* NRF_WIFI_RPU_RECOVERY */
 
 out:
 	if (key_cmd) {
@@ -1231,6 +1536,18 @@ enum nrf_wifi_status nrf_wifi_sys_fmac_set_key(void *dev_ctx,
 	status = umac_cmd_cfg(fmac_dev_ctx,
 			      set_key_cmd,
 			      sizeof(*set_key_cmd));
+#ifdef NRF_WIFI_RPU_RECOVERY
+	if ((status == NRF_WIFI_STATUS_SUCCESS) &&
+	    nrf_wifi_sys_fmac_recovery_keys_enabled(fmac_dev_ctx)) {
+		nrf_wifi_sys_fmac_recovery_record(fmac_dev_ctx,
+						  NRF_WIFI_HOST_RPU_MSG_TYPE_UMAC,
+						  if_idx,
+						  NRF_WIFI_UMAC_CMD_SET_KEY,
+						  0,
+						  set_key_cmd,
+						  sizeof(*set_key_cmd));
+	}
+#endif /* NRF_WIFI_RPU_RECOVERY */
 
 out:
 	if (set_key_cmd) {
@@ -1526,6 +1843,12 @@ enum nrf_wifi_status nrf_wifi_sys_fmac_start_ap(void *dev_ctx,
 			      start_ap_cmd,
 			      sizeof(*start_ap_cmd));
 
+	if (status == NRF_WIFI_STATUS_SUCCESS) {
+		tx_mc_dtim_config(fmac_dev_ctx,
+				  ap_info->beacon_interval,
+				  ap_info->dtim_period);
+	}
+
 out:
 	if (wiphy_info) {
 		nrf_wifi_osal_mem_free(wiphy_info);
@@ -1568,6 +1891,8 @@ enum nrf_wifi_status nrf_wifi_sys_fmac_stop_ap(void *dev_ctx,
 
 	nrf_wifi_fmac_peers_flush(fmac_dev_ctx, if_idx);
 
+	tx_mc_dtim_config(fmac_dev_ctx, 0, 0);
+
 	status = umac_cmd_cfg(fmac_dev_ctx,
 			      stop_ap_cmd,
 			      sizeof(*stop_ap_cmd));
@@ -1580,6 +1905,38 @@ out:
 	return status;
 }
 
+
+enum nrf_wifi_status nrf_wifi_sys_fmac_ap_dtim_tick(void *dev_ctx)
+{
+	enum nrf_wifi_status status = NRF_WIFI_STATUS_FAIL;
+	struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx = NULL;
+	struct nrf_wifi_sys_fmac_dev_ctx *sys_dev_ctx = NULL;
+
+	fmac_dev_ctx = dev_ctx;
+
+	if (!fmac_dev_ctx || fmac_dev_ctx->op_mode != NRF_WIFI_OP_MODE_SYS) {
+		nrf_wifi_osal_log_err("%s: Invalid params",
+				      __func__);
+		goto out;
+	}
+
+	sys_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
+
+	if (!sys_dev_ctx->tx_config.tx_lock) {
+		goto out;
+	}
+
+	nrf_wifi_osal_spinlock_take(sys_dev_ctx->tx_config.tx_lock);
+
+	tx_mc_dtim_check(fmac_dev_ctx);
+
+	nrf_wifi_osal_spinlock_rel(sys_dev_ctx->tx_config.tx_lock);
+
+	status = NRF_WIFI_STATUS_SUCCESS;
+out:
+	return status;
+}
+
 enum nrf_wifi_status nrf_wifi_sys_fmac_del_sta(void *dev_ctx,
 					       unsigned char if_idx,
 					       struct nrf_wifi_umac_del_sta_info *del_sta_info)
@@ -2100,6 +2457,26 @@ unsigned char nrf_wifi_sys_fmac_add_vif(void *dev_ctx,
 		goto err;
 	}
 
+	vif_ctx->ifflags_comp = nrf_wifi_osal_completion_alloc();
+
+	if (!vif_ctx->ifflags_comp) {
+		nrf_wifi_osal_log_err("%s: Unable to allocate completion for VIF ctx",
+				      __func__);
+		goto err;
+	}
+
+#if defined(NRF70_RAW_DATA_RX) || defined(NRF70_PROMISC_DATA_RX)
+	vif_ctx->raw_rx_lock = nrf_wifi_osal_spinlock_alloc();
+
+	if (!vif_ctx->raw_rx_lock) {
+		nrf_wifi_osal_log_err("%s: Unable to allocate raw RX lock for VIF ctx",
+				      __func__);
+		goto err;
+	}
+
+	nrf_wifi_osal_spinlock_init(vif_ctx->raw_rx_lock);
+#endif /* NRF70_RAW_DATA_RX || NRF70_PROMISC_DATA_RX */
+
 	vif_ctx->fmac_dev_ctx = fmac_dev_ctx;
 	vif_ctx->os_vif_ctx = os_vif_ctx;
 	vif_ctx->if_type = vif_info->iftype;
@@ -2168,10 +2545,21 @@ unsigned char nrf_wifi_sys_fmac_add_vif(void *dev_ctx,
 
 	nrf_wifi_fmac_vif_incr_if_type(fmac_dev_ctx,
 				       vif_ctx->if_type);
+#ifdef NRF_WIFI_RPU_RECOVERY
+	nrf_wifi_sys_fmac_recovery_vif_add(fmac_dev_ctx,
+					   vif_idx,
+					   vif_info);
+#endif /* NRF_WIFI_RPU_RECOVERY */
 
 	goto out;
 err:
 	if (vif_ctx) {
+		nrf_wifi_osal_completion_free(vif_ctx->ifflags_comp);
+#if defined(NRF70_RAW_DATA_RX) || defined(NRF70_PROMISC_DATA_RX)
+		if (vif_ctx->raw_rx_lock) {
+			nrf_wifi_osal_spinlock_free(vif_ctx->raw_rx_lock);
+		}
+#endif /* NRF70_RAW_DATA_RX || NRF70_PROMISC_DATA_RX */
 		nrf_wifi_osal_mem_free(vif_ctx);
 	}
 
@@ -2256,6 +2644,15 @@ enum nrf_wifi_status nrf_wifi_sys_fmac_del_vif(void *dev_ctx,
 	}
 
 	nrf_wifi_fmac_vif_decr_if_type(fmac_dev_ctx, vif_ctx->if_type);
+#ifdef NRF70_RAW_DATA_TX
+	tx_rawtx_session_vif_check(fmac_dev_ctx,
+				   if_idx,
+				   true);
+#endif /* NRF70_RAW_DATA_TX */
+#ifdef NRF_WIFI_RPU_RECOVERY
+	nrf_wifi_sys_fmac_recovery_vif_del(fmac_dev_ctx,
+					   if_idx);
+#endif /* NRF_WIFI_RPU_RECOVERY */
 
 out:
 	if (del_vif_cmd) {
@@ -2263,6 +2660,11 @@ out:
 	}
 
 	if (vif_ctx) {
+		nrf_wifi_osal_completion_free(vif_ctx->ifflags_comp);
+#if defined(NRF70_RAW_DATA_RX) || defined(NRF70_PROMISC_DATA_RX)
+		nrf_wifi_util_capture_ring_free(vif_ctx);
+		nrf_wifi_osal_spinlock_free(vif_ctx->raw_rx_lock);
+#endif /* NRF70_RAW_DATA_RX || NRF70_PROMISC_DATA_RX */
 		nrf_wifi_osal_mem_free(vif_ctx);
 	}
 
@@ -2324,6 +2726,17 @@ enum nrf_wifi_status nrf_wifi_sys_fmac_chg_vif(void *dev_ctx,
 	status = umac_cmd_cfg(fmac_dev_ctx,
 			      chg_vif_cmd,
 			      sizeof(*chg_vif_cmd));
+#ifdef NRF_WIFI_RPU_RECOVERY
+	if (status == NRF_WIFI_STATUS_SUCCESS) {
+		nrf_wifi_sys_fmac_recovery_record(fmac_dev_ctx,
+						  NRF_WIFI_HOST_RPU_MSG_TYPE_UMAC,
+						  if_idx,
+						  NRF_WIFI_UMAC_CMD_SET_INTERFACE,
+						  0,
+						  chg_vif_cmd,
+						  sizeof(*chg_vif_cmd));
+	}
+#endif /* NRF_WIFI_RPU_RECOVERY */
 out:
 	if (chg_vif_cmd) {
 		nrf_wifi_osal_mem_free(chg_vif_cmd);
@@ -2339,6 +2752,11 @@ out:
 						 vif_info->iftype);
 
 		sys_dev_ctx->vif_ctx[if_idx]->if_type = vif_info->iftype;
+#ifdef NRF70_RAW_DATA_TX
+		tx_rawtx_session_vif_check(fmac_dev_ctx,
+					   if_idx,
+					   false);
+#endif /* NRF70_RAW_DATA_TX */
 	}
 
 	return status;
@@ -2354,7 +2772,6 @@ enum nrf_wifi_status nrf_wifi_sys_fmac_chg_vif_state(void *dev_ctx,
 	struct nrf_wifi_umac_cmd_chg_vif_state *chg_vif_state_cmd = NULL;
 	struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx = NULL;
 	struct nrf_wifi_fmac_vif_ctx *vif_ctx = NULL;
-	unsigned int count = RPU_CMD_TIMEOUT_MS;
 	struct nrf_wifi_sys_fmac_dev_ctx *sys_dev_ctx = NULL;
 
 	fmac_dev_ctx = dev_ctx;
@@ -2387,28 +2804,36 @@ enum nrf_wifi_status nrf_wifi_sys_fmac_chg_vif_state(void *dev_ctx,
 	vif_ctx = sys_dev_ctx->vif_ctx[if_idx];
 
 	vif_ctx->ifflags = false;
+	nrf_wifi_osal_completion_init(vif_ctx->ifflags_comp);
 
 	status = umac_cmd_cfg(fmac_dev_ctx,
 			      chg_vif_state_cmd,
 			      sizeof(*chg_vif_state_cmd));
 
-	while (!vif_ctx->ifflags && (--count > 0))
-		nrf_wifi_osal_sleep_ms(1);
+	nrf_wifi_osal_completion_wait(vif_ctx->ifflags_comp,
+				      RPU_CMD_TIMEOUT_MS);
 
-	if (count == 0) {
+	if (!vif_ctx->ifflags) {
 		status = NRF_WIFI_STATUS_FAIL;
 		nrf_wifi_osal_log_err("%s: RPU is unresponsive for %d sec",
 				      __func__, RPU_CMD_TIMEOUT_MS / 1000);
 		goto out;
 	}
+#ifdef NRF_WIFI_RPU_RECOVERY
+	nrf_wifi_sys_fmac_recovery_record(fmac_dev_ctx,
+					  NRF_WIFI_HOST_RPU_MSG_TYPE_UMAC,
+					  if_idx,
+					  NRF_WIFI_UMAC_CMD_SET_IFFLAGS,
+					  0,
+					  chg_vif_state_cmd,
+					  sizeof(*chg_vif_state_cmd));
+#endif /* NRF_WIFI_RPU_RECOVERY */
 #ifdef NRF70_AP_MODE
 	if (vif_ctx->if_type == NRF_WIFI_IFTYPE_AP) {
 		if (vif_info->state == 1) {
-			sys_dev_ctx->tx_config.peers[MAX_PEERS].peer_id = MAX_PEERS;
-			sys_dev_ctx->tx_config.peers[MAX_PEERS].if_idx = if_idx;
+			nrf_wifi_fmac_peer_mc_set(fmac_dev_ctx, if_idx, true);
 		} else if (vif_info->state == 0) {
-			sys_dev_ctx->tx_config.peers[MAX_PEERS].peer_id = -1;
-			sys_dev_ctx->tx_config.peers[MAX_PEERS].if_idx = if_idx;
+			nrf_wifi_fmac_peer_mc_set(fmac_dev_ctx, if_idx, false);
 		}
 	}
 #endif /* NRF70_AP_MODE */
@@ -2466,6 +2891,17 @@ enum nrf_wifi_status nrf_wifi_sys_fmac_set_vif_macaddr(void *dev_ctx,
 	status = umac_cmd_cfg(fmac_dev_ctx,
 			      cmd,
 			      sizeof(*cmd));
+#ifdef NRF_WIFI_RPU_RECOVERY
+	if (status == NRF_WIFI_STATUS_SUCCESS) {
+		nrf_wifi_sys_fmac_recovery_record(fmac_dev_ctx,
+						  NRF_WIFI_HOST_RPU_MSG_TYPE_UMAC,
+						  if_idx,
+						  NRF_WIFI_UMAC_CMD_CHANGE_MACADDR,
+						  0,
+						  cmd,
+						  sizeof(*cmd));
+	}
+#endif /* NRF_WIFI_RPU_RECOVERY */
 out:
 	if (cmd) {
 		nrf_wifi_osal_mem_free(cmd);
@@ -2828,6 +3264,17 @@ enum nrf_wifi_status nrf_wifi_sys_fmac_set_power_save(void *dev_ctx,
 	status = umac_cmd_cfg(fmac_dev_ctx,
 			      set_ps_cmd,
 			      sizeof(*set_ps_cmd));
+#ifdef NRF_WIFI_RPU_RECOVERY
+	if (status == NRF_WIFI_STATUS_SUCCESS) {
+		nrf_wifi_sys_fmac_recovery_record(fmac_dev_ctx,
+						  NRF_WIFI_HOST_RPU_MSG_TYPE_UMAC,
+						  if_idx,
+						  NRF_WIFI_UMAC_CMD_SET_POWER_SAVE,
+						  0,
+						  set_ps_cmd,
+						  sizeof(*set_ps_cmd));
+	}
+#endif /* NRF_WIFI_RPU_RECOVERY */
 out:
 	if (set_ps_cmd) {
 		nrf_wifi_osal_mem_free(set_ps_cmd);
@@ -2873,6 +3320,17 @@ enum nrf_wifi_status nrf_wifi_sys_fmac_set_uapsd_queue(void *dev_ctx,
 	status = umac_cmd_cfg(fmac_dev_ctx,
 			      set_uapsdq_cmd,
 			      sizeof(*set_uapsdq_cmd));
+#ifdef NRF_WIFI_RPU_RECOVERY
+	if (status == NRF_WIFI_STATUS_SUCCESS) {
+		nrf_wifi_sys_fmac_recovery_record(fmac_dev_ctx,
+						  NRF_WIFI_HOST_RPU_MSG_TYPE_UMAC,
+						  if_idx,
+						  NRF_WIFI_UMAC_CMD_CONFIG_UAPSD,
+						  0,
+						  set_uapsdq_cmd,
+						  sizeof(*set_uapsdq_cmd));
+	}
+#endif /* NRF_WIFI_RPU_RECOVERY */
 out:
 	if (set_uapsdq_cmd) {
 		nrf_wifi_osal_mem_free(set_uapsdq_cmd);
@@ -2914,6 +3372,17 @@ enum nrf_wifi_status nrf_wifi_sys_fmac_set_power_save_timeout(void *dev_ctx,
 	status = umac_cmd_cfg(fmac_dev_ctx,
 			      set_ps_timeout_cmd,
 			      sizeof(*set_ps_timeout_cmd));
+#ifdef NRF_WIFI_RPU_RECOVERY
+	if (status == NRF_WIFI_STATUS_SUCCESS) {
+		nrf_wifi_sys_fmac_recovery_record(fmac_dev_ctx,
+						  NRF_WIFI_HOST_RPU_MSG_TYPE_UMAC,
+						  if_idx,
+						  NRF_WIFI_UMAC_CMD_SET_POWER_SAVE_TIMEOUT,
+						  0,
+						  set_ps_timeout_cmd,
+						  sizeof(*set_ps_timeout_cmd));
+	}
+#endif /* NRF_WIFI_RPU_RECOVERY */
 out:
 	if (set_ps_timeout_cmd) {
 		nrf_wifi_osal_mem_free(set_ps_timeout_cmd);
@@ -3136,6 +3605,25 @@ enum nrf_wifi_status nrf_wifi_sys_fmac_set_mcast_addr(struct nrf_wifi_fmac_dev_c
 	status = umac_cmd_cfg(fmac_dev_ctx,
 			      set_mcast_cmd,
 			      sizeof(*set_mcast_cmd));
+#ifdef NRF_WIFI_RPU_RECOVERY
+	if (status == NRF_WIFI_STATUS_SUCCESS) {
+		if (mcast_info->type == MCAST_ADDR_ADD) {
+			nrf_wifi_sys_fmac_recovery_record(fmac_dev_ctx,
+							  NRF_WIFI_HOST_RPU_MSG_TYPE_UMAC,
+							  if_idx,
+							  NRF_WIFI_UMAC_CMD_MCAST_FILTER,
+							  nrf_wifi_sys_fmac_recovery_addr_key(mcast_info->mac_addr),
+							  set_mcast_cmd,
+							  sizeof(*set_mcast_cmd));
+		} else {
+			nrf_wifi_sys_fmac_recovery_forget(fmac_dev_ctx,
+							  NRF_WIFI_HOST_RPU_MSG_TYPE_UMAC,
+							  if_idx,
+							  NRF_WIFI_UMAC_CMD_MCAST_FILTER,
+							  nrf_wifi_sys_fmac_recovery_addr_key(mcast_info->mac_addr));
+		}
+	}
+#endif /* NRF_WIFI_RPU_RECOVERY */
 out:
 
 	if (set_mcast_cmd) {
@@ -3252,6 +3740,17 @@ enum nrf_wifi_status nrf_wifi_sys_fmac_set_listen_interval(void *dev_ctx,
 	status = umac_cmd_cfg(fmac_dev_ctx,
 			      set_listen_interval_cmd,
 			      sizeof(*set_listen_interval_cmd));
+#ifdef NRF_WIFI_RPU_RECOVERY
+	if (status == NRF_WIFI_STATUS_SUCCESS) {
+		nrf_wifi_sys_fmac_recovery_record(fmac_dev_ctx,
+						  NRF_WIFI_HOST_RPU_MSG_TYPE_UMAC,
+						  if_idx,
+						  NRF_WIFI_UMAC_CMD_SET_LISTEN_INTERVAL,
+						  0,
+						  set_listen_interval_cmd,
+						  sizeof(*set_listen_interval_cmd));
+	}
+#endif /* NRF_WIFI_RPU_RECOVERY */
 out:
 	if (set_listen_interval_cmd) {
 		nrf_wifi_osal_mem_free(set_listen_interval_cmd);
@@ -3293,8 +3792,19 @@ enum nrf_wifi_status nrf_wifi_sys_fmac_set_ps_wakeup_mode(void *dev_ctx,
 	status = umac_cmd_cfg(fmac_dev_ctx,
 			      set_ps_wakeup_mode_cmd,
 			      sizeof(*set_ps_wakeup_mode_cmd));
-out:
-	if (set_ps_wakeup_mode_cmd) {
+#ifdef NRF_WIFI_RPU_RECOVERY
+	if (status == NRF_WIFI_STATUS_SUCCESS) {
+		nrf_wifi_sys_fmac_recovery_record(fmac_dev_ctx,
+						  NRF_WIFI_HOST_RPU_MSG_TYPE_UMAC,
+						  if_idx,
+						  NRF_WIFI_UMAC_CMD_CONFIG_EXTENDED_PS,
+						  0,
+						  set_ps_wakeup_mode_cmd,
+						  sizeof(*set_ps_wakeup_mode_cmd));
+	}
+#endif /* NRF_WIFI_RPU_RECOVERY */
+out:
+	if (set_ps_wakeup_mode_cmd) {
 		nrf_wifi_osal_mem_free(set_ps_wakeup_mode_cmd);
 	}
 
@@ -3335,6 +3845,17 @@ enum nrf_wifi_status nrf_wifi_sys_fmac_set_ps_exit_strategy(void *dev_ctx,
 	status = umac_cmd_cfg(fmac_dev_ctx,
 			      set_ps_exit_strategy_cmd,
 			      sizeof(*set_ps_exit_strategy_cmd));
+#ifdef NRF_WIFI_RPU_RECOVERY
+	if (status == NRF_WIFI_STATUS_SUCCESS) {
+		nrf_wifi_sys_fmac_recovery_record(fmac_dev_ctx,
+						  NRF_WIFI_HOST_RPU_MSG_TYPE_UMAC,
+						  if_idx,
+						  NRF_WIFI_UMAC_CMD_PS_EXIT_STRATEGY,
+						  0,
+						  set_ps_exit_strategy_cmd,
+						  sizeof(*set_ps_exit_strategy_cmd));
+	}
+#endif /* NRF_WIFI_RPU_RECOVERY */
 out:
 	if (set_ps_exit_strategy_cmd) {
 		nrf_wifi_osal_mem_free(set_ps_exit_strategy_cmd);
@@ -3349,8 +3870,9 @@ enum nrf_wifi_status nrf_wifi_sys_fmac_stats_get(struct nrf_wifi_fmac_dev_ctx *f
 						 struct rpu_sys_op_stats *stats)
 {
 	enum nrf_wifi_status status = NRF_WIFI_STATUS_FAIL;
-	unsigned char count = 0;
 	struct nrf_wifi_sys_fmac_dev_ctx *sys_dev_ctx = NULL;
+	struct nrf_wifi_fmac_stats_periodic *periodic = NULL;
+	bool send = false;
 
 	if (fmac_dev_ctx->op_mode != NRF_WIFI_OP_MODE_SYS) {
 		nrf_wifi_osal_log_err("%s: Invalid op mode",
@@ -3358,38 +3880,261 @@ enum nrf_wifi_status nrf_wifi_sys_fmac_stats_get(struct nrf_wifi_fmac_dev_ctx *f
 		goto out;
 	}
 
+	sys_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
+	periodic = &sys_dev_ctx->stats_periodic;
+
+	if (!periodic->lock) {
+		nrf_wifi_osal_log_err("%s: Device not initialized",
+				      __func__);
+		goto out;
+	}
+
+	nrf_wifi_osal_spinlock_take(periodic->lock);
+
 	if (fmac_dev_ctx->stats_req == true) {
+		nrf_wifi_osal_spinlock_rel(periodic->lock);
 		nrf_wifi_osal_log_err("%s: Stats request already pending",
 				      __func__);
 		goto out;
 	}
 
+	nrf_wifi_osal_completion_init(fmac_dev_ctx->stats_comp);
 	fmac_dev_ctx->stats_req = true;
 	fmac_dev_ctx->fw_stats = &stats->fw;
 
-	status = umac_cmd_sys_prog_stats_get(fmac_dev_ctx);
+	/* Reuse the reply to an outstanding periodic request, if any */
+	send = !periodic->req_pending;
+
+	nrf_wifi_osal_spinlock_rel(periodic->lock);
+
+	if (send) {
+		status = umac_cmd_sys_prog_stats_get(fmac_dev_ctx);
+
+		if (status != NRF_WIFI_STATUS_SUCCESS) {
+			goto cancel;
+		}
+	}
+
+	status = nrf_wifi_osal_completion_wait(fmac_dev_ctx->stats_comp,
+					       NRF_WIFI_FMAC_STATS_RECV_TIMEOUT);
 
 	if (status != NRF_WIFI_STATUS_SUCCESS) {
+		nrf_wifi_osal_log_err("%s: Timed out",
+				      __func__);
+		goto cancel;
+	}
+
+	nrf_wifi_osal_mem_cpy(&stats->host,
+			      &sys_dev_ctx->host_stats,
+			      sizeof(sys_dev_ctx->host_stats));
+
+	status = NRF_WIFI_STATUS_SUCCESS;
+	goto out;
+cancel:
+	/* Make sure a late reply does not land in the caller's buffer */
+	nrf_wifi_osal_spinlock_take(periodic->lock);
+	fmac_dev_ctx->stats_req = false;
+	nrf_wifi_osal_spinlock_rel(periodic->lock);
+out:
+	return status;
+}
+
+
+#define NRF_WIFI_FMAC_STATS_PERIODIC_REQ_TIMEOUT_MS 1000
+
+enum nrf_wifi_status nrf_wifi_sys_fmac_stats_periodic_start(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+							    unsigned int interval_ms)
+{
+	enum nrf_wifi_status status = NRF_WIFI_STATUS_FAIL;
+	struct nrf_wifi_sys_fmac_dev_ctx *sys_dev_ctx = NULL;
+	struct nrf_wifi_fmac_stats_periodic *periodic = NULL;
+	struct nrf_wifi_fmac_stats_snapshot *snap = NULL;
+
+	if (!fmac_dev_ctx || !interval_ms) {
+		nrf_wifi_osal_log_err("%s: Invalid parameters",
+				      __func__);
 		goto out;
 	}
 
-	do {
-		nrf_wifi_osal_sleep_ms(1);
-		count++;
-	} while ((fmac_dev_ctx->stats_req == true) &&
-		 (count < NRF_WIFI_FMAC_STATS_RECV_TIMEOUT));
+	if (fmac_dev_ctx->op_mode != NRF_WIFI_OP_MODE_SYS) {
+		nrf_wifi_osal_log_err("%s: Invalid op mode",
+				      __func__);
+		goto out;
+	}
 
-	if (count == NRF_WIFI_FMAC_STATS_RECV_TIMEOUT) {
-		nrf_wifi_osal_log_err("%s: Timed out",
+	sys_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
+	periodic = &sys_dev_ctx->stats_periodic;
+
+	if (!periodic->lock) {
+		nrf_wifi_osal_log_err("%s: Device not initialized",
+				      __func__);
+		goto out;
+	}
+
+	if (!periodic->snap) {
+		snap = nrf_wifi_osal_mem_zalloc(2 * sizeof(*snap));
+
+		if (!snap) {
+			nrf_wifi_osal_log_err("%s: Unable to allocate snapshots",
+					      __func__);
+			goto out;
+		}
+	}
+
+	nrf_wifi_osal_spinlock_take(periodic->lock);
+
+	if (snap) {
+		periodic->snap = snap;
+		periodic->active = 0;
+	}
+
+	periodic->interval_ms = interval_ms;
+
+	nrf_wifi_osal_spinlock_rel(periodic->lock);
+
+	status = NRF_WIFI_STATUS_SUCCESS;
+out:
+	return status;
+}
+
+
+void nrf_wifi_sys_fmac_stats_periodic_stop(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx)
+{
+	struct nrf_wifi_sys_fmac_dev_ctx *sys_dev_ctx = NULL;
+	struct nrf_wifi_fmac_stats_periodic *periodic = NULL;
+
+	if (!fmac_dev_ctx || (fmac_dev_ctx->op_mode != NRF_WIFI_OP_MODE_SYS)) {
+		return;
+	}
+
+	sys_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
+	periodic = &sys_dev_ctx->stats_periodic;
+
+	if (!periodic->lock) {
+		return;
+	}
+
+	/* The snapshots are kept until device deinit, as readers access
+	 * them without the lock.
+	 */
+	nrf_wifi_osal_spinlock_take(periodic->lock);
+	periodic->interval_ms = 0;
+	nrf_wifi_osal_spinlock_rel(periodic->lock);
+}
+
+
+enum nrf_wifi_status nrf_wifi_sys_fmac_stats_periodic_tick(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx)
+{
+	enum nrf_wifi_status status = NRF_WIFI_STATUS_SUCCESS;
+	struct nrf_wifi_sys_fmac_dev_ctx *sys_dev_ctx = NULL;
+	struct nrf_wifi_fmac_stats_periodic *periodic = NULL;
+	unsigned long elapsed_ms = 0;
+	bool send = false;
+
+	if (!fmac_dev_ctx || (fmac_dev_ctx->op_mode != NRF_WIFI_OP_MODE_SYS)) {
+		return NRF_WIFI_STATUS_FAIL;
+	}
+
+	sys_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
+	periodic = &sys_dev_ctx->stats_periodic;
+
+	if (!periodic->lock) {
+		return NRF_WIFI_STATUS_FAIL;
+	}
+
+	nrf_wifi_osal_spinlock_take(periodic->lock);
+
+	if (!periodic->snap) {
+		goto unlock;
+	}
+
+	elapsed_ms = nrf_wifi_osal_time_elapsed_ms(periodic->last_req_ms);
+
+	if (periodic->req_pending) {
+		if (elapsed_ms < NRF_WIFI_FMAC_STATS_PERIODIC_REQ_TIMEOUT_MS) {
+			goto unlock;
+		}
+
+		nrf_wifi_osal_log_err("%s: Periodic stats request timed out",
 				      __func__);
+		periodic->req_pending = false;
+	}
+
+	if (!periodic->interval_ms) {
+		goto unlock;
+	}
+
+	if (periodic->snap[periodic->active].seq &&
+	    (elapsed_ms < periodic->interval_ms)) {
+		goto unlock;
+	}
+
+	periodic->req_pending = true;
+	periodic->last_req_ms = nrf_wifi_osal_time_get_curr_ms();
+
+	/* Reuse the reply to an outstanding on-demand request, if any */
+	send = !fmac_dev_ctx->stats_req;
+unlock:
+	nrf_wifi_osal_spinlock_rel(periodic->lock);
+
+	if (!send) {
+		goto out;
+	}
+
+	status = umac_cmd_sys_prog_stats_get(fmac_dev_ctx);
+
+	if (status != NRF_WIFI_STATUS_SUCCESS) {
+		nrf_wifi_osal_spinlock_take(periodic->lock);
+		periodic->req_pending = false;
+		nrf_wifi_osal_spinlock_rel(periodic->lock);
+	}
+out:
+	return status;
+}
+
+
+enum nrf_wifi_status nrf_wifi_sys_fmac_stats_periodic_get(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+							  struct nrf_wifi_fmac_stats_snapshot *snapshot)
+{
+	enum nrf_wifi_status status = NRF_WIFI_STATUS_FAIL;
+	struct nrf_wifi_sys_fmac_dev_ctx *sys_dev_ctx = NULL;
+	struct nrf_wifi_fmac_stats_periodic *periodic = NULL;
+	struct nrf_wifi_fmac_stats_snapshot *snap = NULL;
+	unsigned char active = 0;
+	unsigned int seq = 0;
+
+	if (!fmac_dev_ctx || !snapshot ||
+	    (fmac_dev_ctx->op_mode != NRF_WIFI_OP_MODE_SYS)) {
 		goto out;
 	}
 
 	sys_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
+	periodic = &sys_dev_ctx->stats_periodic;
 
-	nrf_wifi_osal_mem_cpy(&stats->host,
-			      &sys_dev_ctx->host_stats,
-			      sizeof(sys_dev_ctx->host_stats));
+	if (!periodic->lock) {
+		goto out;
+	}
+
+	snap = periodic->snap;
+
+	if (!snap || !periodic->interval_ms) {
+		goto out;
+	}
+
+	/* Retry if the event context republished the buffer while copying */
+	do {
+		active = periodic->active;
+		seq = snap[active].seq;
+
+		if (!seq) {
+			goto out;
+		}
+
+		nrf_wifi_osal_mem_cpy(snapshot,
+				      &snap[active],
+				      sizeof(*snapshot));
+	} while ((periodic->active != active) ||
+		 (snap[active].seq != seq));
 
 	status = NRF_WIFI_STATUS_SUCCESS;
 out:
@@ -3799,12 +4544,251 @@ enum nrf_wifi_status nrf_wifi_sys_fmac_set_packet_filter(void *dev_ctx, unsigned
 	umac_cmd_data->filter = filter;
 	umac_cmd_data->capture_len = buffer_size;
 
+#ifdef NRF_WIFI_RPU_RECOVERY
+	/* Recorded before sending, the HAL owns the message afterwards */
+	nrf_wifi_sys_fmac_recovery_record(fmac_dev_ctx,
+					  NRF_WIFI_HOST_RPU_MSG_TYPE_SYSTEM,
+					  if_idx,
+					  NRF_WIFI_CMD_RAW_CONFIG_FILTER,
+					  0,
+					  umac_cmd_data,
+					  len);
+#endif /* NRF_WIFI_RPU_RECOVERY */
 	status = nrf_wifi_hal_ctrl_cmd_send(fmac_dev_ctx->hal_dev_ctx,
 					    umac_cmd,
 					    (sizeof(*umac_cmd) + len));
 out:
 	return status;
 }
+
+
+enum nrf_wifi_status nrf_wifi_sys_fmac_set_rx_filter(void *dev_ctx,
+						     unsigned char if_idx,
+						     const struct nrf_wifi_fmac_rx_filter *filter)
+{
+	enum nrf_wifi_status status = NRF_WIFI_STATUS_FAIL;
+	struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx = dev_ctx;
+	struct nrf_wifi_sys_fmac_dev_ctx *sys_dev_ctx = NULL;
+	struct nrf_wifi_fmac_vif_ctx *vif_ctx = NULL;
+
+	if (!fmac_dev_ctx || if_idx >= MAX_NUM_VIFS) {
+		nrf_wifi_osal_log_err("%s: Invalid parameters",
+				      __func__);
+		goto out;
+	}
+
+	if (fmac_dev_ctx->op_mode != NRF_WIFI_OP_MODE_SYS) {
+		nrf_wifi_osal_log_err("%s: Invalid op mode",
+				      __func__);
+		goto out;
+	}
+
+	sys_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
+	vif_ctx = sys_dev_ctx->vif_ctx[if_idx];
+
+	if (!vif_ctx) {
+		nrf_wifi_osal_log_err("%s: No VIF at index %d",
+				      __func__,
+				      if_idx);
+		goto out;
+	}
+
+	if (filter && !nrf_wifi_util_rx_filter_valid(filter)) {
+		nrf_wifi_osal_log_err("%s: Invalid filter",
+				      __func__);
+		goto out;
+	}
+
+	/* The RX path evaluates the filter under the same lock */
+	nrf_wifi_osal_spinlock_take(vif_ctx->raw_rx_lock);
+
+	vif_ctx->rx_filter_enabled = false;
+
+	nrf_wifi_osal_mem_set(&vif_ctx->rx_filter_stats,
+			      0,
+			      sizeof(vif_ctx->rx_filter_stats));
+
+	if (filter) {
+		nrf_wifi_osal_mem_cpy(&vif_ctx->rx_filter,
+				      filter,
+				      sizeof(vif_ctx->rx_filter));
+
+		vif_ctx->rx_filter_enabled = true;
+	}
+
+	nrf_wifi_osal_spinlock_rel(vif_ctx->raw_rx_lock);
+
+	status = NRF_WIFI_STATUS_SUCCESS;
+out:
+	return status;
+}
+
+
+enum nrf_wifi_status nrf_wifi_sys_fmac_get_rx_filter_stats(void *dev_ctx,
+							   unsigned char if_idx,
+							   struct nrf_wifi_fmac_rx_filter_stats *stats)
+{
+	enum nrf_wifi_status status = NRF_WIFI_STATUS_FAIL;
+	struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx = dev_ctx;
+	struct nrf_wifi_sys_fmac_dev_ctx *sys_dev_ctx = NULL;
+	struct nrf_wifi_fmac_vif_ctx *vif_ctx = NULL;
+
+	if (!fmac_dev_ctx || if_idx >= MAX_NUM_VIFS || !stats) {
+		nrf_wifi_osal_log_err("%s: Invalid parameters",
+				      __func__);
+		goto out;
+	}
+
+	if (fmac_dev_ctx->op_mode != NRF_WIFI_OP_MODE_SYS) {
+		nrf_wifi_osal_log_err("%s: Invalid op mode",
+				      __func__);
+		goto out;
+	}
+
+	sys_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
+	vif_ctx = sys_dev_ctx->vif_ctx[if_idx];
+
+	if (!vif_ctx) {
+		nrf_wifi_osal_log_err("%s: No VIF at index %d",
+				      __func__,
+				      if_idx);
+		goto out;
+	}
+
+	nrf_wifi_osal_spinlock_take(vif_ctx->raw_rx_lock);
+
+	nrf_wifi_osal_mem_cpy(stats,
+			      &vif_ctx->rx_filter_stats,
+			      sizeof(*stats));
+
+	nrf_wifi_osal_spinlock_rel(vif_ctx->raw_rx_lock);
+
+	status = NRF_WIFI_STATUS_SUCCESS;
+out:
+	return status;
+}
+
+
+static struct nrf_wifi_fmac_vif_ctx *nrf_wifi_sys_fmac_capture_vif_get(void *dev_ctx,
+								       unsigned char if_idx)
+{
+	struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx = dev_ctx;
+	struct nrf_wifi_sys_fmac_dev_ctx *sys_dev_ctx = NULL;
+	struct nrf_wifi_fmac_vif_ctx *vif_ctx = NULL;
+
+	if (!fmac_dev_ctx || if_idx >= MAX_NUM_VIFS) {
+		nrf_wifi_osal_log_err("%s: Invalid parameters",
+				      __func__);
+		goto out;
+	}
+
+	if (fmac_dev_ctx->op_mode != NRF_WIFI_OP_MODE_SYS) {
+		nrf_wifi_osal_log_err("%s: Invalid op mode",
+				      __func__);
+		goto out;
+	}
+
+	sys_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
+	vif_ctx = sys_dev_ctx->vif_ctx[if_idx];
+
+	if (!vif_ctx) {
+		nrf_wifi_osal_log_err("%s: No VIF at index %d",
+				      __func__,
+				      if_idx);
+	}
+out:
+	return vif_ctx;
+}
+
+
+enum nrf_wifi_status nrf_wifi_sys_fmac_capture_ring_start(void *dev_ctx,
+							  unsigned char if_idx,
+							  void *buf,
+							  unsigned int size,
+							  unsigned int snaplen)
+{
+	enum nrf_wifi_status status = NRF_WIFI_STATUS_FAIL;
+	struct nrf_wifi_fmac_vif_ctx *vif_ctx = NULL;
+
+	vif_ctx = nrf_wifi_sys_fmac_capture_vif_get(dev_ctx,
+						    if_idx);
+
+	if (!vif_ctx || !buf) {
+		goto out;
+	}
+
+	status = nrf_wifi_util_capture_ring_alloc(vif_ctx,
+						  buf,
+						  size,
+						  snaplen);
+out:
+	return status;
+}
+
+
+enum nrf_wifi_status nrf_wifi_sys_fmac_capture_ring_stop(void *dev_ctx,
+							 unsigned char if_idx)
+{
+	enum nrf_wifi_status status = NRF_WIFI_STATUS_FAIL;
+	struct nrf_wifi_fmac_vif_ctx *vif_ctx = NULL;
+
+	vif_ctx = nrf_wifi_sys_fmac_capture_vif_get(dev_ctx,
+						    if_idx);
+
+	if (!vif_ctx) {
+		goto out;
+	}
+
+	nrf_wifi_util_capture_ring_free(vif_ctx);
+
+	status = NRF_WIFI_STATUS_SUCCESS;
+out:
+	return status;
+}
+
+
+enum nrf_wifi_status nrf_wifi_sys_fmac_capture_ring_sync(void *dev_ctx,
+							 unsigned char if_idx,
+							 unsigned int tail,
+							 unsigned int *head)
+{
+	enum nrf_wifi_status status = NRF_WIFI_STATUS_FAIL;
+	struct nrf_wifi_fmac_vif_ctx *vif_ctx = NULL;
+
+	vif_ctx = nrf_wifi_sys_fmac_capture_vif_get(dev_ctx,
+						    if_idx);
+
+	if (!vif_ctx || !head) {
+		goto out;
+	}
+
+	status = nrf_wifi_util_capture_ring_sync(vif_ctx,
+						 tail,
+						 head);
+out:
+	return status;
+}
+
+
+enum nrf_wifi_status nrf_wifi_sys_fmac_capture_ring_stats_get(void *dev_ctx,
+							      unsigned char if_idx,
+							      struct nrf_wifi_fmac_capture_ring_stats *stats)
+{
+	enum nrf_wifi_status status = NRF_WIFI_STATUS_FAIL;
+	struct nrf_wifi_fmac_vif_ctx *vif_ctx = NULL;
+
+	vif_ctx = nrf_wifi_sys_fmac_capture_vif_get(dev_ctx,
+						    if_idx);
+
+	if (!vif_ctx || !stats) {
+		goto out;
+	}
+
+	status = nrf_wifi_util_capture_ring_stats_get(vif_ctx,
+						      stats);
+out:
+	return status;
+}
 #endif /* NRF70_RAW_DATA_RX || NRF70_PROMISC_DATA_RX */
 
 
@@ -3844,6 +4828,16 @@ enum nrf_wifi_status nrf_wifi_sys_fmac_set_tx_rate(struct nrf_wifi_fmac_dev_ctx
 	umac_cmd_data->rate_flags = rate_flag;
 	umac_cmd_data->fixed_rate = data_rate;
 
+#ifdef NRF_WIFI_RPU_RECOVERY
+	/* Recorded before sending, the HAL owns the message afterwards */
+	nrf_wifi_sys_fmac_recovery_record(fmac_dev_ctx,
+					  NRF_WIFI_HOST_RPU_MSG_TYPE_SYSTEM,
+					  MAX_NUM_VIFS,
+					  NRF_WIFI_CMD_TX_FIX_DATA_RATE,
+					  0,
+					  umac_cmd_data,
+					  len);
+#endif /* NRF_WIFI_RPU_RECOVERY */
 	status = nrf_wifi_hal_ctrl_cmd_send(fmac_dev_ctx->hal_dev_ctx,
 					    umac_cmd,
 					    (sizeof(*umac_cmd) + len));
@@ -0,0 +1,814 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @brief File containing scan result BSS table specific definitions for
+ * the FMAC IF Layer of the Wi-Fi driver.
+ */
+
+#include "system/fmac_api.h"
+#include "system/fmac_bss.h"
+#include "common/fmac_util.h"
+#include "util.h"
+
+#define NRF_WIFI_FMAC_BSS_RSSI_UNKNOWN -127
+#define NRF_WIFI_FMAC_ASSOC_RESP_STATUS_OFFSET 26
+
+
+struct nrf_wifi_fmac_bss_res {
+	const unsigned char *bssid;
+	int band;
+	unsigned int channel;
+	unsigned int frequency;
+	const unsigned char *ssid;
+	unsigned int ssid_len;
+	int security_type;
+	unsigned short beacon_interval;
+	unsigned short capability;
+	int rssi;
+	unsigned long seen_ms;
+};
+
+
+static unsigned int nrf_wifi_sys_fmac_bss_chan_to_freq(int band,
+						       unsigned int channel)
+{
+	/* Unlike nrf_wifi_utils_chan_to_freq this does not validate (and log)
+	 * the channel, the firmware only reports channels it has scanned.
+	 */
+	if (band == NRF_WIFI_BAND_2GHZ) {
+		return (channel == 14) ? 2484 : (2407 + (channel * 5));
+	} else if (band == NRF_WIFI_BAND_5GHZ) {
+		return 5000 + (channel * 5);
+	}
+
+	return 0;
+}
+
+
+static int nrf_wifi_sys_fmac_bss_rssi(struct nrf_wifi_signal *signal)
+{
+	if (signal->signal_type == NRF_WIFI_SIGNAL_TYPE_MBM) {
+		return MBM_TO_DBM((int)signal->signal.mbm_signal);
+	} else if (signal->signal_type == NRF_WIFI_SIGNAL_TYPE_UNSPEC) {
+		/* Scale 0..100 to -100..0 dBm */
+		return (int)signal->signal.unspec_signal - 100;
+	}
+
+	return NRF_WIFI_FMAC_BSS_RSSI_UNKNOWN;
+}
+
+
+#if NRF_WIFI_FMAC_BSS_TABLE_SIZE > 0
+/* Drops the entries which have not been seen for max_age_ms. Must be called
+ * with the table lock held.
+ */
+static void nrf_wifi_sys_fmac_bss_table_age(struct nrf_wifi_fmac_bss_table *bss_table)
+{
+	unsigned int i = 0;
+
+	while (i < bss_table->num_entries) {
+		if (nrf_wifi_osal_time_elapsed_ms(bss_table->entries[i].last_seen_ms) <
+		    bss_table->max_age_ms) {
+			i++;
+			continue;
+		}
+
+		/* Order does not matter, fill the hole with the last entry */
+		bss_table->num_entries--;
+
+		if (i != bss_table->num_entries) {
+			bss_table->entries[i] = bss_table->entries[bss_table->num_entries];
+		}
+	}
+}
+#endif /* NRF_WIFI_FMAC_BSS_TABLE_SIZE > 0 */
+
+
+#if NRF_WIFI_FMAC_CHAN_HINT_CACHE_SIZE > 0
+/* Must be called with the table lock held. */
+static void nrf_wifi_sys_fmac_chan_hint_update(struct nrf_wifi_fmac_bss_table *bss_table,
+					       struct nrf_wifi_fmac_chan_hint *new_hint)
+{
+	struct nrf_wifi_fmac_chan_hint *hint = NULL;
+	unsigned int i = 0;
+	int victim = -1;
+
+	for (i = 0; i < bss_table->num_hints; i++) {
+		if (nrf_wifi_util_ether_addr_equal(bss_table->hints[i].bssid,
+						   new_hint->bssid) &&
+		    (bss_table->hints[i].ssid.nrf_wifi_ssid_len ==
+		     new_hint->ssid.nrf_wifi_ssid_len) &&
+		    !nrf_wifi_osal_mem_cmp(bss_table->hints[i].ssid.nrf_wifi_ssid,
+					   new_hint->ssid.nrf_wifi_ssid,
+					   new_hint->ssid.nrf_wifi_ssid_len)) {
+			hint = &bss_table->hints[i];
+			break;
+		}
+	}
+
+	if (hint) {
+		/* A BSS which moved channel can no longer be trusted as an association hint */
+		if (hint->frequency != new_hint->frequency) {
+			hint->assoc = false;
+		}
+
+		hint->frequency = new_hint->frequency;
+		hint->assoc |= new_hint->assoc;
+
+		if ((long)(new_hint->last_seen_ms - hint->last_seen_ms) > 0) {
+			hint->last_seen_ms = new_hint->last_seen_ms;
+		}
+
+		return;
+	}
+
+	if (bss_table->num_hints < NRF_WIFI_FMAC_CHAN_HINT_CACHE_SIZE) {
+		bss_table->hints[bss_table->num_hints++] = *new_hint;
+		return;
+	}
+
+	/* Cache is full, replace the least recently seen hint preferring the
+	 * ones which were never associated with.
+	 */
+	for (i = 0; i < bss_table->num_hints; i++) {
+		if ((victim < 0) ||
+		    (bss_table->hints[victim].assoc && !bss_table->hints[i].assoc) ||
+		    ((bss_table->hints[victim].assoc == bss_table->hints[i].assoc) &&
+		     ((long)(bss_table->hints[i].last_seen_ms -
+			     bss_table->hints[victim].last_seen_ms) < 0))) {
+			victim = i;
+		}
+	}
+
+	bss_table->hints[victim] = *new_hint;
+}
+
+
+/* Must be called with the table lock held. */
+static void nrf_wifi_sys_fmac_bss_hint_add(struct nrf_wifi_fmac_bss_table *bss_table,
+					   const unsigned char *ssid,
+					   unsigned int ssid_len,
+					   const unsigned char *bssid,
+					   unsigned int frequency,
+					   unsigned long seen_ms)
+{
+	struct nrf_wifi_fmac_chan_hint hint;
+
+	nrf_wifi_osal_mem_set(&hint,
+			      0,
+			      sizeof(hint));
+
+	hint.ssid.nrf_wifi_ssid_len = ssid_len;
+
+	nrf_wifi_osal_mem_cpy(hint.ssid.nrf_wifi_ssid,
+			      ssid,
+			      ssid_len);
+
+	nrf_wifi_osal_mem_cpy(hint.bssid,
+			      bssid,
+			      NRF_WIFI_ETH_ADDR_LEN);
+
+	hint.frequency = frequency;
+	hint.last_seen_ms = seen_ms;
+
+	nrf_wifi_sys_fmac_chan_hint_update(bss_table,
+					   &hint);
+}
+#endif /* NRF_WIFI_FMAC_CHAN_HINT_CACHE_SIZE > 0 */
+
+
+static void nrf_wifi_sys_fmac_bss_table_merge(struct nrf_wifi_fmac_bss_table *bss_table,
+					      struct nrf_wifi_fmac_bss_res *res)
+{
+#if NRF_WIFI_FMAC_BSS_TABLE_SIZE > 0
+	struct nrf_wifi_fmac_bss_entry *entry = NULL;
+	unsigned int i = 0;
+	unsigned int victim = 0;
+
+	for (i = 0; i < bss_table->num_entries; i++) {
+		if ((bss_table->entries[i].band == res->band) &&
+		    nrf_wifi_util_ether_addr_equal(bss_table->entries[i].bssid,
+						   res->bssid)) {
+			entry = &bss_table->entries[i];
+			break;
+		}
+	}
+
+	if (!entry) {
+		if (bss_table->num_entries < NRF_WIFI_FMAC_BSS_TABLE_SIZE) {
+			entry = &bss_table->entries[bss_table->num_entries++];
+		} else {
+			/* Table is full, replace the least recently seen entry */
+			for (i = 1; i < bss_table->num_entries; i++) {
+				if ((long)(bss_table->entries[i].last_seen_ms -
+					   bss_table->entries[victim].last_seen_ms) < 0) {
+					victim = i;
+				}
+			}
+
+			entry = &bss_table->entries[victim];
+		}
+
+		nrf_wifi_osal_mem_set(entry,
+				      0,
+				      sizeof(*entry));
+
+		nrf_wifi_osal_mem_cpy(entry->bssid,
+				      res->bssid,
+				      NRF_WIFI_ETH_ADDR_LEN);
+
+		entry->band = res->band;
+		entry->security_type = -1;
+		entry->best_rssi = NRF_WIFI_FMAC_BSS_RSSI_UNKNOWN;
+		entry->first_seen_ms = res->seen_ms;
+	}
+
+	if (res->channel) {
+		entry->channel = res->channel;
+	}
+
+	if (res->frequency) {
+		entry->frequency = res->frequency;
+	}
+
+	/* Hidden SSIDs are reported with a zero length (or zeroed) SSID, do not
+	 * lose an SSID learnt from an earlier probe response.
+	 */
+	if (res->ssid && res->ssid_len && res->ssid[0]) {
+		entry->ssid.nrf_wifi_ssid_len = res->ssid_len;
+
+		nrf_wifi_osal_mem_cpy(entry->ssid.nrf_wifi_ssid,
+				      res->ssid,
+				      res->ssid_len);
+	}
+
+	if (res->security_type >= 0) {
+		entry->security_type = res->security_type;
+	}
+
+	entry->beacon_interval = res->beacon_interval;
+	entry->capability = res->capability;
+	entry->last_rssi = res->rssi;
+
+	if (res->rssi > entry->best_rssi) {
+		entry->best_rssi = res->rssi;
+	}
+
+	if ((long)(res->seen_ms - entry->last_seen_ms) > 0 || !entry->seen_cnt) {
+		entry->last_seen_ms = res->seen_ms;
+	}
+
+	entry->seen_cnt++;
+
+#if NRF_WIFI_FMAC_CHAN_HINT_CACHE_SIZE > 0
+	if (entry->ssid.nrf_wifi_ssid_len && entry->frequency) {
+		nrf_wifi_sys_fmac_bss_hint_add(bss_table,
+					       entry->ssid.nrf_wifi_ssid,
+					       entry->ssid.nrf_wifi_ssid_len,
+					       entry->bssid,
+					       entry->frequency,
+					       entry->last_seen_ms);
+	}
+#endif /* NRF_WIFI_FMAC_CHAN_HINT_CACHE_SIZE > 0 */
+#elif NRF_WIFI_FMAC_CHAN_HINT_CACHE_SIZE > 0
+	/* No BSS table, feed the channel hint cache straight from the result */
+	if (res->ssid && res->ssid_len && res->ssid[0] && res->frequency) {
+		nrf_wifi_sys_fmac_bss_hint_add(bss_table,
+					       res->ssid,
+					       res->ssid_len,
+					       res->bssid,
+					       res->frequency,
+					       res->seen_ms);
+	}
+#endif /* NRF_WIFI_FMAC_BSS_TABLE_SIZE > 0 */
+}
+
+
+enum nrf_wifi_status nrf_wifi_sys_fmac_bss_table_init(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx)
+{
+	struct nrf_wifi_sys_fmac_dev_ctx *sys_dev_ctx = NULL;
+
+	sys_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
+
+	nrf_wifi_osal_mem_set(&sys_dev_ctx->bss_table,
+			      0,
+			      sizeof(sys_dev_ctx->bss_table));
+
+	sys_dev_ctx->bss_table.lock = nrf_wifi_osal_spinlock_alloc();
+
+	if (!sys_dev_ctx->bss_table.lock) {
+		nrf_wifi_osal_log_err("%s: Unable to allocate BSS table lock",
+				      __func__);
+		return NRF_WIFI_STATUS_FAIL;
+	}
+
+	nrf_wifi_osal_spinlock_init(sys_dev_ctx->bss_table.lock);
+
+#if NRF_WIFI_FMAC_BSS_TABLE_SIZE > 0
+	sys_dev_ctx->bss_table.max_age_ms = NRF_WIFI_FMAC_BSS_MAX_AGE_MS;
+#endif /* NRF_WIFI_FMAC_BSS_TABLE_SIZE > 0 */
+
+	return NRF_WIFI_STATUS_SUCCESS;
+}
+
+
+void nrf_wifi_sys_fmac_bss_table_deinit(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx)
+{
+	struct nrf_wifi_sys_fmac_dev_ctx *sys_dev_ctx = NULL;
+
+	sys_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
+
+	if (!sys_dev_ctx->bss_table.lock) {
+		return;
+	}
+
+	nrf_wifi_osal_spinlock_free(sys_dev_ctx->bss_table.lock);
+	sys_dev_ctx->bss_table.lock = NULL;
+#if NRF_WIFI_FMAC_BSS_TABLE_SIZE > 0
+	sys_dev_ctx->bss_table.num_entries = 0;
+#endif /* NRF_WIFI_FMAC_BSS_TABLE_SIZE > 0 */
+}
+
+
+void nrf_wifi_sys_fmac_bss_table_scan_res(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+					  struct nrf_wifi_umac_event_new_scan_results *scan_res,
+					  unsigned int event_len)
+{
+	struct nrf_wifi_sys_fmac_dev_ctx *sys_dev_ctx = NULL;
+	struct nrf_wifi_fmac_bss_res res;
+	struct nrf_wifi_fmac_ie_index ie_index;
+	unsigned int ies_len = 0;
+	unsigned int pos = 0;
+	unsigned long now_ms = 0;
+
+	sys_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
+
+	if (!sys_dev_ctx->bss_table.lock || (event_len < sizeof(*scan_res))) {
+		return;
+	}
+
+	nrf_wifi_osal_mem_set(&res,
+			      0,
+			      sizeof(res));
+
+	now_ms = nrf_wifi_osal_time_get_curr_ms();
+
+	res.bssid = scan_res->mac_addr;
+	res.frequency = scan_res->frequency;
+	res.security_type = -1;
+	res.beacon_interval = scan_res->beacon_interval;
+	res.capability = scan_res->capability;
+	res.rssi = nrf_wifi_sys_fmac_bss_rssi(&scan_res->signal);
+	res.seen_ms = now_ms - scan_res->seen_ms_ago;
+
+	if (scan_res->frequency == 2484) {
+		res.band = NRF_WIFI_BAND_2GHZ;
+		res.channel = 14;
+	} else if (scan_res->frequency < 5000) {
+		res.band = NRF_WIFI_BAND_2GHZ;
+		res.channel = (scan_res->frequency - 2407) / 5;
+	} else {
+		res.band = NRF_WIFI_BAND_5GHZ;
+		res.channel = (scan_res->frequency - 5000) / 5;
+	}
+
+	ies_len = scan_res->ies_len;
+
+	if (ies_len > event_len - sizeof(*scan_res)) {
+		ies_len = event_len - sizeof(*scan_res);
+	}
+
+	nrf_wifi_util_ie_index(scan_res->ies,
+			       ies_len,
+			       &ie_index);
+
+	pos = ie_index.offset[NRF_WIFI_FMAC_IE_SSID];
+
+	if ((pos != NRF_WIFI_FMAC_IE_NOT_PRESENT) &&
+	    (ie_index.len[NRF_WIFI_FMAC_IE_SSID] <= NRF_WIFI_MAX_SSID_LEN)) {
+		res.ssid = &scan_res->ies[pos + 2];
+		res.ssid_len = ie_index.len[NRF_WIFI_FMAC_IE_SSID];
+	}
+
+	nrf_wifi_osal_spinlock_take(sys_dev_ctx->bss_table.lock);
+
+#if NRF_WIFI_FMAC_BSS_TABLE_SIZE > 0
+	nrf_wifi_sys_fmac_bss_table_age(&sys_dev_ctx->bss_table);
+#endif /* NRF_WIFI_FMAC_BSS_TABLE_SIZE > 0 */
+
+	nrf_wifi_sys_fmac_bss_table_merge(&sys_dev_ctx->bss_table,
+					  &res);
+
+	nrf_wifi_osal_spinlock_rel(sys_dev_ctx->bss_table.lock);
+}
+
+
+void nrf_wifi_sys_fmac_bss_table_disp_res(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+					  struct nrf_wifi_umac_event_new_scan_display_results *disp_res,
+					  unsigned int event_len)
+{
+	struct nrf_wifi_sys_fmac_dev_ctx *sys_dev_ctx = NULL;
+	struct umac_display_results *disp = NULL;
+	struct nrf_wifi_fmac_bss_res res;
+	unsigned int num_res = 0;
+	unsigned long now_ms = 0;
+	unsigned int i = 0;
+
+	sys_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
+
+	if (!sys_dev_ctx->bss_table.lock ||
+	    (event_len < sizeof(disp_res->umac_hdr) + sizeof(disp_res->event_bss_count))) {
+		return;
+	}
+
+	num_res = disp_res->event_bss_count;
+
+	if (num_res > DISPLAY_BSS_TOHOST_PEREVNT) {
+		num_res = DISPLAY_BSS_TOHOST_PEREVNT;
+	}
+
+	now_ms = nrf_wifi_osal_time_get_curr_ms();
+
+	nrf_wifi_osal_spinlock_take(sys_dev_ctx->bss_table.lock);
+
+#if NRF_WIFI_FMAC_BSS_TABLE_SIZE > 0
+	nrf_wifi_sys_fmac_bss_table_age(&sys_dev_ctx->bss_table);
+#endif /* NRF_WIFI_FMAC_BSS_TABLE_SIZE > 0 */
+
+	for (i = 0; i < num_res; i++) {
+		disp = &disp_res->display_results[i];
+
+		nrf_wifi_osal_mem_set(&res,
+				      0,
+				      sizeof(res));
+
+		res.bssid = disp->mac_addr;
+		res.band = disp->nwk_band;
+		res.channel = disp->nwk_channel;
+		res.frequency = nrf_wifi_sys_fmac_bss_chan_to_freq(disp->nwk_band,
+								   disp->nwk_channel);
+		res.ssid = disp->ssid.nrf_wifi_ssid;
+		res.ssid_len = disp->ssid.nrf_wifi_ssid_len;
+		res.security_type = disp->security_type;
+		res.beacon_interval = disp->beacon_interval;
+		res.capability = disp->capability;
+		res.rssi = nrf_wifi_sys_fmac_bss_rssi(&disp->signal);
+		res.seen_ms = now_ms;
+
+		if (res.ssid_len > NRF_WIFI_MAX_SSID_LEN) {
+			res.ssid_len = NRF_WIFI_MAX_SSID_LEN;
+		}
+
+		nrf_wifi_sys_fmac_bss_table_merge(&sys_dev_ctx->bss_table,
+						  &res);
+	}
+
+	nrf_wifi_osal_spinlock_rel(sys_dev_ctx->bss_table.lock);
+}
+
+
+#if NRF_WIFI_FMAC_BSS_TABLE_SIZE > 0
+enum nrf_wifi_status nrf_wifi_sys_fmac_bss_table_get(void *dev_ctx,
+						     struct nrf_wifi_fmac_bss_entry *entries,
+						     unsigned int max_entries,
+						     unsigned int *num_entries)
+{
+	struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx = NULL;
+	struct nrf_wifi_sys_fmac_dev_ctx *sys_dev_ctx = NULL;
+	struct nrf_wifi_fmac_bss_table *bss_table = NULL;
+	struct nrf_wifi_fmac_bss_entry *entry = NULL;
+	unsigned int num = 0;
+	unsigned int i = 0;
+	unsigned int j = 0;
+
+	fmac_dev_ctx = dev_ctx;
+
+	if (!fmac_dev_ctx || !entries || !num_entries) {
+		nrf_wifi_osal_log_err("%s: Invalid parameters",
+				      __func__);
+		return NRF_WIFI_STATUS_FAIL;
+	}
+
+	sys_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
+	bss_table = &sys_dev_ctx->bss_table;
+
+	if (!bss_table->lock) {
+		nrf_wifi_osal_log_err("%s: BSS table not initialized",
+				      __func__);
+		return NRF_WIFI_STATUS_FAIL;
+	}
+
+	nrf_wifi_osal_spinlock_take(bss_table->lock);
+
+	nrf_wifi_sys_fmac_bss_table_age(bss_table);
+
+	/* Insert into the caller's array sorted by the latest RSSI, keeping
+	 * only the strongest max_entries BSSs.
+	 */
+	for (i = 0; i < bss_table->num_entries; i++) {
+		entry = &bss_table->entries[i];
+
+		for (j = num; j > 0; j--) {
+			if (entries[j - 1].last_rssi >= entry->last_rssi) {
+				break;
+			}
+
+			if (j < max_entries) {
+				entries[j] = entries[j - 1];
+			}
+		}
+
+		if (j < max_entries) {
+			entries[j] = *entry;
+
+			if (num < max_entries) {
+				num++;
+			}
+		}
+	}
+
+	nrf_wifi_osal_spinlock_rel(bss_table->lock);
+
+	*num_entries = num;
+
+	return NRF_WIFI_STATUS_SUCCESS;
+}
+
+
+void nrf_wifi_sys_fmac_bss_table_flush(void *dev_ctx)
+{
+	struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx = NULL;
+	struct nrf_wifi_sys_fmac_dev_ctx *sys_dev_ctx = NULL;
+
+	fmac_dev_ctx = dev_ctx;
+
+	if (!fmac_dev_ctx) {
+		return;
+	}
+
+	sys_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
+
+	if (!sys_dev_ctx->bss_table.lock) {
+		return;
+	}
+
+	nrf_wifi_osal_spinlock_take(sys_dev_ctx->bss_table.lock);
+	sys_dev_ctx->bss_table.num_entries = 0;
+	nrf_wifi_osal_spinlock_rel(sys_dev_ctx->bss_table.lock);
+}
+
+
+void nrf_wifi_sys_fmac_bss_table_max_age_set(void *dev_ctx,
+					     unsigned int max_age_ms)
+{
+	struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx = NULL;
+	struct nrf_wifi_sys_fmac_dev_ctx *sys_dev_ctx = NULL;
+
+	fmac_dev_ctx = dev_ctx;
+
+	if (!fmac_dev_ctx) {
+		return;
+	}
+
+	sys_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
+
+	if (!sys_dev_ctx->bss_table.lock) {
+		return;
+	}
+
+	nrf_wifi_osal_spinlock_take(sys_dev_ctx->bss_table.lock);
+	sys_dev_ctx->bss_table.max_age_ms = max_age_ms;
+	nrf_wifi_osal_spinlock_rel(sys_dev_ctx->bss_table.lock);
+}
+#else
+enum nrf_wifi_status nrf_wifi_sys_fmac_bss_table_get(void *dev_ctx,
+						     struct nrf_wifi_fmac_bss_entry *entries,
+						     unsigned int max_entries,
+						     unsigned int *num_entries)
+{
+	if (num_entries) {
+		*num_entries = 0;
+	}
+
+	nrf_wifi_osal_log_err("%s: BSS table is disabled",
+			      __func__);
+
+	return NRF_WIFI_STATUS_FAIL;
+}
+
+
+void nrf_wifi_sys_fmac_bss_table_flush(void *dev_ctx)
+{
+}
+
+
+void nrf_wifi_sys_fmac_bss_table_max_age_set(void *dev_ctx,
+					     unsigned int max_age_ms)
+{
+}
+#endif /* NRF_WIFI_FMAC_BSS_TABLE_SIZE > 0 */
+
+
+#if NRF_WIFI_FMAC_CHAN_HINT_CACHE_SIZE > 0
+void nrf_wifi_sys_fmac_chan_hint_assoc_start(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+					     struct nrf_wifi_umac_assoc_info *assoc_info)
+{
+	struct nrf_wifi_sys_fmac_dev_ctx *sys_dev_ctx = NULL;
+	struct nrf_wifi_fmac_bss_table *bss_table = NULL;
+
+	sys_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
+	bss_table = &sys_dev_ctx->bss_table;
+
+	if (!bss_table->lock) {
+		return;
+	}
+
+	nrf_wifi_osal_spinlock_take(bss_table->lock);
+
+	nrf_wifi_osal_mem_set(&bss_table->pending_assoc,
+			      0,
+			      sizeof(bss_table->pending_assoc));
+
+	bss_table->pending_assoc_valid = (assoc_info->ssid.nrf_wifi_ssid_len > 0) &&
+		(assoc_info->ssid.nrf_wifi_ssid_len <= NRF_WIFI_MAX_SSID_LEN);
+
+	if (bss_table->pending_assoc_valid) {
+		bss_table->pending_assoc.ssid = assoc_info->ssid;
+
+		nrf_wifi_osal_mem_cpy(bss_table->pending_assoc.bssid,
+				      assoc_info->nrf_wifi_bssid,
+				      NRF_WIFI_ETH_ADDR_LEN);
+
+		bss_table->pending_assoc.frequency = assoc_info->center_frequency;
+		bss_table->pending_assoc.assoc = true;
+	}
+
+	nrf_wifi_osal_spinlock_rel(bss_table->lock);
+}
+
+
+void nrf_wifi_sys_fmac_chan_hint_assoc_done(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+					    struct nrf_wifi_umac_event_mlme *mlme,
+					    unsigned int event_len)
+{
+	struct nrf_wifi_sys_fmac_dev_ctx *sys_dev_ctx = NULL;
+	struct nrf_wifi_fmac_bss_table *bss_table = NULL;
+	const unsigned char *frm = NULL;
+	unsigned short status_code = 0;
+
+	sys_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
+	bss_table = &sys_dev_ctx->bss_table;
+
+	if (!bss_table->lock || (event_len < sizeof(*mlme))) {
+		return;
+	}
+
+	/* The status code follows the MAC header and the capabilities field of
+	 * the (re)association response.
+	 */
+	if ((mlme->frame.frame_len < NRF_WIFI_FMAC_ASSOC_RESP_STATUS_OFFSET + 2) ||
+	    (mlme->frame.frame_len > NRF_WIFI_MAX_FRAME_LEN)) {
+		return;
+	}
+
+	frm = (const unsigned char *)mlme->frame.frame;
+	status_code = frm[NRF_WIFI_FMAC_ASSOC_RESP_STATUS_OFFSET] |
+		(frm[NRF_WIFI_FMAC_ASSOC_RESP_STATUS_OFFSET + 1] << 8);
+
+	nrf_wifi_osal_spinlock_take(bss_table->lock);
+
+	if (bss_table->pending_assoc_valid && !status_code) {
+		if (mlme->frequency) {
+			bss_table->pending_assoc.frequency = mlme->frequency;
+		}
+
+		bss_table->pending_assoc.last_seen_ms = nrf_wifi_osal_time_get_curr_ms();
+
+		if (bss_table->pending_assoc.frequency) {
+			nrf_wifi_sys_fmac_chan_hint_update(bss_table,
+							   &bss_table->pending_assoc);
+		}
+	}
+
+	bss_table->pending_assoc_valid = false;
+
+	nrf_wifi_osal_spinlock_rel(bss_table->lock);
+}
+
+
+enum nrf_wifi_status nrf_wifi_sys_fmac_chan_hints_get(void *dev_ctx,
+						      struct nrf_wifi_ssid *ssid,
+						      unsigned int *freqs,
+						      unsigned int max_freqs,
+						      unsigned int *num_freqs)
+{
+	struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx = NULL;
+	struct nrf_wifi_sys_fmac_dev_ctx *sys_dev_ctx = NULL;
+	struct nrf_wifi_fmac_bss_table *bss_table = NULL;
+	struct nrf_wifi_fmac_chan_hint *order[NRF_WIFI_FMAC_CHAN_HINT_CACHE_SIZE];
+	struct nrf_wifi_fmac_chan_hint *hint = NULL;
+	unsigned int num_order = 0;
+	unsigned int num = 0;
+	unsigned int i = 0;
+	unsigned int j = 0;
+
+	fmac_dev_ctx = dev_ctx;
+
+	if (!fmac_dev_ctx || !ssid || !freqs || !num_freqs) {
+		nrf_wifi_osal_log_err("%s: Invalid parameters",
+				      __func__);
+		return NRF_WIFI_STATUS_FAIL;
+	}
+
+	*num_freqs = 0;
+
+	sys_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
+	bss_table = &sys_dev_ctx->bss_table;
+
+	if (!bss_table->lock) {
+		nrf_wifi_osal_log_err("%s: BSS table not initialized",
+				      __func__);
+		return NRF_WIFI_STATUS_FAIL;
+	}
+
+	nrf_wifi_osal_spinlock_take(bss_table->lock);
+
+	/* Associated BSSs first, then the most recently seen ones */
+	for (i = 0; i < bss_table->num_hints; i++) {
+		hint = &bss_table->hints[i];
+
+		if ((hint->ssid.nrf_wifi_ssid_len != ssid->nrf_wifi_ssid_len) ||
+		    nrf_wifi_osal_mem_cmp(hint->ssid.nrf_wifi_ssid,
+					  ssid->nrf_wifi_ssid,
+					  ssid->nrf_wifi_ssid_len)) {
+			continue;
+		}
+
+		for (j = num_order; j > 0; j--) {
+			if ((order[j - 1]->assoc && !hint->assoc) ||
+			    ((order[j - 1]->assoc == hint->assoc) &&
+			     ((long)(order[j - 1]->last_seen_ms - hint->last_seen_ms) >= 0))) {
+				break;
+			}
+
+			order[j] = order[j - 1];
+		}
+
+		order[j] = hint;
+		num_order++;
+	}
+
+	for (i = 0; (i < num_order) && (num < max_freqs); i++) {
+		for (j = 0; j < num; j++) {
+			if (freqs[j] == order[i]->frequency) {
+				break;
+			}
+		}
+
+		if (j == num) {
+			freqs[num++] = order[i]->frequency;
+		}
+	}
+
+	nrf_wifi_osal_spinlock_rel(bss_table->lock);
+
+	*num_freqs = num;
+
+	return NRF_WIFI_STATUS_SUCCESS;
+}
+#else
+void nrf_wifi_sys_fmac_chan_hint_assoc_start(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+					     struct nrf_wifi_umac_assoc_info *assoc_info)
+{
+}
+
+
+void nrf_wifi_sys_fmac_chan_hint_assoc_done(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+					    struct nrf_wifi_umac_event_mlme *mlme,
+					    unsigned int event_len)
+{
+}
+
+
+enum nrf_wifi_status nrf_wifi_sys_fmac_chan_hints_get(void *dev_ctx,
+						      struct nrf_wifi_ssid *ssid,
+						      unsigned int *freqs,
+						      unsigned int max_freqs,
+						      unsigned int *num_freqs)
+{
+	if (!dev_ctx || !ssid || !freqs || !num_freqs) {
+		nrf_wifi_osal_log_err("%s: Invalid parameters",
+				      __func__);
+		return NRF_WIFI_STATUS_FAIL;
+	}
+
+	/* No cache, report no hints so that callers scan all the channels */
+	*num_freqs = 0;
+
+	return NRF_WIFI_STATUS_SUCCESS;
+}
+#endif /* NRF_WIFI_FMAC_CHAN_HINT_CACHE_SIZE > 0 */
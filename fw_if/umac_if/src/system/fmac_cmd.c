@@ -203,6 +203,10 @@ enum nrf_wifi_status umac_cmd_sys_prog_stats_get(struct nrf_wifi_fmac_dev_ctx *f
 	umac_cmd_data->sys_head.len = len;
 	umac_cmd_data->stats_type = RPU_STATS_TYPE_ALL;
 
+#ifdef NRF_WIFI_LOW_POWER
+	nrf_wifi_hal_ps_wake_cause_set(fmac_dev_ctx->hal_dev_ctx,
+				       NRF_WIFI_HAL_PS_WAKE_CAUSE_STATS);
+#endif /* NRF_WIFI_LOW_POWER */
 	status = nrf_wifi_hal_ctrl_cmd_send(fmac_dev_ctx->hal_dev_ctx,
 					    umac_cmd,
 					    (sizeof(*umac_cmd) + len));
@@ -0,0 +1,465 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @brief File containing asynchronous UMAC control command specific
+ * definitions for the FMAC IF Layer of the Wi-Fi driver.
+ */
+
+#include "system/fmac_api.h"
+#include "system/fmac_cmd_async.h"
+#include "common/fmac_util.h"
+#include "system/fmac_peer.h"
+#ifdef NRF_WIFI_RPU_RECOVERY
+#include "system/fmac_recovery.h"
+#endif /* NRF_WIFI_RPU_RECOVERY */
+
+#define RPU_CMD_TIMEOUT_MS 10000
+
+
+/* Completes the outstanding commands which have exceeded their timeouts.
+ * The callbacks are invoked outside the lock so that they can submit
+ * further commands.
+ */
+static void nrf_wifi_sys_fmac_cmd_async_expire(struct nrf_wifi_sys_fmac_dev_ctx *sys_dev_ctx,
+					       bool flush)
+{
+	struct nrf_wifi_fmac_async_cmd_ctx *async_cmd = &sys_dev_ctx->async_cmd;
+	struct nrf_wifi_fmac_async_cmd expired[NRF_WIFI_FMAC_MAX_ASYNC_CMDS];
+	unsigned int num_expired = 0;
+	unsigned int i = 0;
+
+	nrf_wifi_osal_spinlock_take(async_cmd->lock);
+
+	for (i = 0; i < NRF_WIFI_FMAC_MAX_ASYNC_CMDS; i++) {
+		if (!async_cmd->cmds[i].in_use) {
+			continue;
+		}
+
+		if (!flush &&
+		    (nrf_wifi_osal_time_elapsed_ms(async_cmd->cmds[i].submit_time_ms) <
+		     async_cmd->cmds[i].timeout_ms)) {
+			continue;
+		}
+
+		expired[num_expired++] = async_cmd->cmds[i];
+		async_cmd->cmds[i].in_use = false;
+		async_cmd->num_pending--;
+	}
+
+	nrf_wifi_osal_spinlock_rel(async_cmd->lock);
+
+	for (i = 0; i < num_expired; i++) {
+		nrf_wifi_osal_log_err("%s: Command %d (tag %d) timed out waiting for event %d",
+				      __func__,
+				      expired[i].cmd,
+				      expired[i].tag,
+				      expired[i].resp_event);
+
+		if (expired[i].callbk_fn) {
+			expired[i].callbk_fn(expired[i].callbk_ctx,
+					     expired[i].tag,
+					     NRF_WIFI_STATUS_FAIL,
+					     NULL,
+					     0);
+		}
+	}
+}
+
+
+enum nrf_wifi_status nrf_wifi_sys_fmac_cmd_async_init(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx)
+{
+	struct nrf_wifi_sys_fmac_dev_ctx *sys_dev_ctx = NULL;
+
+	sys_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
+
+	nrf_wifi_osal_mem_set(&sys_dev_ctx->async_cmd,
+			      0,
+			      sizeof(sys_dev_ctx->async_cmd));
+
+	sys_dev_ctx->async_cmd.lock = nrf_wifi_osal_spinlock_alloc();
+
+	if (!sys_dev_ctx->async_cmd.lock) {
+		nrf_wifi_osal_log_err("%s: Unable to allocate async command lock",
+				      __func__);
+		return NRF_WIFI_STATUS_FAIL;
+	}
+
+	nrf_wifi_osal_spinlock_init(sys_dev_ctx->async_cmd.lock);
+
+	/* Tag 0 is never handed out so that it can be used as "no tag" */
+	sys_dev_ctx->async_cmd.next_tag = 1;
+
+	return NRF_WIFI_STATUS_SUCCESS;
+}
+
+
+void nrf_wifi_sys_fmac_cmd_async_deinit(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx)
+{
+	struct nrf_wifi_sys_fmac_dev_ctx *sys_dev_ctx = NULL;
+
+	sys_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
+
+	if (!sys_dev_ctx->async_cmd.lock) {
+		return;
+	}
+
+	nrf_wifi_sys_fmac_cmd_async_expire(sys_dev_ctx,
+					   true);
+
+	nrf_wifi_osal_spinlock_free(sys_dev_ctx->async_cmd.lock);
+	sys_dev_ctx->async_cmd.lock = NULL;
+}
+
+
+bool nrf_wifi_sys_fmac_cmd_async_resp(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+				      struct nrf_wifi_umac_hdr *umac_hdr,
+				      unsigned int event_len)
+{
+	struct nrf_wifi_sys_fmac_dev_ctx *sys_dev_ctx = NULL;
+	struct nrf_wifi_fmac_async_cmd_ctx *async_cmd = NULL;
+	struct nrf_wifi_fmac_async_cmd done;
+	int match = -1;
+	unsigned int i = 0;
+
+	sys_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
+	async_cmd = &sys_dev_ctx->async_cmd;
+
+	if (!async_cmd->lock || !async_cmd->num_pending) {
+		return false;
+	}
+
+	nrf_wifi_osal_spinlock_take(async_cmd->lock);
+
+	/* The UMAC does not echo the sequence number, so responses are matched
+	 * to the oldest outstanding command waiting for this event on this VIF.
+	 */
+	for (i = 0; i < NRF_WIFI_FMAC_MAX_ASYNC_CMDS; i++) {
+		if (!async_cmd->cmds[i].in_use ||
+		    (async_cmd->cmds[i].resp_event != umac_hdr->cmd_evnt) ||
+		    (async_cmd->cmds[i].if_idx != umac_hdr->ids.wdev_id)) {
+			continue;
+		}
+
+		if ((match < 0) ||
+		    ((int)(async_cmd->cmds[i].tag - async_cmd->cmds[match].tag) < 0)) {
+			match = i;
+		}
+	}
+
+	if (match >= 0) {
+		done = async_cmd->cmds[match];
+		async_cmd->cmds[match].in_use = false;
+		async_cmd->num_pending--;
+	}
+
+	nrf_wifi_osal_spinlock_rel(async_cmd->lock);
+
+	if (match < 0) {
+		nrf_wifi_sys_fmac_cmd_async_expire(sys_dev_ctx,
+						   false);
+		return false;
+	}
+
+	nrf_wifi_osal_log_dbg("%s: Command %d (tag %d) completed in %d ms",
+			      __func__,
+			      done.cmd,
+			      done.tag,
+			      nrf_wifi_osal_time_elapsed_ms(done.submit_time_ms));
+
+	if (done.callbk_fn) {
+		done.callbk_fn(done.callbk_ctx,
+			       done.tag,
+			       NRF_WIFI_STATUS_SUCCESS,
+			       umac_hdr,
+			       event_len);
+	}
+
+	return true;
+}
+
+
+enum nrf_wifi_status nrf_wifi_sys_fmac_cmd_submit_async(void *dev_ctx,
+							void *cmd,
+							unsigned int cmd_len,
+							unsigned int resp_event,
+							unsigned int timeout_ms,
+							nrf_wifi_fmac_cmd_resp_callbk_t callbk_fn,
+							void *callbk_ctx,
+							unsigned int *tag)
+{
+	enum nrf_wifi_status status = NRF_WIFI_STATUS_FAIL;
+	struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx = NULL;
+	struct nrf_wifi_sys_fmac_dev_ctx *sys_dev_ctx = NULL;
+	struct nrf_wifi_fmac_async_cmd_ctx *async_cmd = NULL;
+	struct nrf_wifi_umac_hdr *umac_hdr = NULL;
+	unsigned int cmd_tag = 0;
+	int slot = -1;
+	unsigned int i = 0;
+
+	fmac_dev_ctx = dev_ctx;
+
+	if (!fmac_dev_ctx || !cmd || (cmd_len < sizeof(*umac_hdr))) {
+		nrf_wifi_osal_log_err("%s: Invalid parameters",
+				      __func__);
+		goto out;
+	}
+
+	if (fmac_dev_ctx->op_mode != NRF_WIFI_OP_MODE_SYS) {
+		nrf_wifi_osal_log_err("%s: Invalid op mode",
+				      __func__);
+		goto out;
+	}
+
+	sys_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
+	async_cmd = &sys_dev_ctx->async_cmd;
+	umac_hdr = cmd;
+
+	if (!async_cmd->lock) {
+		nrf_wifi_osal_log_err("%s: Async command path not initialized",
+				      __func__);
+		goto out;
+	}
+
+	nrf_wifi_sys_fmac_cmd_async_expire(sys_dev_ctx,
+					   false);
+
+	nrf_wifi_osal_spinlock_take(async_cmd->lock);
+
+	cmd_tag = async_cmd->next_tag++;
+
+	if (!async_cmd->next_tag) {
+		async_cmd->next_tag = 1;
+	}
+
+	if (resp_event) {
+		for (i = 0; i < NRF_WIFI_FMAC_MAX_ASYNC_CMDS; i++) {
+			if (!async_cmd->cmds[i].in_use) {
+				slot = i;
+				break;
+			}
+		}
+
+		if (slot >= 0) {
+			async_cmd->cmds[slot].in_use = true;
+			async_cmd->cmds[slot].tag = cmd_tag;
+			async_cmd->cmds[slot].cmd = umac_hdr->cmd_evnt;
+			async_cmd->cmds[slot].resp_event = resp_event;
+			async_cmd->cmds[slot].if_idx = umac_hdr->ids.wdev_id;
+			async_cmd->cmds[slot].submit_time_ms = nrf_wifi_osal_time_get_curr_ms();
+			async_cmd->cmds[slot].timeout_ms = timeout_ms;
+			async_cmd->cmds[slot].callbk_fn = callbk_fn;
+			async_cmd->cmds[slot].callbk_ctx = callbk_ctx;
+			async_cmd->num_pending++;
+		}
+	}
+
+	nrf_wifi_osal_spinlock_rel(async_cmd->lock);
+
+	if (resp_event && (slot < 0)) {
+		nrf_wifi_osal_log_err("%s: Too many outstanding commands",
+				      __func__);
+		goto out;
+	}
+
+	/* The sequence field is unused by the UMAC, use it to carry the tag
+	 * so that the commands can be correlated in RPU side logs.
+	 */
+	umac_hdr->seq = cmd_tag;
+
+	status = umac_cmd_cfg(fmac_dev_ctx,
+			      cmd,
+			      cmd_len);
+
+	if (status != NRF_WIFI_STATUS_SUCCESS) {
+		nrf_wifi_osal_log_err("%s: Failed to send command %d",
+				      __func__,
+				      umac_hdr->cmd_evnt);
+
+		if (slot >= 0) {
+			nrf_wifi_osal_spinlock_take(async_cmd->lock);
+			async_cmd->cmds[slot].in_use = false;
+			async_cmd->num_pending--;
+			nrf_wifi_osal_spinlock_rel(async_cmd->lock);
+		}
+		goto out;
+	}
+
+	if (tag) {
+		*tag = cmd_tag;
+	}
+
+	/* Commands without a response event complete once sent */
+	if (!resp_event && callbk_fn) {
+		callbk_fn(callbk_ctx,
+			  cmd_tag,
+			  NRF_WIFI_STATUS_SUCCESS,
+			  NULL,
+			  0);
+	}
+out:
+	return status;
+}
+
+
+enum nrf_wifi_status nrf_wifi_sys_fmac_cmd_async_cancel(void *dev_ctx,
+							unsigned int tag)
+{
+	enum nrf_wifi_status status = NRF_WIFI_STATUS_FAIL;
+	struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx = NULL;
+	struct nrf_wifi_sys_fmac_dev_ctx *sys_dev_ctx = NULL;
+	struct nrf_wifi_fmac_async_cmd_ctx *async_cmd = NULL;
+	unsigned int i = 0;
+
+	fmac_dev_ctx = dev_ctx;
+
+	if (!fmac_dev_ctx || (fmac_dev_ctx->op_mode != NRF_WIFI_OP_MODE_SYS)) {
+		goto out;
+	}
+
+	sys_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
+	async_cmd = &sys_dev_ctx->async_cmd;
+
+	if (!async_cmd->lock) {
+		goto out;
+	}
+
+	nrf_wifi_osal_spinlock_take(async_cmd->lock);
+
+	for (i = 0; i < NRF_WIFI_FMAC_MAX_ASYNC_CMDS; i++) {
+		if (async_cmd->cmds[i].in_use && (async_cmd->cmds[i].tag == tag)) {
+			async_cmd->cmds[i].in_use = false;
+			async_cmd->num_pending--;
+			status = NRF_WIFI_STATUS_SUCCESS;
+			break;
+		}
+	}
+
+	nrf_wifi_osal_spinlock_rel(async_cmd->lock);
+out:
+	return status;
+}
+
+
+unsigned int nrf_wifi_sys_fmac_cmd_async_poll(void *dev_ctx)
+{
+	struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx = NULL;
+	struct nrf_wifi_sys_fmac_dev_ctx *sys_dev_ctx = NULL;
+
+	fmac_dev_ctx = dev_ctx;
+
+	if (!fmac_dev_ctx || (fmac_dev_ctx->op_mode != NRF_WIFI_OP_MODE_SYS)) {
+		return 0;
+	}
+
+	sys_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
+
+	if (!sys_dev_ctx->async_cmd.lock) {
+		return 0;
+	}
+
+	nrf_wifi_sys_fmac_cmd_async_expire(sys_dev_ctx,
+					   false);
+
+	return sys_dev_ctx->async_cmd.num_pending;
+}
+
+
+enum nrf_wifi_status nrf_wifi_sys_fmac_chg_vif_state_async(void *dev_ctx,
+							   unsigned char if_idx,
+							   struct nrf_wifi_umac_chg_vif_state_info *vif_info,
+							   nrf_wifi_fmac_cmd_resp_callbk_t callbk_fn,
+							   void *callbk_ctx,
+							   unsigned int *tag)
+{
+	enum nrf_wifi_status status = NRF_WIFI_STATUS_FAIL;
+	struct nrf_wifi_umac_cmd_chg_vif_state *chg_vif_state_cmd = NULL;
+	struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx = NULL;
+	struct nrf_wifi_sys_fmac_dev_ctx *sys_dev_ctx = NULL;
+	struct nrf_wifi_fmac_vif_ctx *vif_ctx = NULL;
+
+	fmac_dev_ctx = dev_ctx;
+
+	if (!fmac_dev_ctx || !vif_info || (if_idx >= MAX_NUM_VIFS)) {
+		nrf_wifi_osal_log_err("%s: Invalid parameters",
+				      __func__);
+		goto out;
+	}
+
+	if (fmac_dev_ctx->op_mode != NRF_WIFI_OP_MODE_SYS) {
+		nrf_wifi_osal_log_err("%s: Invalid op mode",
+				      __func__);
+		goto out;
+	}
+
+	sys_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
+	vif_ctx = sys_dev_ctx->vif_ctx[if_idx];
+
+	if (!vif_ctx) {
+		nrf_wifi_osal_log_err("%s: Interface %d not added",
+				      __func__,
+				      if_idx);
+		goto out;
+	}
+
+	chg_vif_state_cmd = nrf_wifi_osal_mem_zalloc(sizeof(*chg_vif_state_cmd));
+
+	if (!chg_vif_state_cmd) {
+		nrf_wifi_osal_log_err("%s: Unable to allocate memory",
+				      __func__);
+		goto out;
+	}
+
+	chg_vif_state_cmd->umac_hdr.cmd_evnt = NRF_WIFI_UMAC_CMD_SET_IFFLAGS;
+	chg_vif_state_cmd->umac_hdr.ids.wdev_id = if_idx;
+	chg_vif_state_cmd->umac_hdr.ids.valid_fields |=
+		NRF_WIFI_INDEX_IDS_WDEV_ID_VALID;
+
+	nrf_wifi_osal_mem_cpy(&chg_vif_state_cmd->info,
+			      vif_info,
+			      sizeof(chg_vif_state_cmd->info));
+
+	status = nrf_wifi_sys_fmac_cmd_submit_async(fmac_dev_ctx,
+						    chg_vif_state_cmd,
+						    sizeof(*chg_vif_state_cmd),
+						    NRF_WIFI_UMAC_EVENT_IFFLAGS_STATUS,
+						    RPU_CMD_TIMEOUT_MS,
+						    callbk_fn,
+						    callbk_ctx,
+						    tag);
+
+	if (status != NRF_WIFI_STATUS_SUCCESS) {
+		goto out;
+	}
+
+	/* Unlike the synchronous API the driver state is updated once the
+	 * command is sent, the callback reports the status from the RPU.
+	 */
+#ifdef NRF_WIFI_RPU_RECOVERY
+	nrf_wifi_sys_fmac_recovery_record(fmac_dev_ctx,
+					  NRF_WIFI_HOST_RPU_MSG_TYPE_UMAC,
+					  if_idx,
+					  NRF_WIFI_UMAC_CMD_SET_IFFLAGS,
+					  0,
+					  chg_vif_state_cmd,
+					  sizeof(*chg_vif_state_cmd));
+#endif /* NRF_WIFI_RPU_RECOVERY */
+#ifdef NRF70_AP_MODE
+	if (vif_ctx->if_type == NRF_WIFI_IFTYPE_AP) {
+		if (vif_info->state == 1) {
+			nrf_wifi_fmac_peer_mc_set(fmac_dev_ctx, if_idx, true);
+		} else if (vif_info->state == 0) {
+			nrf_wifi_fmac_peer_mc_set(fmac_dev_ctx, if_idx, false);
+		}
+	}
+#endif /* NRF70_AP_MODE */
+out:
+	if (chg_vif_state_cmd) {
+		nrf_wifi_osal_mem_free(chg_vif_state_cmd);
+	}
+
+	return status;
+}
@@ -18,6 +18,9 @@
 #include "system/fmac_peer.h"
 #include "system/fmac_ap.h"
 #include "system/fmac_event.h"
+#include "system/fmac_cmd_async.h"
+#include "system/fmac_bss.h"
+#include "system/fmac_event_dispatch.h"
 #include "common/fmac_util.h"
 
 #ifdef NRF70_SYSTEM_WITH_RAW_MODES
@@ -27,12 +30,10 @@ nrf_wifi_fmac_if_mode_set_event_proc(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
 {
 	enum nrf_wifi_status status = NRF_WIFI_STATUS_SUCCESS;
 	struct nrf_wifi_sys_fmac_dev_ctx *sys_dev_ctx;
-	struct tx_config *config;
 	struct nrf_wifi_fmac_vif_ctx *vif;
 	unsigned char if_idx = mode_event->if_index;
 
 	sys_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
-	config = &sys_dev_ctx->tx_config;
 	vif = sys_dev_ctx->vif_ctx[if_idx];
 
 	if (!mode_event->status) {
@@ -47,8 +48,7 @@ nrf_wifi_fmac_if_mode_set_event_proc(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
 			== NRF_WIFI_STA_MODE) {
 			mode_event->op_mode ^= NRF_WIFI_STA_MODE;
 			vif->if_type = NRF_WIFI_IFTYPE_STATION;
-			config->peers[MAX_PEERS].peer_id = -1;
-			config->peers[MAX_PEERS].if_idx = -1;
+			nrf_wifi_fmac_peer_mc_set(fmac_dev_ctx, -1, false);
 
 #if defined(NRF70_RAW_DATA_TX) && defined (NRF70_PROMISC_DATA_RX)
 			if ((mode_event->op_mode ^
@@ -56,10 +56,7 @@ nrf_wifi_fmac_if_mode_set_event_proc(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
 			     NRF_WIFI_TX_INJECTION_MODE)) == 0) {
 				vif->if_type
 					= NRF_WIFI_STA_PROMISC_TX_INJECTOR;
-				config->peers[MAX_PEERS].peer_id
-					= MAX_PEERS;
-				config->peers[MAX_PEERS].if_idx
-					= if_idx;
+				nrf_wifi_fmac_peer_mc_set(fmac_dev_ctx, if_idx, true);
 				vif->txinjection_mode = true;
 				vif->promisc_mode = true;
 			}
@@ -67,10 +64,7 @@ nrf_wifi_fmac_if_mode_set_event_proc(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
 #ifdef NRF70_RAW_DATA_TX
 			if ((mode_event->op_mode ^
 			     NRF_WIFI_TX_INJECTION_MODE) == 0) {
-				config->peers[MAX_PEERS].peer_id
-					= MAX_PEERS;
-				config->peers[MAX_PEERS].if_idx
-					= if_idx;
+				nrf_wifi_fmac_peer_mc_set(fmac_dev_ctx, if_idx, true);
 				vif->if_type = NRF_WIFI_STA_TX_INJECTOR;
 				vif->txinjection_mode = true;
 			}
@@ -89,15 +83,11 @@ nrf_wifi_fmac_if_mode_set_event_proc(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
 			== NRF_WIFI_MONITOR_MODE) {
 			mode_event->op_mode ^= NRF_WIFI_MONITOR_MODE;
 			vif->if_type = NRF_WIFI_IFTYPE_MONITOR;
-			config->peers[MAX_PEERS].peer_id = -1;
-			config->peers[MAX_PEERS].if_idx = -1;
+			nrf_wifi_fmac_peer_mc_set(fmac_dev_ctx, -1, false);
 #ifdef NRF70_RAW_DATA_TX
 			if ((mode_event->op_mode ^
 			     NRF_WIFI_TX_INJECTION_MODE) == 0) {
-				config->peers[MAX_PEERS].peer_id
-					= MAX_PEERS;
-				config->peers[MAX_PEERS].if_idx
-					= if_idx;
+				nrf_wifi_fmac_peer_mc_set(fmac_dev_ctx, if_idx, true);
 				vif->if_type = NRF_WIFI_MONITOR_TX_INJECTOR;
 				vif->txinjection_mode = true;
 			}
@@ -111,6 +101,13 @@ nrf_wifi_fmac_if_mode_set_event_proc(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
 		status = NRF_WIFI_STATUS_FAIL;
 	}
 out:
+#ifdef NRF70_RAW_DATA_TX
+	if (status == NRF_WIFI_STATUS_SUCCESS) {
+		tx_rawtx_session_vif_check(fmac_dev_ctx,
+					   if_idx,
+					   false);
+	}
+#endif /* NRF70_RAW_DATA_TX */
 	return status;
 }
 #endif /* NRF70_SYSTEM_WITH_RAW_MODES */
@@ -172,12 +169,118 @@ out:
 #endif /* NRF70_DATA_TX */
 
 
+static void umac_event_sys_stats_delta(const void *cur,
+				       const void *prev,
+				       void *delta,
+				       unsigned int len)
+{
+	const unsigned char *cur_p = cur;
+	const unsigned char *prev_p = prev;
+	unsigned char *delta_p = delta;
+	unsigned int cur_val = 0;
+	unsigned int prev_val = 0;
+	unsigned int delta_val = 0;
+	unsigned int i = 0;
+
+	/* The statistics are packed, access the counters byte-wise */
+	for (i = 0; (i + sizeof(cur_val)) <= len; i += sizeof(cur_val)) {
+		nrf_wifi_osal_mem_cpy(&cur_val, cur_p + i, sizeof(cur_val));
+		nrf_wifi_osal_mem_cpy(&prev_val, prev_p + i, sizeof(prev_val));
+		delta_val = cur_val - prev_val;
+		nrf_wifi_osal_mem_cpy(delta_p + i, &delta_val, sizeof(delta_val));
+	}
+}
+
+
+static unsigned int umac_event_sys_stats_rate(unsigned int delta,
+					      unsigned int interval_ms)
+{
+	if (!interval_ms) {
+		return 0;
+	}
+
+	return ((delta / interval_ms) * 1000) +
+		(((delta % interval_ms) * 1000) / interval_ms);
+}
+
+
+/* Only called from the event context, which is the sole writer of the
+ * snapshots. The new snapshot is built in the unpublished buffer and then
+ * published by flipping the index, readers never wait for the update.
+ */
+static void umac_event_sys_stats_periodic_update(struct nrf_wifi_fmac_stats_periodic *periodic,
+						 struct nrf_wifi_fmac_stats_snapshot *snap,
+						 struct rpu_sys_fw_stats *fw)
+{
+	struct nrf_wifi_fmac_stats_snapshot *prev = NULL;
+	struct nrf_wifi_fmac_stats_snapshot *next = NULL;
+	struct nrf_wifi_interface_stats *if_delta = NULL;
+
+	prev = &snap[periodic->active];
+	next = &snap[!periodic->active];
+
+	/* Make a reader which is still copying this buffer retry */
+	next->seq = 0;
+
+	nrf_wifi_osal_mem_cpy(&next->fw,
+			      fw,
+			      sizeof(next->fw));
+
+	next->timestamp_ms = nrf_wifi_osal_time_get_curr_ms();
+
+	if (prev->seq) {
+		next->interval_ms = next->timestamp_ms - prev->timestamp_ms;
+
+		umac_event_sys_stats_delta(&next->fw.lmac,
+					   &prev->fw.lmac,
+					   &next->lmac_delta,
+					   sizeof(next->lmac_delta));
+
+		umac_event_sys_stats_delta(&next->fw.umac,
+					   &prev->fw.umac,
+					   &next->umac_delta,
+					   sizeof(next->umac_delta));
+	} else {
+		next->interval_ms = 0;
+
+		nrf_wifi_osal_mem_set(&next->lmac_delta,
+				      0,
+				      sizeof(next->lmac_delta));
+
+		nrf_wifi_osal_mem_set(&next->umac_delta,
+				      0,
+				      sizeof(next->umac_delta));
+	}
+
+	if_delta = &next->umac_delta.interface_data_stats;
+
+	next->tx_bytes_per_sec = umac_event_sys_stats_rate(if_delta->tx_bytes,
+							   next->interval_ms);
+	next->rx_bytes_per_sec = umac_event_sys_stats_rate(if_delta->rx_bytes,
+							   next->interval_ms);
+	next->tx_pkts_per_sec = umac_event_sys_stats_rate(if_delta->tx_unicast_pkt_count,
+							  next->interval_ms);
+	next->rx_pkts_per_sec = umac_event_sys_stats_rate(if_delta->rx_unicast_pkt_count,
+							  next->interval_ms);
+
+	next->seq = prev->seq + 1;
+
+	/* Publish the new snapshot to the readers */
+	periodic->active = !periodic->active;
+}
+
+
 static enum nrf_wifi_status umac_event_sys_stats_process(
 	struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
 	void *event)
 {
 	enum nrf_wifi_status status = NRF_WIFI_STATUS_FAIL;
 	struct nrf_wifi_sys_umac_event_stats *stats = NULL;
+	struct nrf_wifi_sys_fmac_dev_ctx *sys_dev_ctx = NULL;
+	struct nrf_wifi_fmac_stats_periodic *periodic = NULL;
+	struct nrf_wifi_fmac_stats_snapshot *snap = NULL;
+	bool on_demand = false;
+	bool periodic_req = false;
 
 	if (!event) {
 		nrf_wifi_osal_log_err("%s: Invalid parameters",
@@ -185,19 +288,51 @@ static enum nrf_wifi_status umac_event_sys_stats_process(
 		goto out;
 	}
 
-	if (!fmac_dev_ctx->stats_req) {
-		nrf_wifi_osal_log_err("%s: Stats recd when req was not sent!",
-				      __func__);
+	sys_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
+	periodic = &sys_dev_ctx->stats_periodic;
+	stats = ((struct nrf_wifi_sys_umac_event_stats *)event);
+
+	if (!periodic->lock) {
 		goto out;
 	}
 
-	stats = ((struct nrf_wifi_sys_umac_event_stats *)event);
+	/* A single reply serves both an on-demand and a periodic request */
+	nrf_wifi_osal_spinlock_take(periodic->lock);
+
+	on_demand = fmac_dev_ctx->stats_req;
+
+	if (on_demand) {
+		nrf_wifi_osal_mem_cpy(fmac_dev_ctx->fw_stats,
+				      &stats->fw,
+				      sizeof(stats->fw));
+		fmac_dev_ctx->stats_req = false;
+	}
+
+	periodic_req = periodic->req_pending;
+	periodic->req_pending = false;
+
+	/* NULL if periodic stats were never enabled, the buffers are only
+	 * freed on device deinit.
+	 */
+	snap = periodic->snap;
+
+	nrf_wifi_osal_spinlock_rel(periodic->lock);
+
+	if (periodic_req && snap) {
+		umac_event_sys_stats_periodic_update(periodic,
+						     snap,
+						     &stats->fw);
+	}
 
-	nrf_wifi_osal_mem_cpy(fmac_dev_ctx->fw_stats,
-			      &stats->fw,
-			      sizeof(stats->fw));
+	if (!on_demand && !periodic_req) {
+		nrf_wifi_osal_log_err("%s: Stats recd when req was not sent!",
+				      __func__);
+		goto out;
+	}
 
-	fmac_dev_ctx->stats_req = false;
+	if (on_demand) {
+		nrf_wifi_osal_completion_complete(fmac_dev_ctx->stats_comp);
+	}
 
 	status = NRF_WIFI_STATUS_SUCCESS;
 
@@ -229,10 +364,12 @@ static enum nrf_wifi_status umac_event_sys_proc_events(struct nrf_wifi_fmac_dev_
 		break;
 	case NRF_WIFI_EVENT_INIT_DONE:
 		fmac_dev_ctx->fw_init_done = 1;
+		nrf_wifi_osal_completion_complete(fmac_dev_ctx->fw_init_comp);
 		status = NRF_WIFI_STATUS_SUCCESS;
 		break;
 	case NRF_WIFI_EVENT_DEINIT_DONE:
 		fmac_dev_ctx->fw_deinit_done = 1;
+		nrf_wifi_osal_completion_complete(fmac_dev_ctx->fw_deinit_comp);
 		status = NRF_WIFI_STATUS_SUCCESS;
 		break;
 #ifdef NRF70_RAW_DATA_TX
@@ -288,6 +425,7 @@ nrf_wifi_fmac_data_event_process(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
 	enum nrf_wifi_status status = NRF_WIFI_STATUS_SUCCESS;
 	int event = -1;
 	struct nrf_wifi_sys_fmac_dev_ctx *sys_dev_ctx = NULL;
+	unsigned long start_us = 0;
 
 	sys_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
 
@@ -313,6 +451,8 @@ nrf_wifi_fmac_data_event_process(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
 			      event);
 #endif /* NRF_WIFI_CMD_EVENT_LOG */
 
+	start_us = nrf_wifi_sys_fmac_event_dispatch_start(fmac_dev_ctx);
+
 	switch (event) {
 	case NRF_WIFI_CMD_RX_BUFF:
 #ifdef NRF70_RX_DONE_WQ_ENABLED
@@ -395,6 +535,15 @@ nrf_wifi_fmac_data_event_process(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
 	}
 
 out:
+	if (fmac_dev_ctx && umac_head) {
+		nrf_wifi_sys_fmac_event_dispatch_done(fmac_dev_ctx,
+						      start_us,
+						      true,
+						      event,
+						      umac_head,
+						      ((struct nrf_wifi_umac_head *)umac_head)->len);
+	}
+
 	if (status != NRF_WIFI_STATUS_SUCCESS) {
 		nrf_wifi_osal_log_err("%s: Failed for event = %d",
 				      __func__,
@@ -444,6 +593,9 @@ static void umac_event_connect(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
 {
 	unsigned char if_index = 0;
 	int peer_id = -1;
+#ifdef NRF70_AP_MODE
+	unsigned int ies_len = 0;
+#endif /* NRF70_AP_MODE */
 	struct nrf_wifi_fmac_vif_ctx *vif_ctx = NULL;
 	struct nrf_wifi_umac_event_new_station *event = NULL;
 	struct nrf_wifi_sys_fmac_dev_ctx *sys_dev_ctx = NULL;
@@ -482,6 +634,25 @@ static void umac_event_connect(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
 				return;
 			}
 		}
+
+#ifdef NRF70_AP_MODE
+		if (vif_ctx->if_type == NRF_WIFI_IFTYPE_AP) {
+			ies_len = 0;
+
+			if (event->valid_fields & NRF_WIFI_CMD_SEND_STATION_ASSOC_REQ_IES_VALID) {
+				ies_len = event->assoc_req_ies.ie_len;
+
+				if (ies_len > NRF_WIFI_MAX_IE_LEN) {
+					ies_len = NRF_WIFI_MAX_IE_LEN;
+				}
+			}
+
+			sap_client_uapsd_init(fmac_dev_ctx,
+					      peer_id,
+					      (const unsigned char *)event->assoc_req_ies.ie,
+					      ies_len);
+		}
+#endif /* NRF70_AP_MODE */
 	} else if (event->umac_hdr.cmd_evnt == NRF_WIFI_UMAC_EVENT_DEL_STATION) {
 		peer_id = nrf_wifi_fmac_peer_get_id(fmac_dev_ctx, event->mac_addr);
 		if (peer_id != -1) {
@@ -511,6 +682,12 @@ static enum nrf_wifi_status umac_event_ctrl_process(struct nrf_wifi_fmac_dev_ctx
 	bool more_res = false;
 	unsigned char if_id = 0;
 	unsigned int event_num = 0;
+	unsigned long start_us = 0;
+#ifdef NRF70_DATA_TX
+	struct nrf_wifi_umac_event_twt_sleep *twt_sleep = NULL;
+	struct nrf_wifi_umac_cmd_config_twt *twt_config = NULL;
+	struct nrf_wifi_umac_cmd_teardown_twt *twt_teardown = NULL;
+#endif /* NRF70_DATA_TX */
 
 	if (!fmac_dev_ctx || !event_data) {
 		nrf_wifi_osal_log_err("%s: Invalid parameters",
@@ -560,6 +737,8 @@ static enum nrf_wifi_status umac_event_ctrl_process(struct nrf_wifi_fmac_dev_ctx
 			      event_num);
 #endif /* NRF_WIFI_CMD_EVENT_LOG */
 
+	start_us = nrf_wifi_sys_fmac_event_dispatch_start(fmac_dev_ctx);
+
 	switch (umac_hdr->cmd_evnt) {
 	case NRF_WIFI_UMAC_EVENT_GET_REG:
 		if (callbk_fns->event_get_reg)
@@ -570,6 +749,9 @@ static enum nrf_wifi_status umac_event_ctrl_process(struct nrf_wifi_fmac_dev_ctx
 			nrf_wifi_osal_log_err("%s: No callback registered for event %d",
 					      __func__,
 					      umac_hdr->cmd_evnt);
+
+		if (fmac_dev_ctx->alpha2_valid)
+			nrf_wifi_osal_completion_complete(fmac_dev_ctx->reg_get_comp);
 		break;
 	case NRF_WIFI_UMAC_EVENT_REG_CHANGE:
 		if (callbk_fns->reg_change_callbk_fn)
@@ -580,6 +762,9 @@ static enum nrf_wifi_status umac_event_ctrl_process(struct nrf_wifi_fmac_dev_ctx
 			nrf_wifi_osal_log_err("%s: No callback registered for event %d",
 					      __func__,
 					      umac_hdr->cmd_evnt);
+
+		if (fmac_dev_ctx->reg_set_status)
+			nrf_wifi_osal_completion_complete(fmac_dev_ctx->reg_set_comp);
 		break;
 	case NRF_WIFI_UMAC_EVENT_TRIGGER_SCAN_START:
 		if (callbk_fns->scan_start_callbk_fn)
@@ -615,6 +800,10 @@ static enum nrf_wifi_status umac_event_ctrl_process(struct nrf_wifi_fmac_dev_ctx
 		if (umac_hdr->seq != 0)
 			more_res = true;
 
+		nrf_wifi_sys_fmac_bss_table_disp_res(fmac_dev_ctx,
+						     event_data,
+						     event_len);
+
 		if (callbk_fns->disp_scan_res_callbk_fn)
 			callbk_fns->disp_scan_res_callbk_fn(vif_ctx->os_vif_ctx,
 							    event_data,
@@ -632,12 +821,18 @@ static enum nrf_wifi_status umac_event_ctrl_process(struct nrf_wifi_fmac_dev_ctx
 			nrf_wifi_osal_log_err("%s: Failed to set interface flags: %d",
 					      __func__,
 						evnt_vif_state->status);
-			goto out;
+			break;
 		}
 		vif_ctx->ifflags = true;
+		nrf_wifi_osal_completion_complete(vif_ctx->ifflags_comp);
 		break;
 #ifdef NRF70_STA_MODE
 	case NRF_WIFI_UMAC_EVENT_TWT_SLEEP:
+#ifdef NRF70_DATA_TX
+		twt_sleep = event_data;
+		tx_twt_state_set(fmac_dev_ctx,
+				 twt_sleep->info.type == TWT_UNBLOCK_TX);
+#endif /* NRF70_DATA_TX */
 		if (callbk_fns->twt_sleep_callbk_fn)
 			callbk_fns->twt_sleep_callbk_fn(vif_ctx->os_vif_ctx,
 							event_data,
@@ -651,6 +846,10 @@ static enum nrf_wifi_status umac_event_ctrl_process(struct nrf_wifi_fmac_dev_ctx
 		if (umac_hdr->seq != 0)
 			more_res = true;
 
+		nrf_wifi_sys_fmac_bss_table_scan_res(fmac_dev_ctx,
+						     event_data,
+						     event_len);
+
 		if (callbk_fns->scan_res_callbk_fn)
 			callbk_fns->scan_res_callbk_fn(vif_ctx->os_vif_ctx,
 						       event_data,
@@ -672,6 +871,10 @@ static enum nrf_wifi_status umac_event_ctrl_process(struct nrf_wifi_fmac_dev_ctx
 					      umac_hdr->cmd_evnt);
 		break;
 	case NRF_WIFI_UMAC_EVENT_ASSOCIATE:
+		nrf_wifi_sys_fmac_chan_hint_assoc_done(fmac_dev_ctx,
+						       event_data,
+						       event_len);
+
 		if (callbk_fns->assoc_resp_callbk_fn)
 			callbk_fns->assoc_resp_callbk_fn(vif_ctx->os_vif_ctx,
 							 event_data,
@@ -793,6 +996,10 @@ static enum nrf_wifi_status umac_event_ctrl_process(struct nrf_wifi_fmac_dev_ctx
 					      umac_hdr->cmd_evnt);
 		break;
 	case NRF_WIFI_UMAC_EVENT_CONFIG_TWT:
+#ifdef NRF70_DATA_TX
+		twt_config = event_data;
+		tx_twt_config(fmac_dev_ctx, &twt_config->info);
+#endif /* NRF70_DATA_TX */
 		if (callbk_fns->twt_config_callbk_fn)
 			callbk_fns->twt_config_callbk_fn(vif_ctx->os_vif_ctx,
 							event_data,
@@ -803,6 +1010,10 @@ static enum nrf_wifi_status umac_event_ctrl_process(struct nrf_wifi_fmac_dev_ctx
 					      umac_hdr->cmd_evnt);
 		break;
 	case NRF_WIFI_UMAC_EVENT_TEARDOWN_TWT:
+#ifdef NRF70_DATA_TX
+		twt_teardown = event_data;
+		tx_twt_teardown(fmac_dev_ctx, twt_teardown->info.twt_flow_id);
+#endif /* NRF70_DATA_TX */
 		if (callbk_fns->twt_teardown_callbk_fn)
 			callbk_fns->twt_teardown_callbk_fn(vif_ctx->os_vif_ctx,
 							   event_data,
@@ -813,6 +1024,14 @@ static enum nrf_wifi_status umac_event_ctrl_process(struct nrf_wifi_fmac_dev_ctx
 					      umac_hdr->cmd_evnt);
 		break;
 	case NRF_WIFI_UMAC_EVENT_NEW_WIPHY:
+#ifdef NRF70_DATA_TX
+		if (event_len >= sizeof(struct nrf_wifi_event_get_wiphy)) {
+			nrf_wifi_fmac_peers_fw_capa_set(fmac_dev_ctx,
+							((struct nrf_wifi_event_get_wiphy *)
+							 event_data)->max_ap_assoc_sta);
+		}
+#endif /* NRF70_DATA_TX */
+
 		if (callbk_fns->event_get_wiphy)
 			callbk_fns->event_get_wiphy(vif_ctx->os_vif_ctx,
 						    event_data,
@@ -894,11 +1113,27 @@ static enum nrf_wifi_status umac_event_ctrl_process(struct nrf_wifi_fmac_dev_ctx
 		break;
 	}
 
+	/* Complete any asynchronous command waiting for this event, once the
+	 * driver state has been updated by the event processing above.
+	 */
+	nrf_wifi_sys_fmac_cmd_async_resp(fmac_dev_ctx,
+					 umac_hdr,
+					 event_len);
+
 	nrf_wifi_osal_log_dbg("%s: Event %d processed",
 			      __func__,
 			      event_num);
 
 out:
+	if (sys_dev_ctx && umac_hdr) {
+		nrf_wifi_sys_fmac_event_dispatch_done(fmac_dev_ctx,
+						      start_us,
+						      false,
+						      event_num,
+						      event_data,
+						      event_len);
+	}
+
 	return status;
 }
 
@@ -0,0 +1,392 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @brief File containing UMAC event dispatch specific definitions for the
+ * FMAC IF Layer of the Wi-Fi driver.
+ */
+
+#include "system/fmac_api.h"
+#include "system/fmac_event_dispatch.h"
+#include "common/fmac_util.h"
+
+
+static void nrf_wifi_sys_fmac_event_stats_update(struct nrf_wifi_fmac_event_stats *stats,
+						 unsigned int elapsed_us)
+{
+	unsigned int bin = 0;
+	unsigned int limit_us = NRF_WIFI_FMAC_EVENT_HIST_BASE_US;
+
+	while ((bin < NRF_WIFI_FMAC_EVENT_HIST_BINS - 1) && (elapsed_us >= limit_us)) {
+		bin++;
+		limit_us <<= 1;
+	}
+
+	stats->count++;
+	stats->total_us += elapsed_us;
+	stats->hist[bin]++;
+
+	if (elapsed_us > stats->max_us) {
+		stats->max_us = elapsed_us;
+	}
+}
+
+
+enum nrf_wifi_status nrf_wifi_sys_fmac_event_dispatch_init(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx)
+{
+	struct nrf_wifi_sys_fmac_dev_ctx *sys_dev_ctx = NULL;
+
+	sys_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
+
+	nrf_wifi_osal_mem_set(&sys_dev_ctx->event_dispatch,
+			      0,
+			      sizeof(sys_dev_ctx->event_dispatch));
+
+	sys_dev_ctx->event_dispatch.lock = nrf_wifi_osal_spinlock_alloc();
+
+	if (!sys_dev_ctx->event_dispatch.lock) {
+		nrf_wifi_osal_log_err("%s: Unable to allocate event dispatch lock",
+				      __func__);
+		return NRF_WIFI_STATUS_FAIL;
+	}
+
+	nrf_wifi_osal_spinlock_init(sys_dev_ctx->event_dispatch.lock);
+
+	sys_dev_ctx->event_dispatch.observer_lock = nrf_wifi_osal_spinlock_alloc();
+
+	if (!sys_dev_ctx->event_dispatch.observer_lock) {
+		nrf_wifi_osal_log_err("%s: Unable to allocate event observer lock",
+				      __func__);
+		nrf_wifi_osal_spinlock_free(sys_dev_ctx->event_dispatch.lock);
+		sys_dev_ctx->event_dispatch.lock = NULL;
+		return NRF_WIFI_STATUS_FAIL;
+	}
+
+	nrf_wifi_osal_spinlock_init(sys_dev_ctx->event_dispatch.observer_lock);
+
+	return NRF_WIFI_STATUS_SUCCESS;
+}
+
+
+void nrf_wifi_sys_fmac_event_dispatch_deinit(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx)
+{
+	struct nrf_wifi_sys_fmac_dev_ctx *sys_dev_ctx = NULL;
+
+	sys_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
+
+	if (!sys_dev_ctx->event_dispatch.lock) {
+		return;
+	}
+
+	nrf_wifi_osal_spinlock_free(sys_dev_ctx->event_dispatch.observer_lock);
+	sys_dev_ctx->event_dispatch.observer_lock = NULL;
+	nrf_wifi_osal_spinlock_free(sys_dev_ctx->event_dispatch.lock);
+	sys_dev_ctx->event_dispatch.lock = NULL;
+	sys_dev_ctx->event_dispatch.num_observers = 0;
+	sys_dev_ctx->event_dispatch.stats_enabled = false;
+}
+
+
+unsigned long nrf_wifi_sys_fmac_event_dispatch_start(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx)
+{
+	struct nrf_wifi_sys_fmac_dev_ctx *sys_dev_ctx = NULL;
+
+	sys_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
+
+	/* Keep the dispatch path free of timer reads unless asked for */
+	if (!sys_dev_ctx->event_dispatch.stats_enabled) {
+		return 0;
+	}
+
+	return nrf_wifi_osal_time_get_curr_us();
+}
+
+
+void nrf_wifi_sys_fmac_event_dispatch_done(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+					   unsigned long start_us,
+					   bool data_event,
+					   unsigned int event,
+					   void *event_data,
+					   unsigned int event_len)
+{
+	struct nrf_wifi_sys_fmac_dev_ctx *sys_dev_ctx = NULL;
+	struct nrf_wifi_fmac_event_dispatch *dispatch = NULL;
+	struct nrf_wifi_fmac_event_observer observers[NRF_WIFI_FMAC_MAX_EVENT_OBSERVERS];
+	struct nrf_wifi_fmac_event_stats *stats = NULL;
+	unsigned int num_observers = 0;
+	unsigned int elapsed_us = 0;
+	unsigned int i = 0;
+
+	sys_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
+	dispatch = &sys_dev_ctx->event_dispatch;
+
+	if (!dispatch->lock) {
+		return;
+	}
+
+	if (!dispatch->stats_enabled && !dispatch->num_observers) {
+		return;
+	}
+
+	if (start_us) {
+		elapsed_us = nrf_wifi_osal_time_elapsed_us(start_us);
+	}
+
+	if (data_event) {
+		if (event < NRF_WIFI_FMAC_NUM_DATA_EVENTS) {
+			stats = &dispatch->data_stats[event];
+		}
+	} else if ((event >= NRF_WIFI_UMAC_EVENT_UNSPECIFIED) &&
+		   (event - NRF_WIFI_UMAC_EVENT_UNSPECIFIED < NRF_WIFI_FMAC_NUM_CTRL_EVENTS)) {
+		stats = &dispatch->ctrl_stats[event - NRF_WIFI_UMAC_EVENT_UNSPECIFIED];
+	}
+
+	/* Held across the observer calls so that unregister can wait for them */
+	nrf_wifi_osal_spinlock_take(dispatch->observer_lock);
+
+	nrf_wifi_osal_spinlock_take(dispatch->lock);
+
+	if (start_us && dispatch->stats_enabled && stats) {
+		nrf_wifi_sys_fmac_event_stats_update(stats,
+						     elapsed_us);
+	}
+
+	for (i = 0; i < NRF_WIFI_FMAC_MAX_EVENT_OBSERVERS; i++) {
+		if (dispatch->observers[i].callbk_fn &&
+		    (dispatch->observers[i].data_event == data_event) &&
+		    (dispatch->observers[i].event == event)) {
+			observers[num_observers++] = dispatch->observers[i];
+		}
+	}
+
+	nrf_wifi_osal_spinlock_rel(dispatch->lock);
+
+	/* Observers may register others, so call them outside the lock */
+	for (i = 0; i < num_observers; i++) {
+		observers[i].callbk_fn(observers[i].callbk_ctx,
+				       event,
+				       event_data,
+				       event_len);
+	}
+
+	nrf_wifi_osal_spinlock_rel(dispatch->observer_lock);
+}
+
+
+enum nrf_wifi_status nrf_wifi_sys_fmac_event_observer_register(void *dev_ctx,
+							       bool data_event,
+							       unsigned int event,
+							       nrf_wifi_fmac_event_observer_t callbk_fn,
+							       void *callbk_ctx)
+{
+	enum nrf_wifi_status status = NRF_WIFI_STATUS_FAIL;
+	struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx = NULL;
+	struct nrf_wifi_sys_fmac_dev_ctx *sys_dev_ctx = NULL;
+	struct nrf_wifi_fmac_event_dispatch *dispatch = NULL;
+	bool valid_event = false;
+	unsigned int i = 0;
+
+	fmac_dev_ctx = dev_ctx;
+
+	if (data_event) {
+		valid_event = (event < NRF_WIFI_FMAC_NUM_DATA_EVENTS);
+	} else {
+		valid_event = (event >= NRF_WIFI_UMAC_EVENT_UNSPECIFIED) &&
+			(event - NRF_WIFI_UMAC_EVENT_UNSPECIFIED < NRF_WIFI_FMAC_NUM_CTRL_EVENTS);
+	}
+
+	if (!fmac_dev_ctx || !callbk_fn || !valid_event) {
+		nrf_wifi_osal_log_err("%s: Invalid parameters",
+				      __func__);
+		goto out;
+	}
+
+	sys_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
+	dispatch = &sys_dev_ctx->event_dispatch;
+
+	if (!dispatch->lock) {
+		goto out;
+	}
+
+	nrf_wifi_osal_spinlock_take(dispatch->lock);
+
+	for (i = 0; i < NRF_WIFI_FMAC_MAX_EVENT_OBSERVERS; i++) {
+		if (!dispatch->observers[i].callbk_fn) {
+			dispatch->observers[i].data_event = data_event;
+			dispatch->observers[i].event = event;
+			dispatch->observers[i].callbk_fn = callbk_fn;
+			dispatch->observers[i].callbk_ctx = callbk_ctx;
+			dispatch->num_observers++;
+			status = NRF_WIFI_STATUS_SUCCESS;
+			break;
+		}
+	}
+
+	nrf_wifi_osal_spinlock_rel(dispatch->lock);
+
+	if (status != NRF_WIFI_STATUS_SUCCESS) {
+		nrf_wifi_osal_log_err("%s: No free observer slots",
+				      __func__);
+	}
+out:
+	return status;
+}
+
+
+enum nrf_wifi_status nrf_wifi_sys_fmac_event_observer_unregister(void *dev_ctx,
+								 bool data_event,
+								 unsigned int event,
+								 nrf_wifi_fmac_event_observer_t callbk_fn,
+								 void *callbk_ctx)
+{
+	enum nrf_wifi_status status = NRF_WIFI_STATUS_FAIL;
+	struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx = NULL;
+	struct nrf_wifi_sys_fmac_dev_ctx *sys_dev_ctx = NULL;
+	struct nrf_wifi_fmac_event_dispatch *dispatch = NULL;
+	unsigned int i = 0;
+
+	fmac_dev_ctx = dev_ctx;
+
+	if (!fmac_dev_ctx || !callbk_fn) {
+		nrf_wifi_osal_log_err("%s: Invalid parameters",
+				      __func__);
+		goto out;
+	}
+
+	sys_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
+	dispatch = &sys_dev_ctx->event_dispatch;
+
+	if (!dispatch->lock) {
+		goto out;
+	}
+
+	nrf_wifi_osal_spinlock_take(dispatch->lock);
+
+	for (i = 0; i < NRF_WIFI_FMAC_MAX_EVENT_OBSERVERS; i++) {
+		if ((dispatch->observers[i].data_event == data_event) &&
+		    (dispatch->observers[i].event == event) &&
+		    (dispatch->observers[i].callbk_fn == callbk_fn) &&
+		    (dispatch->observers[i].callbk_ctx == callbk_ctx)) {
+			nrf_wifi_osal_mem_set(&dispatch->observers[i],
+					      0,
+					      sizeof(dispatch->observers[i]));
+			dispatch->num_observers--;
+			status = NRF_WIFI_STATUS_SUCCESS;
+			break;
+		}
+	}
+
+	nrf_wifi_osal_spinlock_rel(dispatch->lock);
+
+	if (status == NRF_WIFI_STATUS_SUCCESS) {
+		/* A dispatch which copied the observer before it was removed may
+		 * still be calling it, wait for that to return.
+		 */
+		nrf_wifi_osal_spinlock_take(dispatch->observer_lock);
+		nrf_wifi_osal_spinlock_rel(dispatch->observer_lock);
+	}
+out:
+	return status;
+}
+
+
+void nrf_wifi_sys_fmac_event_stats_enable(void *dev_ctx,
+					  bool enable)
+{
+	struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx = NULL;
+	struct nrf_wifi_sys_fmac_dev_ctx *sys_dev_ctx = NULL;
+
+	fmac_dev_ctx = dev_ctx;
+
+	if (!fmac_dev_ctx) {
+		return;
+	}
+
+	sys_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
+
+	sys_dev_ctx->event_dispatch.stats_enabled = enable;
+}
+
+
+void nrf_wifi_sys_fmac_event_stats_reset(void *dev_ctx)
+{
+	struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx = NULL;
+	struct nrf_wifi_sys_fmac_dev_ctx *sys_dev_ctx = NULL;
+	struct nrf_wifi_fmac_event_dispatch *dispatch = NULL;
+
+	fmac_dev_ctx = dev_ctx;
+
+	if (!fmac_dev_ctx) {
+		return;
+	}
+
+	sys_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
+	dispatch = &sys_dev_ctx->event_dispatch;
+
+	if (!dispatch->lock) {
+		return;
+	}
+
+	nrf_wifi_osal_spinlock_take(dispatch->lock);
+
+	nrf_wifi_osal_mem_set(dispatch->ctrl_stats,
+			      0,
+			      sizeof(dispatch->ctrl_stats));
+
+	nrf_wifi_osal_mem_set(dispatch->data_stats,
+			      0,
+			      sizeof(dispatch->data_stats));
+
+	nrf_wifi_osal_spinlock_rel(dispatch->lock);
+}
+
+
+enum nrf_wifi_status nrf_wifi_sys_fmac_event_stats_get(void *dev_ctx,
+						       bool data_event,
+						       unsigned int event,
+						       struct nrf_wifi_fmac_event_stats *stats)
+{
+	struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx = NULL;
+	struct nrf_wifi_sys_fmac_dev_ctx *sys_dev_ctx = NULL;
+	struct nrf_wifi_fmac_event_dispatch *dispatch = NULL;
+	struct nrf_wifi_fmac_event_stats *src = NULL;
+
+	fmac_dev_ctx = dev_ctx;
+
+	if (!fmac_dev_ctx || !stats) {
+		nrf_wifi_osal_log_err("%s: Invalid parameters",
+				      __func__);
+		return NRF_WIFI_STATUS_FAIL;
+	}
+
+	sys_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
+	dispatch = &sys_dev_ctx->event_dispatch;
+
+	if (data_event) {
+		if (event >= NRF_WIFI_FMAC_NUM_DATA_EVENTS) {
+			return NRF_WIFI_STATUS_FAIL;
+		}
+
+		src = &dispatch->data_stats[event];
+	} else {
+		if ((event < NRF_WIFI_UMAC_EVENT_UNSPECIFIED) ||
+		    (event - NRF_WIFI_UMAC_EVENT_UNSPECIFIED >= NRF_WIFI_FMAC_NUM_CTRL_EVENTS)) {
+			return NRF_WIFI_STATUS_FAIL;
+		}
+
+		src = &dispatch->ctrl_stats[event - NRF_WIFI_UMAC_EVENT_UNSPECIFIED];
+	}
+
+	if (!dispatch->lock) {
+		return NRF_WIFI_STATUS_FAIL;
+	}
+
+	nrf_wifi_osal_spinlock_take(dispatch->lock);
+	*stats = *src;
+	nrf_wifi_osal_spinlock_rel(dispatch->lock);
+
+	return NRF_WIFI_STATUS_SUCCESS;
+}
@@ -11,9 +11,37 @@
 
 #include "common/hal_mem.h"
 #include "system/fmac_peer.h"
+#include "system/fmac_tx.h"
 #include "host_rpu_umac_if.h"
 #include "common/fmac_util.h"
 
+static unsigned int peer_hash_get(const unsigned char *mac_addr)
+{
+	/* The OUI bytes are shared by many clients, hash the NIC specific ones */
+	return (mac_addr[3] ^ mac_addr[4] ^ mac_addr[5]) % NRF_WIFI_FMAC_PEER_HASH_SIZE;
+}
+
+
+static void peer_hash_del(struct tx_config *config,
+			  int peer_id)
+{
+	int *link = NULL;
+
+	link = &config->peer_hash[peer_hash_get(config->peers[peer_id].ra_addr)];
+
+	while (*link != -1) {
+		if (*link == peer_id) {
+			*link = config->peers[peer_id].hash_next;
+			break;
+		}
+
+		link = &config->peers[*link].hash_next;
+	}
+
+	config->peers[peer_id].hash_next = -1;
+}
+
+
 int nrf_wifi_fmac_peer_get_id(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
 			      const unsigned char *mac_addr)
 {
@@ -23,20 +51,25 @@ int nrf_wifi_fmac_peer_get_id(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
 
 	sys_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
 
+	if (!sys_dev_ctx->tx_config.peers) {
+		return -1;
+	}
+
 	if (nrf_wifi_util_is_multicast_addr(mac_addr)) {
-		return MAX_PEERS;
+		return sys_dev_ctx->tx_config.max_peers;
 	}
 
-	for (i = 0; i < MAX_PEERS; i++) {
+	i = sys_dev_ctx->tx_config.peer_hash[peer_hash_get(mac_addr)];
+
+	while (i != -1) {
 		peer = &sys_dev_ctx->tx_config.peers[i];
-		if (peer->peer_id == -1) {
-			continue;
-		}
 
 		if ((nrf_wifi_util_ether_addr_equal(mac_addr,
 						    (void *)peer->ra_addr))) {
 			return peer->peer_id;
 		}
+
+		i = peer->hash_next;
 	}
 	return -1;
 }
@@ -48,26 +81,40 @@ int nrf_wifi_fmac_peer_add(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
 			   unsigned char qos_supported)
 {
 	int i;
+	int max_peers;
+	unsigned int hash = 0;
 	struct peers_info *peer;
 	struct nrf_wifi_fmac_vif_ctx *vif_ctx = NULL;
 	struct nrf_wifi_sys_fmac_dev_ctx *sys_dev_ctx = NULL;
 
 	sys_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
 
+	if (!sys_dev_ctx->tx_config.peers) {
+		return -1;
+	}
+
 	vif_ctx = sys_dev_ctx->vif_ctx[if_idx];
+	max_peers = sys_dev_ctx->tx_config.max_peers;
 
 	if (nrf_wifi_util_is_multicast_addr(mac_addr)
 	    && (vif_ctx->if_type == NRF_WIFI_IFTYPE_AP)) {
 
-		sys_dev_ctx->tx_config.peers[MAX_PEERS].if_idx = if_idx;
-		sys_dev_ctx->tx_config.peers[MAX_PEERS].peer_id = MAX_PEERS;
-		sys_dev_ctx->tx_config.peers[MAX_PEERS].is_legacy = 1;
+		sys_dev_ctx->tx_config.peers[max_peers].if_idx = if_idx;
+		sys_dev_ctx->tx_config.peers[max_peers].peer_id = max_peers;
+		sys_dev_ctx->tx_config.peers[max_peers].is_legacy = 1;
 
+		return max_peers;
+	}
 
-		return MAX_PEERS;
+	/* The pending frames bitmap of a SoftAP client lives in RPU memory at
+	 * an offset given by its peer ID, so the clients need to use the low
+	 * peer IDs within the firmware capability.
+	 */
+	if (vif_ctx->if_type == NRF_WIFI_IFTYPE_AP) {
+		max_peers = sys_dev_ctx->tx_config.max_ap_peers;
 	}
 
-	for (i = 0; i < MAX_PEERS; i++) {
+	for (i = 0; i < max_peers; i++) {
 		peer = &sys_dev_ctx->tx_config.peers[i];
 
 		if (peer->peer_id == -1) {
@@ -78,6 +125,11 @@ int nrf_wifi_fmac_peer_add(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
 			peer->peer_id = i;
 			peer->is_legacy = is_legacy;
 			peer->qos_supported = qos_supported;
+
+			hash = peer_hash_get(peer->ra_addr);
+			peer->hash_next = sys_dev_ctx->tx_config.peer_hash[hash];
+			sys_dev_ctx->tx_config.peer_hash[hash] = i;
+
 			if (vif_ctx->if_type == NRF_WIFI_IFTYPE_AP) {
 				hal_rpu_mem_write(fmac_dev_ctx->hal_dev_ctx,
 						  (RPU_MEM_UMAC_PEND_Q_BMP +
@@ -104,16 +156,18 @@ void nrf_wifi_fmac_peer_remove(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
 	struct nrf_wifi_fmac_vif_ctx *vif_ctx = NULL;
 	struct nrf_wifi_sys_fmac_dev_ctx *sys_dev_ctx = NULL;
 
-	if (peer_id == -1 || peer_id >= MAX_PEERS) {
+	sys_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
+
+	if (!sys_dev_ctx->tx_config.peers ||
+	    peer_id == -1 || peer_id >= (int)sys_dev_ctx->tx_config.max_peers) {
 		return;
 	}
 
-	sys_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
-
 	vif_ctx = sys_dev_ctx->vif_ctx[if_idx];
 	peer = &sys_dev_ctx->tx_config.peers[peer_id];
 
-	if (!peer || peer->peer_id == -1 || peer->peer_id >= MAX_PEERS ||
+	if (!peer || peer->peer_id == -1 ||
+	    peer->peer_id >= (int)sys_dev_ctx->tx_config.max_peers ||
 	    peer->if_idx != if_idx) {
 		return;
 	}
@@ -126,10 +180,22 @@ void nrf_wifi_fmac_peer_remove(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
 				  NRF_WIFI_FMAC_ETH_ADDR_LEN);
 	}
 
+	peer_hash_del(&sys_dev_ctx->tx_config, peer_id);
+
+#ifdef NRF70_AP_MODE
+	if (peer->ps_sp_active || peer->ps_state == NRF_WIFI_CLIENT_PS_MODE) {
+		nrf_wifi_osal_spinlock_take(sys_dev_ctx->tx_config.tx_lock);
+		tx_ps_sp_end(fmac_dev_ctx, peer);
+		tx_ps_state_set(fmac_dev_ctx, peer, NRF_WIFI_CLIENT_ACTIVE);
+		nrf_wifi_osal_spinlock_rel(sys_dev_ctx->tx_config.tx_lock);
+	}
+#endif /* NRF70_AP_MODE */
+
 	nrf_wifi_osal_mem_set(peer,
 			      0x0,
 			      sizeof(struct peers_info));
 	peer->peer_id = -1;
+	peer->hash_next = -1;
 }
 
 
@@ -143,21 +209,36 @@ void nrf_wifi_fmac_peers_flush(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
 
 	sys_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
 
+	if (!sys_dev_ctx->tx_config.peers) {
+		return;
+	}
+
 	vif_ctx = sys_dev_ctx->vif_ctx[if_idx];
-	sys_dev_ctx->tx_config.peers[MAX_PEERS].peer_id = -1;
+	sys_dev_ctx->tx_config.peers[sys_dev_ctx->tx_config.max_peers].peer_id = -1;
 
-	for (i = 0; i < MAX_PEERS; i++) {
+	for (i = 0; i < sys_dev_ctx->tx_config.max_peers; i++) {
 		peer = &sys_dev_ctx->tx_config.peers[i];
 
 		if (peer->peer_id == -1)
 			continue;
 
 		if (peer->if_idx == if_idx) {
+			peer_hash_del(&sys_dev_ctx->tx_config, i);
+
+#ifdef NRF70_AP_MODE
+			if (peer->ps_sp_active || peer->ps_state == NRF_WIFI_CLIENT_PS_MODE) {
+				nrf_wifi_osal_spinlock_take(sys_dev_ctx->tx_config.tx_lock);
+				tx_ps_sp_end(fmac_dev_ctx, peer);
+				tx_ps_state_set(fmac_dev_ctx, peer, NRF_WIFI_CLIENT_ACTIVE);
+				nrf_wifi_osal_spinlock_rel(sys_dev_ctx->tx_config.tx_lock);
+			}
+#endif /* NRF70_AP_MODE */
 
 			nrf_wifi_osal_mem_set(peer,
 					      0x0,
 					      sizeof(struct peers_info));
 			peer->peer_id = -1;
+			peer->hash_next = -1;
 
 			if (vif_ctx->if_type == NRF_WIFI_IFTYPE_AP) {
 				hal_rpu_mem_write(fmac_dev_ctx->hal_dev_ctx,
@@ -169,3 +250,57 @@ void nrf_wifi_fmac_peers_flush(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
 		}
 	}
 }
+
+
+void nrf_wifi_fmac_peer_mc_set(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+			       unsigned char if_idx,
+			       bool enable)
+{
+	struct peers_info *peer = NULL;
+	struct nrf_wifi_sys_fmac_dev_ctx *sys_dev_ctx = NULL;
+
+	sys_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
+
+	if (!sys_dev_ctx->tx_config.peers) {
+		return;
+	}
+
+	peer = &sys_dev_ctx->tx_config.peers[sys_dev_ctx->tx_config.max_peers];
+
+	peer->peer_id = enable ? (int)sys_dev_ctx->tx_config.max_peers : -1;
+	peer->if_idx = if_idx;
+}
+
+
+void nrf_wifi_fmac_peers_fw_capa_set(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+				     unsigned int max_ap_assoc_sta)
+{
+	struct nrf_wifi_sys_fmac_dev_ctx *sys_dev_ctx = NULL;
+	unsigned int max_ap_peers = 0;
+
+	sys_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
+
+	if (!sys_dev_ctx->tx_config.peers) {
+		return;
+	}
+
+	max_ap_peers = sys_dev_ctx->tx_config.max_peers;
+
+	if (max_ap_peers > NRF_WIFI_FMAC_FW_AP_MAX_PEERS) {
+		max_ap_peers = NRF_WIFI_FMAC_FW_AP_MAX_PEERS;
+	}
+
+	/* Older firmware does not report the capability */
+	if (max_ap_assoc_sta && (max_ap_peers > max_ap_assoc_sta)) {
+		max_ap_peers = max_ap_assoc_sta;
+	}
+
+	if (sys_dev_ctx->tx_config.max_peers > max_ap_peers + MAX_NUM_VIFS) {
+		nrf_wifi_osal_log_info("%s: %d peers configured, the firmware supports %d SoftAP clients",
+				       __func__,
+				       sys_dev_ctx->tx_config.max_peers,
+				       max_ap_peers);
+	}
+
+	sys_dev_ctx->tx_config.max_ap_peers = max_ap_peers;
+}
@@ -64,3 +64,572 @@ bool nrf_wifi_util_check_filt_setting(struct nrf_wifi_fmac_vif_ctx *vif,
 	}
 	return filter_check;
 }
+
+
+unsigned int nrf_wifi_util_ieee80211_hdr_len(const unsigned char *frm,
+					     unsigned int len)
+{
+	unsigned char type = 0;
+	unsigned char subtype = 0;
+	unsigned char flags = 0;
+	unsigned int hdr_len = 0;
+
+	if (len < 2) {
+		return 0;
+	}
+
+	/* Parsed from the raw bytes, the frame control is little endian */
+	type = (frm[0] >> 2) & 0x3;
+	subtype = (frm[0] >> 4) & 0xF;
+	flags = frm[1];
+
+	switch (type) {
+	case NRF_WIFI_MGMT_PKT_TYPE:
+		hdr_len = 24;
+		/* HT control */
+		if (flags & 0x80) {
+			hdr_len += 4;
+		}
+		break;
+	case NRF_WIFI_CTRL_PKT_TYPE:
+		/* CTS and ACK carry only the receiver address */
+		if (subtype == 0xC || subtype == 0xD) {
+			hdr_len = 10;
+		} else {
+			hdr_len = 16;
+		}
+		break;
+	case NRF_WIFI_DATA_PKT_TYPE:
+		hdr_len = 24;
+		/* Fourth address when both To DS and From DS are set */
+		if ((flags & 0x3) == 0x3) {
+			hdr_len += 6;
+		}
+		/* QoS control and, if the order bit is set, HT control */
+		if (subtype & 0x8) {
+			hdr_len += 2;
+			if (flags & 0x80) {
+				hdr_len += 4;
+			}
+		}
+		break;
+	default:
+		return 0;
+	}
+
+	if (hdr_len > len) {
+		return 0;
+	}
+
+	return hdr_len;
+}
+
+
+bool nrf_wifi_util_rx_filter_valid(const struct nrf_wifi_fmac_rx_filter *filter)
+{
+	const struct nrf_wifi_fmac_rx_filter_rule *rule = NULL;
+	unsigned int i = 0;
+
+	if (!filter->num_rules ||
+	    filter->num_rules > NRF_WIFI_FMAC_RX_FILTER_MAX_RULES) {
+		return false;
+	}
+
+	for (i = 0; i < filter->num_rules; i++) {
+		rule = &filter->rules[i];
+
+		if (rule->base >= NRF_WIFI_FMAC_RX_FILTER_BASE_MAX ||
+		    rule->op >= NRF_WIFI_FMAC_RX_FILTER_OP_MAX) {
+			return false;
+		}
+
+		if (rule->base == NRF_WIFI_FMAC_RX_FILTER_BASE_SIGNAL) {
+			continue;
+		}
+
+		/* Ordered comparisons are only defined for the signal */
+		if (rule->op != NRF_WIFI_FMAC_RX_FILTER_OP_EQ &&
+		    rule->op != NRF_WIFI_FMAC_RX_FILTER_OP_NE) {
+			return false;
+		}
+
+		if (!rule->len ||
+		    rule->len > NRF_WIFI_FMAC_RX_FILTER_MAX_MATCH_LEN) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+
+static bool nrf_wifi_util_rx_filter_rule_match(const struct nrf_wifi_fmac_rx_filter_rule *rule,
+					       const unsigned char *frm,
+					       unsigned int len,
+					       unsigned int hdr_len,
+					       signed short signal)
+{
+	unsigned int start = 0;
+	unsigned int i = 0;
+	bool equal = true;
+
+	if (rule->base == NRF_WIFI_FMAC_RX_FILTER_BASE_SIGNAL) {
+		switch (rule->op) {
+		case NRF_WIFI_FMAC_RX_FILTER_OP_EQ:
+			return signal == rule->signal;
+		case NRF_WIFI_FMAC_RX_FILTER_OP_NE:
+			return signal != rule->signal;
+		case NRF_WIFI_FMAC_RX_FILTER_OP_GE:
+			return signal >= rule->signal;
+		case NRF_WIFI_FMAC_RX_FILTER_OP_LE:
+			return signal <= rule->signal;
+		default:
+			return false;
+		}
+	}
+
+	if (rule->base == NRF_WIFI_FMAC_RX_FILTER_BASE_PAYLOAD) {
+		/* Unknown header layout, the payload cannot be located */
+		if (!hdr_len) {
+			return false;
+		}
+		start = hdr_len;
+	}
+
+	start += rule->offset;
+
+	if (start >= len || rule->len > len - start) {
+		return false;
+	}
+
+	for (i = 0; i < rule->len; i++) {
+		if ((frm[start + i] & rule->mask[i]) != rule->value[i]) {
+			equal = false;
+			break;
+		}
+	}
+
+	return (rule->op == NRF_WIFI_FMAC_RX_FILTER_OP_EQ) ? equal : !equal;
+}
+
+
+bool nrf_wifi_util_rx_filter_match(const struct nrf_wifi_fmac_rx_filter *filter,
+				   const unsigned char *frm,
+				   unsigned int len,
+				   signed short signal)
+{
+	unsigned int hdr_len = 0;
+	unsigned int i = 0;
+	bool match = false;
+
+	hdr_len = nrf_wifi_util_ieee80211_hdr_len(frm,
+						  len);
+
+	for (i = 0; i < filter->num_rules; i++) {
+		match = nrf_wifi_util_rx_filter_rule_match(&filter->rules[i],
+							   frm,
+							   len,
+							   hdr_len,
+							   signal);
+
+		/* Stop at the first rule deciding the outcome */
+		if (match == filter->match_any) {
+			break;
+		}
+	}
+
+	return match;
+}
+
+
+bool nrf_wifi_util_rx_filter_check(struct nrf_wifi_fmac_vif_ctx *vif,
+				   const unsigned char *frm,
+				   unsigned int len,
+				   signed short signal)
+{
+	bool accept = true;
+
+	nrf_wifi_osal_spinlock_take(vif->raw_rx_lock);
+
+	if (!vif->rx_filter_enabled) {
+		goto out;
+	}
+
+	accept = nrf_wifi_util_rx_filter_match(&vif->rx_filter,
+					       frm,
+					       len,
+					       signal);
+
+	if (accept) {
+		vif->rx_filter_stats.num_accepted++;
+	} else {
+		vif->rx_filter_stats.num_rejected++;
+	}
+out:
+	nrf_wifi_osal_spinlock_rel(vif->raw_rx_lock);
+
+	return accept;
+}
+
+
+/* Radiotap fields, see https://www.radiotap.org/fields/defined */
+#define RADIOTAP_RATE 2
+#define RADIOTAP_CHANNEL 3
+#define RADIOTAP_DBM_ANTSIGNAL 5
+#define RADIOTAP_MCS 19
+#define RADIOTAP_VHT 21
+#define RADIOTAP_HE 23
+
+#define RADIOTAP_CHAN_2GHZ 0x0080
+#define RADIOTAP_CHAN_5GHZ 0x0100
+#define RADIOTAP_MCS_HAVE_MCS 0x02
+#define RADIOTAP_HE_DATA1_MCS_KNOWN 0x0020
+
+static unsigned int nrf_wifi_util_radiotap_align(unsigned char *buf,
+						 unsigned int off,
+						 unsigned int align)
+{
+	while (off & (align - 1)) {
+		buf[off++] = 0;
+	}
+
+	return off;
+}
+
+
+static unsigned int nrf_wifi_util_radiotap_put_le16(unsigned char *buf,
+						    unsigned int off,
+						    unsigned short val)
+{
+	buf[off++] = val & 0xFF;
+	buf[off++] = (val >> 8) & 0xFF;
+
+	return off;
+}
+
+
+unsigned int nrf_wifi_util_radiotap_hdr_build(unsigned char *buf,
+					      struct raw_rx_pkt_header *raw_rx_hdr)
+{
+	unsigned int present = 0;
+	unsigned int off = 8;
+	unsigned short he_data1 = RADIOTAP_HE_DATA1_MCS_KNOWN;
+
+	nrf_wifi_osal_mem_set(buf,
+			      0,
+			      NRF_WIFI_RADIOTAP_MAX_LEN);
+
+	if (raw_rx_hdr->rate_flags == RPU_TPUT_MODE_LEGACY) {
+		present |= (1 << RADIOTAP_RATE);
+		/* In units of 500 Kbps, 5.5 Mbps is reported as 55 */
+		buf[off++] = (raw_rx_hdr->rate == 55) ? 11 : (raw_rx_hdr->rate * 2);
+	}
+
+	present |= (1 << RADIOTAP_CHANNEL);
+	off = nrf_wifi_util_radiotap_align(buf, off, 2);
+	off = nrf_wifi_util_radiotap_put_le16(buf, off, raw_rx_hdr->frequency);
+	off = nrf_wifi_util_radiotap_put_le16(buf,
+					      off,
+					      (raw_rx_hdr->frequency < 5000) ?
+					      RADIOTAP_CHAN_2GHZ : RADIOTAP_CHAN_5GHZ);
+
+	present |= (1 << RADIOTAP_DBM_ANTSIGNAL);
+	buf[off++] = (unsigned char)(signed char)raw_rx_hdr->signal;
+
+	switch (raw_rx_hdr->rate_flags) {
+	case RPU_TPUT_MODE_HT:
+		present |= (1 << RADIOTAP_MCS);
+		buf[off++] = RADIOTAP_MCS_HAVE_MCS;
+		buf[off++] = 0;
+		buf[off++] = raw_rx_hdr->rate;
+		break;
+	case RPU_TPUT_MODE_VHT:
+		present |= (1 << RADIOTAP_VHT);
+		off = nrf_wifi_util_radiotap_align(buf, off, 2);
+		/* known, flags and bandwidth are left as 0 */
+		off += 4;
+		/* MCS in the upper nibble, single spatial stream */
+		buf[off] = (raw_rx_hdr->rate << 4) | 1;
+		/* mcs_nss, coding, group_id and partial_aid */
+		off += 8;
+		break;
+	case RPU_TPUT_MODE_HE_SU:
+	case RPU_TPUT_MODE_HE_ER_SU:
+	case RPU_TPUT_MODE_HE_TB:
+		if (raw_rx_hdr->rate_flags == RPU_TPUT_MODE_HE_ER_SU) {
+			he_data1 |= 1;
+		} else if (raw_rx_hdr->rate_flags == RPU_TPUT_MODE_HE_TB) {
+			he_data1 |= 3;
+		}
+
+		present |= (1 << RADIOTAP_HE);
+		off = nrf_wifi_util_radiotap_align(buf, off, 2);
+		off = nrf_wifi_util_radiotap_put_le16(buf, off, he_data1);
+		off = nrf_wifi_util_radiotap_put_le16(buf, off, 0);
+		off = nrf_wifi_util_radiotap_put_le16(buf, off, (raw_rx_hdr->rate & 0xF) << 8);
+		/* data4 to data6 */
+		off += 6;
+		break;
+	default:
+		break;
+	}
+
+	/* Version and pad are 0 */
+	nrf_wifi_util_radiotap_put_le16(buf, 2, off);
+	nrf_wifi_util_radiotap_put_le16(buf, 4, present & 0xFFFF);
+	nrf_wifi_util_radiotap_put_le16(buf, 6, present >> 16);
+
+	return off;
+}
+
+
+enum nrf_wifi_status nrf_wifi_util_capture_ring_alloc(struct nrf_wifi_fmac_vif_ctx *vif,
+						      void *buf,
+						      unsigned int size,
+						      unsigned int snaplen)
+{
+	enum nrf_wifi_status status = NRF_WIFI_STATUS_FAIL;
+	struct nrf_wifi_fmac_capture_ring *ring = NULL;
+
+	/* Records are 4 byte aligned, as is the end of the ring */
+	if (((unsigned long)buf & 0x3) || (size & 0x3) ||
+	    size <= sizeof(struct nrf_wifi_fmac_capture_rec_hdr) + NRF_WIFI_RADIOTAP_MAX_LEN) {
+		nrf_wifi_osal_log_err("%s: Invalid ring memory",
+				      __func__);
+		goto out;
+	}
+
+	ring = nrf_wifi_osal_mem_zalloc(sizeof(*ring));
+
+	if (!ring) {
+		nrf_wifi_osal_log_err("%s: Unable to allocate ring",
+				      __func__);
+		goto out;
+	}
+
+	ring->lock = nrf_wifi_osal_spinlock_alloc();
+
+	if (!ring->lock) {
+		nrf_wifi_osal_log_err("%s: Unable to allocate lock",
+				      __func__);
+		nrf_wifi_osal_mem_free(ring);
+		goto out;
+	}
+
+	nrf_wifi_osal_spinlock_init(ring->lock);
+
+	ring->buf = buf;
+	ring->size = size;
+	ring->snaplen = snaplen;
+
+	nrf_wifi_osal_spinlock_take(vif->raw_rx_lock);
+
+	if (!vif->capture_ring) {
+		vif->capture_ring = ring;
+		status = NRF_WIFI_STATUS_SUCCESS;
+	}
+
+	nrf_wifi_osal_spinlock_rel(vif->raw_rx_lock);
+
+	if (status != NRF_WIFI_STATUS_SUCCESS) {
+		nrf_wifi_osal_log_err("%s: Capture ring already started",
+				      __func__);
+		nrf_wifi_osal_spinlock_free(ring->lock);
+		nrf_wifi_osal_mem_free(ring);
+	}
+out:
+	return status;
+}
+
+
+void nrf_wifi_util_capture_ring_free(struct nrf_wifi_fmac_vif_ctx *vif)
+{
+	struct nrf_wifi_fmac_capture_ring *ring = NULL;
+
+	/* The RX path writes records holding this lock, once the ring is
+	 * detached under it no record can be in progress.
+	 */
+	nrf_wifi_osal_spinlock_take(vif->raw_rx_lock);
+	ring = vif->capture_ring;
+	vif->capture_ring = NULL;
+	nrf_wifi_osal_spinlock_rel(vif->raw_rx_lock);
+
+	if (!ring) {
+		return;
+	}
+
+	nrf_wifi_osal_spinlock_free(ring->lock);
+	nrf_wifi_osal_mem_free(ring);
+}
+
+
+static bool nrf_wifi_util_capture_ring_reserve(struct nrf_wifi_fmac_capture_ring *ring,
+					       unsigned int rec_len,
+					       unsigned int *off)
+{
+	unsigned int space = 0;
+
+	/* head == tail means empty, so the head must never catch up with the tail */
+	if (ring->head < ring->tail) {
+		if (rec_len < ring->tail - ring->head) {
+			*off = ring->head;
+			return true;
+		}
+
+		return false;
+	}
+
+	space = ring->size - ring->head;
+
+	if (rec_len < space || (rec_len == space && ring->tail)) {
+		*off = ring->head;
+		return true;
+	}
+
+	if (rec_len < ring->tail) {
+		if (space >= sizeof(struct nrf_wifi_fmac_capture_rec_hdr)) {
+			/* Wrap marker */
+			nrf_wifi_osal_mem_set(ring->buf + ring->head,
+					      0,
+					      sizeof(struct nrf_wifi_fmac_capture_rec_hdr));
+		}
+
+		*off = 0;
+		return true;
+	}
+
+	return false;
+}
+
+
+bool nrf_wifi_util_capture_ring_put(struct nrf_wifi_fmac_capture_ring *ring,
+				    struct raw_rx_pkt_header *raw_rx_hdr,
+				    const unsigned char *frm,
+				    unsigned int len)
+{
+	struct nrf_wifi_fmac_capture_rec_hdr rec_hdr;
+	unsigned char rt_hdr[NRF_WIFI_RADIOTAP_MAX_LEN];
+	unsigned int rt_len = 0;
+	unsigned int cap_len = len;
+	unsigned int rec_len = 0;
+	unsigned int off = 0;
+	unsigned long ts_us = 0;
+	bool written = false;
+
+	ts_us = nrf_wifi_osal_time_get_curr_us();
+
+	rt_len = nrf_wifi_util_radiotap_hdr_build(rt_hdr,
+						  raw_rx_hdr);
+
+	if (ring->snaplen && cap_len > ring->snaplen) {
+		cap_len = ring->snaplen;
+	}
+
+	rec_hdr.ts_sec = ts_us / 1000000;
+	rec_hdr.ts_usec = ts_us % 1000000;
+	rec_hdr.incl_len = rt_len + cap_len;
+	rec_hdr.orig_len = rt_len + len;
+
+	rec_len = (sizeof(rec_hdr) + rec_hdr.incl_len + 3) & ~0x3;
+
+	nrf_wifi_osal_spinlock_take(ring->lock);
+
+	if (!nrf_wifi_util_capture_ring_reserve(ring,
+						rec_len,
+						&off)) {
+		ring->stats.num_dropped++;
+		ring->stats.bytes_dropped += len;
+		goto out;
+	}
+
+	nrf_wifi_osal_mem_cpy(ring->buf + off,
+			      &rec_hdr,
+			      sizeof(rec_hdr));
+	off += sizeof(rec_hdr);
+
+	nrf_wifi_osal_mem_cpy(ring->buf + off,
+			      rt_hdr,
+			      rt_len);
+	off += rt_len;
+
+	nrf_wifi_osal_mem_cpy(ring->buf + off,
+			      frm,
+			      cap_len);
+	off += cap_len;
+
+	/* Published to the consumer only on the next sync */
+	ring->head = (off + 3) & ~0x3;
+
+	if (ring->head == ring->size) {
+		ring->head = 0;
+	}
+
+	ring->stats.num_records++;
+	written = true;
+out:
+	nrf_wifi_osal_spinlock_rel(ring->lock);
+
+	return written;
+}
+
+
+enum nrf_wifi_status nrf_wifi_util_capture_ring_sync(struct nrf_wifi_fmac_vif_ctx *vif,
+						     unsigned int tail,
+						     unsigned int *head)
+{
+	enum nrf_wifi_status status = NRF_WIFI_STATUS_FAIL;
+	struct nrf_wifi_fmac_capture_ring *ring = NULL;
+
+	nrf_wifi_osal_spinlock_take(vif->raw_rx_lock);
+
+	ring = vif->capture_ring;
+
+	if (!ring || tail > ring->size || (tail & 0x3)) {
+		nrf_wifi_osal_log_err("%s: Invalid parameters",
+				      __func__);
+		goto out;
+	}
+
+	nrf_wifi_osal_spinlock_take(ring->lock);
+
+	ring->tail = (tail == ring->size) ? 0 : tail;
+	*head = ring->head;
+
+	nrf_wifi_osal_spinlock_rel(ring->lock);
+
+	status = NRF_WIFI_STATUS_SUCCESS;
+out:
+	nrf_wifi_osal_spinlock_rel(vif->raw_rx_lock);
+
+	return status;
+}
+
+
+enum nrf_wifi_status nrf_wifi_util_capture_ring_stats_get(struct nrf_wifi_fmac_vif_ctx *vif,
+							  struct nrf_wifi_fmac_capture_ring_stats *stats)
+{
+	enum nrf_wifi_status status = NRF_WIFI_STATUS_FAIL;
+	struct nrf_wifi_fmac_capture_ring *ring = NULL;
+
+	nrf_wifi_osal_spinlock_take(vif->raw_rx_lock);
+
+	ring = vif->capture_ring;
+
+	if (!ring) {
+		nrf_wifi_osal_log_err("%s: Capture ring not started",
+				      __func__);
+		goto out;
+	}
+
+	nrf_wifi_osal_spinlock_take(ring->lock);
+	nrf_wifi_osal_mem_cpy(stats,
+			      &ring->stats,
+			      sizeof(*stats));
+	nrf_wifi_osal_spinlock_rel(ring->lock);
+
+	status = NRF_WIFI_STATUS_SUCCESS;
+out:
+	nrf_wifi_osal_spinlock_rel(vif->raw_rx_lock);
+
+	return status;
+}
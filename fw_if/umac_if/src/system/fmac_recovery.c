@@ -0,0 +1,906 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @brief File containing RPU recovery configuration replay specific
+ * definitions for the FMAC IF Layer of the Wi-Fi driver.
+ */
+
+#include "system/fmac_api.h"
+#include "system/fmac_recovery.h"
+#include "system/fmac_peer.h"
+#include "common/fmac_util.h"
+#include "common/fmac_cmd_common.h"
+
+static struct nrf_wifi_fmac_recovery_ctx *nrf_wifi_sys_fmac_recovery_ctx(
+	struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx)
+{
+	struct nrf_wifi_sys_fmac_priv *sys_fpriv = NULL;
+
+	sys_fpriv = wifi_fmac_priv(fmac_dev_ctx->fpriv);
+
+	return &sys_fpriv->recovery;
+}
+
+
+static void nrf_wifi_sys_fmac_recovery_cmd_free(struct nrf_wifi_fmac_recovery_cmd *rec)
+{
+	if (!rec->data) {
+		return;
+	}
+
+	/* The recorded commands can hold keys */
+	nrf_wifi_osal_mem_set(rec->data,
+			      0,
+			      rec->len);
+	nrf_wifi_osal_mem_free(rec->data);
+
+	nrf_wifi_osal_mem_set(rec,
+			      0,
+			      sizeof(*rec));
+}
+
+
+static void nrf_wifi_sys_fmac_recovery_flush(struct nrf_wifi_fmac_recovery_ctx *recovery)
+{
+	unsigned int i = 0;
+
+	for (i = 0; i < NRF_WIFI_FMAC_RECOVERY_MAX_CMDS; i++) {
+		nrf_wifi_sys_fmac_recovery_cmd_free(&recovery->cmds[i]);
+	}
+
+	nrf_wifi_osal_mem_set(recovery->vif_valid,
+			      0,
+			      sizeof(recovery->vif_valid));
+	recovery->next_seq = 0;
+}
+
+
+/* Closes the current recovery phase at now_ms and starts the given one */
+static void nrf_wifi_sys_fmac_recovery_phase_next(struct nrf_wifi_fmac_recovery_ctx *recovery,
+						  enum nrf_wifi_fmac_recovery_phase phase,
+						  unsigned long now_ms)
+{
+	if (!recovery->rec_open || (phase <= recovery->phase)) {
+		return;
+	}
+
+	recovery->rec.phase_ms[recovery->phase] += now_ms - recovery->phase_start_ms;
+	recovery->phase = phase;
+	recovery->phase_start_ms = now_ms;
+}
+
+
+/* Completes the breakdown of the current recovery and adds it to the history */
+static void nrf_wifi_sys_fmac_recovery_rec_close(struct nrf_wifi_fmac_recovery_ctx *recovery,
+						 bool replayed)
+{
+	struct nrf_wifi_fmac_recovery_record *rec = NULL;
+
+	if (!recovery->rec_open) {
+		return;
+	}
+
+	rec = &recovery->rec;
+
+	nrf_wifi_sys_fmac_recovery_phase_next(recovery,
+					      NRF_WIFI_FMAC_RECOVERY_PHASE_MAX,
+					      nrf_wifi_osal_time_get_curr_ms());
+
+	rec->total_ms = nrf_wifi_osal_time_elapsed_ms(rec->detect_time_ms);
+	rec->replayed = replayed;
+
+	nrf_wifi_osal_mem_cpy(&recovery->history[recovery->history_idx],
+			      rec,
+			      sizeof(*rec));
+
+	recovery->history_idx = (recovery->history_idx + 1) % NRF_WIFI_FMAC_RECOVERY_HISTORY_LEN;
+
+	if (recovery->history_cnt < NRF_WIFI_FMAC_RECOVERY_HISTORY_LEN) {
+		recovery->history_cnt++;
+	}
+
+	recovery->rec_open = false;
+
+	nrf_wifi_osal_log_info("%s: RPU recovery (cause %d) took %d ms: detect %d ms, teardown %d ms, "
+			       "reload %d ms, init %d ms, reconfig %d ms, %d TX frames dropped",
+			       __func__,
+			       rec->cause,
+			       rec->total_ms,
+			       rec->phase_ms[NRF_WIFI_FMAC_RECOVERY_PHASE_DETECT],
+			       rec->phase_ms[NRF_WIFI_FMAC_RECOVERY_PHASE_TEARDOWN],
+			       rec->phase_ms[NRF_WIFI_FMAC_RECOVERY_PHASE_RELOAD],
+			       rec->phase_ms[NRF_WIFI_FMAC_RECOVERY_PHASE_INIT],
+			       rec->phase_ms[NRF_WIFI_FMAC_RECOVERY_PHASE_RECONFIG],
+			       rec->tx_dropped);
+}
+
+
+/* Returns whether the configuration is to be recorded. Must be called with
+ * the recovery lock held.
+ */
+static bool nrf_wifi_sys_fmac_recovery_recording(struct nrf_wifi_fmac_recovery_ctx *recovery)
+{
+	switch (recovery->state) {
+	case NRF_WIFI_FMAC_RECOVERY_TEARDOWN:
+	case NRF_WIFI_FMAC_RECOVERY_REPLAYING:
+		/* Neither the teardown nor the replay change the configuration,
+		 * and the replay reads the recorded commands without the lock.
+		 */
+		return false;
+	case NRF_WIFI_FMAC_RECOVERY_RELOADED:
+		/* The OS layer is reconfiguring the RPU itself instead of
+		 * replaying, start over from its configuration.
+		 */
+		nrf_wifi_sys_fmac_recovery_flush(recovery);
+		recovery->state = NRF_WIFI_FMAC_RECOVERY_IDLE;
+		break;
+	default:
+		break;
+	}
+
+	return true;
+}
+
+
+/* Must be called with the recovery lock held. */
+static void nrf_wifi_sys_fmac_recovery_keys_flush(struct nrf_wifi_fmac_recovery_ctx *recovery)
+{
+	unsigned int i = 0;
+
+	for (i = 0; i < NRF_WIFI_FMAC_RECOVERY_MAX_CMDS; i++) {
+		if (recovery->cmds[i].data &&
+		    ((recovery->cmds[i].cmd == NRF_WIFI_UMAC_CMD_NEW_KEY) ||
+		     (recovery->cmds[i].cmd == NRF_WIFI_UMAC_CMD_SET_KEY))) {
+			nrf_wifi_sys_fmac_recovery_cmd_free(&recovery->cmds[i]);
+		}
+	}
+}
+
+
+static struct nrf_wifi_fmac_recovery_cmd *nrf_wifi_sys_fmac_recovery_cmd_find(
+	struct nrf_wifi_fmac_recovery_ctx *recovery,
+	int type,
+	unsigned char if_idx,
+	unsigned int cmd,
+	unsigned int key)
+{
+	struct nrf_wifi_fmac_recovery_cmd *rec = NULL;
+	unsigned int i = 0;
+
+	for (i = 0; i < NRF_WIFI_FMAC_RECOVERY_MAX_CMDS; i++) {
+		rec = &recovery->cmds[i];
+
+		if (rec->data &&
+		    (rec->type == type) &&
+		    (rec->if_idx == if_idx) &&
+		    (rec->cmd == cmd) &&
+		    (rec->key == key)) {
+			return rec;
+		}
+	}
+
+	return NULL;
+}
+
+
+unsigned int nrf_wifi_sys_fmac_recovery_addr_key(const unsigned char *addr)
+{
+	if (!addr) {
+		return 0;
+	}
+
+	return (addr[3] << 16) | (addr[4] << 8) | addr[5];
+}
+
+
+enum nrf_wifi_status nrf_wifi_sys_fmac_recovery_init(struct nrf_wifi_fmac_priv *fpriv)
+{
+	enum nrf_wifi_status status = NRF_WIFI_STATUS_FAIL;
+	struct nrf_wifi_sys_fmac_priv *sys_fpriv = NULL;
+	struct nrf_wifi_fmac_recovery_ctx *recovery = NULL;
+
+	sys_fpriv = wifi_fmac_priv(fpriv);
+	recovery = &sys_fpriv->recovery;
+
+	recovery->lock = nrf_wifi_osal_spinlock_alloc();
+
+	if (!recovery->lock) {
+		nrf_wifi_osal_log_err("%s: Unable to allocate lock",
+				      __func__);
+		goto out;
+	}
+
+	nrf_wifi_osal_spinlock_init(recovery->lock);
+
+	status = NRF_WIFI_STATUS_SUCCESS;
+out:
+	return status;
+}
+
+
+void nrf_wifi_sys_fmac_recovery_deinit(struct nrf_wifi_fmac_priv *fpriv)
+{
+	struct nrf_wifi_sys_fmac_priv *sys_fpriv = NULL;
+	struct nrf_wifi_fmac_recovery_ctx *recovery = NULL;
+
+	sys_fpriv = wifi_fmac_priv(fpriv);
+	recovery = &sys_fpriv->recovery;
+
+	if (!recovery->lock) {
+		return;
+	}
+
+	nrf_wifi_sys_fmac_recovery_flush(recovery);
+
+	nrf_wifi_osal_spinlock_free(recovery->lock);
+	recovery->lock = NULL;
+}
+
+
+void nrf_wifi_sys_fmac_recovery_record(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+				       int type,
+				       unsigned char if_idx,
+				       unsigned int cmd,
+				       unsigned int key,
+				       void *data,
+				       unsigned int len)
+{
+	struct nrf_wifi_fmac_recovery_ctx *recovery = NULL;
+	struct nrf_wifi_fmac_recovery_cmd *rec = NULL;
+	void *rec_data = NULL;
+	unsigned int i = 0;
+
+	recovery = nrf_wifi_sys_fmac_recovery_ctx(fmac_dev_ctx);
+
+	/* Copy the command before taking the lock, most calls record */
+	rec_data = nrf_wifi_osal_mem_alloc(len);
+
+	if (!rec_data) {
+		nrf_wifi_osal_log_err("%s: Unable to allocate memory for command %d",
+				      __func__,
+				      cmd);
+		return;
+	}
+
+	nrf_wifi_osal_mem_cpy(rec_data,
+			      data,
+			      len);
+
+	nrf_wifi_osal_spinlock_take(recovery->lock);
+
+	if (!nrf_wifi_sys_fmac_recovery_recording(recovery)) {
+		goto out;
+	}
+
+	/* Without a replay, the recovery is over once the OS layer has
+	 * brought a VIF back up.
+	 */
+	if (recovery->rec_open &&
+	    (type == NRF_WIFI_HOST_RPU_MSG_TYPE_UMAC) &&
+	    (cmd == NRF_WIFI_UMAC_CMD_SET_IFFLAGS) &&
+	    (((struct nrf_wifi_umac_cmd_chg_vif_state *)data)->info.state == 1)) {
+		nrf_wifi_sys_fmac_recovery_rec_close(recovery,
+						     false);
+	}
+
+	/* A command replaces the previously recorded one with the same key */
+	rec = nrf_wifi_sys_fmac_recovery_cmd_find(recovery,
+						  type,
+						  if_idx,
+						  cmd,
+						  key);
+
+	if (rec) {
+		nrf_wifi_sys_fmac_recovery_cmd_free(rec);
+	} else {
+		for (i = 0; i < NRF_WIFI_FMAC_RECOVERY_MAX_CMDS; i++) {
+			if (!recovery->cmds[i].data) {
+				rec = &recovery->cmds[i];
+				break;
+			}
+		}
+	}
+
+	if (!rec) {
+		nrf_wifi_osal_log_err("%s: No space to record command %d, it will not be replayed",
+				      __func__,
+				      cmd);
+		goto out;
+	}
+
+	rec->type = type;
+	rec->if_idx = if_idx;
+	rec->cmd = cmd;
+	rec->key = key;
+	rec->seq = recovery->next_seq++;
+	rec->len = len;
+	rec->data = rec_data;
+	rec_data = NULL;
+out:
+	nrf_wifi_osal_spinlock_rel(recovery->lock);
+
+	if (rec_data) {
+		nrf_wifi_osal_mem_set(rec_data,
+				      0,
+				      len);
+		nrf_wifi_osal_mem_free(rec_data);
+	}
+}
+
+
+void nrf_wifi_sys_fmac_recovery_forget(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+				       int type,
+				       unsigned char if_idx,
+				       unsigned int cmd,
+				       unsigned int key)
+{
+	struct nrf_wifi_fmac_recovery_ctx *recovery = NULL;
+	struct nrf_wifi_fmac_recovery_cmd *rec = NULL;
+
+	recovery = nrf_wifi_sys_fmac_recovery_ctx(fmac_dev_ctx);
+
+	nrf_wifi_osal_spinlock_take(recovery->lock);
+
+	if (nrf_wifi_sys_fmac_recovery_recording(recovery)) {
+		rec = nrf_wifi_sys_fmac_recovery_cmd_find(recovery,
+							  type,
+							  if_idx,
+							  cmd,
+							  key);
+
+		if (rec) {
+			nrf_wifi_sys_fmac_recovery_cmd_free(rec);
+		}
+	}
+
+	nrf_wifi_osal_spinlock_rel(recovery->lock);
+}
+
+
+void nrf_wifi_sys_fmac_recovery_vif_add(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+					unsigned char if_idx,
+					struct nrf_wifi_umac_add_vif_info *vif_info)
+{
+	struct nrf_wifi_fmac_recovery_ctx *recovery = NULL;
+
+	if (if_idx >= MAX_NUM_VIFS) {
+		return;
+	}
+
+	recovery = nrf_wifi_sys_fmac_recovery_ctx(fmac_dev_ctx);
+
+	nrf_wifi_osal_spinlock_take(recovery->lock);
+
+	if (nrf_wifi_sys_fmac_recovery_recording(recovery)) {
+		nrf_wifi_osal_mem_cpy(&recovery->vif_info[if_idx],
+				      vif_info,
+				      sizeof(recovery->vif_info[if_idx]));
+		recovery->vif_valid[if_idx] = true;
+	}
+
+	nrf_wifi_osal_spinlock_rel(recovery->lock);
+}
+
+
+void nrf_wifi_sys_fmac_recovery_vif_del(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+					unsigned char if_idx)
+{
+	struct nrf_wifi_fmac_recovery_ctx *recovery = NULL;
+	unsigned int i = 0;
+
+	if (if_idx >= MAX_NUM_VIFS) {
+		return;
+	}
+
+	recovery = nrf_wifi_sys_fmac_recovery_ctx(fmac_dev_ctx);
+
+	nrf_wifi_osal_spinlock_take(recovery->lock);
+
+	if (nrf_wifi_sys_fmac_recovery_recording(recovery)) {
+		for (i = 0; i < NRF_WIFI_FMAC_RECOVERY_MAX_CMDS; i++) {
+			if (recovery->cmds[i].if_idx == if_idx) {
+				nrf_wifi_sys_fmac_recovery_cmd_free(&recovery->cmds[i]);
+			}
+		}
+
+		recovery->vif_valid[if_idx] = false;
+	}
+
+	nrf_wifi_osal_spinlock_rel(recovery->lock);
+}
+
+
+bool nrf_wifi_sys_fmac_recovery_keys_enabled(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx)
+{
+	/* A single flag, the lock is taken when the key is recorded */
+	return nrf_wifi_sys_fmac_recovery_ctx(fmac_dev_ctx)->replay_keys;
+}
+
+
+void nrf_wifi_sys_fmac_recovery_request(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+					struct nrf_wifi_hal_recovery_info *info)
+{
+	struct nrf_wifi_fmac_recovery_ctx *recovery = NULL;
+	unsigned long now_ms = 0;
+
+	recovery = nrf_wifi_sys_fmac_recovery_ctx(fmac_dev_ctx);
+
+	nrf_wifi_osal_spinlock_take(recovery->lock);
+
+	/* A repeated request before the replay is part of the same recovery */
+	if ((recovery->state == NRF_WIFI_FMAC_RECOVERY_TEARDOWN) ||
+	    (recovery->state == NRF_WIFI_FMAC_RECOVERY_RELOADED)) {
+		goto out;
+	}
+
+	/* The previous recovery never got a VIF back up */
+	nrf_wifi_sys_fmac_recovery_rec_close(recovery,
+					     false);
+
+	now_ms = nrf_wifi_osal_time_get_curr_ms();
+
+	recovery->state = NRF_WIFI_FMAC_RECOVERY_TEARDOWN;
+	recovery->request_time_ms = now_ms;
+	recovery->stats.num_recoveries++;
+
+	nrf_wifi_osal_mem_set(&recovery->rec,
+			      0,
+			      sizeof(recovery->rec));
+
+	if (info) {
+		recovery->rec.cause = info->cause;
+		recovery->rec.detect_time_ms = info->detect_time_ms;
+	} else {
+		recovery->rec.cause = NRF_WIFI_HAL_RECOVERY_CAUSE_OTHER;
+		recovery->rec.detect_time_ms = now_ms;
+	}
+
+	recovery->rec_open = true;
+	recovery->phase = NRF_WIFI_FMAC_RECOVERY_PHASE_DETECT;
+	recovery->phase_start_ms = recovery->rec.detect_time_ms;
+
+	nrf_wifi_sys_fmac_recovery_phase_next(recovery,
+					      NRF_WIFI_FMAC_RECOVERY_PHASE_TEARDOWN,
+					      now_ms);
+out:
+	nrf_wifi_osal_spinlock_rel(recovery->lock);
+}
+
+
+void nrf_wifi_sys_fmac_recovery_tx_dropped(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+					   unsigned int num_frames)
+{
+	struct nrf_wifi_fmac_recovery_ctx *recovery = NULL;
+
+	recovery = nrf_wifi_sys_fmac_recovery_ctx(fmac_dev_ctx);
+
+	nrf_wifi_osal_spinlock_take(recovery->lock);
+
+	if (recovery->rec_open &&
+	    (recovery->state == NRF_WIFI_FMAC_RECOVERY_TEARDOWN)) {
+		recovery->rec.tx_dropped += num_frames;
+	}
+
+	nrf_wifi_osal_spinlock_rel(recovery->lock);
+}
+
+
+void nrf_wifi_sys_fmac_recovery_dev_init(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+					 unsigned long start_time_ms)
+{
+	struct nrf_wifi_fmac_recovery_ctx *recovery = NULL;
+
+	recovery = nrf_wifi_sys_fmac_recovery_ctx(fmac_dev_ctx);
+
+	nrf_wifi_osal_spinlock_take(recovery->lock);
+
+	if (recovery->state == NRF_WIFI_FMAC_RECOVERY_TEARDOWN) {
+		recovery->state = NRF_WIFI_FMAC_RECOVERY_RELOADED;
+
+		nrf_wifi_sys_fmac_recovery_phase_next(recovery,
+						      NRF_WIFI_FMAC_RECOVERY_PHASE_INIT,
+						      start_time_ms);
+		nrf_wifi_sys_fmac_recovery_phase_next(recovery,
+						      NRF_WIFI_FMAC_RECOVERY_PHASE_RECONFIG,
+						      nrf_wifi_osal_time_get_curr_ms());
+	}
+
+	nrf_wifi_osal_spinlock_rel(recovery->lock);
+}
+
+
+void nrf_wifi_sys_fmac_recovery_dev_deinit(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx)
+{
+	struct nrf_wifi_fmac_recovery_ctx *recovery = NULL;
+
+	recovery = nrf_wifi_sys_fmac_recovery_ctx(fmac_dev_ctx);
+
+	nrf_wifi_osal_spinlock_take(recovery->lock);
+
+	if (recovery->state == NRF_WIFI_FMAC_RECOVERY_TEARDOWN) {
+		nrf_wifi_sys_fmac_recovery_phase_next(recovery,
+						      NRF_WIFI_FMAC_RECOVERY_PHASE_RELOAD,
+						      nrf_wifi_osal_time_get_curr_ms());
+	}
+
+	/* The configuration is only kept across a recovery */
+	if (recovery->state == NRF_WIFI_FMAC_RECOVERY_IDLE) {
+		nrf_wifi_sys_fmac_recovery_rec_close(recovery,
+						     false);
+		nrf_wifi_sys_fmac_recovery_flush(recovery);
+	}
+
+	nrf_wifi_osal_spinlock_rel(recovery->lock);
+}
+
+
+static enum nrf_wifi_status nrf_wifi_sys_fmac_recovery_cmd_send(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+								struct nrf_wifi_fmac_recovery_cmd *rec)
+{
+	enum nrf_wifi_status status = NRF_WIFI_STATUS_FAIL;
+	struct host_rpu_msg *umac_cmd = NULL;
+
+	if (rec->type == NRF_WIFI_HOST_RPU_MSG_TYPE_UMAC) {
+		return umac_cmd_cfg(fmac_dev_ctx,
+				    rec->data,
+				    rec->len);
+	}
+
+	umac_cmd = umac_cmd_alloc(fmac_dev_ctx,
+				  rec->type,
+				  rec->len);
+
+	if (!umac_cmd) {
+		nrf_wifi_osal_log_err("%s: umac_cmd_alloc failed",
+				      __func__);
+		goto out;
+	}
+
+	nrf_wifi_osal_mem_cpy(umac_cmd->msg,
+			      rec->data,
+			      rec->len);
+
+	status = nrf_wifi_hal_ctrl_cmd_send(fmac_dev_ctx->hal_dev_ctx,
+					    umac_cmd,
+					    (sizeof(*umac_cmd) + rec->len));
+out:
+	return status;
+}
+
+
+/* Restores the host state which the original API call updated along with
+ * sending the command.
+ */
+static void nrf_wifi_sys_fmac_recovery_cmd_done(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+						struct nrf_wifi_fmac_recovery_cmd *rec)
+{
+	struct nrf_wifi_sys_fmac_dev_ctx *sys_dev_ctx = NULL;
+	struct nrf_wifi_fmac_vif_ctx *vif_ctx = NULL;
+	struct nrf_wifi_umac_cmd_key *key_cmd = NULL;
+	struct nrf_wifi_umac_cmd_chg_vif_state *chg_vif_state_cmd = NULL;
+
+	if ((rec->type != NRF_WIFI_HOST_RPU_MSG_TYPE_UMAC) ||
+	    (rec->if_idx >= MAX_NUM_VIFS)) {
+		return;
+	}
+
+	sys_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
+	vif_ctx = sys_dev_ctx->vif_ctx[rec->if_idx];
+
+	switch (rec->cmd) {
+	case NRF_WIFI_UMAC_CMD_NEW_KEY:
+		key_cmd = rec->data;
+
+		if (key_cmd->key_info.key_type == NRF_WIFI_KEYTYPE_GROUP) {
+			vif_ctx->groupwise_cipher = key_cmd->key_info.cipher_suite;
+		}
+		break;
+	case NRF_WIFI_UMAC_CMD_SET_IFFLAGS:
+		chg_vif_state_cmd = rec->data;
+#ifdef NRF70_AP_MODE
+		if (vif_ctx->if_type == NRF_WIFI_IFTYPE_AP) {
+			nrf_wifi_fmac_peer_mc_set(fmac_dev_ctx,
+						  rec->if_idx,
+						  chg_vif_state_cmd->info.state == 1);
+		}
+#else
+		(void)chg_vif_state_cmd;
+#endif /* NRF70_AP_MODE */
+		break;
+	default:
+		break;
+	}
+}
+
+
+enum nrf_wifi_status nrf_wifi_sys_fmac_recovery_replay(void *dev_ctx,
+						       void *os_vif_ctx[])
+{
+	enum nrf_wifi_status status = NRF_WIFI_STATUS_FAIL;
+	struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx = NULL;
+	struct nrf_wifi_fmac_recovery_ctx *recovery = NULL;
+	struct nrf_wifi_fmac_recovery_cmd *rec = NULL;
+	bool vif_restored[MAX_NUM_VIFS];
+	unsigned long start_time_ms = 0;
+	unsigned int num_replayed = 0;
+	unsigned int num_fails = 0;
+	unsigned int last_seq = 0;
+	unsigned int i = 0;
+	unsigned int j = 0;
+	unsigned char vif_idx = 0;
+
+	fmac_dev_ctx = dev_ctx;
+
+	if (!fmac_dev_ctx || !os_vif_ctx) {
+		nrf_wifi_osal_log_err("%s: Invalid parameters",
+				      __func__);
+		goto out;
+	}
+
+	if (fmac_dev_ctx->op_mode != NRF_WIFI_OP_MODE_SYS) {
+		nrf_wifi_osal_log_err("%s: Invalid op mode",
+				      __func__);
+		goto out;
+	}
+
+	recovery = nrf_wifi_sys_fmac_recovery_ctx(fmac_dev_ctx);
+
+	nrf_wifi_osal_spinlock_take(recovery->lock);
+
+	if ((recovery->state != NRF_WIFI_FMAC_RECOVERY_TEARDOWN) &&
+	    (recovery->state != NRF_WIFI_FMAC_RECOVERY_RELOADED)) {
+		nrf_wifi_osal_spinlock_rel(recovery->lock);
+		nrf_wifi_osal_log_err("%s: No RPU recovery in progress",
+				      __func__);
+		goto out;
+	}
+
+	start_time_ms = nrf_wifi_osal_time_get_curr_ms();
+	recovery->stats.last_reload_ms = start_time_ms - recovery->request_time_ms;
+	recovery->state = NRF_WIFI_FMAC_RECOVERY_REPLAYING;
+
+	nrf_wifi_sys_fmac_recovery_phase_next(recovery,
+					      NRF_WIFI_FMAC_RECOVERY_PHASE_RECONFIG,
+					      start_time_ms);
+
+	/* While replaying nothing else changes the recorded configuration, so it
+	 * is read without the lock, which cannot be held across adding the VIFs
+	 * (these record themselves) and sending the commands.
+	 */
+	nrf_wifi_osal_spinlock_rel(recovery->lock);
+
+	/* The VIFs are re-added in index order so that they get their
+	 * original indices back.
+	 */
+	for (i = 0; i < MAX_NUM_VIFS; i++) {
+		vif_restored[i] = false;
+
+		if (!recovery->vif_valid[i] || !os_vif_ctx[i]) {
+			continue;
+		}
+
+		vif_idx = nrf_wifi_sys_fmac_add_vif(fmac_dev_ctx,
+						    os_vif_ctx[i],
+						    &recovery->vif_info[i]);
+
+		if (vif_idx != i) {
+			nrf_wifi_osal_log_err("%s: Unable to restore VIF %d (got %d)",
+					      __func__,
+					      i,
+					      vif_idx);
+			num_fails++;
+			continue;
+		}
+
+		vif_restored[i] = true;
+	}
+
+	/* The commands are sent back to back in the order they were originally
+	 * issued, without waiting for the RPU to acknowledge each of them.
+	 */
+	for (i = 0; i < NRF_WIFI_FMAC_RECOVERY_MAX_CMDS; i++) {
+		rec = NULL;
+
+		for (j = 0; j < NRF_WIFI_FMAC_RECOVERY_MAX_CMDS; j++) {
+			if (!recovery->cmds[j].data ||
+			    (i && (recovery->cmds[j].seq <= last_seq))) {
+				continue;
+			}
+
+			if (!rec || (recovery->cmds[j].seq < rec->seq)) {
+				rec = &recovery->cmds[j];
+			}
+		}
+
+		if (!rec) {
+			break;
+		}
+
+		last_seq = rec->seq;
+
+		if ((rec->if_idx < MAX_NUM_VIFS) && !vif_restored[rec->if_idx]) {
+			continue;
+		}
+
+		if (nrf_wifi_sys_fmac_recovery_cmd_send(fmac_dev_ctx,
+							rec) != NRF_WIFI_STATUS_SUCCESS) {
+			nrf_wifi_osal_log_err("%s: Unable to replay command %d on VIF %d",
+					      __func__,
+					      rec->cmd,
+					      rec->if_idx);
+			num_fails++;
+			continue;
+		}
+
+		nrf_wifi_sys_fmac_recovery_cmd_done(fmac_dev_ctx,
+						    rec);
+		num_replayed++;
+	}
+
+	nrf_wifi_osal_spinlock_take(recovery->lock);
+
+	recovery->stats.num_replayed_cmds += num_replayed;
+	recovery->stats.num_replays++;
+	recovery->stats.num_replay_fails += num_fails;
+	recovery->stats.last_replay_ms = nrf_wifi_osal_time_elapsed_ms(start_time_ms);
+	recovery->stats.last_total_ms = nrf_wifi_osal_time_elapsed_ms(recovery->request_time_ms);
+
+	if (recovery->stats.last_total_ms > recovery->stats.max_total_ms) {
+		recovery->stats.max_total_ms = recovery->stats.last_total_ms;
+	}
+
+	recovery->state = NRF_WIFI_FMAC_RECOVERY_IDLE;
+
+	nrf_wifi_sys_fmac_recovery_rec_close(recovery,
+					     true);
+
+	/* Key replay was disabled while replaying */
+	if (!recovery->replay_keys) {
+		nrf_wifi_sys_fmac_recovery_keys_flush(recovery);
+	}
+
+	nrf_wifi_osal_spinlock_rel(recovery->lock);
+
+	if (!num_fails) {
+		status = NRF_WIFI_STATUS_SUCCESS;
+	}
+out:
+	return status;
+}
+
+
+enum nrf_wifi_status nrf_wifi_sys_fmac_recovery_replay_keys_set(void *dev_ctx,
+								bool enable)
+{
+	enum nrf_wifi_status status = NRF_WIFI_STATUS_FAIL;
+	struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx = NULL;
+	struct nrf_wifi_fmac_recovery_ctx *recovery = NULL;
+
+	fmac_dev_ctx = dev_ctx;
+
+	if (!fmac_dev_ctx || (fmac_dev_ctx->op_mode != NRF_WIFI_OP_MODE_SYS)) {
+		nrf_wifi_osal_log_err("%s: Invalid parameters",
+				      __func__);
+		goto out;
+	}
+
+	recovery = nrf_wifi_sys_fmac_recovery_ctx(fmac_dev_ctx);
+
+	nrf_wifi_osal_spinlock_take(recovery->lock);
+
+	recovery->replay_keys = enable;
+
+	/* A replay in progress drops the keys once it is done */
+	if (!enable && (recovery->state != NRF_WIFI_FMAC_RECOVERY_REPLAYING)) {
+		nrf_wifi_sys_fmac_recovery_keys_flush(recovery);
+	}
+
+	nrf_wifi_osal_spinlock_rel(recovery->lock);
+
+	status = NRF_WIFI_STATUS_SUCCESS;
+out:
+	return status;
+}
+
+
+enum nrf_wifi_status nrf_wifi_sys_fmac_recovery_stats_get(void *dev_ctx,
+							  struct nrf_wifi_fmac_recovery_stats *stats)
+{
+	enum nrf_wifi_status status = NRF_WIFI_STATUS_FAIL;
+	struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx = NULL;
+	struct nrf_wifi_fmac_recovery_ctx *recovery = NULL;
+
+	fmac_dev_ctx = dev_ctx;
+
+	if (!fmac_dev_ctx || !stats ||
+	    (fmac_dev_ctx->op_mode != NRF_WIFI_OP_MODE_SYS)) {
+		nrf_wifi_osal_log_err("%s: Invalid parameters",
+				      __func__);
+		goto out;
+	}
+
+	recovery = nrf_wifi_sys_fmac_recovery_ctx(fmac_dev_ctx);
+
+	nrf_wifi_osal_spinlock_take(recovery->lock);
+
+	nrf_wifi_osal_mem_cpy(stats,
+			      &recovery->stats,
+			      sizeof(*stats));
+
+	nrf_wifi_osal_spinlock_rel(recovery->lock);
+
+	status = NRF_WIFI_STATUS_SUCCESS;
+out:
+	return status;
+}
+
+
+enum nrf_wifi_status nrf_wifi_sys_fmac_recovery_history_get(void *dev_ctx,
+							    struct nrf_wifi_fmac_recovery_record *history,
+							    unsigned int *num_records)
+{
+	enum nrf_wifi_status status = NRF_WIFI_STATUS_FAIL;
+	struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx = NULL;
+	struct nrf_wifi_fmac_recovery_ctx *recovery = NULL;
+	unsigned int idx = 0;
+	unsigned int i = 0;
+
+	fmac_dev_ctx = dev_ctx;
+
+	if (!fmac_dev_ctx || !history || !num_records ||
+	    (fmac_dev_ctx->op_mode != NRF_WIFI_OP_MODE_SYS)) {
+		nrf_wifi_osal_log_err("%s: Invalid parameters",
+				      __func__);
+		goto out;
+	}
+
+	recovery = nrf_wifi_sys_fmac_recovery_ctx(fmac_dev_ctx);
+
+	nrf_wifi_osal_spinlock_take(recovery->lock);
+
+	if (*num_records > recovery->history_cnt) {
+		*num_records = recovery->history_cnt;
+	}
+
+	/* Most recent recovery first */
+	idx = recovery->history_idx;
+
+	for (i = 0; i < *num_records; i++) {
+		idx = (idx + NRF_WIFI_FMAC_RECOVERY_HISTORY_LEN - 1) % NRF_WIFI_FMAC_RECOVERY_HISTORY_LEN;
+
+		nrf_wifi_osal_mem_cpy(&history[i],
+				      &recovery->history[idx],
+				      sizeof(history[i]));
+	}
+
+	nrf_wifi_osal_spinlock_rel(recovery->lock);
+
+	status = NRF_WIFI_STATUS_SUCCESS;
+out:
+	return status;
+}
+
+
+enum nrf_wifi_status nrf_wifi_sys_fmac_recovery_trigger(void *dev_ctx,
+							enum nrf_wifi_hal_recovery_cause cause)
+{
+	enum nrf_wifi_status status = NRF_WIFI_STATUS_FAIL;
+	struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx = NULL;
+
+	fmac_dev_ctx = dev_ctx;
+
+	if (!fmac_dev_ctx || (fmac_dev_ctx->op_mode != NRF_WIFI_OP_MODE_SYS)) {
+		nrf_wifi_osal_log_err("%s: Invalid parameters",
+				      __func__);
+		goto out;
+	}
+
+	status = nrf_wifi_hal_rpu_recovery_request(fmac_dev_ctx->hal_dev_ctx,
+						   cause);
+out:
+	return status;
+}
@@ -12,6 +12,9 @@
 #include "system/fmac_vif.h"
 #include "host_rpu_umac_if.h"
 #include "common/fmac_util.h"
+#if defined(NRF70_RAW_DATA_RX) || defined(NRF70_PROMISC_DATA_RX)
+#include "system/fmac_promisc.h"
+#endif /* NRF70_RAW_DATA_RX || NRF70_PROMISC_DATA_RX */
 
 
 int nrf_wifi_fmac_vif_check_if_limit(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
@@ -106,6 +109,14 @@ void nrf_wifi_fmac_vif_clear_ctx(void *dev_ctx,
 
 	vif_ctx = sys_dev_ctx->vif_ctx[if_idx];
 
+	if (vif_ctx) {
+		nrf_wifi_osal_completion_free(vif_ctx->ifflags_comp);
+#if defined(NRF70_RAW_DATA_RX) || defined(NRF70_PROMISC_DATA_RX)
+		nrf_wifi_util_capture_ring_free(vif_ctx);
+		nrf_wifi_osal_spinlock_free(vif_ctx->raw_rx_lock);
+#endif /* NRF70_RAW_DATA_RX || NRF70_PROMISC_DATA_RX */
+	}
+
 	nrf_wifi_osal_mem_free(vif_ctx);
 	sys_dev_ctx->vif_ctx[if_idx] = NULL;
 }
@@ -334,6 +334,7 @@ enum nrf_wifi_status nrf_wifi_fmac_rx_event_process(struct nrf_wifi_fmac_dev_ctx
 	struct nrf_wifi_fmac_rx_pool_map_info pool_info;
 #if defined(NRF70_RAW_DATA_RX) || defined(NRF70_PROMISC_DATA_RX)
 	struct raw_rx_pkt_header raw_rx_hdr;
+	struct nrf_wifi_fmac_capture_ring *capture_ring = NULL;
 #if defined(NRF70_PROMISC_DATA_RX)
 	unsigned short frame_control;
 #endif
@@ -349,6 +350,9 @@ enum nrf_wifi_status nrf_wifi_fmac_rx_event_process(struct nrf_wifi_fmac_dev_ctx
 	unsigned short eth_type = 0;
 	unsigned int size = 0;
 #endif /* NRF70_STA_MODE */
+#ifdef WIFI_MGMT_RAW_SCAN_RESULTS
+	struct nrf_wifi_fmac_ie_index ie_index;
+#endif /* WIFI_MGMT_RAW_SCAN_RESULTS */
 	struct nrf_wifi_sys_fmac_dev_ctx *sys_dev_ctx = NULL;
 	struct nrf_wifi_sys_fmac_priv *sys_fpriv = NULL;
 
@@ -425,7 +429,11 @@ enum nrf_wifi_status nrf_wifi_fmac_rx_event_process(struct nrf_wifi_fmac_dev_ctx
 				raw_rx_hdr.signal = config->signal;
 				raw_rx_hdr.rate_flags = config->rate_flags;
 				raw_rx_hdr.rate = config->rate;
-				if (nrf_wifi_util_check_filt_setting(vif_ctx, &frame_control)) {
+				if (nrf_wifi_util_check_filt_setting(vif_ctx, &frame_control) &&
+				    nrf_wifi_util_rx_filter_check(vif_ctx,
+								  nwb_data,
+								  pkt_len,
+								  config->signal)) {
 					sys_fpriv->callbk_fns.sniffer_callbk_fn(vif_ctx->os_vif_ctx,
 									       nwb,
 									       &raw_rx_hdr,
@@ -475,11 +483,25 @@ enum nrf_wifi_status nrf_wifi_fmac_rx_event_process(struct nrf_wifi_fmac_dev_ctx
 #endif /* NRF70_STA_MODE */
 		} else if (config->rx_pkt_type == NRF_WIFI_RX_PKT_BCN_PRB_RSP) {
 #ifdef WIFI_MGMT_RAW_SCAN_RESULTS
-			sys_fpriv->callbk_fns.rx_bcn_prb_resp_callbk_fn(
-							vif_ctx->os_vif_ctx,
-							nwb,
-							config->frequency,
-							config->signal);
+			if (sys_fpriv->callbk_fns.rx_bcn_prb_resp_ie_callbk_fn) {
+				/* Index the IEs once here rather than in every consumer */
+				nrf_wifi_util_bcn_prb_rsp_ie_index(nrf_wifi_osal_nbuf_data_get(nwb),
+								   nrf_wifi_osal_nbuf_data_size(nwb),
+								   &ie_index);
+
+				sys_fpriv->callbk_fns.rx_bcn_prb_resp_ie_callbk_fn(
+								vif_ctx->os_vif_ctx,
+								nwb,
+								config->frequency,
+								config->signal,
+								&ie_index);
+			} else {
+				sys_fpriv->callbk_fns.rx_bcn_prb_resp_callbk_fn(
+								vif_ctx->os_vif_ctx,
+								nwb,
+								config->frequency,
+								config->signal);
+			}
 #endif /* WIFI_MGMT_RAW_SCAN_RESULTS */
 			nrf_wifi_osal_nbuf_free(nwb);
 #ifdef NRF_WIFI_MGMT_BUFF_OFFLOAD
@@ -492,26 +514,46 @@ enum nrf_wifi_status nrf_wifi_fmac_rx_event_process(struct nrf_wifi_fmac_dev_ctx
 			raw_rx_hdr.signal = config->signal;
 			raw_rx_hdr.rate_flags = config->rate_flags;
 			raw_rx_hdr.rate = config->rate;
+			if (
 #if defined(NRF70_PROMISC_DATA_RX)
-			if (nrf_wifi_util_check_filt_setting(vif_ctx, &frame_control))
+			    nrf_wifi_util_check_filt_setting(vif_ctx, &frame_control) &&
 #endif
-			{
-				sys_fpriv->callbk_fns.sniffer_callbk_fn(vif_ctx->os_vif_ctx,
-								       nwb,
+			    nrf_wifi_util_rx_filter_check(vif_ctx,
+							  nwb_data,
+							  pkt_len,
+							  config->signal)) {
+				/* The ring is freed only once detached under this lock */
+				nrf_wifi_osal_spinlock_take(vif_ctx->raw_rx_lock);
+
+				capture_ring = vif_ctx->capture_ring;
+
+				if (capture_ring) {
+					nrf_wifi_util_capture_ring_put(capture_ring,
 								       &raw_rx_hdr,
-								       true);
+								       nwb_data,
+								       pkt_len);
+				}
+
+				nrf_wifi_osal_spinlock_rel(vif_ctx->raw_rx_lock);
+
+				if (capture_ring) {
+					nrf_wifi_osal_nbuf_free(nwb);
+				} else {
+					sys_fpriv->callbk_fns.sniffer_callbk_fn(vif_ctx->os_vif_ctx,
+									       nwb,
+									       &raw_rx_hdr,
+									       true);
+				}
 			}
-#if defined(NRF70_PROMISC_DATA_RX)
 			/**
-			 * In the case of Monitor mode, the sniffer callback function
-			 * will free the packet. For promiscuous mode, if the packet
-			 * is not meant to be sent up the stack, the packet needs
-			 * to be freed here.
+			 * The sniffer callback function frees the packets passed
+			 * up the stack, the packets which are filtered out need
+			 * to be freed here before the buffer is handed back to
+			 * the RPU.
 			 */
 			else {
 				nrf_wifi_osal_nbuf_free(nwb);
 			}
-#endif
 		}
 #endif /* NRF70_RAW_DATA_RX || NRF70_PROMISC_DATA_RX */
 		else {
@@ -18,6 +18,9 @@
 #include "common/hal_structs_common.h"
 #include "common/hal_mem.h"
 #include "common/fmac_util.h"
+#ifdef NRF_WIFI_RPU_RECOVERY
+#include "system/fmac_recovery.h"
+#endif /* NRF_WIFI_RPU_RECOVERY */
 
 static bool is_twt_emergency_pkt(void *nwb)
 {
@@ -217,6 +220,25 @@ int pending_frames_count(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
 }
 
 
+static struct tx_vif_sched *tx_vif_sched_get(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+					     int peer_id)
+{
+	struct nrf_wifi_sys_fmac_dev_ctx *sys_dev_ctx = NULL;
+	unsigned char vif_id = 0;
+
+	sys_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
+
+	vif_id = sys_dev_ctx->tx_config.peers[peer_id].if_idx;
+
+	/* The multicast/raw TX peer is shared by all the VIFs */
+	if (peer_id >= (int)sys_dev_ctx->tx_config.max_peers || vif_id >= MAX_NUM_VIFS) {
+		vif_id = MAX_NUM_VIFS;
+	}
+
+	return &sys_dev_ctx->tx_config.vif_sched[vif_id];
+}
+
+
 static enum nrf_wifi_status update_pend_q_bmp(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
 				       unsigned int ac,
 				       int peer_id)
@@ -239,7 +261,7 @@ static enum nrf_wifi_status update_pend_q_bmp(struct nrf_wifi_fmac_dev_ctx *fmac
 	vif_ctx = sys_dev_ctx->vif_ctx[vif_id];
 
 	if (vif_ctx->if_type == NRF_WIFI_IFTYPE_AP &&
-	    peer_id < MAX_PEERS) {
+	    peer_id < (int)sys_dev_ctx->tx_config.max_peers) {
 		const unsigned int bitmap_offset = offsetof(struct sap_client_pend_frames_bitmap,
 						      pend_frames_bitmap);
 		const unsigned char *rpu_addr = (unsigned char *)RPU_MEM_UMAC_PEND_Q_BMP +
@@ -269,6 +291,78 @@ out:
 }
 
 
+/* Called with the VIF lock of the peer held */
+static void tx_pend_peers_update(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+				 unsigned int ac,
+				 int peer_id)
+{
+	struct nrf_wifi_sys_fmac_dev_ctx *sys_dev_ctx = NULL;
+	unsigned long *bmp = NULL;
+	void *pend_pkt_q = NULL;
+
+	sys_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
+
+	if (peer_id >= (int)sys_dev_ctx->tx_config.max_peers) {
+		return;
+	}
+
+	bmp = tx_vif_sched_get(fmac_dev_ctx, peer_id)->pend_peers[ac];
+	pend_pkt_q = sys_dev_ctx->tx_config.data_pending_txq[peer_id][ac];
+
+	if (!bmp) {
+		return;
+	}
+
+	if (nrf_wifi_utils_q_len(pend_pkt_q)) {
+		bmp[peer_id / TX_PEER_BMP_BITS] |= (1UL << (peer_id % TX_PEER_BMP_BITS));
+	} else {
+		bmp[peer_id / TX_PEER_BMP_BITS] &= ~(1UL << (peer_id % TX_PEER_BMP_BITS));
+	}
+}
+
+
+/* Find the first peer with pending frames within num_bits of start (wrapping
+ * around), skipping over empty words of the bitmap.
+ */
+static int tx_pend_peer_next(unsigned long *bmp,
+			     unsigned int max_peers,
+			     unsigned int start,
+			     unsigned int num_bits)
+{
+	unsigned int idx = 0;
+	unsigned int step = 0;
+	unsigned long word = 0;
+
+	while (num_bits) {
+		idx = start % max_peers;
+		word = bmp[idx / TX_PEER_BMP_BITS] >> (idx % TX_PEER_BMP_BITS);
+
+		if (word & 1) {
+			return idx;
+		}
+
+		step = 1;
+
+		if (!word) {
+			step = TX_PEER_BMP_BITS - (idx % TX_PEER_BMP_BITS);
+
+			if (idx + step > max_peers) {
+				step = max_peers - idx;
+			}
+		}
+
+		if (step > num_bits) {
+			step = num_bits;
+		}
+
+		start = idx + step;
+		num_bits -= step;
+	}
+
+	return -1;
+}
+
+
 static void tx_desc_free(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
 		  unsigned int desc,
 		  int queue)
@@ -319,6 +413,10 @@ unsigned int tx_desc_get(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
 
 	desc = sys_fpriv->num_tx_tokens;
 
+	if (sys_dev_ctx->tx_config.quiesce) {
+		return desc;
+	}
+
 	/* First search for a reserved desc */
 
 	for (cnt = 0; cnt < sys_fpriv->num_tx_tokens_per_ac; cnt++) {
@@ -445,7 +543,8 @@ static int get_peer_from_wakeup_q(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
 	while (list_node) {
 		peer = nrf_wifi_osal_llist_node_data_get(list_node);
 
-		if (peer != NULL && peer->ps_token_count) {
+		if (peer != NULL && peer->ps_token_count &&
+		    (peer->ps_sp_ac_mask & (1 << ac))) {
 
 			pend_q = sys_dev_ctx->tx_config.data_pending_txq[peer->peer_id][ac];
 			pend_q_len = nrf_wifi_utils_q_len(pend_q);
@@ -464,225 +563,866 @@ static int get_peer_from_wakeup_q(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
 }
 
 
-static int tx_curr_peer_opp_get(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
-			 unsigned int ac)
+void tx_ps_sp_end(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+		  struct peers_info *peer)
 {
-	unsigned int i = 0;
-	unsigned int curr_peer_opp = 0;
-	unsigned int init_peer_opp = 0;
-	unsigned int pend_q_len;
-	void *pend_q = NULL;
-	int peer_id = -1;
-	unsigned char ps_state = 0;
 	struct nrf_wifi_sys_fmac_dev_ctx *sys_dev_ctx = NULL;
 
 	sys_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
 
-	if (ac == NRF_WIFI_FMAC_AC_MC) {
-		return MAX_PEERS;
+	if (peer->ps_sp_active) {
+		nrf_wifi_utils_list_del_node(sys_dev_ctx->tx_config.wakeup_client_q,
+					     peer);
 	}
 
-#ifdef NRF70_RAW_DATA_TX
-	if (sys_dev_ctx->raw_tx_config.raw_tx_flag) {
-		return MAX_PEERS;
-	}
-#endif /* NRF70_RAW_DATA_TX */
+	peer->ps_sp_active = false;
+	peer->ps_sp_ac_mask = 0;
+	peer->ps_token_count = 0;
+}
 
-	peer_id = get_peer_from_wakeup_q(fmac_dev_ctx, ac);
 
-	if (peer_id != -1) {
-		return peer_id;
+#ifdef NRF70_AP_MODE
+/* Group addressed frames are held back for the next DTIM beacon as long as a
+ * SoftAP client is in power save, unless a DTIM burst is ongoing.
+ */
+static bool tx_mc_held(struct nrf_wifi_sys_fmac_dev_ctx *sys_dev_ctx)
+{
+	return sys_dev_ctx->tx_config.num_ps_peers &&
+		sys_dev_ctx->tx_config.dtim_interval_ms &&
+		!sys_dev_ctx->tx_config.mc_burst_left;
+}
+
+
+/* Called with the TX lock held */
+static void tx_mc_kick(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx)
+{
+	struct nrf_wifi_sys_fmac_priv *sys_fpriv = NULL;
+	unsigned int desc = 0;
+
+	sys_fpriv = wifi_fmac_priv(fmac_dev_ctx->fpriv);
+
+	desc = tx_desc_get(fmac_dev_ctx, NRF_WIFI_FMAC_AC_MC);
+
+	if (desc < sys_fpriv->num_tx_tokens) {
+		tx_pending_process(fmac_dev_ctx, desc, NRF_WIFI_FMAC_AC_MC);
 	}
+}
 
-	init_peer_opp = sys_dev_ctx->tx_config.curr_peer_opp[ac];
 
-	for (i = 0; i < MAX_PEERS; i++) {
-		curr_peer_opp = (init_peer_opp + i) % MAX_PEERS;
+void tx_ps_state_set(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+		     struct peers_info *peer,
+		     unsigned char ps_state)
+{
+	struct nrf_wifi_sys_fmac_dev_ctx *sys_dev_ctx = NULL;
 
-		ps_state = sys_dev_ctx->tx_config.peers[curr_peer_opp].ps_state;
+	sys_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
 
-		if (ps_state == NRF_WIFI_CLIENT_PS_MODE) {
-			continue;
-		}
+	if (peer->ps_state == ps_state) {
+		return;
+	}
 
-		pend_q = sys_dev_ctx->tx_config.data_pending_txq[curr_peer_opp][ac];
-		pend_q_len = nrf_wifi_utils_q_len(pend_q);
+	peer->ps_state = ps_state;
 
-		if (pend_q_len) {
-			sys_dev_ctx->tx_config.curr_peer_opp[ac] =
-				(curr_peer_opp + 1) % MAX_PEERS;
-			break;
-		}
+	if (ps_state == NRF_WIFI_CLIENT_PS_MODE) {
+		sys_dev_ctx->tx_config.num_ps_peers++;
+		return;
 	}
 
-	if (i != MAX_PEERS) {
-		peer_id = curr_peer_opp;
+	if (sys_dev_ctx->tx_config.num_ps_peers) {
+		sys_dev_ctx->tx_config.num_ps_peers--;
 	}
 
-	return peer_id;
+	/* The last dozing client woke up, release the held frames */
+	if (!sys_dev_ctx->tx_config.num_ps_peers) {
+		tx_mc_kick(fmac_dev_ctx);
+	}
 }
 
-static size_t _tx_pending_process(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
-			unsigned int desc,
-			unsigned int ac)
-{
-	int len = 0;
-	void *pend_pkt_q = NULL;
-	void *txq = NULL;
-	struct tx_pkt_info *pkt_info = NULL;
-	int peer_id = -1;
-	void *nwb = NULL;
-	void *first_nwb = NULL;
 
-	int max_txq_len, avail_ampdu_len_per_token;
-	int ampdu_len = 0;
+void tx_mc_dtim_config(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+		       unsigned short beacon_interval,
+		       unsigned char dtim_period)
+{
 	struct nrf_wifi_sys_fmac_dev_ctx *sys_dev_ctx = NULL;
-	struct nrf_wifi_sys_fmac_priv *sys_fpriv = NULL;
 
 	sys_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
-	sys_fpriv = wifi_fmac_priv(fmac_dev_ctx->fpriv);
-
-	max_txq_len = sys_fpriv->data_config.max_tx_aggregation;
-	avail_ampdu_len_per_token = sys_fpriv->avail_ampdu_len_per_token;
-
-	peer_id = tx_curr_peer_opp_get(fmac_dev_ctx, ac);
 
-	/* No pending frames for any peer in that AC. */
-	if (peer_id == -1) {
-		return 0;
+	if (!sys_dev_ctx->tx_config.tx_lock) {
+		return;
 	}
 
-	pend_pkt_q = sys_dev_ctx->tx_config.data_pending_txq[peer_id][ac];
+	nrf_wifi_osal_spinlock_take(sys_dev_ctx->tx_config.tx_lock);
 
-	if (nrf_wifi_utils_q_len(pend_pkt_q) == 0) {
-		return 0;
+	/* 1 TU = 1024 us. The RPU does not report the beacon transmissions,
+	 * so, the DTIMs are counted from the start of the SoftAP.
+	 */
+	sys_dev_ctx->tx_config.dtim_interval_ms =
+		((unsigned int)beacon_interval * (dtim_period ? dtim_period : 1) * 1024) / 1000;
+	sys_dev_ctx->tx_config.next_dtim_ms = nrf_wifi_osal_time_get_curr_ms() +
+		sys_dev_ctx->tx_config.dtim_interval_ms;
+	sys_dev_ctx->tx_config.mc_burst_left = 0;
+
+	if (!sys_dev_ctx->tx_config.dtim_interval_ms) {
+		tx_mc_kick(fmac_dev_ctx);
 	}
 
-	pkt_info = &sys_dev_ctx->tx_config.pkt_info_p[desc];
-	txq = pkt_info->pkt;
+	nrf_wifi_osal_spinlock_rel(sys_dev_ctx->tx_config.tx_lock);
+}
 
-	/* Aggregate Only MPDU's with same RA, same Rate,
-	 * same Rate flags, same Tx Info flags
-	 */
-	if (nrf_wifi_utils_q_len(pend_pkt_q)) {
-		first_nwb = nrf_wifi_utils_q_peek(pend_pkt_q);
-	}
 
-	while (nrf_wifi_utils_q_len(pend_pkt_q)) {
-		nwb = nrf_wifi_utils_q_peek(pend_pkt_q);
+/* Lockless pre-check for tx_mc_dtim_check(), to keep the TX lock out of the
+ * paths which only queue a frame.
+ */
+static bool tx_mc_dtim_due(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx)
+{
+	struct nrf_wifi_sys_fmac_dev_ctx *sys_dev_ctx = NULL;
 
-		ampdu_len += TX_BUF_HEADROOM +
-			nrf_wifi_osal_nbuf_data_size((void *)nwb);
+	sys_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
 
-		if (ampdu_len >= avail_ampdu_len_per_token) {
-			break;
-		}
+	return sys_dev_ctx->tx_config.dtim_interval_ms &&
+		((long)(nrf_wifi_osal_time_get_curr_ms() -
+			sys_dev_ctx->tx_config.next_dtim_ms) >= 0);
+}
 
-		if (!can_xmit(fmac_dev_ctx, nwb) ||
-			(!tx_aggr_check(fmac_dev_ctx, first_nwb, ac, peer_id)) ||
-			(nrf_wifi_utils_q_len(txq) >= max_txq_len)) {
-			break;
-		}
 
-		nwb = nrf_wifi_utils_q_dequeue(pend_pkt_q);
+void tx_mc_dtim_check(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx)
+{
+	struct nrf_wifi_sys_fmac_dev_ctx *sys_dev_ctx = NULL;
+	unsigned long now_ms = 0;
+	unsigned long missed = 0;
+	void *pend_pkt_q = NULL;
 
-		nrf_wifi_utils_list_add_tail(txq,
-					     nwb);
+	sys_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
+
+	if (!sys_dev_ctx->tx_config.dtim_interval_ms) {
+		return;
 	}
 
-	/* If our criterion rejects all pending frames, or
-	 * pend_q is empty, send only 1
-	 */
-	if (!nrf_wifi_utils_q_len(txq)) {
-		nwb = nrf_wifi_utils_q_peek(pend_pkt_q);
+	now_ms = nrf_wifi_osal_time_get_curr_ms();
 
-		if (!nwb || !can_xmit(fmac_dev_ctx, nwb)) {
-			return 0;
-		}
+	if ((long)(now_ms - sys_dev_ctx->tx_config.next_dtim_ms) < 0) {
+		return;
+	}
 
-		nwb = nrf_wifi_utils_q_dequeue(pend_pkt_q);
+	/* Skip over the DTIMs which were not checked in time */
+	missed = (now_ms - sys_dev_ctx->tx_config.next_dtim_ms) /
+		sys_dev_ctx->tx_config.dtim_interval_ms;
+	sys_dev_ctx->tx_config.next_dtim_ms += (missed + 1) *
+		sys_dev_ctx->tx_config.dtim_interval_ms;
 
-		nrf_wifi_utils_list_add_tail(txq,
-					     nwb);
+	if (!sys_dev_ctx->tx_config.num_ps_peers ||
+	    sys_dev_ctx->tx_config.mc_burst_left) {
+		return;
 	}
 
-	len = nrf_wifi_utils_q_len(txq);
+	/* Only the frames buffered before the DTIM are part of the burst */
+	pend_pkt_q = sys_dev_ctx->tx_config.data_pending_txq[sys_dev_ctx->tx_config.max_peers]
+							    [NRF_WIFI_FMAC_AC_MC];
+	sys_dev_ctx->tx_config.mc_burst_left = nrf_wifi_utils_q_len(pend_pkt_q);
 
-	if (len > 0) {
-		sys_dev_ctx->tx_config.pkt_info_p[desc].peer_id = peer_id;
+	if (sys_dev_ctx->tx_config.mc_burst_left) {
+		tx_mc_kick(fmac_dev_ctx);
 	}
+}
+#endif /* NRF70_AP_MODE */
 
-	update_pend_q_bmp(fmac_dev_ctx, ac, peer_id);
 
-	return len;
+static void tx_pend_bytes_sub(struct peers_info *peer,
+			      void *nwb)
+{
+	unsigned int len = nrf_wifi_osal_nbuf_data_size(nwb);
+
+	/* The peer can have been removed (and reset) with frames still queued */
+	peer->pend_bytes = (peer->pend_bytes > len) ? (peer->pend_bytes - len) : 0;
 }
 
-#ifdef NRF70_RAW_DATA_TX
-enum nrf_wifi_status rawtx_cmd_prep_callbk_fn(void *callbk_data,
-					      void *nbuf)
+
+/* While a TWT flow is set up, frames queued during sleep are aggregated ahead
+ * of the next service period instead of being left in the pending queues.
+ * Raw frames are not batched.
+ */
+static bool tx_twt_prebuild_ok(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+			       int peer_id)
 {
-	enum nrf_wifi_status status = NRF_WIFI_STATUS_FAIL;
-	struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx = NULL;
-	struct nrf_wifi_fmac_buf_map_info *tx_buf_info = NULL;
-	unsigned long nwb = 0;
-	unsigned long nwb_data = 0;
-	unsigned long phy_addr = 0;
-	struct tx_cmd_prep_raw_info *info = NULL;
-	struct nrf_wifi_cmd_raw_tx *config = NULL;
-	unsigned int desc_id = 0;
-	unsigned int buf_len = 0;
-	unsigned char frame_indx = 0;
-	struct nrf_wifi_sys_fmac_priv *sys_fpriv = NULL;
 	struct nrf_wifi_sys_fmac_dev_ctx *sys_dev_ctx = NULL;
 
-	info = (struct tx_cmd_prep_raw_info *)callbk_data;
-	fmac_dev_ctx = info->fmac_dev_ctx;
-	config = info->raw_config;
-	frame_indx = info->num_tx_pkts;
-
-	sys_fpriv = wifi_fmac_priv(fmac_dev_ctx->fpriv);
 	sys_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
-	nwb = (unsigned long)nbuf;
-	desc_id = (config->raw_tx_info.desc_num *
-		   sys_fpriv->data_config.max_tx_aggregation) + frame_indx;
 
-	tx_buf_info = &sys_dev_ctx->tx_buf_info[desc_id];
-	if (tx_buf_info->mapped) {
-		nrf_wifi_osal_log_err("%s: Raw init_TX cmd called for already mapped TX buffer(%d)",
-				      __func__,
-				      desc_id);
+	return sys_dev_ctx->tx_config.twt.stats.active &&
+	       sys_dev_ctx->twt_sleep_status == NRF_WIFI_FMAC_TWT_STATE_SLEEP &&
+	       peer_id != (int)sys_dev_ctx->tx_config.max_peers;
+}
 
-		status = NRF_WIFI_STATUS_FAIL;
-		goto out;
+
+/* Frames which can be sent right away are not aggregated with the ones held
+ * for the next service period.
+ */
+static bool tx_twt_aggr_check(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+			      void *first_nwb,
+			      void *nwb,
+			      int peer_id)
+{
+	if (can_xmit(fmac_dev_ctx, first_nwb)) {
+		return can_xmit(fmac_dev_ctx, nwb);
 	}
 
-	nwb_data = (unsigned long)nrf_wifi_osal_nbuf_data_get((void *)nwb);
-	buf_len = nrf_wifi_osal_nbuf_data_size((void *)nwb);
+	return tx_twt_prebuild_ok(fmac_dev_ctx, peer_id);
+}
 
-	phy_addr = nrf_wifi_sys_hal_buf_map_tx(fmac_dev_ctx->hal_dev_ctx,
-					       nwb_data,
-					       buf_len,
-					       desc_id,
-					       config->raw_tx_info.desc_num,
-					       frame_indx);
-	if (!phy_addr) {
-		nrf_wifi_osal_log_err("%s: nrf_wifi_sys_hal_buf_map_tx failed",
-				      __func__);
-		status = NRF_WIFI_STATUS_FAIL;
-		goto out;
+
+/* Called with the TX lock held. Holds the aggregate of the descriptor until
+ * the next TWT service period unless it can be sent right away.
+ */
+static bool tx_twt_defer(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+			 unsigned int desc,
+			 unsigned int ac)
+{
+	struct tx_pkt_info *pkt_info = NULL;
+	struct nrf_wifi_sys_fmac_dev_ctx *sys_dev_ctx = NULL;
+
+	sys_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
+	pkt_info = &sys_dev_ctx->tx_config.pkt_info_p[desc];
+
+	if (can_xmit(fmac_dev_ctx, nrf_wifi_utils_list_peek(pkt_info->pkt))) {
+		return false;
 	}
 
-	tx_buf_info->nwb = nwb;
-	tx_buf_info->mapped = true;
-	config->raw_tx_info.frame_ddr_pointer = (unsigned long long)phy_addr;
-	config->raw_tx_info.pkt_length = buf_len;
-	info->num_tx_pkts++;
+	pkt_info->deferred = true;
+	pkt_info->ac = ac;
 
-	status = NRF_WIFI_STATUS_SUCCESS;
-out:
-	return status;
+	return true;
 }
-#endif /* NRF70_RAW_DATA_TX */
+
+
+/* Called with the TX lock held. Builds an aggregate for the next TWT service
+ * period once enough frames are queued to fill it. Only the descriptors
+ * reserved for the AC are used, the spare ones are left for emergency frames.
+ */
+static bool tx_twt_prebuild(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+			    unsigned int ac,
+			    int peer_id)
+{
+	unsigned int desc = 0;
+	unsigned int pend_q_len = 0;
+	struct tx_vif_sched *vif_sched = NULL;
+	struct nrf_wifi_sys_fmac_dev_ctx *sys_dev_ctx = NULL;
+	struct nrf_wifi_sys_fmac_priv *sys_fpriv = NULL;
+
+	sys_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
+	sys_fpriv = wifi_fmac_priv(fmac_dev_ctx->fpriv);
+
+	if (!tx_twt_prebuild_ok(fmac_dev_ctx, peer_id) ||
+	    sys_dev_ctx->tx_config.outstanding_descs[ac] >= sys_fpriv->num_tx_tokens_per_ac) {
+		return false;
+	}
+
+	vif_sched = tx_vif_sched_get(fmac_dev_ctx, peer_id);
+
+	nrf_wifi_osal_spinlock_take(vif_sched->lock);
+	pend_q_len = nrf_wifi_utils_q_len(sys_dev_ctx->tx_config.data_pending_txq[peer_id][ac]);
+	nrf_wifi_osal_spinlock_rel(vif_sched->lock);
+
+	if (pend_q_len < sys_fpriv->data_config.max_tx_aggregation) {
+		return false;
+	}
+
+	desc = tx_desc_get(fmac_dev_ctx, ac);
+
+	if (desc == sys_fpriv->num_tx_tokens) {
+		return false;
+	}
+
+	tx_pending_process(fmac_dev_ctx, desc, ac);
+
+	return sys_dev_ctx->tx_config.pkt_info_p[desc].deferred;
+}
+
+
+/* Called with the TX lock held, returns the bytes waiting to be sent */
+static unsigned int tx_twt_backlog_bytes(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx)
+{
+	unsigned int bytes = 0;
+	unsigned int i = 0;
+	void *txq = NULL;
+	void *list_node = NULL;
+	struct nrf_wifi_sys_fmac_dev_ctx *sys_dev_ctx = NULL;
+	struct nrf_wifi_sys_fmac_priv *sys_fpriv = NULL;
+
+	sys_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
+	sys_fpriv = wifi_fmac_priv(fmac_dev_ctx->fpriv);
+
+	for (i = 0; i < sys_dev_ctx->tx_config.max_peers; i++) {
+		bytes += sys_dev_ctx->tx_config.peers[i].pend_bytes;
+	}
+
+	for (i = 0; i < sys_fpriv->num_tx_tokens; i++) {
+		if (!sys_dev_ctx->tx_config.pkt_info_p[i].deferred) {
+			continue;
+		}
+
+		txq = sys_dev_ctx->tx_config.pkt_info_p[i].pkt;
+		list_node = nrf_wifi_osal_llist_get_node_head(txq);
+
+		while (list_node) {
+			bytes += nrf_wifi_osal_nbuf_data_size(nrf_wifi_osal_llist_node_data_get(list_node));
+			list_node = nrf_wifi_osal_llist_get_node_nxt(txq,
+								     list_node);
+		}
+	}
+
+	return bytes;
+}
+
+
+/* Called with the TX lock held. Sends the aggregates held for the service
+ * period, then keeps building new ones for as long as there are free
+ * descriptors, highest priority AC first.
+ */
+static void tx_twt_flush(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx)
+{
+	enum nrf_wifi_status status = NRF_WIFI_STATUS_FAIL;
+	unsigned int desc = 0;
+	int ac = 0;
+	struct tx_pkt_info *pkt_info = NULL;
+	struct nrf_wifi_sys_fmac_dev_ctx *sys_dev_ctx = NULL;
+	struct nrf_wifi_sys_fmac_priv *sys_fpriv = NULL;
+
+	sys_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
+	sys_fpriv = wifi_fmac_priv(fmac_dev_ctx->fpriv);
+
+	for (desc = 0; desc < sys_fpriv->num_tx_tokens; desc++) {
+		pkt_info = &sys_dev_ctx->tx_config.pkt_info_p[desc];
+
+		if (!pkt_info->deferred) {
+			continue;
+		}
+
+		pkt_info->deferred = false;
+		sys_dev_ctx->tx_config.twt.stats.num_prebuilt++;
+
+		status = tx_cmd_init(fmac_dev_ctx,
+				     pkt_info->pkt,
+				     desc,
+				     pkt_info->peer_id);
+
+		if (status != NRF_WIFI_STATUS_SUCCESS) {
+			nrf_wifi_osal_log_err("%s: tx_cmd_init failed for desc %d",
+					      __func__,
+					      desc);
+		}
+	}
+
+	for (ac = NRF_WIFI_FMAC_AC_VO; ac >= NRF_WIFI_FMAC_AC_BK; ac--) {
+		while (1) {
+			desc = tx_desc_get(fmac_dev_ctx, ac);
+
+			if (desc == sys_fpriv->num_tx_tokens) {
+				break;
+			}
+
+			tx_pending_process(fmac_dev_ctx, desc, ac);
+
+			/* The descriptor is released if nothing was pending */
+			if (!nrf_wifi_utils_q_len(sys_dev_ctx->tx_config.pkt_info_p[desc].pkt)) {
+				break;
+			}
+		}
+	}
+}
+
+
+/* Called with the TX lock held. Puts the frames held for the next service
+ * period back in front of their pending queues and releases the descriptors,
+ * they are rebuilt when descriptors are granted again.
+ */
+static void tx_twt_requeue(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx)
+{
+	unsigned int desc = 0;
+	unsigned int held = 0;
+	void *pend_pkt_q = NULL;
+	void *nwb = NULL;
+	struct tx_pkt_info *pkt_info = NULL;
+	struct tx_vif_sched *vif_sched = NULL;
+	struct peers_info *peer = NULL;
+	struct nrf_wifi_sys_fmac_dev_ctx *sys_dev_ctx = NULL;
+	struct nrf_wifi_sys_fmac_priv *sys_fpriv = NULL;
+
+	sys_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
+	sys_fpriv = wifi_fmac_priv(fmac_dev_ctx->fpriv);
+
+	for (desc = 0; desc < sys_fpriv->num_tx_tokens; desc++) {
+		pkt_info = &sys_dev_ctx->tx_config.pkt_info_p[desc];
+
+		if (!pkt_info->deferred) {
+			continue;
+		}
+
+		pkt_info->deferred = false;
+
+		peer = &sys_dev_ctx->tx_config.peers[pkt_info->peer_id];
+		pend_pkt_q = sys_dev_ctx->tx_config.data_pending_txq[pkt_info->peer_id][pkt_info->ac];
+		vif_sched = tx_vif_sched_get(fmac_dev_ctx, pkt_info->peer_id);
+
+		nrf_wifi_osal_spinlock_take(vif_sched->lock);
+
+		/* Keep the order, the held frames go before the ones queued since */
+		held = nrf_wifi_utils_q_len(pkt_info->pkt);
+
+		while (nrf_wifi_utils_q_len(pend_pkt_q)) {
+			nrf_wifi_utils_list_add_tail(pkt_info->pkt,
+						     nrf_wifi_utils_q_dequeue(pend_pkt_q));
+		}
+
+		while (nrf_wifi_utils_q_len(pkt_info->pkt)) {
+			nwb = nrf_wifi_utils_q_dequeue(pkt_info->pkt);
+
+			if (held) {
+				peer->pend_bytes += nrf_wifi_osal_nbuf_data_size(nwb);
+				held--;
+			}
+
+			nrf_wifi_utils_q_enqueue(pend_pkt_q,
+						 nwb);
+		}
+
+		tx_pend_peers_update(fmac_dev_ctx, pkt_info->ac, pkt_info->peer_id);
+		update_pend_q_bmp(fmac_dev_ctx, pkt_info->ac, pkt_info->peer_id);
+
+		nrf_wifi_osal_spinlock_rel(vif_sched->lock);
+
+		tx_desc_free(fmac_dev_ctx,
+			     desc,
+			     pkt_info->ac);
+	}
+}
+
+
+/* The throughput is only known to be reached when the service period ended
+ * with frames left, otherwise it is at least what was sent.
+ */
+static void tx_twt_rate_update(struct tx_twt_sched *twt,
+			       unsigned long sp_ms,
+			       bool saturated)
+{
+	unsigned int rate = 0;
+
+	rate = twt->sp_tx_bytes / (sp_ms ? sp_ms : 1);
+
+	if (saturated) {
+		twt->est_bytes_per_ms = twt->est_bytes_per_ms ?
+			((3 * twt->est_bytes_per_ms) + rate) / 4 : rate;
+	} else if (rate > twt->est_bytes_per_ms) {
+		twt->est_bytes_per_ms = rate;
+	}
+
+	twt->stats.est_sp_capacity_bytes =
+		((unsigned long long)twt->est_bytes_per_ms * twt->stats.wake_duration_us) / 1000;
+}
+
+
+void tx_twt_config(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+		   struct nrf_wifi_umac_config_twt_info *twt_info)
+{
+	struct tx_twt_sched *twt = NULL;
+	struct nrf_wifi_sys_fmac_dev_ctx *sys_dev_ctx = NULL;
+
+	sys_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
+
+	if (twt_info->setup_cmd != NRF_WIFI_ACCEPT_TWT) {
+		return;
+	}
+
+	nrf_wifi_osal_spinlock_take(sys_dev_ctx->tx_config.tx_lock);
+
+	twt = &sys_dev_ctx->tx_config.twt;
+
+	nrf_wifi_osal_mem_set(twt,
+			      0,
+			      sizeof(*twt));
+
+	twt->flow_id = twt_info->twt_flow_id;
+	twt->stats.active = true;
+	twt->stats.wake_interval_us =
+		(unsigned long long)twt_info->twt_target_wake_interval_mantissa <<
+		twt_info->twt_target_wake_interval_exponent;
+	twt->stats.wake_duration_us = twt_info->nominal_min_twt_wake_duration;
+
+	nrf_wifi_osal_spinlock_rel(sys_dev_ctx->tx_config.tx_lock);
+}
+
+
+void tx_twt_teardown(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+		     unsigned char flow_id)
+{
+	struct nrf_wifi_sys_fmac_dev_ctx *sys_dev_ctx = NULL;
+
+	sys_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
+
+	nrf_wifi_osal_spinlock_take(sys_dev_ctx->tx_config.tx_lock);
+
+	if (!sys_dev_ctx->tx_config.twt.stats.active ||
+	    sys_dev_ctx->tx_config.twt.flow_id != flow_id) {
+		goto out;
+	}
+
+	sys_dev_ctx->tx_config.twt.stats.active = false;
+
+	/* No more service periods, nothing holds the TX back anymore */
+	sys_dev_ctx->twt_sleep_status = NRF_WIFI_FMAC_TWT_STATE_AWAKE;
+	tx_twt_flush(fmac_dev_ctx);
+out:
+	nrf_wifi_osal_spinlock_rel(sys_dev_ctx->tx_config.tx_lock);
+}
+
+
+void tx_twt_state_set(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+		      bool awake)
+{
+	struct tx_twt_sched *twt = NULL;
+	unsigned int backlog = 0;
+	unsigned long now_ms = 0;
+	unsigned int i = 0;
+	int ac = 0;
+	bool built = false;
+	struct nrf_wifi_sys_fmac_dev_ctx *sys_dev_ctx = NULL;
+
+	sys_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
+	twt = &sys_dev_ctx->tx_config.twt;
+
+	nrf_wifi_osal_spinlock_take(sys_dev_ctx->tx_config.tx_lock);
+
+	if ((sys_dev_ctx->twt_sleep_status == NRF_WIFI_FMAC_TWT_STATE_AWAKE) == awake) {
+		goto out;
+	}
+
+	sys_dev_ctx->twt_sleep_status = awake ? NRF_WIFI_FMAC_TWT_STATE_AWAKE :
+		NRF_WIFI_FMAC_TWT_STATE_SLEEP;
+	now_ms = nrf_wifi_osal_time_get_curr_ms();
+
+	if (awake) {
+		if (twt->stats.active) {
+			backlog = tx_twt_backlog_bytes(fmac_dev_ctx);
+
+			twt->sp_start_ms = now_ms;
+			twt->sp_tx_bytes = 0;
+			twt->stats.num_sps++;
+			twt->stats.last_backlog_bytes = backlog;
+
+			if (twt->stats.est_sp_capacity_bytes &&
+			    backlog > twt->stats.est_sp_capacity_bytes) {
+				twt->stats.num_predicted_misses++;
+			}
+		}
+
+		tx_twt_flush(fmac_dev_ctx);
+		goto out;
+	}
+
+	if (!twt->stats.active) {
+		goto out;
+	}
+
+	backlog = tx_twt_backlog_bytes(fmac_dev_ctx);
+
+	if (backlog) {
+		twt->stats.num_misses++;
+	}
+
+	twt->stats.last_sp_tx_bytes = twt->sp_tx_bytes;
+	tx_twt_rate_update(twt,
+			   now_ms - twt->sp_start_ms,
+			   backlog != 0);
+
+	/* Get the frames left over ready for the next service period */
+	for (i = 0; i < sys_dev_ctx->tx_config.max_peers; i++) {
+		if (sys_dev_ctx->tx_config.peers[i].peer_id == -1) {
+			continue;
+		}
+
+		for (ac = NRF_WIFI_FMAC_AC_VO; ac >= NRF_WIFI_FMAC_AC_BK; ac--) {
+			do {
+				built = tx_twt_prebuild(fmac_dev_ctx, ac, i);
+			} while (built);
+		}
+	}
+out:
+	nrf_wifi_osal_spinlock_rel(sys_dev_ctx->tx_config.tx_lock);
+}
+
+
+static int tx_curr_peer_opp_get(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+			 unsigned int ac)
+{
+	unsigned int j = 0;
+	unsigned int max_peers = 0;
+	unsigned int num_bits = 0;
+	unsigned int pos = 0;
+	unsigned int curr_vif_opp = 0;
+	unsigned int init_vif_opp = 0;
+	unsigned int pend_q_len;
+	void *pend_q = NULL;
+	int peer_id = -1;
+	unsigned char ps_state = 0;
+	struct tx_vif_sched *vif_sched = NULL;
+	struct nrf_wifi_sys_fmac_dev_ctx *sys_dev_ctx = NULL;
+
+	sys_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
+	max_peers = sys_dev_ctx->tx_config.max_peers;
+
+	if (ac == NRF_WIFI_FMAC_AC_MC) {
+#ifdef NRF70_AP_MODE
+		if (tx_mc_held(sys_dev_ctx)) {
+			return -1;
+		}
+#endif /* NRF70_AP_MODE */
+		return max_peers;
+	}
+
+#ifdef NRF70_RAW_DATA_TX
+	if (sys_dev_ctx->raw_tx_config.raw_tx_flag) {
+		return max_peers;
+	}
+#endif /* NRF70_RAW_DATA_TX */
+
+	peer_id = get_peer_from_wakeup_q(fmac_dev_ctx, ac);
+
+	if (peer_id != -1) {
+		return peer_id;
+	}
+
+	/* Round robin across the VIFs first and then across the peers of
+	 * the chosen VIF, so that a busy VIF cannot starve the other one.
+	 * Only the peers marked in the pending bitmap of the VIF are visited.
+	 * The queue lengths are only sampled here, the caller re-checks
+	 * them under the VIF lock before dequeuing.
+	 */
+	init_vif_opp = sys_dev_ctx->tx_config.curr_vif_opp[ac];
+
+	for (j = 0; j < MAX_NUM_VIFS; j++) {
+		curr_vif_opp = (init_vif_opp + j) % MAX_NUM_VIFS;
+		vif_sched = &sys_dev_ctx->tx_config.vif_sched[curr_vif_opp];
+		pos = vif_sched->curr_peer_opp[ac];
+		num_bits = max_peers;
+
+		while (num_bits) {
+			peer_id = tx_pend_peer_next(vif_sched->pend_peers[ac],
+						    max_peers,
+						    pos,
+						    num_bits);
+
+			if (peer_id == -1) {
+				break;
+			}
+
+			num_bits -= ((peer_id + max_peers - pos) % max_peers) + 1;
+			pos = (peer_id + 1) % max_peers;
+
+			if (sys_dev_ctx->tx_config.peers[peer_id].if_idx != curr_vif_opp) {
+				continue;
+			}
+
+			ps_state = sys_dev_ctx->tx_config.peers[peer_id].ps_state;
+
+			if (ps_state == NRF_WIFI_CLIENT_PS_MODE) {
+				continue;
+			}
+
+			pend_q = sys_dev_ctx->tx_config.data_pending_txq[peer_id][ac];
+			pend_q_len = nrf_wifi_utils_q_len(pend_q);
+
+			if (pend_q_len) {
+				vif_sched->curr_peer_opp[ac] = pos;
+				sys_dev_ctx->tx_config.curr_vif_opp[ac] =
+					(curr_vif_opp + 1) % MAX_NUM_VIFS;
+				return peer_id;
+			}
+		}
+	}
+
+	return -1;
+}
+
+static size_t _tx_pending_process(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+			unsigned int desc,
+			unsigned int ac)
+{
+	int len = 0;
+	void *pend_pkt_q = NULL;
+	void *txq = NULL;
+	struct tx_pkt_info *pkt_info = NULL;
+	int peer_id = -1;
+	void *nwb = NULL;
+	void *first_nwb = NULL;
+
+	int max_txq_len, avail_ampdu_len_per_token;
+	int ampdu_len = 0;
+	struct tx_vif_sched *vif_sched = NULL;
+	struct nrf_wifi_sys_fmac_dev_ctx *sys_dev_ctx = NULL;
+	struct nrf_wifi_sys_fmac_priv *sys_fpriv = NULL;
+
+	sys_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
+	sys_fpriv = wifi_fmac_priv(fmac_dev_ctx->fpriv);
+
+	max_txq_len = sys_fpriv->data_config.max_tx_aggregation;
+	avail_ampdu_len_per_token = sys_fpriv->avail_ampdu_len_per_token;
+
+	peer_id = tx_curr_peer_opp_get(fmac_dev_ctx, ac);
+
+	/* No pending frames for any peer in that AC. */
+	if (peer_id == -1) {
+		return 0;
+	}
+
+	pend_pkt_q = sys_dev_ctx->tx_config.data_pending_txq[peer_id][ac];
+	vif_sched = tx_vif_sched_get(fmac_dev_ctx, peer_id);
+
+	nrf_wifi_osal_spinlock_take(vif_sched->lock);
+
+	if (nrf_wifi_utils_q_len(pend_pkt_q) == 0) {
+		goto unlock;
+	}
+
+	pkt_info = &sys_dev_ctx->tx_config.pkt_info_p[desc];
+	txq = pkt_info->pkt;
+
+	/* Aggregate Only MPDU's with same RA, same Rate,
+	 * same Rate flags, same Tx Info flags
+	 */
+	if (nrf_wifi_utils_q_len(pend_pkt_q)) {
+		first_nwb = nrf_wifi_utils_q_peek(pend_pkt_q);
+	}
+
+	while (nrf_wifi_utils_q_len(pend_pkt_q)) {
+		nwb = nrf_wifi_utils_q_peek(pend_pkt_q);
+
+		ampdu_len += TX_BUF_HEADROOM +
+			nrf_wifi_osal_nbuf_data_size((void *)nwb);
+
+		if (ampdu_len >= avail_ampdu_len_per_token) {
+			break;
+		}
+
+		if (!tx_twt_aggr_check(fmac_dev_ctx, first_nwb, nwb, peer_id) ||
+			(!tx_aggr_check(fmac_dev_ctx, first_nwb, ac, peer_id)) ||
+			(nrf_wifi_utils_q_len(txq) >= max_txq_len)) {
+			break;
+		}
+
+		nwb = nrf_wifi_utils_q_dequeue(pend_pkt_q);
+		tx_pend_bytes_sub(&sys_dev_ctx->tx_config.peers[peer_id], nwb);
+
+		nrf_wifi_utils_list_add_tail(txq,
+					     nwb);
+	}
+
+	/* If our criterion rejects all pending frames, or
+	 * pend_q is empty, send only 1
+	 */
+	if (!nrf_wifi_utils_q_len(txq)) {
+		nwb = nrf_wifi_utils_q_peek(pend_pkt_q);
+
+		if (!nwb || !tx_twt_aggr_check(fmac_dev_ctx, nwb, nwb, peer_id)) {
+			goto unlock;
+		}
+
+		nwb = nrf_wifi_utils_q_dequeue(pend_pkt_q);
+		tx_pend_bytes_sub(&sys_dev_ctx->tx_config.peers[peer_id], nwb);
+
+		nrf_wifi_utils_list_add_tail(txq,
+					     nwb);
+	}
+
+	len = nrf_wifi_utils_q_len(txq);
+
+	if (len > 0) {
+		sys_dev_ctx->tx_config.pkt_info_p[desc].peer_id = peer_id;
+	}
+
+#ifdef NRF70_AP_MODE
+	if (ac == NRF_WIFI_FMAC_AC_MC && sys_dev_ctx->tx_config.mc_burst_left) {
+		if ((unsigned int)len >= sys_dev_ctx->tx_config.mc_burst_left ||
+		    !nrf_wifi_utils_q_len(pend_pkt_q)) {
+			sys_dev_ctx->tx_config.mc_burst_left = 0;
+		} else {
+			sys_dev_ctx->tx_config.mc_burst_left -= len;
+		}
+	}
+#endif /* NRF70_AP_MODE */
+
+	update_pend_q_bmp(fmac_dev_ctx, ac, peer_id);
+	tx_pend_peers_update(fmac_dev_ctx, ac, peer_id);
+unlock:
+	nrf_wifi_osal_spinlock_rel(vif_sched->lock);
+
+	return len;
+}
+
+#ifdef NRF70_RAW_DATA_TX
+enum nrf_wifi_status rawtx_cmd_prep_callbk_fn(void *callbk_data,
+					      void *nbuf)
+{
+	enum nrf_wifi_status status = NRF_WIFI_STATUS_FAIL;
+	struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx = NULL;
+	struct nrf_wifi_fmac_buf_map_info *tx_buf_info = NULL;
+	unsigned long nwb = 0;
+	unsigned long nwb_data = 0;
+	unsigned long phy_addr = 0;
+	struct tx_cmd_prep_raw_info *info = NULL;
+	struct nrf_wifi_cmd_raw_tx *config = NULL;
+	unsigned int desc_id = 0;
+	unsigned int buf_len = 0;
+	unsigned char frame_indx = 0;
+	struct nrf_wifi_sys_fmac_priv *sys_fpriv = NULL;
+	struct nrf_wifi_sys_fmac_dev_ctx *sys_dev_ctx = NULL;
+
+	info = (struct tx_cmd_prep_raw_info *)callbk_data;
+	fmac_dev_ctx = info->fmac_dev_ctx;
+	config = info->raw_config;
+	frame_indx = info->num_tx_pkts;
+
+	sys_fpriv = wifi_fmac_priv(fmac_dev_ctx->fpriv);
+	sys_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
+	nwb = (unsigned long)nbuf;
+	desc_id = (config->raw_tx_info.desc_num *
+		   sys_fpriv->data_config.max_tx_aggregation) + frame_indx;
+
+	tx_buf_info = &sys_dev_ctx->tx_buf_info[desc_id];
+	if (tx_buf_info->mapped) {
+		nrf_wifi_osal_log_err("%s: Raw init_TX cmd called for already mapped TX buffer(%d)",
+				      __func__,
+				      desc_id);
+
+		status = NRF_WIFI_STATUS_FAIL;
+		goto out;
+	}
+
+	nwb_data = (unsigned long)nrf_wifi_osal_nbuf_data_get((void *)nwb);
+	buf_len = nrf_wifi_osal_nbuf_data_size((void *)nwb);
+
+	phy_addr = nrf_wifi_sys_hal_buf_map_tx(fmac_dev_ctx->hal_dev_ctx,
+					       nwb_data,
+					       buf_len,
+					       desc_id,
+					       config->raw_tx_info.desc_num,
+					       frame_indx);
+	if (!phy_addr) {
+		nrf_wifi_osal_log_err("%s: nrf_wifi_sys_hal_buf_map_tx failed",
+				      __func__);
+		status = NRF_WIFI_STATUS_FAIL;
+		goto out;
+	}
+
+	tx_buf_info->nwb = nwb;
+	tx_buf_info->mapped = true;
+	config->raw_tx_info.frame_ddr_pointer = (unsigned long long)phy_addr;
+	config->raw_tx_info.pkt_length = buf_len;
+	info->num_tx_pkts++;
+
+	status = NRF_WIFI_STATUS_SUCCESS;
+out:
+	return status;
+}
+#endif /* NRF70_RAW_DATA_TX */
 
 static enum nrf_wifi_status tx_cmd_prep_callbk_fn(void *callbk_data,
 					   void *nbuf)
@@ -774,6 +1514,9 @@ enum nrf_wifi_status rawtx_cmd_prepare(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ct
 	unsigned char vif_id;
 	struct nrf_wifi_fmac_vif_ctx *vif_ctx;
 	struct nrf_wifi_sys_fmac_dev_ctx *sys_dev_ctx = NULL;
+	struct nrf_wifi_fmac_rawtx_session_hdr *session_hdr = NULL;
+	unsigned char rate_retries = 0;
+	bool session = false;
 
 	sys_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
 	vif_id = sys_dev_ctx->tx_config.peers[peer_id].if_idx;
@@ -788,11 +1531,22 @@ enum nrf_wifi_status rawtx_cmd_prepare(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ct
 	}
 
 	nwb = nrf_wifi_utils_list_peek(txq);
+	session_hdr = nrf_wifi_osal_nbuf_data_get(nwb);
+
+	session = (session_hdr->raw_hdr.magic_num ==
+		   NRF_WIFI_MAGIC_NUM_RAWTX_SESSION);
+
+	if (session) {
+		rate_retries = session_hdr->rate_retries;
+	}
+
 	/**
 	 * Pull the Raw packet header and only send the buffer to the UMAC
-	 * with the parameters configured to the UMAC
+	 * with the parameters configured to the UMAC. Frames of a raw TX
+	 * session carry the header of their session instead.
 	 */
 	nrf_wifi_osal_nbuf_data_pull(nwb,
+				     session ? sizeof(*session_hdr) :
 				     sizeof(struct raw_tx_pkt_header));
 
 	sys_dev_ctx->tx_config.send_pkt_coalesce_count_p[desc] = txq_len;
@@ -804,7 +1558,9 @@ enum nrf_wifi_status rawtx_cmd_prepare(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ct
 	config->if_index = vif_id;
 	config->raw_tx_info.desc_num = desc;
 	config->raw_tx_info.queue_num = sys_dev_ctx->raw_tx_config.queue;
-	if (len != sys_dev_ctx->raw_tx_config.packet_length) {
+	if (session) {
+		config->raw_tx_info.rate_retries = rate_retries;
+	} else if (len != sys_dev_ctx->raw_tx_config.packet_length) {
 		goto err;
 	}
 	config->raw_tx_info.pkt_length = len;
@@ -849,6 +1605,7 @@ static enum nrf_wifi_status tx_cmd_prepare(struct nrf_wifi_fmac_dev_ctx *fmac_de
 	struct nrf_wifi_sys_fmac_priv *sys_fpriv = NULL;
 	unsigned char vif_id;
 	struct nrf_wifi_fmac_vif_ctx *vif_ctx = NULL;
+	struct peers_info *peer = NULL;
 
 	sys_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
 	sys_fpriv = wifi_fmac_priv(fmac_dev_ctx->fpriv);
@@ -930,14 +1687,27 @@ static enum nrf_wifi_status tx_cmd_prepare(struct nrf_wifi_fmac_dev_ctx *fmac_de
 		config->mac_hdr_info.more_data = 1;
 	}
 
-	if (sys_dev_ctx->tx_config.peers[peer_id].ps_token_count == 0) {
-		nrf_wifi_utils_list_del_node(sys_dev_ctx->tx_config.wakeup_client_q,
-					     &sys_dev_ctx->tx_config.peers[peer_id]);
+#ifdef NRF70_AP_MODE
+	/* Group addressed frames of a DTIM burst announce the rest of the burst */
+	if (peer_id == (int)sys_dev_ctx->tx_config.max_peers &&
+	    sys_dev_ctx->tx_config.mc_burst_left) {
+		config->mac_hdr_info.more_data = 1;
+	}
+#endif /* NRF70_AP_MODE */
 
-		config->mac_hdr_info.eosp = 1;
+	peer = &sys_dev_ctx->tx_config.peers[peer_id];
 
-	} else {
+	/* The service period ends when the frames requested by the client
+	 * have been sent or the ACs of the service period have run dry.
+	 */
+	if (peer->ps_sp_active &&
+	    peer->ps_token_count &&
+	    (peer->pend_q_bmp & peer->ps_sp_ac_mask)) {
 		config->mac_hdr_info.eosp = 0;
+	} else {
+		tx_ps_sp_end(fmac_dev_ctx, peer);
+
+		config->mac_hdr_info.eosp = 1;
 	}
 
 	return NRF_WIFI_STATUS_SUCCESS;
@@ -1049,6 +1819,11 @@ enum nrf_wifi_status tx_pending_process(struct nrf_wifi_fmac_dev_ctx *fmac_dev_c
 	}
 
 	if (_tx_pending_process(fmac_dev_ctx, desc, ac)) {
+		if (tx_twt_defer(fmac_dev_ctx, desc, ac)) {
+			status = NRF_WIFI_STATUS_SUCCESS;
+			goto out;
+		}
+
 #ifdef NRF70_RAW_DATA_TX
 		if (!sys_dev_ctx->raw_tx_config.raw_tx_flag) {
 #endif
@@ -1077,6 +1852,55 @@ out:
 }
 
 
+/* Called with the VIF lock of the peer held. Makes room for len bytes in the
+ * power save buffer of the peer by dropping the oldest frames, starting with
+ * the lowest priority AC and never going above the AC of the new frame.
+ */
+static bool tx_ps_buf_admit(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+			    unsigned int ac,
+			    int peer_id,
+			    unsigned int len)
+{
+	struct nrf_wifi_sys_fmac_dev_ctx *sys_dev_ctx = NULL;
+	struct peers_info *peer = NULL;
+	void *queue = NULL;
+	void *nwb = NULL;
+	unsigned int evict_ac = 0;
+	bool evicted = false;
+
+	sys_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
+	peer = &sys_dev_ctx->tx_config.peers[peer_id];
+
+	if (len > TX_PS_BUF_MAX_BYTES) {
+		return false;
+	}
+
+	for (evict_ac = NRF_WIFI_FMAC_AC_BK;
+	     evict_ac <= ac && (peer->pend_bytes + len) > TX_PS_BUF_MAX_BYTES;
+	     evict_ac++) {
+		queue = sys_dev_ctx->tx_config.data_pending_txq[peer_id][evict_ac];
+		evicted = false;
+
+		while (nrf_wifi_utils_q_len(queue) &&
+		       (peer->pend_bytes + len) > TX_PS_BUF_MAX_BYTES) {
+			nwb = nrf_wifi_utils_q_dequeue(queue);
+			tx_pend_bytes_sub(peer, nwb);
+			nrf_wifi_osal_nbuf_free(nwb);
+
+			sys_dev_ctx->host_stats.total_tx_drop_pkts++;
+			evicted = true;
+		}
+
+		if (evicted) {
+			tx_pend_peers_update(fmac_dev_ctx, evict_ac, peer_id);
+			update_pend_q_bmp(fmac_dev_ctx, evict_ac, peer_id);
+		}
+	}
+
+	return (peer->pend_bytes + len) <= TX_PS_BUF_MAX_BYTES;
+}
+
+
 static enum nrf_wifi_status tx_enqueue(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
 				void *nwb,
 				unsigned int ac,
@@ -1085,6 +1909,8 @@ static enum nrf_wifi_status tx_enqueue(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ct
 	enum nrf_wifi_status status = NRF_WIFI_STATUS_FAIL;
 	void *queue = NULL;
 	int qlen = 0;
+	unsigned int len = 0;
+	struct peers_info *peer = NULL;
 	struct nrf_wifi_sys_fmac_dev_ctx *sys_dev_ctx = NULL;
 
 	sys_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
@@ -1103,6 +1929,23 @@ static enum nrf_wifi_status tx_enqueue(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ct
 		goto out;
 	}
 
+	peer = &sys_dev_ctx->tx_config.peers[peer_id];
+	len = nrf_wifi_osal_nbuf_data_size(nwb);
+
+	if (peer->ps_state == NRF_WIFI_CLIENT_PS_MODE &&
+	    !tx_ps_buf_admit(fmac_dev_ctx, ac, peer_id, len)) {
+		goto out;
+	}
+
+#ifdef NRF70_AP_MODE
+	/* Held group addressed frames share the power save buffer bound */
+	if (peer_id == sys_dev_ctx->tx_config.max_peers &&
+	    tx_mc_held(sys_dev_ctx) &&
+	    !tx_ps_buf_admit(fmac_dev_ctx, ac, peer_id, len)) {
+		goto out;
+	}
+#endif /* NRF70_AP_MODE */
+
 	if (is_twt_emergency_pkt(nwb)) {
 		nrf_wifi_utils_q_enqueue_head(queue,
 					      nwb);
@@ -1111,6 +1954,10 @@ static enum nrf_wifi_status tx_enqueue(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ct
 					 nwb);
 	}
 
+	peer->pend_bytes += len;
+
+	tx_pend_peers_update(fmac_dev_ctx, ac, peer_id);
+
 	status = update_pend_q_bmp(fmac_dev_ctx, ac, peer_id);
 
 out:
@@ -1124,7 +1971,6 @@ static enum nrf_wifi_fmac_tx_status tx_process(struct nrf_wifi_fmac_dev_ctx *fma
 				unsigned int ac,
 				unsigned int peer_id)
 {
-	enum nrf_wifi_fmac_tx_status status;
 	struct nrf_wifi_fmac_priv *fpriv = NULL;
 	struct nrf_wifi_sys_fmac_dev_ctx *sys_dev_ctx = NULL;
 	struct nrf_wifi_sys_fmac_priv *sys_fpriv = NULL;
@@ -1133,19 +1979,13 @@ static enum nrf_wifi_fmac_tx_status tx_process(struct nrf_wifi_fmac_dev_ctx *fma
 	unsigned char ps_state = 0;
 	bool aggr_status = false;
 	int max_cmds = 0;
+	int pend_q_len = 0;
+	struct tx_vif_sched *vif_sched = NULL;
 
 	fpriv = fmac_dev_ctx->fpriv;
 	sys_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
 	sys_fpriv = wifi_fmac_priv(fpriv);
-
-	status = (enum nrf_wifi_fmac_tx_status)tx_enqueue(fmac_dev_ctx,
-						  nbuf,
-						  ac,
-						  peer_id);
-
-	if (status != NRF_WIFI_FMAC_TX_STATUS_SUCCESS) {
-		goto err;
-	}
+	vif_sched = tx_vif_sched_get(fmac_dev_ctx, peer_id);
 
 	ps_state = sys_dev_ctx->tx_config.peers[peer_id].ps_state;
 
@@ -1159,11 +1999,16 @@ static enum nrf_wifi_fmac_tx_status tx_process(struct nrf_wifi_fmac_dev_ctx *fma
 	 * access category >= NUM_TX_DESCS_PER_AC means there are already
 	 * pending packets for that access category. So now see if frames
 	 * can be aggregated depending upon access category depending
-	 * upon SA, RA & AC
+	 * upon SA, RA & AC. This runs without the TX lock, a stale count only
+	 * delays the frame until the next TX done of the AC picks it up.
 	 */
 
 	if ((sys_dev_ctx->tx_config.outstanding_descs[ac]) >= sys_fpriv->num_tx_tokens_per_ac) {
-		if (nrf_wifi_utils_q_len(pend_pkt_q)) {
+		nrf_wifi_osal_spinlock_take(vif_sched->lock);
+
+		pend_q_len = nrf_wifi_utils_q_len(pend_pkt_q);
+
+		if (pend_q_len) {
 			first_nwb = nrf_wifi_utils_q_peek(pend_pkt_q);
 
 			aggr_status = true;
@@ -1179,10 +2024,12 @@ static enum nrf_wifi_fmac_tx_status tx_process(struct nrf_wifi_fmac_dev_ctx *fma
 			}
 		}
 
+		nrf_wifi_osal_spinlock_rel(vif_sched->lock);
+
 		if (aggr_status) {
 			max_cmds = sys_fpriv->data_config.max_tx_aggregation;
 
-			if (nrf_wifi_utils_q_len(pend_pkt_q) < max_cmds) {
+			if (pend_q_len < max_cmds) {
 				goto out;
 			}
 		}
@@ -1190,8 +2037,6 @@ static enum nrf_wifi_fmac_tx_status tx_process(struct nrf_wifi_fmac_dev_ctx *fma
 	return NRF_WIFI_FMAC_TX_STATUS_SUCCESS;
 out:
 	return NRF_WIFI_FMAC_TX_STATUS_QUEUED;
-err:
-	return NRF_WIFI_FMAC_TX_STATUS_FAIL;
 }
 
 
@@ -1237,6 +2082,11 @@ unsigned int tx_buff_req_free(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
 	}
 
 	for (cnt = start_ac; cnt >= end_ac; cnt--) {
+		/* Let the descriptors drain while the TX parameters are changed */
+		if (sys_dev_ctx->tx_config.quiesce) {
+			break;
+		}
+
 		pkts_pend = _tx_pending_process(fmac_dev_ctx, desc, cnt);
 
 		if (pkts_pend) {
@@ -1283,6 +2133,7 @@ static enum nrf_wifi_status tx_done_process(struct nrf_wifi_fmac_dev_ctx *fmac_d
 	struct nrf_wifi_fmac_buf_map_info *tx_buf_info = NULL;
 	struct tx_pkt_info *pkt_info = NULL;
 	unsigned int pkt = 0;
+	unsigned int bytes = 0;
 	unsigned int pkts_pending = 0;
 	unsigned char queue = 0;
 	void *txq = NULL;
@@ -1345,12 +2196,17 @@ static enum nrf_wifi_status tx_done_process(struct nrf_wifi_fmac_dev_ctx *fmac_d
 			continue;
 		}
 
+		bytes += nrf_wifi_osal_nbuf_data_size(nwb);
 		nrf_wifi_osal_nbuf_free(nwb);
 		pkt++;
 	}
 
 	sys_dev_ctx->host_stats.total_tx_done_pkts += pkt;
 
+	if (sys_dev_ctx->twt_sleep_status == NRF_WIFI_FMAC_TWT_STATE_AWAKE) {
+		sys_dev_ctx->tx_config.twt.sp_tx_bytes += bytes;
+	}
+
 	pkts_pending = tx_buff_req_free(fmac_dev_ctx, tx_desc_num, &queue);
 
 	if (pkts_pending) {
@@ -1369,10 +2225,10 @@ static enum nrf_wifi_status tx_done_process(struct nrf_wifi_fmac_dev_ctx *fmac_d
 		nwb = nrf_wifi_utils_list_peek(txq);
 		data = nrf_wifi_osal_nbuf_data_get(nwb);
 
-		if (*(unsigned int *)data != NRF_WIFI_MAGIC_NUM_RAWTX) {
+		if (*(unsigned int *)data != NRF_WIFI_MAGIC_NUM_RAWTX &&
+		    *(unsigned int *)data != NRF_WIFI_MAGIC_NUM_RAWTX_SESSION) {
 #endif /* NRF70_RAW_DATA_TX */
-			if (sys_dev_ctx->twt_sleep_status ==
-			    NRF_WIFI_FMAC_TWT_STATE_AWAKE) {
+			if (!tx_twt_defer(fmac_dev_ctx, desc, queue)) {
 				pkt_info = &sys_dev_ctx->tx_config.pkt_info_p[desc];
 				txq = pkt_info->pkt;
 				status = tx_cmd_init(fmac_dev_ctx,
@@ -1384,6 +2240,7 @@ static enum nrf_wifi_status tx_done_process(struct nrf_wifi_fmac_dev_ctx *fmac_d
 			}
 #ifdef NRF70_RAW_DATA_TX
 		} else {
+			/* Session frames start with the settings of their session */
 			nrf_wifi_osal_mem_cpy(&sys_dev_ctx->raw_tx_config,
 					      data,
 					      sizeof(struct raw_tx_pkt_header));
@@ -1393,7 +2250,7 @@ static enum nrf_wifi_status tx_done_process(struct nrf_wifi_fmac_dev_ctx *fmac_d
 			 * if so, we need to check for TWT_SLEEP.
 			 * for RAW TX, we use MAX-PEERS queue presently
 			 */
-			if_idx = sys_dev_ctx->tx_config.peers[MAX_PEERS].if_idx;
+			if_idx = sys_dev_ctx->tx_config.peers[sys_dev_ctx->tx_config.max_peers].if_idx;
 			vif_ctx = sys_dev_ctx->vif_ctx[if_idx];
 			if ((vif_ctx->if_type == NRF_WIFI_STA_TX_INJECTOR) &&
 			    (sys_dev_ctx->twt_sleep_status == NRF_WIFI_FMAC_TWT_STATE_SLEEP)) {
@@ -1521,6 +2378,10 @@ enum nrf_wifi_status (nrf_wifi_fmac_tx_done_event_process)(
 	status = tx_done_process(fmac_dev_ctx,
 				 config->tx_desc_num);
 
+#ifdef NRF70_AP_MODE
+	tx_mc_dtim_check(fmac_dev_ctx);
+#endif /* NRF70_AP_MODE */
+
 	nrf_wifi_osal_spinlock_rel(sys_dev_ctx->tx_config.tx_lock);
 
 out:
@@ -1544,18 +2405,39 @@ static enum nrf_wifi_fmac_tx_status nrf_wifi_fmac_tx(struct nrf_wifi_fmac_dev_ct
 	struct nrf_wifi_fmac_priv *fpriv = NULL;
 	struct nrf_wifi_sys_fmac_dev_ctx *sys_dev_ctx = NULL;
 	struct nrf_wifi_sys_fmac_priv *sys_fpriv = NULL;
+	struct tx_vif_sched *vif_sched = NULL;
 
 	fpriv = fmac_dev_ctx->fpriv;
 	sys_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
 	sys_fpriv = wifi_fmac_priv(fpriv);
 
-	nrf_wifi_osal_spinlock_take(sys_dev_ctx->tx_config.tx_lock);
+	if (sys_fpriv->num_tx_tokens == 0) {
+		goto err;
+	}
+
+	/* Queueing the frame only needs the lock of the VIF the peer belongs
+	 * to, the TX lock is only needed to arbitrate the TX descriptors.
+	 */
+	vif_sched = tx_vif_sched_get(fmac_dev_ctx, peer_id);
 
+	nrf_wifi_osal_spinlock_take(vif_sched->lock);
 
-	if (sys_fpriv->num_tx_tokens == 0) {
-		goto out;
+	status = (enum nrf_wifi_fmac_tx_status)tx_enqueue(fmac_dev_ctx,
+							  nbuf,
+							  ac,
+							  peer_id);
+
+	nrf_wifi_osal_spinlock_rel(vif_sched->lock);
+
+	if (status != NRF_WIFI_FMAC_TX_STATUS_SUCCESS) {
+		status = NRF_WIFI_FMAC_TX_STATUS_FAIL;
+		goto err;
 	}
 
+	/* Whether the frame has to wait behind the earlier frames of its AC is
+	 * decided from the per-VIF state, the TX lock is only taken when a
+	 * descriptor is to be claimed.
+	 */
 	status = tx_process(fmac_dev_ctx,
 			    if_id,
 			    nbuf,
@@ -1563,12 +2445,26 @@ static enum nrf_wifi_fmac_tx_status nrf_wifi_fmac_tx(struct nrf_wifi_fmac_dev_ct
 			    peer_id);
 
 	if (status != NRF_WIFI_FMAC_TX_STATUS_SUCCESS) {
-		goto out;
+#ifdef NRF70_AP_MODE
+		if (tx_mc_dtim_due(fmac_dev_ctx)) {
+			nrf_wifi_osal_spinlock_take(sys_dev_ctx->tx_config.tx_lock);
+			tx_mc_dtim_check(fmac_dev_ctx);
+			nrf_wifi_osal_spinlock_rel(sys_dev_ctx->tx_config.tx_lock);
+		}
+#endif /* NRF70_AP_MODE */
+		goto err;
 	}
 
+	nrf_wifi_osal_spinlock_take(sys_dev_ctx->tx_config.tx_lock);
+
+#ifdef NRF70_AP_MODE
+	tx_mc_dtim_check(fmac_dev_ctx);
+#endif /* NRF70_AP_MODE */
+
 	status = NRF_WIFI_FMAC_TX_STATUS_QUEUED;
 
 	if (!can_xmit(fmac_dev_ctx, nbuf)) {
+		tx_twt_prebuild(fmac_dev_ctx, ac, peer_id);
 		goto out;
 	}
 
@@ -1581,9 +2477,14 @@ static enum nrf_wifi_fmac_tx_status nrf_wifi_fmac_tx(struct nrf_wifi_fmac_dev_ct
 	status = (enum nrf_wifi_fmac_tx_status)tx_pending_process(fmac_dev_ctx,
 					desc,
 					ac);
+
+	/* The frame was already queued, it is no longer the caller's */
+	if (status == NRF_WIFI_FMAC_TX_STATUS_FAIL) {
+		status = NRF_WIFI_FMAC_TX_STATUS_QUEUED_FAIL;
+	}
 out:
 	nrf_wifi_osal_spinlock_rel(sys_dev_ctx->tx_config.tx_lock);
-
+err:
 	return status;
 }
 
@@ -1596,6 +2497,8 @@ enum nrf_wifi_status tx_init(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx)
 	void *q_ptr = NULL;
 	unsigned int i = 0;
 	unsigned int j = 0;
+	unsigned int max_peers = 0;
+	unsigned int bmp_size = 0;
 
 	if (!fmac_dev_ctx) {
 		goto out;
@@ -1615,15 +2518,43 @@ enum nrf_wifi_status tx_init(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx)
 		goto out;
 	}
 
+	/* One extra entry for the multicast/raw TX peer */
+	max_peers = sys_fpriv->max_peers;
+	sys_dev_ctx->tx_config.max_peers = max_peers;
+	sys_dev_ctx->tx_config.max_ap_peers = max_peers;
+
+	if (sys_dev_ctx->tx_config.max_ap_peers > NRF_WIFI_FMAC_FW_AP_MAX_PEERS) {
+		sys_dev_ctx->tx_config.max_ap_peers = NRF_WIFI_FMAC_FW_AP_MAX_PEERS;
+	}
+
+	sys_dev_ctx->tx_config.peers =
+		nrf_wifi_osal_mem_zalloc(sizeof(struct peers_info) * (max_peers + 1));
+
+	if (!sys_dev_ctx->tx_config.peers) {
+		nrf_wifi_osal_log_err("%s: Unable to allocate peers",
+				      __func__);
+		goto coal_q_free;
+	}
+
+	sys_dev_ctx->tx_config.data_pending_txq =
+		nrf_wifi_osal_mem_zalloc(sizeof(*sys_dev_ctx->tx_config.data_pending_txq) *
+					 (max_peers + 1));
+
+	if (!sys_dev_ctx->tx_config.data_pending_txq) {
+		nrf_wifi_osal_log_err("%s: Unable to allocate data_pending_txq",
+				      __func__);
+		goto peers_free;
+	}
+
 	for (i = 0; i < NRF_WIFI_FMAC_AC_MAX; i++) {
-		for (j = 0; j < MAX_SW_PEERS; j++) {
+		for (j = 0; j <= max_peers; j++) {
 			sys_dev_ctx->tx_config.data_pending_txq[j][i] =
 				nrf_wifi_utils_q_alloc();
 
 			if (!sys_dev_ctx->tx_config.data_pending_txq[j][i]) {
 				nrf_wifi_osal_log_err("%s: Unable to allocate data_pending_txq",
 						      __func__);
-				goto coal_q_free;
+				goto tx_q_free;
 			}
 		}
 
@@ -1653,7 +2584,11 @@ enum nrf_wifi_status tx_init(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx)
 	}
 
 	for (j = 0; j < NRF_WIFI_FMAC_AC_MAX; j++) {
-		sys_dev_ctx->tx_config.curr_peer_opp[j] = 0;
+		sys_dev_ctx->tx_config.curr_vif_opp[j] = 0;
+
+		for (i = 0; i <= MAX_NUM_VIFS; i++) {
+			sys_dev_ctx->tx_config.vif_sched[i].curr_peer_opp[j] = 0;
+		}
 	}
 
 	sys_dev_ctx->tx_config.buf_pool_bmp_p =
@@ -1670,8 +2605,13 @@ enum nrf_wifi_status tx_init(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx)
 			      0,
 			      sizeof(long)*((sys_fpriv->num_tx_tokens/TX_DESC_BUCKET_BOUND) + 1));
 
-	for (i = 0; i < MAX_PEERS; i++) {
+	for (i = 0; i <= max_peers; i++) {
 		sys_dev_ctx->tx_config.peers[i].peer_id = -1;
+		sys_dev_ctx->tx_config.peers[i].hash_next = -1;
+	}
+
+	for (i = 0; i < NRF_WIFI_FMAC_PEER_HASH_SIZE; i++) {
+		sys_dev_ctx->tx_config.peer_hash[i] = -1;
 	}
 
 	sys_dev_ctx->tx_config.tx_lock = nrf_wifi_osal_spinlock_alloc();
@@ -1684,12 +2624,39 @@ enum nrf_wifi_status tx_init(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx)
 
 	nrf_wifi_osal_spinlock_init(sys_dev_ctx->tx_config.tx_lock);
 
+	for (i = 0; i <= MAX_NUM_VIFS; i++) {
+		sys_dev_ctx->tx_config.vif_sched[i].lock = nrf_wifi_osal_spinlock_alloc();
+
+		if (!sys_dev_ctx->tx_config.vif_sched[i].lock) {
+			nrf_wifi_osal_log_err("%s: Unable to allocate VIF TX lock",
+					      __func__);
+			goto vif_spin_lock_free;
+		}
+
+		nrf_wifi_osal_spinlock_init(sys_dev_ctx->tx_config.vif_sched[i].lock);
+	}
+
+	bmp_size = sizeof(unsigned long) * ((max_peers + TX_PEER_BMP_BITS - 1) / TX_PEER_BMP_BITS);
+
+	for (i = 0; i < MAX_NUM_VIFS; i++) {
+		for (j = 0; j < NRF_WIFI_FMAC_AC_MAX; j++) {
+			sys_dev_ctx->tx_config.vif_sched[i].pend_peers[j] =
+				nrf_wifi_osal_mem_zalloc(bmp_size);
+
+			if (!sys_dev_ctx->tx_config.vif_sched[i].pend_peers[j]) {
+				nrf_wifi_osal_log_err("%s: Unable to allocate pending peers bitmap",
+						      __func__);
+				goto vif_spin_lock_free;
+			}
+		}
+	}
+
 	sys_dev_ctx->tx_config.wakeup_client_q = nrf_wifi_utils_q_alloc();
 
 	if (!sys_dev_ctx->tx_config.wakeup_client_q) {
 		nrf_wifi_osal_log_err("%s: Unable to allocate Wakeup Client List",
 				      __func__);
-		goto tx_spin_lock_free;
+		goto vif_spin_lock_free;
 	}
 
 	sys_dev_ctx->twt_sleep_status = NRF_WIFI_FMAC_TWT_STATE_AWAKE;
@@ -1719,7 +2686,21 @@ tx_done_tasklet_free:
 wakeup_client_q_free:
 	nrf_wifi_utils_q_free(sys_dev_ctx->tx_config.wakeup_client_q);
 #endif /* NRF70_TX_DONE_WQ_ENABLED */
-tx_spin_lock_free:
+vif_spin_lock_free:
+	for (i = 0; i <= MAX_NUM_VIFS; i++) {
+		for (j = 0; j < NRF_WIFI_FMAC_AC_MAX; j++) {
+			if (sys_dev_ctx->tx_config.vif_sched[i].pend_peers[j]) {
+				nrf_wifi_osal_mem_free(sys_dev_ctx->tx_config.vif_sched[i].pend_peers[j]);
+				sys_dev_ctx->tx_config.vif_sched[i].pend_peers[j] = NULL;
+			}
+		}
+
+		if (sys_dev_ctx->tx_config.vif_sched[i].lock) {
+			nrf_wifi_osal_spinlock_free(sys_dev_ctx->tx_config.vif_sched[i].lock);
+			sys_dev_ctx->tx_config.vif_sched[i].lock = NULL;
+		}
+	}
+
 	nrf_wifi_osal_spinlock_free(sys_dev_ctx->tx_config.tx_lock);
 tx_buff_map_free:
 	nrf_wifi_osal_mem_free(sys_dev_ctx->tx_config.buf_pool_bmp_p);
@@ -1731,12 +2712,20 @@ tx_q_setup_free:
 	nrf_wifi_osal_mem_free(sys_dev_ctx->tx_config.pkt_info_p);
 tx_q_free:
 	for (i = 0; i < NRF_WIFI_FMAC_AC_MAX; i++) {
-		for (j = 0; j < MAX_SW_PEERS; j++) {
+		for (j = 0; j <= max_peers; j++) {
 			q_ptr = sys_dev_ctx->tx_config.data_pending_txq[j][i];
 
-			nrf_wifi_utils_q_free(q_ptr);
+			if (q_ptr) {
+				nrf_wifi_utils_q_free(q_ptr);
+			}
 		}
 	}
+
+	nrf_wifi_osal_mem_free(sys_dev_ctx->tx_config.data_pending_txq);
+	sys_dev_ctx->tx_config.data_pending_txq = NULL;
+peers_free:
+	nrf_wifi_osal_mem_free(sys_dev_ctx->tx_config.peers);
+	sys_dev_ctx->tx_config.peers = NULL;
 coal_q_free:
 	nrf_wifi_osal_mem_free(sys_dev_ctx->tx_config.send_pkt_coalesce_count_p);
 out:
@@ -1749,6 +2738,7 @@ void tx_deinit(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx)
 	struct nrf_wifi_fmac_priv *fpriv = NULL;
 	struct nrf_wifi_sys_fmac_dev_ctx *sys_dev_ctx = NULL;
 	struct nrf_wifi_sys_fmac_priv *sys_fpriv = NULL;
+	unsigned int num_dropped = 0;
 	unsigned int i = 0;
 	unsigned int j = 0;
 
@@ -1764,6 +2754,16 @@ void tx_deinit(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx)
 #endif /* NRF70_TX_DONE_WQ_ENABLED */
 	nrf_wifi_utils_q_free(sys_dev_ctx->tx_config.wakeup_client_q);
 
+	for (i = 0; i <= MAX_NUM_VIFS; i++) {
+		for (j = 0; j < NRF_WIFI_FMAC_AC_MAX; j++) {
+			if (sys_dev_ctx->tx_config.vif_sched[i].pend_peers[j]) {
+				nrf_wifi_osal_mem_free(sys_dev_ctx->tx_config.vif_sched[i].pend_peers[j]);
+			}
+		}
+
+		nrf_wifi_osal_spinlock_free(sys_dev_ctx->tx_config.vif_sched[i].lock);
+	}
+
 	nrf_wifi_osal_spinlock_free(sys_dev_ctx->tx_config.tx_lock);
 
 	nrf_wifi_osal_mem_free(sys_dev_ctx->tx_config.buf_pool_bmp_p);
@@ -1773,6 +2773,7 @@ void tx_deinit(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx)
 			while (nrf_wifi_utils_q_len(sys_dev_ctx->tx_config.pkt_info_p[i].pkt)) {
 				nrf_wifi_osal_nbuf_free(
 					nrf_wifi_utils_q_dequeue(sys_dev_ctx->tx_config.pkt_info_p[i].pkt));
+				num_dropped++;
 			}
 			nrf_wifi_utils_list_free(
 						 sys_dev_ctx->tx_config.pkt_info_p[i].pkt);
@@ -1782,21 +2783,32 @@ void tx_deinit(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx)
 	nrf_wifi_osal_mem_free(sys_dev_ctx->tx_config.pkt_info_p);
 
 	for (i = 0; i < NRF_WIFI_FMAC_AC_MAX; i++) {
-		for (j = 0; j < MAX_SW_PEERS; j++) {
+		for (j = 0; j <= sys_dev_ctx->tx_config.max_peers; j++) {
 			while (nrf_wifi_utils_q_len(sys_dev_ctx->tx_config.data_pending_txq[j][i])) {
 				nrf_wifi_osal_nbuf_free(
 					nrf_wifi_utils_q_dequeue(sys_dev_ctx->tx_config.data_pending_txq[j][i]));
+				num_dropped++;
 			}
 			nrf_wifi_utils_q_free(
 					      sys_dev_ctx->tx_config.data_pending_txq[j][i]);
 		}
 	}
 
+	nrf_wifi_osal_mem_free(sys_dev_ctx->tx_config.data_pending_txq);
+	nrf_wifi_osal_mem_free(sys_dev_ctx->tx_config.peers);
+
 	nrf_wifi_osal_mem_free(sys_dev_ctx->tx_config.send_pkt_coalesce_count_p);
 
 	nrf_wifi_osal_mem_set(&sys_dev_ctx->tx_config,
 			      0,
 			      sizeof(struct tx_config));
+
+#ifdef NRF_WIFI_RPU_RECOVERY
+	nrf_wifi_sys_fmac_recovery_tx_dropped(fmac_dev_ctx,
+					      num_dropped);
+#else
+	(void)num_dropped;
+#endif /* NRF_WIFI_RPU_RECOVERY */
 }
 
 
@@ -1817,116 +2829,378 @@ static int map_ac_from_tid(int tid)
 }
 
 
-static int get_ac(unsigned int tid,
-		  unsigned char *ra)
-{
-	if (nrf_wifi_util_is_multicast_addr(ra)) {
-		return NRF_WIFI_FMAC_AC_MC;
-	}
+static int get_ac(unsigned int tid,
+		  unsigned char *ra)
+{
+	if (nrf_wifi_util_is_multicast_addr(ra)) {
+		return NRF_WIFI_FMAC_AC_MC;
+	}
+
+	return map_ac_from_tid(tid);
+}
+
+
+unsigned char *nrf_wifi_util_get_ra(struct nrf_wifi_fmac_vif_ctx *vif,
+				    void *nwb)
+{
+	if ((vif->if_type == NRF_WIFI_IFTYPE_STATION)
+#ifdef NRF70_RAW_DATA_TX
+	    || (vif->if_type == NRF_WIFI_STA_TX_INJECTOR)
+#endif /* NRF70_RAW_DATA_TX */
+#ifdef NRF70_PROMISC_DATA_RX
+	    || (vif->if_type == NRF_WIFI_STA_PROMISC)
+	    || (vif->if_type == NRF_WIFI_STA_PROMISC_TX_INJECTOR)
+#endif
+	    ) {
+		return vif->bssid;
+	}
+
+	return nrf_wifi_osal_nbuf_data_get(nwb);
+}
+
+
+#ifdef NRF70_RAW_DATA_TX
+static bool nrf_wifi_raw_pkt_mode_enabled(struct nrf_wifi_fmac_vif_ctx *vif)
+{
+	if ((vif->if_type == NRF_WIFI_STA_TX_INJECTOR) ||
+	    (vif->if_type == NRF_WIFI_MONITOR_TX_INJECTOR) ||
+	    (vif->if_type == NRF_WIFI_STA_PROMISC_TX_INJECTOR)) {
+		return true;
+	}
+	return false;
+}
+
+enum nrf_wifi_status nrf_wifi_fmac_start_rawpkt_xmit(void *dev_ctx,
+						     unsigned char if_idx,
+						     void *nwb)
+{
+	enum nrf_wifi_fmac_tx_status tx_status = NRF_WIFI_FMAC_TX_STATUS_FAIL;
+	struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx = NULL;
+	struct nrf_wifi_sys_fmac_dev_ctx *sys_dev_ctx = NULL;
+	void *nwb_data = NULL;
+	int ac;
+	int peer_id;
+
+	if (!nwb || !dev_ctx) {
+		/**
+		 * Handling an abnormal case.
+		 * return failure as network buffer and device
+		 * context are NULL
+		 */
+		goto fail;
+	}
+
+	fmac_dev_ctx = (struct nrf_wifi_fmac_dev_ctx *)dev_ctx;
+	sys_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
+
+	/**
+	 * only allow raw packet to be transmitted if interface type allows it
+	 * do not queue the packet if interface type does not allow raw tx
+	 */
+	if (!nrf_wifi_raw_pkt_mode_enabled(sys_dev_ctx->vif_ctx[if_idx])) {
+		nrf_wifi_osal_log_err("%s: raw_packet mode is not enabled",
+				      __func__);
+		goto out;
+	}
+
+	nwb_data = nrf_wifi_osal_nbuf_data_get(nwb);
+	nrf_wifi_osal_mem_cpy(&sys_dev_ctx->raw_tx_config,
+			      nwb_data,
+			      sizeof(struct raw_tx_pkt_header));
+
+	sys_dev_ctx->raw_tx_config.raw_tx_flag = 1;
+	peer_id = sys_dev_ctx->tx_config.max_peers;
+	ac = sys_dev_ctx->raw_tx_config.queue;
+
+	tx_status = nrf_wifi_fmac_tx(fmac_dev_ctx,
+				     if_idx,
+				     nwb,
+				     ac,
+				     peer_id);
+	if ((tx_status == NRF_WIFI_FMAC_TX_STATUS_FAIL) ||
+	    (tx_status == NRF_WIFI_FMAC_TX_STATUS_QUEUED_FAIL)) {
+		nrf_wifi_osal_log_dbg("%s: Failed to send packet\n",
+				      __func__);
+		/** Increment failure count */
+		sys_dev_ctx->raw_pkt_stats.raw_pkt_send_failure += 1;
+	} else {
+		/**
+		 * Increment success count.
+		 * can be added to shell command to obtain statistics
+		 */
+		sys_dev_ctx->raw_pkt_stats.raw_pkt_send_success += 1;
+	}
+
+	/**
+	 * Always silently drop the RAW packet and not send Failure.
+	 * The network stack might think interface is down
+	 */
+out:
+	sys_dev_ctx->raw_pkt_stats.raw_pkts_sent += 1;
+	return NRF_WIFI_STATUS_SUCCESS;
+fail:
+	return NRF_WIFI_STATUS_FAIL;
+}
+
+
+enum nrf_wifi_status nrf_wifi_fmac_rawtx_session_start(void *dev_ctx,
+						       unsigned char if_idx,
+						       const struct nrf_wifi_fmac_rawtx_session_cfg *cfg)
+{
+	enum nrf_wifi_status status = NRF_WIFI_STATUS_FAIL;
+	struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx = dev_ctx;
+	struct nrf_wifi_sys_fmac_dev_ctx *sys_dev_ctx = NULL;
+	struct nrf_wifi_fmac_rawtx_session *session = NULL;
+
+	if (!fmac_dev_ctx || !cfg || if_idx >= MAX_NUM_VIFS) {
+		nrf_wifi_osal_log_err("%s: Invalid parameters",
+				      __func__);
+		goto out;
+	}
+
+	sys_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
+	session = &sys_dev_ctx->raw_tx_session;
+
+	if (!sys_dev_ctx->vif_ctx[if_idx] ||
+	    !nrf_wifi_raw_pkt_mode_enabled(sys_dev_ctx->vif_ctx[if_idx])) {
+		nrf_wifi_osal_log_err("%s: raw_packet mode is not enabled",
+				      __func__);
+		goto out;
+	}
+
+	if (cfg->hdr_len > NRF_WIFI_FMAC_RAWTX_TEMPLATE_MAX_LEN ||
+	    (cfg->seq_num_update && cfg->hdr_len < 24) ||
+	    cfg->queue >= NRF_WIFI_FMAC_AC_MAX ||
+	    cfg->tx_mode >= NRF_WIFI_FMAC_RAWTX_MODE_MAX) {
+		nrf_wifi_osal_log_err("%s: Invalid session configuration",
+				      __func__);
+		goto out;
+	}
+
+	nrf_wifi_osal_mem_set(session,
+			      0,
+			      sizeof(*session));
+
+	nrf_wifi_osal_mem_cpy(&session->cfg,
+			      cfg,
+			      sizeof(session->cfg));
+
+	/* Built once, copied as is to every frame of the session */
+	session->frame_hdr.raw_hdr.magic_num = NRF_WIFI_MAGIC_NUM_RAWTX_SESSION;
+	session->frame_hdr.raw_hdr.data_rate = cfg->data_rate;
+	session->frame_hdr.raw_hdr.tx_mode = cfg->tx_mode;
+	session->frame_hdr.raw_hdr.queue = cfg->queue;
+	session->frame_hdr.raw_hdr.raw_tx_flag = 1;
+	session->frame_hdr.rate_retries = cfg->rate_retries;
+
+	session->if_idx = if_idx;
+	session->start_us = nrf_wifi_osal_time_get_curr_us();
+	session->active = true;
+
+	status = NRF_WIFI_STATUS_SUCCESS;
+out:
+	return status;
+}
+
+
+enum nrf_wifi_status nrf_wifi_fmac_rawtx_session_xmit(void *dev_ctx,
+						      void **nwbs,
+						      unsigned int num_nwbs,
+						      unsigned int *num_queued)
+{
+	enum nrf_wifi_status status = NRF_WIFI_STATUS_FAIL;
+	enum nrf_wifi_fmac_tx_status tx_status = NRF_WIFI_FMAC_TX_STATUS_FAIL;
+	struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx = dev_ctx;
+	struct nrf_wifi_sys_fmac_dev_ctx *sys_dev_ctx = NULL;
+	struct nrf_wifi_fmac_rawtx_session *session = NULL;
+	struct nrf_wifi_fmac_vif_ctx *vif_ctx = NULL;
+	unsigned char *data = NULL;
+	unsigned int hdr_len = 0;
+	unsigned int push_len = 0;
+	unsigned int num_failed = 0;
+	unsigned int i = 0;
+
+	if (!fmac_dev_ctx || !nwbs || !num_queued) {
+		nrf_wifi_osal_log_err("%s: Invalid parameters",
+				      __func__);
+		goto out;
+	}
+
+	*num_queued = 0;
+
+	sys_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
+	session = &sys_dev_ctx->raw_tx_session;
+
+	nrf_wifi_osal_spinlock_take(sys_dev_ctx->tx_config.tx_lock);
+
+	if (!session->active) {
+		nrf_wifi_osal_spinlock_rel(sys_dev_ctx->tx_config.tx_lock);
+		nrf_wifi_osal_log_err("%s: No raw TX session",
+				      __func__);
+		goto out;
+	}
+
+	/* The VIF might have been removed or left the raw TX mode without
+	 * the session being stopped.
+	 */
+	vif_ctx = sys_dev_ctx->vif_ctx[session->if_idx];
+
+	if (!vif_ctx || !nrf_wifi_raw_pkt_mode_enabled(vif_ctx)) {
+		session->active = false;
+		nrf_wifi_osal_spinlock_rel(sys_dev_ctx->tx_config.tx_lock);
+		nrf_wifi_osal_log_err("%s: raw_packet mode is not enabled",
+				      __func__);
+		goto out;
+	}
+
+	/* The queueing path only needs the raw TX flag, the settings of each
+	 * frame are taken from its own header once it is dequeued.
+	 */
+	nrf_wifi_osal_mem_cpy(&sys_dev_ctx->raw_tx_config,
+			      &session->frame_hdr.raw_hdr,
+			      sizeof(sys_dev_ctx->raw_tx_config));
+
+	nrf_wifi_osal_spinlock_rel(sys_dev_ctx->tx_config.tx_lock);
+
+	hdr_len = sizeof(session->frame_hdr);
+	push_len = hdr_len + session->cfg.hdr_len;
+
+	for (i = 0; i < num_nwbs; i++) {
+		if (nrf_wifi_osal_nbuf_headroom_get(nwbs[i]) < push_len) {
+			nrf_wifi_osal_log_err("%s: Not enough headroom",
+					      __func__);
+			session->stats.num_failed++;
+			break;
+		}
+
+		data = nrf_wifi_osal_nbuf_data_push(nwbs[i],
+						    push_len);
+
+		nrf_wifi_osal_mem_cpy(data,
+				      &session->frame_hdr,
+				      hdr_len);
 
-	return map_ac_from_tid(tid);
-}
+		if (session->cfg.hdr_len) {
+			nrf_wifi_osal_mem_cpy(data + hdr_len,
+					      session->cfg.hdr,
+					      session->cfg.hdr_len);
 
+			if (session->cfg.seq_num_update) {
+				/* Sequence control, fragment number 0 */
+				data[hdr_len + 22] = (session->seq_num << 4) & 0xF0;
+				data[hdr_len + 23] = (session->seq_num >> 4) & 0xFF;
+				session->seq_num = (session->seq_num + 1) & 0xFFF;
+			}
+		}
 
-unsigned char *nrf_wifi_util_get_ra(struct nrf_wifi_fmac_vif_ctx *vif,
-				    void *nwb)
-{
-	if ((vif->if_type == NRF_WIFI_IFTYPE_STATION)
-#ifdef NRF70_RAW_DATA_TX
-	    || (vif->if_type == NRF_WIFI_STA_TX_INJECTOR)
-#endif /* NRF70_RAW_DATA_TX */
-#ifdef NRF70_PROMISC_DATA_RX
-	    || (vif->if_type == NRF_WIFI_STA_PROMISC)
-	    || (vif->if_type == NRF_WIFI_STA_PROMISC_TX_INJECTOR)
-#endif
-	    ) {
-		return vif->bssid;
+		tx_status = nrf_wifi_fmac_tx(fmac_dev_ctx,
+					     session->if_idx,
+					     nwbs[i],
+					     session->cfg.queue,
+					     sys_dev_ctx->tx_config.max_peers);
+
+		if (tx_status == NRF_WIFI_FMAC_TX_STATUS_FAIL) {
+			/* Not queued, hand the frame back to the caller as it was */
+			nrf_wifi_osal_nbuf_data_pull(nwbs[i],
+						     push_len);
+			session->stats.num_failed++;
+			break;
+		}
+
+		if (tx_status == NRF_WIFI_FMAC_TX_STATUS_QUEUED_FAIL) {
+			/* Queued, the frame now belongs to the driver */
+			session->stats.num_failed++;
+			num_failed++;
+			i++;
+			break;
+		}
 	}
 
-	return nrf_wifi_osal_nbuf_data_get(nwb);
-}
+	*num_queued = i;
 
+	session->stats.num_batches++;
+	session->stats.num_frames += i - num_failed;
+	session->stats.duration_us = nrf_wifi_osal_time_elapsed_us(session->start_us);
 
-#ifdef NRF70_RAW_DATA_TX
-static bool nrf_wifi_raw_pkt_mode_enabled(struct nrf_wifi_fmac_vif_ctx *vif)
-{
-	if ((vif->if_type == NRF_WIFI_STA_TX_INJECTOR) ||
-	    (vif->if_type == NRF_WIFI_MONITOR_TX_INJECTOR) ||
-	    (vif->if_type == NRF_WIFI_STA_PROMISC_TX_INJECTOR)) {
-		return true;
-	}
-	return false;
+	sys_dev_ctx->raw_pkt_stats.raw_pkts_sent += i;
+	sys_dev_ctx->raw_pkt_stats.raw_pkt_send_success += i - num_failed;
+	sys_dev_ctx->raw_pkt_stats.raw_pkt_send_failure += num_failed;
+
+	status = ((i == num_nwbs) && !num_failed) ? NRF_WIFI_STATUS_SUCCESS : NRF_WIFI_STATUS_FAIL;
+out:
+	return status;
 }
 
-enum nrf_wifi_status nrf_wifi_fmac_start_rawpkt_xmit(void *dev_ctx,
-						     unsigned char if_idx,
-						     void *nwb)
+
+enum nrf_wifi_status nrf_wifi_fmac_rawtx_session_stop(void *dev_ctx,
+						      struct nrf_wifi_fmac_rawtx_session_stats *stats)
 {
-	enum nrf_wifi_fmac_tx_status tx_status = NRF_WIFI_FMAC_TX_STATUS_FAIL;
-	struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx = NULL;
+	enum nrf_wifi_status status = NRF_WIFI_STATUS_FAIL;
+	struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx = dev_ctx;
 	struct nrf_wifi_sys_fmac_dev_ctx *sys_dev_ctx = NULL;
-	void *nwb_data = NULL;
-	int ac;
-	int peer_id;
+	struct nrf_wifi_fmac_rawtx_session *session = NULL;
 
-	if (!nwb || !dev_ctx) {
-		/**
-		 * Handling an abnormal case.
-		 * return failure as network buffer and device
-		 * context are NULL
-		 */
-		goto fail;
+	if (!fmac_dev_ctx) {
+		nrf_wifi_osal_log_err("%s: Invalid parameters",
+				      __func__);
+		goto out;
 	}
 
-	fmac_dev_ctx = (struct nrf_wifi_fmac_dev_ctx *)dev_ctx;
 	sys_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
+	session = &sys_dev_ctx->raw_tx_session;
 
-	/**
-	 * only allow raw packet to be transmitted if interface type allows it
-	 * do not queue the packet if interface type does not allow raw tx
-	 */
-	if (!nrf_wifi_raw_pkt_mode_enabled(sys_dev_ctx->vif_ctx[if_idx])) {
-		nrf_wifi_osal_log_err("%s: raw_packet mode is not enabled",
+	if (!session->active) {
+		nrf_wifi_osal_log_err("%s: No raw TX session",
 				      __func__);
 		goto out;
 	}
 
-	nwb_data = nrf_wifi_osal_nbuf_data_get(nwb);
-	nrf_wifi_osal_mem_cpy(&sys_dev_ctx->raw_tx_config,
-			      nwb_data,
-			      sizeof(struct raw_tx_pkt_header));
+	if (stats) {
+		nrf_wifi_osal_mem_cpy(stats,
+				      &session->stats,
+				      sizeof(*stats));
+	}
 
-	sys_dev_ctx->raw_tx_config.raw_tx_flag = 1;
-	peer_id = MAX_PEERS;
-	ac = sys_dev_ctx->raw_tx_config.queue;
+	/* Frames still queued keep the session parameters, only new
+	 * submissions are refused.
+	 */
+	nrf_wifi_osal_spinlock_take(sys_dev_ctx->tx_config.tx_lock);
+	session->active = false;
+	nrf_wifi_osal_spinlock_rel(sys_dev_ctx->tx_config.tx_lock);
 
-	tx_status = nrf_wifi_fmac_tx(fmac_dev_ctx,
-				     if_idx,
-				     nwb,
-				     ac,
-				     peer_id);
-	if (tx_status == NRF_WIFI_FMAC_TX_STATUS_FAIL) {
-		nrf_wifi_osal_log_dbg("%s: Failed to send packet\n",
-				      __func__);
-		/** Increment failure count */
-		sys_dev_ctx->raw_pkt_stats.raw_pkt_send_failure += 1;
-	} else {
-		/**
-		 * Increment success count.
-		 * can be added to shell command to obtain statistics
-		 */
-		sys_dev_ctx->raw_pkt_stats.raw_pkt_send_success += 1;
+	status = NRF_WIFI_STATUS_SUCCESS;
+out:
+	return status;
+}
+
+
+void tx_rawtx_session_vif_check(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+				unsigned char if_idx,
+				bool vif_removed)
+{
+	struct nrf_wifi_sys_fmac_dev_ctx *sys_dev_ctx = NULL;
+	struct nrf_wifi_fmac_rawtx_session *session = NULL;
+	struct nrf_wifi_fmac_vif_ctx *vif_ctx = NULL;
+
+	sys_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
+	session = &sys_dev_ctx->raw_tx_session;
+
+	nrf_wifi_osal_spinlock_take(sys_dev_ctx->tx_config.tx_lock);
+
+	if (!session->active || (session->if_idx != if_idx)) {
+		goto out;
 	}
 
-	/**
-	 * Always silently drop the RAW packet and not send Failure.
-	 * The network stack might think interface is down
-	 */
+	vif_ctx = sys_dev_ctx->vif_ctx[if_idx];
+
+	if (vif_removed || !vif_ctx || !nrf_wifi_raw_pkt_mode_enabled(vif_ctx)) {
+		nrf_wifi_osal_log_dbg("%s: Raw TX session on VIF %d ended",
+				      __func__,
+				      if_idx);
+		session->active = false;
+	}
 out:
-	sys_dev_ctx->raw_pkt_stats.raw_pkts_sent += 1;
-	return NRF_WIFI_STATUS_SUCCESS;
-fail:
-	return NRF_WIFI_STATUS_FAIL;
+	nrf_wifi_osal_spinlock_rel(sys_dev_ctx->tx_config.tx_lock);
 }
 #endif /* NRF70_RAW_DATA_TX */
 
@@ -1963,7 +3237,7 @@ enum nrf_wifi_status nrf_wifi_fmac_start_xmit(void *dev_ctx,
 				      __func__);
 
 		goto out;
-	} else if (peer_id == MAX_PEERS) {
+	} else if (peer_id == (int)sys_dev_ctx->tx_config.max_peers) {
 		ac = NRF_WIFI_FMAC_AC_MC;
 	} else {
 		if (sys_dev_ctx->tx_config.peers[peer_id].qos_supported) {
@@ -1986,6 +3260,13 @@ enum nrf_wifi_status nrf_wifi_fmac_start_xmit(void *dev_ctx,
 		goto out;
 	}
 
+	if (tx_status == NRF_WIFI_FMAC_TX_STATUS_QUEUED_FAIL) {
+		/* Already queued, must not be freed here */
+		nrf_wifi_osal_log_dbg("%s: Failed to send packet",
+				      __func__);
+		return status;
+	}
+
 	return NRF_WIFI_STATUS_SUCCESS;
 out:
 	if (nbuf) {
@@ -1993,3 +3274,218 @@ out:
 	}
 	return status;
 }
+
+
+enum nrf_wifi_status nrf_wifi_sys_fmac_tx_params_get(void *dev_ctx,
+						     struct nrf_wifi_fmac_tx_params *params)
+{
+	enum nrf_wifi_status status = NRF_WIFI_STATUS_FAIL;
+	struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx = NULL;
+	struct nrf_wifi_sys_fmac_priv *sys_fpriv = NULL;
+
+	if (!dev_ctx || !params) {
+		nrf_wifi_osal_log_err("%s: Invalid parameters",
+				      __func__);
+		goto out;
+	}
+
+	fmac_dev_ctx = dev_ctx;
+	sys_fpriv = wifi_fmac_priv(fmac_dev_ctx->fpriv);
+
+	params->max_tx_aggregation = sys_fpriv->data_config.max_tx_aggregation;
+	params->num_tx_tokens_per_ac = sys_fpriv->num_tx_tokens_per_ac;
+	params->num_tx_tokens_spare = sys_fpriv->num_tx_tokens_spare;
+	params->max_ampdu_len_per_token = sys_fpriv->max_ampdu_len_per_token;
+	params->avail_ampdu_len_per_token = sys_fpriv->avail_ampdu_len_per_token;
+
+	status = NRF_WIFI_STATUS_SUCCESS;
+out:
+	return status;
+}
+
+
+enum nrf_wifi_status nrf_wifi_sys_fmac_tx_params_set(void *dev_ctx,
+						     struct nrf_wifi_fmac_tx_params *params)
+{
+	enum nrf_wifi_status status = NRF_WIFI_STATUS_FAIL;
+	struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx = NULL;
+	struct nrf_wifi_sys_fmac_dev_ctx *sys_dev_ctx = NULL;
+	struct nrf_wifi_sys_fmac_priv *sys_fpriv = NULL;
+	unsigned long start_time_ms = 0;
+	unsigned int num_tx_tokens_spare = 0;
+	unsigned int pktram_tx_size = 0;
+	unsigned int desc = 0;
+	int ac = 0;
+	bool idle = false;
+
+	if (!dev_ctx || !params) {
+		nrf_wifi_osal_log_err("%s: Invalid parameters",
+				      __func__);
+		goto out;
+	}
+
+	fmac_dev_ctx = dev_ctx;
+	sys_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
+	sys_fpriv = wifi_fmac_priv(fmac_dev_ctx->fpriv);
+
+	if (!sys_dev_ctx->tx_config.tx_lock) {
+		nrf_wifi_osal_log_err("%s: TX path not initialized",
+				      __func__);
+		goto out;
+	}
+
+	/* The parameters live in the FMAC/HAL instance shared by all devices */
+	if (fmac_dev_ctx->fpriv->hpriv->num_devs > 1) {
+		nrf_wifi_osal_log_err("%s: Not supported with %d devices",
+				      __func__,
+				      fmac_dev_ctx->fpriv->hpriv->num_devs);
+		goto out;
+	}
+
+	if (!params->max_tx_aggregation ||
+	    params->max_tx_aggregation > sys_fpriv->max_tx_aggregation_limit) {
+		nrf_wifi_osal_log_err("%s: Invalid TX aggregation %d (max %d)",
+				      __func__,
+				      params->max_tx_aggregation,
+				      sys_fpriv->max_tx_aggregation_limit);
+		goto out;
+	}
+
+	if (!params->num_tx_tokens_per_ac ||
+	    (params->num_tx_tokens_per_ac * NRF_WIFI_FMAC_AC_MAX) > sys_fpriv->num_tx_tokens) {
+		nrf_wifi_osal_log_err("%s: Invalid number of TX tokens per AC %d",
+				      __func__,
+				      params->num_tx_tokens_per_ac);
+		goto out;
+	}
+
+	num_tx_tokens_spare = sys_fpriv->num_tx_tokens -
+		(params->num_tx_tokens_per_ac * NRF_WIFI_FMAC_AC_MAX);
+
+	/* The AC of each spare descriptor is tracked in spare_desc_queue_map */
+	if ((num_tx_tokens_spare * SPARE_DESC_Q_MAP_SIZE) >
+	    (sizeof(sys_dev_ctx->tx_config.spare_desc_queue_map) * 8)) {
+		nrf_wifi_osal_log_err("%s: Too many spare TX tokens %d",
+				      __func__,
+				      num_tx_tokens_spare);
+		goto out;
+	}
+
+	pktram_tx_size = nrf_wifi_sys_hal_tx_pktram_size_get(fmac_dev_ctx->hal_dev_ctx);
+
+	if (params->max_ampdu_len_per_token < fmac_dev_ctx->fpriv->hpriv->cfg_params.max_tx_frm_sz ||
+	    (sys_fpriv->num_tx_tokens * params->max_ampdu_len_per_token) > pktram_tx_size) {
+		nrf_wifi_osal_log_err("%s: Invalid AMPDU length per token %d (packet RAM TX size %d)",
+				      __func__,
+				      params->max_ampdu_len_per_token,
+				      pktram_tx_size);
+		goto out;
+	}
+
+	if (!params->avail_ampdu_len_per_token ||
+	    params->avail_ampdu_len_per_token > params->max_ampdu_len_per_token) {
+		nrf_wifi_osal_log_err("%s: Invalid available AMPDU length per token %d",
+				      __func__,
+				      params->avail_ampdu_len_per_token);
+		goto out;
+	}
+
+	/* Stop granting TX descriptors and wait for the ones already with the
+	 * RPU to be returned, the descriptor to buffer mapping depends on the
+	 * parameters being changed. Frames keep getting queued meanwhile.
+	 * Descriptors held for the next TWT service period never reach the
+	 * RPU, so their frames are queued again instead of waited for.
+	 */
+	nrf_wifi_osal_spinlock_take(sys_dev_ctx->tx_config.tx_lock);
+	sys_dev_ctx->tx_config.quiesce = true;
+	tx_twt_requeue(fmac_dev_ctx);
+	nrf_wifi_osal_spinlock_rel(sys_dev_ctx->tx_config.tx_lock);
+
+	start_time_ms = nrf_wifi_osal_time_get_curr_ms();
+
+	while (1) {
+		nrf_wifi_osal_spinlock_take(sys_dev_ctx->tx_config.tx_lock);
+
+		idle = true;
+
+		for (ac = 0; ac < NRF_WIFI_FMAC_AC_MAX; ac++) {
+			if (sys_dev_ctx->tx_config.outstanding_descs[ac]) {
+				idle = false;
+				break;
+			}
+		}
+
+		if (idle ||
+		    nrf_wifi_osal_time_elapsed_ms(start_time_ms) >= NRF_WIFI_FMAC_TX_QUIESCE_TIMEOUT_MS) {
+			break;
+		}
+
+		nrf_wifi_osal_spinlock_rel(sys_dev_ctx->tx_config.tx_lock);
+
+		nrf_wifi_osal_sleep_ms(1);
+	}
+
+	/* TX lock is held here */
+	if (idle) {
+		sys_fpriv->data_config.max_tx_aggregation = params->max_tx_aggregation;
+		sys_fpriv->num_tx_tokens_per_ac = params->num_tx_tokens_per_ac;
+		sys_fpriv->num_tx_tokens_spare = num_tx_tokens_spare;
+		sys_fpriv->max_ampdu_len_per_token = params->max_ampdu_len_per_token;
+		sys_fpriv->avail_ampdu_len_per_token = params->avail_ampdu_len_per_token;
+		fmac_dev_ctx->fpriv->hpriv->cfg_params.max_ampdu_len_per_token =
+			params->max_ampdu_len_per_token;
+
+		sys_dev_ctx->tx_config.spare_desc_queue_map = 0;
+		sys_dev_ctx->tx_config.next_spare_desc_ac = 0;
+
+		status = NRF_WIFI_STATUS_SUCCESS;
+	} else {
+		nrf_wifi_osal_log_err("%s: Timed out waiting for TX descriptors",
+				      __func__);
+	}
+
+	sys_dev_ctx->tx_config.quiesce = false;
+
+	/* Restart the frames which were queued in the meantime */
+	for (ac = NRF_WIFI_FMAC_AC_VO; ac >= 0; --ac) {
+		desc = tx_desc_get(fmac_dev_ctx, ac);
+
+		if (desc < sys_fpriv->num_tx_tokens) {
+			tx_pending_process(fmac_dev_ctx, desc, ac);
+		}
+	}
+
+	nrf_wifi_osal_spinlock_rel(sys_dev_ctx->tx_config.tx_lock);
+out:
+	return status;
+}
+
+
+enum nrf_wifi_status nrf_wifi_sys_fmac_twt_tx_stats_get(void *dev_ctx,
+							struct nrf_wifi_fmac_twt_tx_stats *stats)
+{
+	enum nrf_wifi_status status = NRF_WIFI_STATUS_FAIL;
+	struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx = NULL;
+	struct nrf_wifi_sys_fmac_dev_ctx *sys_dev_ctx = NULL;
+
+	if (!dev_ctx || !stats) {
+		nrf_wifi_osal_log_err("%s: Invalid parameters",
+				      __func__);
+		goto out;
+	}
+
+	fmac_dev_ctx = dev_ctx;
+	sys_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
+
+	nrf_wifi_osal_spinlock_take(sys_dev_ctx->tx_config.tx_lock);
+
+	nrf_wifi_osal_mem_cpy(stats,
+			      &sys_dev_ctx->tx_config.twt.stats,
+			      sizeof(*stats));
+
+	nrf_wifi_osal_spinlock_rel(sys_dev_ctx->tx_config.tx_lock);
+
+	status = NRF_WIFI_STATUS_SUCCESS;
+out:
+	return status;
+}
@@ -185,8 +185,92 @@ enum nrf_wifi_status hal_rpu_ps_wake(struct nrf_wifi_hal_dev_ctx *hal_dev_ctx);
  */
 enum nrf_wifi_status nrf_wifi_hal_get_rpu_ps_state(struct nrf_wifi_hal_dev_ctx *hal_dev_ctx,
 			int *rpu_ps_ctrl_state);
+
+/**
+ * @brief Attribute the next RPU wake to a cause.
+ *
+ * This function sets the cause accounted for if the next RPU access wakes the
+ * RPU. The cause is consumed by that access whether it wakes the RPU or not,
+ * and is only set if no other cause has been set since the last access.
+ *
+ * @param hal_dev_ctx     Pointer to the Wi-Fi HAL device context.
+ * @param cause           The cause of the RPU access.
+ */
+void nrf_wifi_hal_ps_wake_cause_set(struct nrf_wifi_hal_dev_ctx *hal_dev_ctx,
+				    enum nrf_wifi_hal_ps_wake_cause cause);
+
+/**
+ * @brief Get the RPU power state residency and wake statistics.
+ *
+ * @param hal_dev_ctx     Pointer to the Wi-Fi HAL device context.
+ * @param ps_stats        Pointer to the structure to be filled with the statistics.
+ *
+ * @return The status of the operation.
+ */
+enum nrf_wifi_status nrf_wifi_hal_ps_stats_get(struct nrf_wifi_hal_dev_ctx *hal_dev_ctx,
+					       struct nrf_wifi_hal_ps_stats *ps_stats);
+
+/**
+ * @brief Reset the RPU power state residency and wake statistics.
+ *
+ * @param hal_dev_ctx     Pointer to the Wi-Fi HAL device context.
+ *
+ * @return The status of the operation.
+ */
+enum nrf_wifi_status nrf_wifi_hal_ps_stats_reset(struct nrf_wifi_hal_dev_ctx *hal_dev_ctx);
+
+/**
+ * @brief Set the bounds of the adaptive RPU idle timeout.
+ *
+ * @param hal_dev_ctx     Pointer to the Wi-Fi HAL device context.
+ * @param min_ms          Minimum idle timeout (in ms).
+ * @param max_ms          Maximum idle timeout (in ms).
+ *
+ * @return The status of the operation.
+ */
+enum nrf_wifi_status nrf_wifi_hal_ps_idle_timeout_bounds_set(struct nrf_wifi_hal_dev_ctx *hal_dev_ctx,
+							     unsigned int min_ms,
+							     unsigned int max_ms);
+
+/**
+ * @brief Override the adaptive RPU idle timeout with a fixed value.
+ *
+ * @param hal_dev_ctx     Pointer to the Wi-Fi HAL device context.
+ * @param timeout_ms      Fixed idle timeout (in ms), 0 to go back to the adaptive one.
+ *
+ * @return The status of the operation.
+ */
+enum nrf_wifi_status nrf_wifi_hal_ps_idle_timeout_override(struct nrf_wifi_hal_dev_ctx *hal_dev_ctx,
+							   unsigned int timeout_ms);
 #endif /* NRF_WIFI_LOW_POWER */
 
+#if defined(NRF_WIFI_RPU_RECOVERY) || defined(__DOXYGEN__)
+/**
+ * @brief Request an RPU recovery.
+ *
+ * This function records the cause and time of detection and schedules the
+ * recovery, for failures detected outside the HAL (e.g. a command timeout).
+ *
+ * @param hal_dev_ctx     Pointer to the Wi-Fi HAL device context.
+ * @param cause           Cause of the recovery.
+ *
+ * @return The status of the operation.
+ */
+enum nrf_wifi_status nrf_wifi_hal_rpu_recovery_request(struct nrf_wifi_hal_dev_ctx *hal_dev_ctx,
+						       enum nrf_wifi_hal_recovery_cause cause);
+#endif /* NRF_WIFI_RPU_RECOVERY */
+
+/**
+ * @brief Get the counters of the accesses to the RPU over the bus.
+ *
+ * @param hal_dev_ctx     Pointer to the Wi-Fi HAL device context.
+ * @param stats           Pointer to the structure to be filled with the counters.
+ *
+ * @return The status of the operation.
+ */
+enum nrf_wifi_status nrf_wifi_hal_bus_stats_get(struct nrf_wifi_hal_dev_ctx *hal_dev_ctx,
+						struct nrf_wifi_hal_bus_stats *stats);
+
 /**
  * @brief Get the OTP information for the Wi-Fi HAL.
  *
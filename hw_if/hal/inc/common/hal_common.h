@@ -19,4 +19,9 @@ enum nrf_wifi_status hal_rpu_hpq_enqueue(struct nrf_wifi_hal_dev_ctx *hal_ctx,
 enum nrf_wifi_status hal_rpu_hpq_dequeue(struct nrf_wifi_hal_dev_ctx *hal_ctx,
 					 struct host_rpu_hpq *hpq,
 					 unsigned int *val);
+
+#ifdef NRF_WIFI_RPU_RECOVERY
+void hal_rpu_recovery_note(struct nrf_wifi_hal_dev_ctx *hal_dev_ctx,
+			   enum nrf_wifi_hal_recovery_cause cause);
+#endif /* NRF_WIFI_RPU_RECOVERY */
 #endif /* __HAL_COMMON_H__ */
@@ -20,6 +20,13 @@ enum nrf_wifi_fw_patch_type {
 	NRF_WIFI_FW_PATCH_TYPE_MAX
 };
 
+/* Bytes moved over the bus by a patch download */
+struct nrf_wifi_hal_fw_patch_stats {
+	unsigned int bytes_written;
+	unsigned int bytes_verified;
+	unsigned int bytes_skipped;
+};
+
 
 /* Loads a firmware patch chunk into RPU memory. */
 enum nrf_wifi_status hal_fw_patch_chunk_load(struct nrf_wifi_hal_dev_ctx *hal_dev_ctx,
@@ -28,14 +35,18 @@ enum nrf_wifi_status hal_fw_patch_chunk_load(struct nrf_wifi_hal_dev_ctx *hal_de
 						const void *fw_chunk_data,
 						unsigned int fw_chunk_size);
 /*
- * Downloads a firmware patch into RPU memory.
+ * Downloads a firmware patch into RPU memory. With verify set, the chunks
+ * already held by the RPU (e.g. retained across a soft reset) are read back
+ * and only rewritten if they differ.
  */
 enum nrf_wifi_status nrf_wifi_hal_fw_patch_load(struct nrf_wifi_hal_dev_ctx *hal_dev_ctx,
 						enum RPU_PROC_TYPE rpu_proc,
 						const void *fw_pri_patch_data,
 						unsigned int fw_pri_patch_size,
 						const void *fw_sec_patch_data,
-						unsigned int fw_sec_patch_size);
+						unsigned int fw_sec_patch_size,
+						bool verify,
+						struct nrf_wifi_hal_fw_patch_stats *stats);
 
 enum nrf_wifi_status nrf_wifi_hal_fw_patch_boot(struct nrf_wifi_hal_dev_ctx *hal_dev_ctx,
 						enum RPU_PROC_TYPE rpu_proc,
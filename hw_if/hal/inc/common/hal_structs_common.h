@@ -24,6 +24,12 @@
 #if defined(NRF_WIFI_LOW_POWER) || defined(__DOXYGEN__)
 #define RPU_PS_WAKE_INTERVAL_MS 1
 #define RPU_PS_WAKE_TIMEOUT_S 1
+#define RPU_PS_IDLE_TIMEOUT_MIN_MS 2
+#define RPU_PS_IDLE_TIMEOUT_MAX_MS 1000
+#define RPU_PS_IDLE_BREAK_EVEN_MS 10
+#define RPU_PS_IDLE_HIST_BUCKETS 12
+#define RPU_PS_IDLE_HIST_MAX_SAMPLES 256
+#define RPU_PS_IDLE_UPDATE_SAMPLES 16
 #endif /* NRF_WIFI_LOW_POWER */
 
 /**
@@ -99,8 +105,119 @@ enum RPU_PS_STATE {
 	/** Maximum number of power states */
 	RPU_PS_STATE_MAX
 };
+
+/**
+ * @brief Enumeration of the causes of an RPU wake from sleep.
+ */
+enum nrf_wifi_hal_ps_wake_cause {
+	/** RPU access not attributed to any of the other causes */
+	NRF_WIFI_HAL_PS_WAKE_CAUSE_OTHER,
+	/** Data TX */
+	NRF_WIFI_HAL_PS_WAKE_CAUSE_TX,
+	/** Interrupt, event or RX buffer processing */
+	NRF_WIFI_HAL_PS_WAKE_CAUSE_EVENT,
+	/** Control command */
+	NRF_WIFI_HAL_PS_WAKE_CAUSE_CTRL_CMD,
+	/** Register polling */
+	NRF_WIFI_HAL_PS_WAKE_CAUSE_REG_POLL,
+	/** Statistics read */
+	NRF_WIFI_HAL_PS_WAKE_CAUSE_STATS,
+	/** Number of wake causes */
+	NRF_WIFI_HAL_PS_WAKE_CAUSE_MAX
+};
+
+/**
+ * @brief Structure to hold the RPU power state residency and wake statistics.
+ */
+struct nrf_wifi_hal_ps_stats {
+	/** Time (in us) the RPU was kept awake, including the wake latency */
+	unsigned long long awake_us;
+	/** Time (in us) the RPU was allowed to sleep */
+	unsigned long long asleep_us;
+	/** Number of wakes from sleep */
+	unsigned int num_wakes;
+	/** Number of wakes which timed out */
+	unsigned int num_wake_fails;
+	/** Sum of the wake latencies (in us) */
+	unsigned long long wake_latency_total_us;
+	/** Latency (in us) of the last wake */
+	unsigned int wake_latency_last_us;
+	/** Maximum wake latency (in us) */
+	unsigned int wake_latency_max_us;
+	/** Number of wakes per cause, see &enum nrf_wifi_hal_ps_wake_cause */
+	unsigned int wake_causes[NRF_WIFI_HAL_PS_WAKE_CAUSE_MAX];
+	/** Idle timeout (in ms) currently used before putting the RPU to sleep */
+	unsigned int idle_timeout_ms;
+};
+
+/**
+ * @brief Structure to hold the state of the adaptive RPU idle timeout.
+ *
+ * The gaps between RPU accesses are kept in a histogram with power of two
+ * buckets (bucket n holds gaps of 2^n to 2^(n+1) - 1 ms, the last bucket
+ * holds all longer gaps). The counts are halved once the histogram holds
+ * RPU_PS_IDLE_HIST_MAX_SAMPLES gaps, so older traffic fades out.
+ */
+struct nrf_wifi_hal_ps_idle {
+	/** Idle timeout (in ms) currently in use */
+	unsigned int timeout_ms;
+	/** Fixed idle timeout (in ms) overriding the adaptive one, 0 if none */
+	unsigned int override_ms;
+	/** Lower bound (in ms) of the adaptive idle timeout */
+	unsigned int min_ms;
+	/** Upper bound (in ms) of the adaptive idle timeout */
+	unsigned int max_ms;
+	/** Time (in ms) of the last RPU access */
+	unsigned long last_access_ms;
+	/** Histogram of the gaps between RPU accesses */
+	unsigned int hist[RPU_PS_IDLE_HIST_BUCKETS];
+	/** Number of gaps in the histogram */
+	unsigned int num_samples;
+	/** Number of gaps added since the idle timeout was last computed */
+	unsigned int num_new_samples;
+};
 #endif /* NRF_WIFI_LOW_POWER */
 
+#if defined(NRF_WIFI_RPU_RECOVERY)  || defined(__DOXYGEN__)
+/**
+ * @brief Enumeration of the causes of an RPU recovery.
+ */
+enum nrf_wifi_hal_recovery_cause {
+	/** Recovery not attributed to any of the other causes */
+	NRF_WIFI_HAL_RECOVERY_CAUSE_OTHER,
+	/** RPU watchdog interrupt */
+	NRF_WIFI_HAL_RECOVERY_CAUSE_WATCHDOG,
+	/** Command to the RPU timed out */
+	NRF_WIFI_HAL_RECOVERY_CAUSE_CMD_TIMEOUT,
+	/** RPU did not respond on the bus (e.g. wake from sleep failed) */
+	NRF_WIFI_HAL_RECOVERY_CAUSE_BUS_ERROR,
+	/** Number of recovery causes */
+	NRF_WIFI_HAL_RECOVERY_CAUSE_MAX
+};
+
+/**
+ * @brief Structure passed as event data to the RPU recovery callback.
+ */
+struct nrf_wifi_hal_recovery_info {
+	/** Cause of the recovery, see &enum nrf_wifi_hal_recovery_cause */
+	enum nrf_wifi_hal_recovery_cause cause;
+	/** Time (in ms) at which the need for recovery was detected */
+	unsigned long detect_time_ms;
+};
+#endif /* NRF_WIFI_RPU_RECOVERY */
+
+/**
+ * @brief Structure to hold the counters of the accesses to the RPU over the bus.
+ */
+struct nrf_wifi_hal_bus_stats {
+	/** Number of bytes read from the RPU memory and registers */
+	unsigned long long bytes_read;
+	/** Number of bytes written to the RPU memory and registers */
+	unsigned long long bytes_written;
+	/** Number of reads done while polling for the RPU to reach a state */
+	unsigned int num_polls;
+};
+
 /**
  * @brief Enumeration of NRF WiFi HAL status.
  */
@@ -257,6 +374,10 @@ struct nrf_wifi_hal_dev_ctx {
 	int wdt_irq_received;
 	/** Number of watchdog timer interrupts ignored */
 	int wdt_irq_ignored;
+	/** RPU recovery detected but not yet handed over to the callback */
+	bool recovery_pending;
+	/** Cause and detection time of the pending RPU recovery */
+	struct nrf_wifi_hal_recovery_info recovery_info;
 #endif /* NRF_WIFI_RPU_RECOVERY */
 #if defined(NRF_WIFI_LOW_POWER)  || defined(__DOXYGEN__)
 	/** RPU power state */
@@ -271,6 +392,14 @@ struct nrf_wifi_hal_dev_ctx {
 	bool irq_ctx;
 	/** RPU firmware booted flag */
 	bool rpu_fw_booted;
+	/** Cause attributed to the next RPU wake */
+	enum nrf_wifi_hal_ps_wake_cause ps_wake_cause;
+	/** Time (in us) at which the RPU power state last changed */
+	unsigned long ps_state_since_us;
+	/** RPU power state residency and wake statistics */
+	struct nrf_wifi_hal_ps_stats ps_stats;
+	/** Adaptive RPU idle timeout state */
+	struct nrf_wifi_hal_ps_idle ps_idle;
 #endif /* NRF_WIFI_LOW_POWER */
 	/** Event data */
 	char *event_data;
@@ -284,6 +413,8 @@ struct nrf_wifi_hal_dev_ctx {
 	unsigned int event_resubmit;
 	/** HAL status */
 	enum NRF_WIFI_HAL_STATUS hal_status;
+	/** Bus access counters */
+	struct nrf_wifi_hal_bus_stats bus_stats;
 	/** Recovery tasklet */
 	void *recovery_tasklet;
 	/** Recovery lock */
@@ -124,6 +124,18 @@ unsigned long nrf_wifi_sys_hal_buf_map_tx(struct nrf_wifi_hal_dev_ctx *hal_ctx,
 unsigned long nrf_wifi_sys_hal_buf_unmap_tx(struct nrf_wifi_hal_dev_ctx *hal_ctx,
 					    unsigned int desc_id);
 
+/**
+ * @brief Get the size of the TX region of the RPU packet RAM.
+ *
+ * @param hal_ctx     Pointer to the Wi-Fi HAL device context.
+ *
+ * The TX region starts at the base of the packet RAM and ends where the
+ * first RX buffer pool starts.
+ *
+ * @return Size (in bytes) of the TX region of the packet RAM.
+ */
+unsigned int nrf_wifi_sys_hal_tx_pktram_size_get(struct nrf_wifi_hal_dev_ctx *hal_ctx);
+
 #ifdef NRF70_SR_COEX_SLEEP_CTRL_GPIO_CTRL
  /**
  * @brief Configure Sleep control GPIO control for coexistence.
@@ -31,6 +31,146 @@ static void did_rpu_had_sleep_opp(struct nrf_wifi_hal_dev_ctx *hal_dev_ctx)
 }
 #endif /* NRF_WIFI_RPU_RECOVERY */
 
+/* Gap (in ms) taken as representative of a histogram bucket */
+static unsigned int hal_rpu_ps_idle_gap_ms(int bucket)
+{
+	if (bucket == RPU_PS_IDLE_HIST_BUCKETS - 1) {
+		return 2 << bucket;
+	}
+
+	return (1 << bucket) + ((1 << bucket) >> 1);
+}
+
+
+/* Expected cost, in ms of RPU awake time, of using timeout_ms as the idle
+ * timeout for the gaps in the histogram. A gap shorter than the timeout keeps
+ * the RPU awake for the whole gap, a longer one keeps it awake for the timeout
+ * and then pays for a sleep/wake cycle.
+ */
+static unsigned long long hal_rpu_ps_idle_cost(struct nrf_wifi_hal_ps_idle *ps_idle,
+					       unsigned int timeout_ms,
+					       unsigned int wake_cost_ms)
+{
+	unsigned long long cost = 0;
+	unsigned int gap_ms = 0;
+	int i = 0;
+
+	for (i = 0; i < RPU_PS_IDLE_HIST_BUCKETS; i++) {
+		gap_ms = hal_rpu_ps_idle_gap_ms(i);
+
+		if (gap_ms <= timeout_ms) {
+			cost += (unsigned long long)ps_idle->hist[i] * gap_ms;
+		} else {
+			cost += (unsigned long long)ps_idle->hist[i] *
+				(timeout_ms + wake_cost_ms);
+		}
+	}
+
+	return cost;
+}
+
+
+static unsigned int hal_rpu_ps_idle_timeout_calc(struct nrf_wifi_hal_dev_ctx *hal_dev_ctx)
+{
+	struct nrf_wifi_hal_ps_idle *ps_idle = NULL;
+	struct nrf_wifi_hal_ps_stats *ps_stats = NULL;
+	unsigned long long cost = 0;
+	unsigned long long best_cost = 0;
+	unsigned int best_timeout_ms = 0;
+	unsigned int timeout_ms = 0;
+	unsigned int wake_cost_ms = 0;
+	int i = 0;
+
+	ps_idle = &hal_dev_ctx->ps_idle;
+	ps_stats = &hal_dev_ctx->ps_stats;
+
+	wake_cost_ms = RPU_PS_IDLE_BREAK_EVEN_MS;
+
+	if (ps_stats->num_wakes) {
+		wake_cost_ms += (ps_stats->wake_latency_total_us /
+				 ps_stats->num_wakes) / 1000;
+	}
+
+	best_timeout_ms = ps_idle->min_ms;
+	best_cost = hal_rpu_ps_idle_cost(ps_idle,
+					 best_timeout_ms,
+					 wake_cost_ms);
+
+	/* The cost only drops when the timeout reaches the gap of a bucket and
+	 * grows in between, so only the bounds and the bucket gaps in between
+	 * need to be tried. Ties go to the shorter timeout.
+	 */
+	for (i = 0; i <= RPU_PS_IDLE_HIST_BUCKETS; i++) {
+		if (i == RPU_PS_IDLE_HIST_BUCKETS) {
+			timeout_ms = ps_idle->max_ms;
+		} else {
+			timeout_ms = hal_rpu_ps_idle_gap_ms(i);
+
+			if ((timeout_ms <= ps_idle->min_ms) ||
+			    (timeout_ms >= ps_idle->max_ms)) {
+				continue;
+			}
+		}
+
+		cost = hal_rpu_ps_idle_cost(ps_idle,
+					    timeout_ms,
+					    wake_cost_ms);
+
+		if (cost < best_cost) {
+			best_cost = cost;
+			best_timeout_ms = timeout_ms;
+		}
+	}
+
+	return best_timeout_ms;
+}
+
+
+/* Called with rpu_ps_lock held on every RPU access */
+static void hal_rpu_ps_idle_update(struct nrf_wifi_hal_dev_ctx *hal_dev_ctx)
+{
+	struct nrf_wifi_hal_ps_idle *ps_idle = NULL;
+	unsigned long gap_ms = 0;
+	int bucket = 0;
+	int i = 0;
+
+	ps_idle = &hal_dev_ctx->ps_idle;
+
+	gap_ms = nrf_wifi_osal_time_elapsed_ms(ps_idle->last_access_ms);
+	ps_idle->last_access_ms = nrf_wifi_osal_time_get_curr_ms();
+
+	/* Accesses within the same ms belong to the same burst */
+	if (!gap_ms) {
+		return;
+	}
+
+	while ((bucket < RPU_PS_IDLE_HIST_BUCKETS - 1) &&
+	       (gap_ms >> (bucket + 1))) {
+		bucket++;
+	}
+
+	ps_idle->hist[bucket]++;
+	ps_idle->num_samples++;
+	ps_idle->num_new_samples++;
+
+	if (ps_idle->num_samples >= RPU_PS_IDLE_HIST_MAX_SAMPLES) {
+		ps_idle->num_samples = 0;
+
+		for (i = 0; i < RPU_PS_IDLE_HIST_BUCKETS; i++) {
+			ps_idle->hist[i] >>= 1;
+			ps_idle->num_samples += ps_idle->hist[i];
+		}
+	}
+
+	if (ps_idle->override_ms ||
+	    (ps_idle->num_new_samples < RPU_PS_IDLE_UPDATE_SAMPLES)) {
+		return;
+	}
+
+	ps_idle->num_new_samples = 0;
+	ps_idle->timeout_ms = hal_rpu_ps_idle_timeout_calc(hal_dev_ctx);
+}
+
 enum nrf_wifi_status hal_rpu_ps_wake(struct nrf_wifi_hal_dev_ctx *hal_dev_ctx)
 {
 	unsigned int reg_val = 0;
@@ -40,6 +180,10 @@ enum nrf_wifi_status hal_rpu_ps_wake(struct nrf_wifi_hal_dev_ctx *hal_dev_ctx)
 	unsigned long idle_time_us = 0;
 	unsigned long elapsed_time_sec = 0;
 	unsigned long elapsed_time_usec = 0;
+	unsigned long wake_start_us = 0;
+	unsigned int latency_us = 0;
+	enum nrf_wifi_hal_ps_wake_cause cause = NRF_WIFI_HAL_PS_WAKE_CAUSE_OTHER;
+	struct nrf_wifi_hal_ps_stats *ps_stats = NULL;
 	enum nrf_wifi_status status = NRF_WIFI_STATUS_FAIL;
 
 	if (!hal_dev_ctx) {
@@ -48,6 +192,10 @@ enum nrf_wifi_status hal_rpu_ps_wake(struct nrf_wifi_hal_dev_ctx *hal_dev_ctx)
 		return status;
 	}
 
+	/* The cause is consumed by the first RPU access after it was set */
+	cause = hal_dev_ctx->ps_wake_cause;
+	hal_dev_ctx->ps_wake_cause = NRF_WIFI_HAL_PS_WAKE_CAUSE_OTHER;
+	ps_stats = &hal_dev_ctx->ps_stats;
 
 	/* If the FW is not yet booted up (e.g. during the FW load stage of Host FW load)
 	 * then skip the RPU wake attempt since RPU sleep/wake kicks in only after FW boot
@@ -61,6 +209,8 @@ enum nrf_wifi_status hal_rpu_ps_wake(struct nrf_wifi_hal_dev_ctx *hal_dev_ctx)
 		goto out;
 	}
 
+	wake_start_us = nrf_wifi_osal_time_get_curr_us();
+
 	nrf_wifi_bal_rpu_ps_wake(hal_dev_ctx->bal_dev_ctx);
 #ifdef NRF_WIFI_RPU_RECOVERY
 	hal_dev_ctx->is_wakeup_now_asserted = true;
@@ -79,6 +229,7 @@ enum nrf_wifi_status hal_rpu_ps_wake(struct nrf_wifi_hal_dev_ctx *hal_dev_ctx)
 	do {
 		/* Poll the RPU PS state */
 		reg_val = nrf_wifi_bal_rpu_ps_status(hal_dev_ctx->bal_dev_ctx);
+		hal_dev_ctx->bus_stats.num_polls++;
 
 		if ((reg_val & rpu_ps_state_mask) == rpu_ps_state_mask) {
 			status = NRF_WIFI_STATUS_SUCCESS;
@@ -102,12 +253,28 @@ enum nrf_wifi_status hal_rpu_ps_wake(struct nrf_wifi_hal_dev_ctx *hal_dev_ctx)
 				      RPU_PS_WAKE_TIMEOUT_S,
 				      reg_val,
 				      rpu_ps_state_mask);
+		ps_stats->num_wake_fails++;
 #ifdef NRF_WIFI_RPU_RECOVERY
+		hal_rpu_recovery_note(hal_dev_ctx,
+				      NRF_WIFI_HAL_RECOVERY_CAUSE_BUS_ERROR);
 		nrf_wifi_osal_tasklet_schedule(hal_dev_ctx->recovery_tasklet);
 #endif /* NRF_WIFI_RPU_RECOVERY */
 		goto out;
 	}
 	hal_dev_ctx->rpu_ps_state = RPU_PS_STATE_AWAKE;
+
+	latency_us = nrf_wifi_osal_time_elapsed_us(wake_start_us);
+
+	ps_stats->asleep_us += wake_start_us - hal_dev_ctx->ps_state_since_us;
+	hal_dev_ctx->ps_state_since_us = wake_start_us;
+	ps_stats->num_wakes++;
+	ps_stats->wake_causes[cause]++;
+	ps_stats->wake_latency_total_us += latency_us;
+	ps_stats->wake_latency_last_us = latency_us;
+
+	if (latency_us > ps_stats->wake_latency_max_us) {
+		ps_stats->wake_latency_max_us = latency_us;
+	}
 #ifdef NRF_WIFI_RPU_RECOVERY
 	did_rpu_had_sleep_opp(hal_dev_ctx);
 #endif /* NRF_WIFI_RPU_RECOVERY */
@@ -117,9 +284,10 @@ enum nrf_wifi_status hal_rpu_ps_wake(struct nrf_wifi_hal_dev_ctx *hal_dev_ctx)
 #endif /* NRF_WIFI_RPU_RECOVERY_PS_STATE_DEBUG */
 
 out:
+	hal_rpu_ps_idle_update(hal_dev_ctx);
 
 	nrf_wifi_osal_timer_schedule(hal_dev_ctx->rpu_ps_timer,
-		NRF70_RPU_PS_IDLE_TIMEOUT_MS);
+		hal_dev_ctx->ps_idle.timeout_ms);
 	return status;
 }
 
@@ -135,6 +303,12 @@ static void hal_rpu_ps_sleep(unsigned long data)
 					&flags);
 
 	nrf_wifi_bal_rpu_ps_sleep(hal_dev_ctx->bal_dev_ctx);
+
+	if (hal_dev_ctx->rpu_ps_state == RPU_PS_STATE_AWAKE) {
+		hal_dev_ctx->ps_stats.awake_us +=
+			nrf_wifi_osal_time_elapsed_us(hal_dev_ctx->ps_state_since_us);
+		hal_dev_ctx->ps_state_since_us = nrf_wifi_osal_time_get_curr_us();
+	}
 #ifdef NRF_WIFI_RPU_RECOVERY
 	hal_dev_ctx->is_wakeup_now_asserted = false;
 	hal_dev_ctx->last_wakeup_now_deasserted_time_ms =
@@ -179,6 +353,11 @@ enum nrf_wifi_status hal_rpu_ps_init(struct nrf_wifi_hal_dev_ctx *hal_dev_ctx)
 				 (unsigned long)hal_dev_ctx);
 
 	hal_dev_ctx->rpu_ps_state = RPU_PS_STATE_ASLEEP;
+	hal_dev_ctx->ps_state_since_us = nrf_wifi_osal_time_get_curr_us();
+	hal_dev_ctx->ps_idle.timeout_ms = NRF70_RPU_PS_IDLE_TIMEOUT_MS;
+	hal_dev_ctx->ps_idle.min_ms = RPU_PS_IDLE_TIMEOUT_MIN_MS;
+	hal_dev_ctx->ps_idle.max_ms = RPU_PS_IDLE_TIMEOUT_MAX_MS;
+	hal_dev_ctx->ps_idle.last_access_ms = nrf_wifi_osal_time_get_curr_ms();
 	hal_dev_ctx->dbg_enable = true;
 
 	status = NRF_WIFI_STATUS_SUCCESS;
@@ -214,8 +393,231 @@ enum nrf_wifi_status nrf_wifi_hal_get_rpu_ps_state(
 out:
 	return status;
 }
+
+
+void nrf_wifi_hal_ps_wake_cause_set(struct nrf_wifi_hal_dev_ctx *hal_dev_ctx,
+				    enum nrf_wifi_hal_ps_wake_cause cause)
+{
+	unsigned long flags = 0;
+
+	/* Consumed by the RPU wake path, which runs with rpu_ps_lock held */
+	nrf_wifi_osal_spinlock_irq_take(hal_dev_ctx->rpu_ps_lock,
+					&flags);
+
+	/* The most specific cause is set first, by the outermost caller */
+	if (hal_dev_ctx->ps_wake_cause == NRF_WIFI_HAL_PS_WAKE_CAUSE_OTHER) {
+		hal_dev_ctx->ps_wake_cause = cause;
+	}
+
+	nrf_wifi_osal_spinlock_irq_rel(hal_dev_ctx->rpu_ps_lock,
+				       &flags);
+}
+
+
+enum nrf_wifi_status nrf_wifi_hal_ps_stats_get(struct nrf_wifi_hal_dev_ctx *hal_dev_ctx,
+					       struct nrf_wifi_hal_ps_stats *ps_stats)
+{
+	enum nrf_wifi_status status = NRF_WIFI_STATUS_FAIL;
+	unsigned long curr_state_us = 0;
+	unsigned long flags = 0;
+
+	if (!hal_dev_ctx || !ps_stats) {
+		nrf_wifi_osal_log_err("%s: Invalid parameters",
+				      __func__);
+		goto out;
+	}
+
+	nrf_wifi_osal_spinlock_irq_take(hal_dev_ctx->rpu_ps_lock,
+					&flags);
+
+	nrf_wifi_osal_mem_cpy(ps_stats,
+			      &hal_dev_ctx->ps_stats,
+			      sizeof(*ps_stats));
+
+	/* Account for the time spent in the current state so far */
+	curr_state_us = nrf_wifi_osal_time_elapsed_us(hal_dev_ctx->ps_state_since_us);
+
+	if (hal_dev_ctx->rpu_ps_state == RPU_PS_STATE_AWAKE) {
+		ps_stats->awake_us += curr_state_us;
+	} else {
+		ps_stats->asleep_us += curr_state_us;
+	}
+
+	ps_stats->idle_timeout_ms = hal_dev_ctx->ps_idle.timeout_ms;
+
+	nrf_wifi_osal_spinlock_irq_rel(hal_dev_ctx->rpu_ps_lock,
+				       &flags);
+
+	status = NRF_WIFI_STATUS_SUCCESS;
+out:
+	return status;
+}
+
+
+enum nrf_wifi_status nrf_wifi_hal_ps_stats_reset(struct nrf_wifi_hal_dev_ctx *hal_dev_ctx)
+{
+	enum nrf_wifi_status status = NRF_WIFI_STATUS_FAIL;
+	unsigned long flags = 0;
+
+	if (!hal_dev_ctx) {
+		nrf_wifi_osal_log_err("%s: Invalid parameters",
+				      __func__);
+		goto out;
+	}
+
+	nrf_wifi_osal_spinlock_irq_take(hal_dev_ctx->rpu_ps_lock,
+					&flags);
+
+	nrf_wifi_osal_mem_set(&hal_dev_ctx->ps_stats,
+			      0,
+			      sizeof(hal_dev_ctx->ps_stats));
+	hal_dev_ctx->ps_state_since_us = nrf_wifi_osal_time_get_curr_us();
+
+	nrf_wifi_osal_spinlock_irq_rel(hal_dev_ctx->rpu_ps_lock,
+				       &flags);
+
+	status = NRF_WIFI_STATUS_SUCCESS;
+out:
+	return status;
+}
+
+
+enum nrf_wifi_status nrf_wifi_hal_ps_idle_timeout_bounds_set(struct nrf_wifi_hal_dev_ctx *hal_dev_ctx,
+							     unsigned int min_ms,
+							     unsigned int max_ms)
+{
+	enum nrf_wifi_status status = NRF_WIFI_STATUS_FAIL;
+	struct nrf_wifi_hal_ps_idle *ps_idle = NULL;
+	unsigned long flags = 0;
+
+	if (!hal_dev_ctx || !min_ms || (min_ms > max_ms)) {
+		nrf_wifi_osal_log_err("%s: Invalid parameters",
+				      __func__);
+		goto out;
+	}
+
+	ps_idle = &hal_dev_ctx->ps_idle;
+
+	nrf_wifi_osal_spinlock_irq_take(hal_dev_ctx->rpu_ps_lock,
+					&flags);
+
+	ps_idle->min_ms = min_ms;
+	ps_idle->max_ms = max_ms;
+
+	if (!ps_idle->override_ms) {
+		if (ps_idle->num_samples) {
+			ps_idle->timeout_ms = hal_rpu_ps_idle_timeout_calc(hal_dev_ctx);
+		} else if (ps_idle->timeout_ms < min_ms) {
+			ps_idle->timeout_ms = min_ms;
+		} else if (ps_idle->timeout_ms > max_ms) {
+			ps_idle->timeout_ms = max_ms;
+		}
+	}
+
+	nrf_wifi_osal_spinlock_irq_rel(hal_dev_ctx->rpu_ps_lock,
+				       &flags);
+
+	status = NRF_WIFI_STATUS_SUCCESS;
+out:
+	return status;
+}
+
+
+enum nrf_wifi_status nrf_wifi_hal_ps_idle_timeout_override(struct nrf_wifi_hal_dev_ctx *hal_dev_ctx,
+							   unsigned int timeout_ms)
+{
+	enum nrf_wifi_status status = NRF_WIFI_STATUS_FAIL;
+	struct nrf_wifi_hal_ps_idle *ps_idle = NULL;
+	unsigned long flags = 0;
+
+	if (!hal_dev_ctx) {
+		nrf_wifi_osal_log_err("%s: Invalid parameters",
+				      __func__);
+		goto out;
+	}
+
+	ps_idle = &hal_dev_ctx->ps_idle;
+
+	nrf_wifi_osal_spinlock_irq_take(hal_dev_ctx->rpu_ps_lock,
+					&flags);
+
+	ps_idle->override_ms = timeout_ms;
+
+	if (timeout_ms) {
+		ps_idle->timeout_ms = timeout_ms;
+	} else if (ps_idle->num_samples) {
+		/* The gaps keep being learnt while overridden */
+		ps_idle->timeout_ms = hal_rpu_ps_idle_timeout_calc(hal_dev_ctx);
+	} else {
+		ps_idle->timeout_ms = NRF70_RPU_PS_IDLE_TIMEOUT_MS;
+	}
+
+	nrf_wifi_osal_spinlock_irq_rel(hal_dev_ctx->rpu_ps_lock,
+				       &flags);
+
+	status = NRF_WIFI_STATUS_SUCCESS;
+out:
+	return status;
+}
 #endif /* NRF_WIFI_LOW_POWER */
 
+#ifdef NRF_WIFI_RPU_RECOVERY
+void hal_rpu_recovery_note(struct nrf_wifi_hal_dev_ctx *hal_dev_ctx,
+			   enum nrf_wifi_hal_recovery_cause cause)
+{
+	/* Only the first detection counts until the recovery is handled */
+	if (hal_dev_ctx->recovery_pending) {
+		return;
+	}
+
+	hal_dev_ctx->recovery_info.cause = cause;
+	hal_dev_ctx->recovery_info.detect_time_ms = nrf_wifi_osal_time_get_curr_ms();
+	hal_dev_ctx->recovery_pending = true;
+}
+
+
+enum nrf_wifi_status nrf_wifi_hal_rpu_recovery_request(struct nrf_wifi_hal_dev_ctx *hal_dev_ctx,
+						       enum nrf_wifi_hal_recovery_cause cause)
+{
+	enum nrf_wifi_status status = NRF_WIFI_STATUS_FAIL;
+
+	if (!hal_dev_ctx || cause >= NRF_WIFI_HAL_RECOVERY_CAUSE_MAX) {
+		nrf_wifi_osal_log_err("%s: Invalid parameters",
+				      __func__);
+		goto out;
+	}
+
+	hal_rpu_recovery_note(hal_dev_ctx, cause);
+
+	nrf_wifi_osal_tasklet_schedule(hal_dev_ctx->recovery_tasklet);
+
+	status = NRF_WIFI_STATUS_SUCCESS;
+out:
+	return status;
+}
+#endif /* NRF_WIFI_RPU_RECOVERY */
+
+
+enum nrf_wifi_status nrf_wifi_hal_bus_stats_get(struct nrf_wifi_hal_dev_ctx *hal_dev_ctx,
+						struct nrf_wifi_hal_bus_stats *stats)
+{
+	enum nrf_wifi_status status = NRF_WIFI_STATUS_FAIL;
+
+	if (!hal_dev_ctx || !stats) {
+		nrf_wifi_osal_log_err("%s: Invalid parameters",
+				      __func__);
+		goto out;
+	}
+
+	nrf_wifi_osal_mem_cpy(stats,
+			      &hal_dev_ctx->bus_stats,
+			      sizeof(*stats));
+
+	status = NRF_WIFI_STATUS_SUCCESS;
+out:
+	return status;
+}
+
 
 static bool hal_rpu_hpq_is_empty(struct nrf_wifi_hal_dev_ctx *hal_dev_ctx,
 				 struct host_rpu_hpq *hpq)
@@ -588,6 +990,10 @@ enum nrf_wifi_status nrf_wifi_hal_ctrl_cmd_send(struct nrf_wifi_hal_dev_ctx *hal
 			     __func__,
 			     __builtin_return_address(0));
 #endif
+#ifdef NRF_WIFI_LOW_POWER
+	nrf_wifi_hal_ps_wake_cause_set(hal_dev_ctx,
+				       NRF_WIFI_HAL_PS_WAKE_CAUSE_CTRL_CMD);
+#endif /* NRF_WIFI_LOW_POWER */
 	nrf_wifi_osal_spinlock_take(hal_dev_ctx->lock_hal);
 
 	status = hal_rpu_cmd_queue(hal_dev_ctx,
@@ -793,7 +1199,10 @@ enum nrf_wifi_status nrf_wifi_hal_irq_handler(void *data)
 		goto out;
 	}
 
-
+#ifdef NRF_WIFI_LOW_POWER
+	nrf_wifi_hal_ps_wake_cause_set(hal_dev_ctx,
+				       NRF_WIFI_HAL_PS_WAKE_CAUSE_EVENT);
+#endif /* NRF_WIFI_LOW_POWER */
 	status = hal_rpu_irq_process(hal_dev_ctx, &do_rpu_recovery);
 
 	if (status != NRF_WIFI_STATUS_SUCCESS) {
@@ -825,9 +1234,14 @@ static int nrf_wifi_hal_poll_reg(struct nrf_wifi_hal_dev_ctx *hal_dev_ctx,
 	unsigned int count = 50;
 
 	do {
+#ifdef NRF_WIFI_LOW_POWER
+		nrf_wifi_hal_ps_wake_cause_set(hal_dev_ctx,
+					       NRF_WIFI_HAL_PS_WAKE_CAUSE_REG_POLL);
+#endif /* NRF_WIFI_LOW_POWER */
 		status = hal_rpu_reg_read(hal_dev_ctx,
 					  &val,
 					  reg_addr);
+		hal_dev_ctx->bus_stats.num_polls++;
 
 		if (status != NRF_WIFI_STATUS_SUCCESS) {
 			nrf_wifi_osal_log_err("%s: Read from address (0x%X) failed, val (0x%X)",
@@ -964,6 +1378,7 @@ enum nrf_wifi_status nrf_wifi_hal_fw_chk_boot(struct nrf_wifi_hal_dev_ctx *hal_d
 					  (unsigned char *)&val,
 					  addr,
 					  sizeof(val));
+		hal_dev_ctx->bus_stats.num_polls++;
 
 		if (status != NRF_WIFI_STATUS_SUCCESS) {
 			nrf_wifi_osal_log_err("%s: Reading of boot signature failed for RPU(%d)",
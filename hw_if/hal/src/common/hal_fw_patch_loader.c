@@ -84,7 +84,9 @@ static enum nrf_wifi_status hal_fw_patch_load(struct nrf_wifi_hal_dev_ctx *hal_d
 						const char *patch_id_str,
 						unsigned int dest_addr,
 						const void *fw_patch_data,
-						unsigned int fw_patch_size)
+						unsigned int fw_patch_size,
+						bool verify,
+						struct nrf_wifi_hal_fw_patch_stats *stats)
 {
 	enum nrf_wifi_status status = NRF_WIFI_STATUS_FAIL;
 	int last_chunk_size = fw_patch_size % MAX_PATCH_CHUNK_SIZE;
@@ -114,6 +116,34 @@ static enum nrf_wifi_status hal_fw_patch_load(struct nrf_wifi_hal_dev_ctx *hal_d
 			goto out;
 		}
 
+		if (verify) {
+			/* The previous chunk write resets the context to LMAC */
+			hal_dev_ctx->curr_proc = rpu_proc;
+
+			status = hal_rpu_mem_read(hal_dev_ctx,
+						  patch_data_ram,
+						  dest_chunk_offset,
+						  patch_chunk_size);
+
+			if (status == NRF_WIFI_STATUS_SUCCESS) {
+				stats->bytes_verified += patch_chunk_size;
+
+				if (!nrf_wifi_osal_mem_cmp(patch_data_ram,
+							   src_patch_offset,
+							   patch_chunk_size)) {
+					stats->bytes_skipped += patch_chunk_size;
+					goto out;
+				}
+			}
+
+			/* The RPU memory was not retained, reading back the
+			 * rest of the patch would only double the transfer.
+			 */
+			if (chunk == 0) {
+				verify = false;
+			}
+		}
+
 		nrf_wifi_osal_mem_cpy(patch_data_ram,
 				      src_patch_offset,
 				      patch_chunk_size);
@@ -142,7 +172,12 @@ static enum nrf_wifi_status hal_fw_patch_load(struct nrf_wifi_hal_dev_ctx *hal_d
 					      patch_chunk_size);
 			goto out;
 		}
+
+		stats->bytes_written += patch_chunk_size;
 out:
+		/* A skipped or failed verify leaves the patch context set */
+		hal_dev_ctx->curr_proc = RPU_PROC_TYPE_MCU_LMAC;
+
 		if (patch_data_ram)
 			nrf_wifi_osal_mem_free(patch_data_ram);
 		if (status != NRF_WIFI_STATUS_SUCCESS)
@@ -160,7 +195,9 @@ enum nrf_wifi_status nrf_wifi_hal_fw_patch_load(struct nrf_wifi_hal_dev_ctx *hal
 						const void *fw_pri_patch_data,
 						unsigned int fw_pri_patch_size,
 						const void *fw_sec_patch_data,
-						unsigned int fw_sec_patch_size)
+						unsigned int fw_sec_patch_size,
+						bool verify,
+						struct nrf_wifi_hal_fw_patch_stats *stats)
 {
 	enum nrf_wifi_status status = NRF_WIFI_STATUS_FAIL;
 	unsigned int pri_dest_addr = 0;
@@ -183,6 +220,12 @@ enum nrf_wifi_status nrf_wifi_hal_fw_patch_load(struct nrf_wifi_hal_dev_ctx *hal
 		goto out;
 	}
 
+	if (!stats) {
+		nrf_wifi_osal_log_err("%s: Invalid parameters",
+				      __func__);
+		goto out;
+	}
+
 	/* Set the HAL RPU context to the current required context */
 	hal_dev_ctx->curr_proc = rpu_proc;
 
@@ -218,7 +261,9 @@ enum nrf_wifi_status nrf_wifi_hal_fw_patch_load(struct nrf_wifi_hal_dev_ctx *hal
 						patches[patch].id_str,
 						patches[patch].dest_addr,
 						patches[patch].data,
-						patches[patch].size);
+						patches[patch].size,
+						verify,
+						stats);
 			if (status != NRF_WIFI_STATUS_SUCCESS)
 				goto out;
 		}
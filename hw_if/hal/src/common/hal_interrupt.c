@@ -531,6 +531,9 @@ static enum nrf_wifi_status hal_rpu_process_wdog(struct nrf_wifi_hal_dev_ctx *ha
 	}
 
 	rpu_recovery = true;
+
+	hal_rpu_recovery_note(hal_dev_ctx,
+			      NRF_WIFI_HAL_RECOVERY_CAUSE_WATCHDOG);
 #endif /* NRF_WIFI_RPU_RECOVERY */
 
 	if (!rpu_recovery) {
@@ -111,6 +111,7 @@ static enum nrf_wifi_status rpu_mem_read_ram(struct nrf_wifi_hal_dev_ctx *hal_de
 				src_addr,
 				addr_offset,
 				len);
+	hal_dev_ctx->bus_stats.bytes_read += len;
 
 	status = NRF_WIFI_STATUS_SUCCESS;
 
@@ -162,6 +163,7 @@ static enum nrf_wifi_status rpu_mem_write_ram(struct nrf_wifi_hal_dev_ctx *hal_d
 				 addr_offset,
 				 src_addr,
 				 len);
+	hal_dev_ctx->bus_stats.bytes_written += len;
 
 	status = NRF_WIFI_STATUS_SUCCESS;
 
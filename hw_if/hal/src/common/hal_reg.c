@@ -76,6 +76,7 @@ enum nrf_wifi_status hal_rpu_reg_read(struct nrf_wifi_hal_dev_ctx *hal_dev_ctx,
 
 	*val = nrf_wifi_bal_read_word(hal_dev_ctx->bal_dev_ctx,
 				      addr_offset);
+	hal_dev_ctx->bus_stats.bytes_read += sizeof(*val);
 
 	if (*val == 0xFFFFFFFF) {
 		nrf_wifi_osal_log_err("%s: Error !! Value read at addr_offset = %lx is = %X",
@@ -144,6 +145,7 @@ enum nrf_wifi_status hal_rpu_reg_write(struct nrf_wifi_hal_dev_ctx *hal_dev_ctx,
 	nrf_wifi_bal_write_word(hal_dev_ctx->bal_dev_ctx,
 				addr_offset,
 				val);
+	hal_dev_ctx->bus_stats.bytes_written += sizeof(val);
 
 	status = NRF_WIFI_STATUS_SUCCESS;
 
@@ -52,6 +52,9 @@ out:
 static enum nrf_wifi_status hal_rpu_recovery(struct nrf_wifi_hal_dev_ctx *hal_dev_ctx)
 {
 	enum nrf_wifi_status status = NRF_WIFI_STATUS_FAIL;
+#ifdef NRF_WIFI_RPU_RECOVERY
+	struct nrf_wifi_hal_recovery_info info;
+#endif /* NRF_WIFI_RPU_RECOVERY */
 
 	if (!hal_dev_ctx->hpriv->rpu_recovery_callbk_fn) {
 		nrf_wifi_osal_log_dbg("%s: RPU recovery callback not registered",
@@ -59,7 +62,20 @@ static enum nrf_wifi_status hal_rpu_recovery(struct nrf_wifi_hal_dev_ctx *hal_de
 		goto out;
 	}
 
+#ifdef NRF_WIFI_RPU_RECOVERY
+	/* Does nothing if the cause was already noted on detection */
+	hal_rpu_recovery_note(hal_dev_ctx,
+			      NRF_WIFI_HAL_RECOVERY_CAUSE_OTHER);
+
+	info = hal_dev_ctx->recovery_info;
+	hal_dev_ctx->recovery_pending = false;
+
+	status = hal_dev_ctx->hpriv->rpu_recovery_callbk_fn(hal_dev_ctx->mac_dev_ctx,
+							    &info,
+							    sizeof(info));
+#else
 	status = hal_dev_ctx->hpriv->rpu_recovery_callbk_fn(hal_dev_ctx->mac_dev_ctx, NULL, 0);
+#endif /* NRF_WIFI_RPU_RECOVERY */
 	if (status != NRF_WIFI_STATUS_SUCCESS) {
 		nrf_wifi_osal_log_err("%s: RPU recovery failed",
 				      __func__);
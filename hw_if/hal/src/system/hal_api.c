@@ -71,6 +71,10 @@ static void event_tasklet_fn(unsigned long data)
 		goto out;
 	}
 
+#ifdef NRF_WIFI_LOW_POWER
+	nrf_wifi_hal_ps_wake_cause_set(hal_dev_ctx,
+				       NRF_WIFI_HAL_PS_WAKE_CAUSE_EVENT);
+#endif /* NRF_WIFI_LOW_POWER */
 	status = hal_rpu_eventq_process(hal_dev_ctx);
 
 	if (status != NRF_WIFI_STATUS_SUCCESS) {
@@ -87,6 +91,9 @@ out:
 static enum nrf_wifi_status hal_rpu_recovery(struct nrf_wifi_hal_dev_ctx *hal_dev_ctx)
 {
 	enum nrf_wifi_status status = NRF_WIFI_STATUS_FAIL;
+#ifdef NRF_WIFI_RPU_RECOVERY
+	struct nrf_wifi_hal_recovery_info info;
+#endif /* NRF_WIFI_RPU_RECOVERY */
 
 	if (!hal_dev_ctx->hpriv->rpu_recovery_callbk_fn) {
 		nrf_wifi_osal_log_dbg("%s: RPU recovery callback not registered",
@@ -94,7 +101,20 @@ static enum nrf_wifi_status hal_rpu_recovery(struct nrf_wifi_hal_dev_ctx *hal_de
 		goto out;
 	}
 
+#ifdef NRF_WIFI_RPU_RECOVERY
+	/* Does nothing if the cause was already noted on detection */
+	hal_rpu_recovery_note(hal_dev_ctx,
+			      NRF_WIFI_HAL_RECOVERY_CAUSE_OTHER);
+
+	info = hal_dev_ctx->recovery_info;
+	hal_dev_ctx->recovery_pending = false;
+
+	status = hal_dev_ctx->hpriv->rpu_recovery_callbk_fn(hal_dev_ctx->mac_dev_ctx,
+							    &info,
+							    sizeof(info));
+#else
 	status = hal_dev_ctx->hpriv->rpu_recovery_callbk_fn(hal_dev_ctx->mac_dev_ctx, NULL, 0);
+#endif /* NRF_WIFI_RPU_RECOVERY */
 	if (status != NRF_WIFI_STATUS_SUCCESS) {
 		nrf_wifi_osal_log_err("%s: RPU recovery failed",
 				      __func__);
@@ -166,6 +186,10 @@ unsigned long nrf_wifi_sys_hal_buf_map_rx(struct nrf_wifi_hal_dev_ctx *hal_dev_c
 
 	rpu_addr = RPU_MEM_PKT_BASE + (bounce_buf_addr - hal_dev_ctx->addr_rpu_pktram_base);
 
+#ifdef NRF_WIFI_LOW_POWER
+	nrf_wifi_hal_ps_wake_cause_set(hal_dev_ctx,
+				       NRF_WIFI_HAL_PS_WAKE_CAUSE_EVENT);
+#endif /* NRF_WIFI_LOW_POWER */
 	hal_rpu_mem_write(hal_dev_ctx,
 			  (unsigned int)rpu_addr,
 			  (void *)buf,
@@ -242,6 +266,13 @@ out:
 }
 
 
+unsigned int nrf_wifi_sys_hal_tx_pktram_size_get(struct nrf_wifi_hal_dev_ctx *hal_dev_ctx)
+{
+	return hal_dev_ctx->addr_rpu_pktram_base_rx_pool[0] -
+		hal_dev_ctx->addr_rpu_pktram_base_tx;
+}
+
+
 unsigned long nrf_wifi_sys_hal_buf_map_tx(struct nrf_wifi_hal_dev_ctx *hal_dev_ctx,
 					  unsigned long buf,
 					  unsigned int buf_len,
@@ -297,6 +328,10 @@ unsigned long nrf_wifi_sys_hal_buf_map_tx(struct nrf_wifi_hal_dev_ctx *hal_dev_c
 	       buf_len,
 	       hal_dev_ctx->tx_frame_offset);
 
+#ifdef NRF_WIFI_LOW_POWER
+	nrf_wifi_hal_ps_wake_cause_set(hal_dev_ctx,
+				       NRF_WIFI_HAL_PS_WAKE_CAUSE_TX);
+#endif /* NRF_WIFI_LOW_POWER */
 	hal_rpu_mem_write(hal_dev_ctx,
 			  (unsigned int)rpu_addr,
 			  (void *)buf,
@@ -397,6 +432,12 @@ enum nrf_wifi_status nrf_wifi_sys_hal_data_cmd_send(struct nrf_wifi_hal_dev_ctx
 		host_addr |= RPU_MCU_CORE_INDIRECT_BASE;
 	}
 
+#ifdef NRF_WIFI_LOW_POWER
+	nrf_wifi_hal_ps_wake_cause_set(hal_dev_ctx,
+				       (cmd_type == NRF_WIFI_HAL_MSG_TYPE_CMD_DATA_TX) ?
+				       NRF_WIFI_HAL_PS_WAKE_CAUSE_TX :
+				       NRF_WIFI_HAL_PS_WAKE_CAUSE_EVENT);
+#endif /* NRF_WIFI_LOW_POWER */
 	/* Copy the information to the suggested address */
 	status = hal_rpu_mem_write(hal_dev_ctx,
 				   host_addr,
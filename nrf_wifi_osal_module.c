@@ -24,6 +24,10 @@ EXPORT_SYMBOL_GPL(nrf_wifi_sys_fmac_add_vif);
 EXPORT_SYMBOL_GPL(nrf_wifi_sys_fmac_assoc);
 EXPORT_SYMBOL_GPL(nrf_wifi_sys_fmac_mgmt_tx);
 EXPORT_SYMBOL_GPL(nrf_wifi_fmac_fw_load);
+EXPORT_SYMBOL_GPL(nrf_wifi_fmac_fw_cache_verify_set);
+EXPORT_SYMBOL_GPL(nrf_wifi_fmac_fw_cache_invalidate);
+EXPORT_SYMBOL_GPL(nrf_wifi_fmac_fw_cache_stats_get);
+EXPORT_SYMBOL_GPL(nrf_wifi_fmac_boot_timeline_get);
 EXPORT_SYMBOL_GPL(nrf_wifi_sys_fmac_chg_sta);
 EXPORT_SYMBOL_GPL(nrf_wifi_osal_bus_pcie_dev_dma_unmap);
 EXPORT_SYMBOL_GPL(nrf_wifi_sys_fmac_get_tx_power);
@@ -78,6 +82,59 @@ EXPORT_SYMBOL_GPL(nrf_wifi_sys_fmac_del_vif);
 EXPORT_SYMBOL_GPL(nrf_wifi_osal_log_err);
 EXPORT_SYMBOL_GPL(nrf_wifi_sys_fmac_disassoc);
 EXPORT_SYMBOL_GPL(nrf_wifi_sys_fmac_add_key);
+EXPORT_SYMBOL_GPL(nrf_wifi_sys_fmac_cmd_submit_async);
+EXPORT_SYMBOL_GPL(nrf_wifi_sys_fmac_cmd_async_cancel);
+EXPORT_SYMBOL_GPL(nrf_wifi_sys_fmac_cmd_async_poll);
+EXPORT_SYMBOL_GPL(nrf_wifi_sys_fmac_chg_vif_state_async);
+#ifdef NRF_WIFI_RPU_RECOVERY
+EXPORT_SYMBOL_GPL(nrf_wifi_sys_fmac_recovery_replay);
+EXPORT_SYMBOL_GPL(nrf_wifi_sys_fmac_recovery_replay_keys_set);
+EXPORT_SYMBOL_GPL(nrf_wifi_sys_fmac_recovery_stats_get);
+EXPORT_SYMBOL_GPL(nrf_wifi_sys_fmac_recovery_history_get);
+EXPORT_SYMBOL_GPL(nrf_wifi_sys_fmac_recovery_trigger);
+#endif /* NRF_WIFI_RPU_RECOVERY */
+EXPORT_SYMBOL_GPL(nrf_wifi_sys_fmac_stats_periodic_start);
+EXPORT_SYMBOL_GPL(nrf_wifi_sys_fmac_stats_periodic_stop);
+EXPORT_SYMBOL_GPL(nrf_wifi_sys_fmac_stats_periodic_tick);
+EXPORT_SYMBOL_GPL(nrf_wifi_sys_fmac_stats_periodic_get);
+EXPORT_SYMBOL_GPL(nrf_wifi_fmac_mem_stats_get);
+#ifdef NRF_WIFI_LOW_POWER
+EXPORT_SYMBOL_GPL(nrf_wifi_fmac_rpu_ps_stats_get);
+EXPORT_SYMBOL_GPL(nrf_wifi_fmac_rpu_ps_stats_reset);
+EXPORT_SYMBOL_GPL(nrf_wifi_fmac_rpu_ps_idle_timeout_bounds_set);
+EXPORT_SYMBOL_GPL(nrf_wifi_fmac_rpu_ps_idle_timeout_override);
+#endif /* NRF_WIFI_LOW_POWER */
+EXPORT_SYMBOL_GPL(nrf_wifi_sys_fmac_bss_table_get);
+EXPORT_SYMBOL_GPL(nrf_wifi_sys_fmac_bss_table_flush);
+EXPORT_SYMBOL_GPL(nrf_wifi_sys_fmac_bss_table_max_age_set);
+EXPORT_SYMBOL_GPL(nrf_wifi_sys_fmac_chan_hints_get);
+EXPORT_SYMBOL_GPL(nrf_wifi_sys_fmac_scan_targeted);
+EXPORT_SYMBOL_GPL(nrf_wifi_sys_fmac_event_observer_register);
+EXPORT_SYMBOL_GPL(nrf_wifi_sys_fmac_event_observer_unregister);
+EXPORT_SYMBOL_GPL(nrf_wifi_sys_fmac_event_stats_enable);
+EXPORT_SYMBOL_GPL(nrf_wifi_sys_fmac_event_stats_reset);
+EXPORT_SYMBOL_GPL(nrf_wifi_sys_fmac_event_stats_get);
+EXPORT_SYMBOL_GPL(nrf_wifi_sys_fmac_tx_params_get);
+EXPORT_SYMBOL_GPL(nrf_wifi_sys_fmac_tx_params_set);
+#ifdef NRF70_STA_MODE
+EXPORT_SYMBOL_GPL(nrf_wifi_sys_fmac_twt_tx_stats_get);
+#endif /* NRF70_STA_MODE */
+#ifdef NRF70_AP_MODE
+EXPORT_SYMBOL_GPL(nrf_wifi_sys_fmac_ap_dtim_tick);
+#endif /* NRF70_AP_MODE */
+#ifdef NRF70_RAW_DATA_TX
+EXPORT_SYMBOL_GPL(nrf_wifi_fmac_rawtx_session_start);
+EXPORT_SYMBOL_GPL(nrf_wifi_fmac_rawtx_session_xmit);
+EXPORT_SYMBOL_GPL(nrf_wifi_fmac_rawtx_session_stop);
+#endif /* NRF70_RAW_DATA_TX */
+#if defined(NRF70_RAW_DATA_RX) || defined(NRF70_PROMISC_DATA_RX)
+EXPORT_SYMBOL_GPL(nrf_wifi_sys_fmac_set_rx_filter);
+EXPORT_SYMBOL_GPL(nrf_wifi_sys_fmac_get_rx_filter_stats);
+EXPORT_SYMBOL_GPL(nrf_wifi_sys_fmac_capture_ring_start);
+EXPORT_SYMBOL_GPL(nrf_wifi_sys_fmac_capture_ring_stop);
+EXPORT_SYMBOL_GPL(nrf_wifi_sys_fmac_capture_ring_sync);
+EXPORT_SYMBOL_GPL(nrf_wifi_sys_fmac_capture_ring_stats_get);
+#endif /* NRF70_RAW_DATA_RX || NRF70_PROMISC_DATA_RX */
 
 static int __init nrf_wifi_osal_mod_init(void) {
 	return 0;
@@ -735,6 +735,63 @@ unsigned long nrf_wifi_osal_time_get_curr_ms(void);
  */
 unsigned int nrf_wifi_osal_time_elapsed_ms(unsigned long start_time_ms);
 
+
+/**
+ * @brief Allocate a completion object.
+ *
+ * Allocates a completion object which can be used to block the calling
+ * thread until an event signals the end of an operation. If the OS shim
+ * does not provide completion ops, a generic implementation built on the
+ * spinlock and timer ops is used, which needs a spinlock_take() that can
+ * sleep.
+ *
+ * @return Pointer to the completion object if allocation is successful, NULL otherwise.
+ */
+void *nrf_wifi_osal_completion_alloc(void);
+
+
+/**
+ * @brief Free a completion object.
+ * @param completion Pointer to a completion object.
+ *
+ * Frees a completion object which was allocated using
+ * nrf_wifi_osal_completion_alloc.
+ */
+void nrf_wifi_osal_completion_free(void *completion);
+
+
+/**
+ * @brief Initialize (re-arm) a completion object.
+ * @param completion Pointer to a completion object.
+ *
+ * Clears any earlier signalled state of the completion object. This needs
+ * to be called before issuing the operation whose completion is waited upon.
+ */
+void nrf_wifi_osal_completion_init(void *completion);
+
+
+/**
+ * @brief Wait for a completion object to be signalled.
+ * @param completion Pointer to a completion object.
+ * @param timeout_ms Maximum time to wait in milliseconds.
+ *
+ * Blocks the calling thread until the completion object is signalled using
+ * nrf_wifi_osal_completion_complete or until @p timeout_ms expires.
+ *
+ * @return NRF_WIFI_STATUS_SUCCESS if signalled, NRF_WIFI_STATUS_FAIL on timeout.
+ */
+enum nrf_wifi_status nrf_wifi_osal_completion_wait(void *completion,
+						   unsigned int timeout_ms);
+
+
+/**
+ * @brief Signal a completion object.
+ * @param completion Pointer to a completion object.
+ *
+ * Wakes up a thread waiting on the completion object.
+ */
+void nrf_wifi_osal_completion_complete(void *completion);
+
 /**
  * @brief Initialize a PCIe driver.
  * @param dev_name Name of the PCIe device.
@@ -608,6 +608,53 @@ struct nrf_wifi_osal_ops {
 	 */
 	unsigned int (*time_elapsed_ms)(unsigned long start_time_us);
 
+	/**
+	 * @brief Allocate a completion object.
+	 *
+	 * A completion lets a thread block until another context (typically
+	 * the event processing path) signals that an operation has finished.
+	 *
+	 * @return A pointer to the allocated completion object.
+	 */
+	void *(*completion_alloc)(void);
+
+	/**
+	 * @brief Free a completion object.
+	 *
+	 * @param completion A pointer to the completion object to free.
+	 */
+	void (*completion_free)(void *completion);
+
+	/**
+	 * @brief Initialize (re-arm) a completion object.
+	 *
+	 * Clears any previously signalled state. Must be called before the
+	 * operation whose completion is to be waited upon is started.
+	 *
+	 * @param completion A pointer to the completion object to initialize.
+	 */
+	void (*completion_init)(void *completion);
+
+	/**
+	 * @brief Wait for a completion object to be signalled.
+	 *
+	 * @param completion A pointer to the completion object to wait on.
+	 * @param timeout_ms The maximum time to wait in milliseconds.
+	 * @return NRF_WIFI_STATUS_SUCCESS if signalled, NRF_WIFI_STATUS_FAIL on timeout.
+	 */
+	enum nrf_wifi_status (*completion_wait)(void *completion,
+						unsigned int timeout_ms);
+
+	/**
+	 * @brief Signal a completion object.
+	 *
+	 * Wakes up the thread waiting on the completion object. Can be
+	 * called from the event processing context.
+	 *
+	 * @param completion A pointer to the completion object to signal.
+	 */
+	void (*completion_complete)(void *completion);
+
 	/**
 	 * @brief Initialize the PCIe bus.
 	 *
@@ -484,6 +484,193 @@ unsigned int nrf_wifi_osal_time_elapsed_ms(unsigned long start_time_ms)
 	return os_ops->time_elapsed_ms(start_time_ms);
 }
 
+/*
+ * Fallback for OS shims which do not provide completion ops. The waiter
+ * blocks on sem, which is held while nobody has signalled it, and is
+ * released by either the completion or the expiry of timer. This relies
+ * on spinlock_take() being able to sleep (semaphore based locks).
+ */
+struct nrf_wifi_osal_fb_completion {
+	/* Protects done and waiting */
+	void *lock;
+	/* Held unless a waiter is to be woken up */
+	void *sem;
+	/* Wakes up the waiter on timeout */
+	void *timer;
+	bool done;
+	bool waiting;
+};
+
+
+static void nrf_wifi_osal_fb_completion_wake(struct nrf_wifi_osal_fb_completion *fb_comp,
+					     bool done)
+{
+	bool wake = false;
+
+	os_ops->spinlock_take(fb_comp->lock);
+
+	if (done) {
+		fb_comp->done = true;
+	}
+
+	/* Only one of the completion and the timer releases the waiter */
+	wake = fb_comp->waiting;
+	fb_comp->waiting = false;
+
+	os_ops->spinlock_rel(fb_comp->lock);
+
+	if (wake) {
+		os_ops->spinlock_rel(fb_comp->sem);
+	}
+}
+
+
+static void nrf_wifi_osal_fb_completion_timeout(unsigned long data)
+{
+	nrf_wifi_osal_fb_completion_wake((struct nrf_wifi_osal_fb_completion *)data,
+					 false);
+}
+
+
+static void nrf_wifi_osal_fb_completion_free(struct nrf_wifi_osal_fb_completion *fb_comp)
+{
+	if (fb_comp->timer) {
+		os_ops->timer_kill(fb_comp->timer);
+		os_ops->timer_free(fb_comp->timer);
+	}
+
+	if (fb_comp->sem) {
+		os_ops->spinlock_free(fb_comp->sem);
+	}
+
+	if (fb_comp->lock) {
+		os_ops->spinlock_free(fb_comp->lock);
+	}
+
+	nrf_wifi_osal_mem_free(fb_comp);
+}
+
+
+void *nrf_wifi_osal_completion_alloc(void)
+{
+	struct nrf_wifi_osal_fb_completion *fb_comp = NULL;
+
+	if (os_ops->completion_alloc) {
+		return os_ops->completion_alloc();
+	}
+
+	fb_comp = nrf_wifi_osal_mem_zalloc(sizeof(*fb_comp));
+
+	if (!fb_comp) {
+		goto out;
+	}
+
+	fb_comp->lock = os_ops->spinlock_alloc();
+	fb_comp->sem = os_ops->spinlock_alloc();
+	fb_comp->timer = os_ops->timer_alloc();
+
+	if (!fb_comp->lock || !fb_comp->sem || !fb_comp->timer) {
+		nrf_wifi_osal_fb_completion_free(fb_comp);
+		fb_comp = NULL;
+		goto out;
+	}
+
+	os_ops->spinlock_init(fb_comp->lock);
+	os_ops->spinlock_init(fb_comp->sem);
+	os_ops->timer_init(fb_comp->timer,
+			   nrf_wifi_osal_fb_completion_timeout,
+			   (unsigned long)fb_comp);
+
+	/* Held until a waiter is signalled */
+	os_ops->spinlock_take(fb_comp->sem);
+out:
+	return fb_comp;
+}
+
+
+void nrf_wifi_osal_completion_free(void *completion)
+{
+	if (!completion) {
+		return;
+	}
+
+	if (os_ops->completion_free) {
+		os_ops->completion_free(completion);
+		return;
+	}
+
+	nrf_wifi_osal_fb_completion_free(completion);
+}
+
+
+void nrf_wifi_osal_completion_init(void *completion)
+{
+	struct nrf_wifi_osal_fb_completion *fb_comp = completion;
+
+	if (os_ops->completion_init) {
+		os_ops->completion_init(completion);
+		return;
+	}
+
+	os_ops->spinlock_take(fb_comp->lock);
+	fb_comp->done = false;
+	os_ops->spinlock_rel(fb_comp->lock);
+}
+
+
+enum nrf_wifi_status nrf_wifi_osal_completion_wait(void *completion,
+						   unsigned int timeout_ms)
+{
+	struct nrf_wifi_osal_fb_completion *fb_comp = completion;
+	bool done = false;
+
+	if (os_ops->completion_wait) {
+		return os_ops->completion_wait(completion,
+					       timeout_ms);
+	}
+
+	os_ops->spinlock_take(fb_comp->lock);
+
+	done = fb_comp->done;
+
+	if (!done) {
+		fb_comp->waiting = true;
+	}
+
+	os_ops->spinlock_rel(fb_comp->lock);
+
+	if (done) {
+		return NRF_WIFI_STATUS_SUCCESS;
+	}
+
+	os_ops->timer_schedule(fb_comp->timer,
+			       timeout_ms);
+
+	/* Released by nrf_wifi_osal_completion_complete or the timer */
+	os_ops->spinlock_take(fb_comp->sem);
+
+	os_ops->timer_kill(fb_comp->timer);
+
+	os_ops->spinlock_take(fb_comp->lock);
+	done = fb_comp->done;
+	os_ops->spinlock_rel(fb_comp->lock);
+
+	return done ? NRF_WIFI_STATUS_SUCCESS : NRF_WIFI_STATUS_FAIL;
+}
+
+
+void nrf_wifi_osal_completion_complete(void *completion)
+{
+	if (os_ops->completion_complete) {
+		os_ops->completion_complete(completion);
+		return;
+	}
+
+	nrf_wifi_osal_fb_completion_wake(completion,
+					 true);
+}
+
+
 void *nrf_wifi_osal_bus_pcie_init(const char *dev_name,
 				  unsigned int vendor_id,
 				  unsigned int sub_vendor_id,